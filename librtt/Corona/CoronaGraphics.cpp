@@ -22,11 +22,15 @@
 
 #include "Display/Rtt_TextureResourceExternalAdapter.h"
 
+#include <stddef.h>
+
 
 CORONA_API
 int CoronaExternalPushTexture( lua_State *L, const CoronaExternalTextureCallbacks *callbacks, void* context)
 {
-	if ( callbacks->size != sizeof(CoronaExternalTextureCallbacks) )
+	// Structures from before getDirtyRects was added are still valid
+	if ( callbacks->size != sizeof(CoronaExternalTextureCallbacks)
+		&& callbacks->size != offsetof(CoronaExternalTextureCallbacks, getDirtyRects) )
 	{
 		CoronaLuaError(L, "TextureResourceExternal - invalid binary version for callback structure; size value isn't valid");
 		return 0;
@@ -54,6 +54,19 @@ typedef enum {
 } CoronaExternalBitmapFormat;
 
 
+/**
+ Area of a bitmap, in pixels. `x` and `y` are measured from the top left of the bitmap
+ @see CoronaExternalTextureCallbacks::getDirtyRects
+*/
+typedef struct CoronaExternalTextureRect
+{
+	unsigned int x;
+	unsigned int y;
+	unsigned int width;
+	unsigned int height;
+} CoronaExternalTextureRect;
+
+
 /**
  This structure contains callbacks required for TextureResource's life cycle
  When Corona would require some information about Texture or it's bitmap, a callback would be invoked
@@ -75,6 +88,8 @@ typedef enum {
     is called and all objects using texture are destroyed. Also called when app is shutting down or restarted
   - `onGetField()` is used when user queries texture for unknown field from Lua. Returned number
     must be a number of values pushed on Lua stack
+  - `getDirtyRects()` if present, is called when invalidated texture is about to be uploaded, before `onRequestBitmap()`.
+    Only areas it reports are uploaded, which is much cheaper for large bitmaps with small changes
 
  In order to create external bitmap you must provide width, height and bitmap callbacks
  all other are optional and will be ignored if set to NULL
@@ -84,7 +99,8 @@ typedef struct CoronaExternalTextureCallbacks
 	/**
 	 Required
 	 When creating instance of this type set this member to `size = sizeof(CoronaExternalTextureCallbacks)`.
-	 This is required for identifying version of API used.
+	 This is required for identifying version of API used. Older versions of the structure, which end before
+	 `getDirtyRects`, are accepted as well.
 	*/
 	unsigned long size;
 	
@@ -151,6 +167,17 @@ typedef struct CoronaExternalTextureCallbacks
 	 @return number of values pushed on Lua stack
 	*/
 	int (*onGetField)(lua_State *L, const char *field, void* userData);   // optional; called Lua texture property lookup
+
+	/**
+	 Optional
+	 Called when invalidated texture is about to be uploaded, before @see onRequestBitmap
+	 Reports areas of the bitmap changed since the previous upload, so only they are uploaded
+	 @param rects Array to write the changed areas to
+	 @param maxRects Number of elements in `rects`
+	 @param userData Pointer passed to CoronaExternalPushTexture
+	 @return Number of areas written to `rects`. If 0 or greater than `maxRects`, the entire bitmap is uploaded
+	*/
+	unsigned int (*getDirtyRects)(CoronaExternalTextureRect *rects, unsigned int maxRects, void* userData);
 } CoronaExternalTextureCallbacks;
 
 // C API
@@ -17,6 +17,7 @@
 #include "Display/Rtt_BitmapPaintAdapter.h"
 #include "Display/Rtt_Display.h"
 #include "Display/Rtt_DisplayDefaults.h"
+#include "Display/Rtt_TextureAtlas.h"
 #include "Renderer/Rtt_RenderData.h"
 #include "Rtt_Runtime.h"
 #include "Display/Rtt_TextureFactory.h"
@@ -43,6 +44,8 @@ BitmapPaint::NewBitmap( Runtime& runtime, const char* filename, MPlatform::Direc
 	{
 		if ( pTexture->GetBitmap() == NULL || !pTexture->GetBitmap()->IsMask() )
 		{
+			factory.AddToAtlas( pTexture );
+
 			result = Rtt_NEW( runtime.Allocator(), BitmapPaint( pTexture ) ); Rtt_ASSERT( result );
 		}
 		else
@@ -74,6 +77,11 @@ BitmapPaint::NewBitmap( Runtime& runtime, const FilePath& data, U32 flags, bool
 		bool shouldCreate = !isMask || pTexture->GetBitmap() == NULL || pTexture->GetBitmap()->IsMask();
 		if ( shouldCreate )
 		{
+			if ( ! isMask )
+			{
+				factory.AddToAtlas( pTexture );
+			}
+
 			result = Rtt_NEW( runtime.Allocator(), BitmapPaint( pTexture ) ); Rtt_ASSERT( result );
 		}
 		else
@@ -133,6 +141,28 @@ BitmapPaint::UpdateTransform( Transform& t ) const
 	t = GetTransform();
 }
 
+void
+BitmapPaint::UpdatePaint( RenderData& data )
+{
+	Super::UpdatePaint( data );
+
+	const TextureAtlasRegion *region = GetAtlasRegion();
+	if ( region )
+	{
+		data.fFillTexture0 = & region->GetTexture();
+	}
+}
+
+void
+BitmapPaint::ApplyPaintUVTransformations( ArrayVertex2& vertices ) const
+{
+	const TextureAtlasRegion *region = GetAtlasRegion();
+	if ( region )
+	{
+		region->MapTexCoords( vertices );
+	}
+}
+
 PlatformBitmap *
 BitmapPaint::GetBitmap() const
 {
@@ -140,6 +170,20 @@ BitmapPaint::GetBitmap() const
 	return fResource->GetBitmap();
 }
 
+const TextureAtlasRegion *
+BitmapPaint::GetAtlasRegion() const
+{
+	const TextureAtlasRegion *result = NULL;
+
+	// Composite inputs and masks have no observer
+	if ( IsType( kBitmap ) && GetObserver() && ! HasShader() && fTransform.IsIdentity() )
+	{
+		result = fResource->GetAtlasRegion();
+	}
+
+	return result;
+}
+
 // ----------------------------------------------------------------------------
 
 } // namespace Rtt
@@ -24,6 +24,7 @@ namespace Rtt
 class FilePath;
 class ImageSheet;
 class MCachedResourceLibrary;
+class TextureAtlasRegion;
 class TextureFactory;
 class TextureResource;
 
@@ -53,9 +54,17 @@ class BitmapPaint : public Paint
 		virtual const MLuaUserdataAdapter& GetAdapter() const;
 		virtual void UpdateTransform( Transform& t ) const;
 
+		virtual void UpdatePaint( RenderData& data );
+		virtual void ApplyPaintUVTransformations( ArrayVertex2& vertices ) const;
+
 	public:
 		virtual PlatformBitmap *GetBitmap() const;
 
+		// Non-NULL if the image is drawn from its TextureAtlas page. Only
+		// paints of display objects that sample it as is qualify: effects
+		// and texture transforms rely on coordinates spanning the texture.
+		const TextureAtlasRegion *GetAtlasRegion() const;
+
 ///public:
 ///const SharedPtr< TextureResource >& GetTextureResource() const { return fResource; }
 
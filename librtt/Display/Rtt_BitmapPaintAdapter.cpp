@@ -151,6 +151,14 @@ BitmapPaintAdapter::SetValueForKey(
 
 		paint->Invalidate( Paint::kTextureTransformFlag );
 
+		// An atlased image only uses its page while untransformed, so its
+		// texture may change as well
+		DisplayObject *observer = paint->GetObserver();
+		if ( observer )
+		{
+			observer->Invalidate( DisplayObject::kPaintFlag );
+		}
+
 		result = true;
 	}
 	else
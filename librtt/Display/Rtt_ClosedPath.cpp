@@ -81,24 +81,18 @@ ClosedPath::UpdateGeometry( Geometry& dst, const VertexCache& src, const Matrix&
 
 	Rtt_ASSERT( ! updateTexture || ( vertices.Length() == texVertices.Length() ) );
 
-	for ( U32 i = 0, iMax = vertices.Length(); i < iMax; i++ )
+	if ( updateVertices )
 	{
-		Rtt_ASSERT( i < dst.GetVerticesAllocated() );
-
-		Geometry::Vertex& dst = dstVertices[i];
-
-		if ( updateVertices )
+		// Batched (SIMD where available), with the texture writes fused in
+		srcToDstSpace.Apply( dst, vertices.ReadAccess(), updateTexture ? texVertices.ReadAccess() : NULL, numVertices );
+	}
+	else if ( updateTexture )
+	{
+		for ( U32 i = 0; i < numVertices; i++ )
 		{
-			Vertex2 v = vertices[i];
-			srcToDstSpace.Apply( v );
+			Rtt_ASSERT( i < dst.GetVerticesAllocated() );
 
-			dst.x = v.x;
-			dst.y = v.y;
-			dst.z = 0.f;
-		}
-
-		if ( updateTexture )
-		{
+			Geometry::Vertex& dst = dstVertices[i];
 			dst.u = texVertices[i].x;
 			dst.v = texVertices[i].y;
 			dst.q = 1.f;
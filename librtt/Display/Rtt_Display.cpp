@@ -15,19 +15,29 @@
 #include "Display/Rtt_CPUResourcePool.h"
 #include "Display/Rtt_DisplayDefaults.h"
 #include "Display/Rtt_BitmapPaint.h"
+#include "Display/Rtt_FrameProfiler.h"
+#include "Display/Rtt_FrameReadback.h"
+#include "Rtt_HitTestObject.h"
 #include "Display/Rtt_Paint.h"
+#include "Display/Rtt_RenderThread.h"
 #include "Display/Rtt_Scene.h"
+#include "Display/Rtt_Shader.h"
 #include "Display/Rtt_ShaderFactory.h"
+#include "Display/Rtt_ShaderName.h"
 #include "Display/Rtt_SpritePlayer.h"
 #include "Display/Rtt_TextureFactory.h"
 #include "Display/Rtt_TextureResource.h"
+#include "Display/Rtt_TweenPlayer.h"
 
+#include "Core/Rtt_FileSystem.h"
 #include "Rtt_BufferBitmap.h"
 #include "Rtt_Lua.h"
 #include "Rtt_LuaContext.h"
+#include "Rtt_LuaLibTransition.h"
 #include "Rtt_PlatformSurface.h"
 #include "CoronaLua.h"
 
+#include "Renderer/Rtt_CommandBuffer.h"
 #include "Renderer/Rtt_GLRenderer.h"
 #include "Renderer/Rtt_FrameBufferObject.h"
 #include "Renderer/Rtt_Matrix_Renderer.h"
@@ -55,18 +65,35 @@ Display::Display( Runtime& owner )
 	fDeltaTimeInSeconds( 0.0f ),
 	fPreviousTime( owner.GetElapsedTime() ),
 	fRenderer( NULL ),
+	fRenderThread( NULL ),
 	fShaderFactory( NULL ),
 	fSpritePlayer( Rtt_NEW( owner.Allocator(), SpritePlayer( owner.Allocator() ) ) ),
+	fTweenPlayer( Rtt_NEW( owner.Allocator(), TweenPlayer( * this ) ) ),
 	fTextureFactory( Rtt_NEW( owner.Allocator(), TextureFactory( * this ) ) ),
+	fProfiler( Rtt_NEW( owner.Allocator(), FrameProfiler( owner.Allocator() ) ) ),
+	fHitTestArena( Rtt_NEW( owner.Allocator(), HitTestObjectArena( owner.Allocator() ) ) ),
+	fReadback( Rtt_NEW( owner.Allocator(), FrameReadback( owner.Allocator(), * this ) ) ),
 	fScene( Rtt_NEW( & owner.GetAllocator(), Scene( owner.Allocator(), * this ) ) ),
 	fStream( Rtt_NEW( owner.GetAllocator(), RenderingStream( owner.GetAllocator() ) ) ),
 	fScreenSurface( owner.Platform().CreateScreenSurface() ),
-	fIsCollecting( false )
+	fIsCollecting( false ),
+	fIsSurfaceDestroyed( false )
 {
 }
 
 Display::~Display()
 {
+	// Executes the frame in flight, if any, and hands the context back
+	// unless the surface is going away with it
+	if ( fRenderThread )
+	{
+		Rtt_DELETE( fRenderThread );
+		if ( ! fIsSurfaceDestroyed )
+		{
+			fScreenSurface->SetCurrent();
+		}
+	}
+
 	Paint::Finalize();
 
     //Needs to be done before deletes, because it uses scene etc
@@ -75,7 +102,11 @@ Display::~Display()
 	Rtt_DELETE( fScreenSurface );
 	Rtt_DELETE( fStream );
 	Rtt_DELETE( fScene );
+	Rtt_DELETE( fReadback );
+	Rtt_DELETE( fHitTestArena );
+	Rtt_DELETE( fProfiler );
 	Rtt_DELETE( fTextureFactory );
+	Rtt_DELETE( fTweenPlayer );
 	Rtt_DELETE( fSpritePlayer );
 	Rtt_DELETE( fShaderFactory );
 	Rtt_DELETE( fRenderer );
@@ -107,6 +138,22 @@ Display::Initialize( lua_State *L, int configIndex )
 
 		fShaderFactory = Rtt_NEW( allocator, ShaderFactory( *this, programHeader ) );
 
+		InitializeShaderCache( L, configIndex );
+
+		if ( RenderThread::IsSupported( * fScreenSurface ) )
+		{
+			// These are queried from Lua and image loading without a Lock,
+			// so cache them now. (The first query of a compressed format
+			// caches all of them.)
+			Renderer::GetMaxTextureSize();
+			Renderer::GetGpuSupportsHighPrecisionFragmentShaders();
+			Renderer::GetMaxVertexTextureUnits();
+			CommandBuffer::GetGpuSupportsCompressedFormat( Texture::kETC1 );
+
+			fScreenSurface->ReleaseCurrent();
+			fRenderThread = Rtt_NEW( allocator, RenderThread( * fRenderer, * fScreenSurface ) );
+		}
+
 		result = true;
 	}
 
@@ -174,6 +221,61 @@ Display::ReadRenderingConfig( lua_State *L, int index, ProgramHeader& programHea
 	Rtt_ASSERT( 1 == lua_gettop( L ) );	
 }
 
+// Reads the following (optional) fields of the config.lua content table:
+//   shaderCache: If false, linked shader programs are not cached on disk.
+//   precompileShaders: Array of effect names, e.g. { "filter.blur" }, whose
+//     programs are compiled and linked before the first frame is drawn.
+void
+Display::InitializeShaderCache( lua_State *L, int index )
+{
+	bool isCacheEnabled = true;
+	if ( index > 0 )
+	{
+		lua_getfield( L, index, "shaderCache" );
+		if ( lua_isboolean( L, -1 ) )
+		{
+			isCacheEnabled = ( !! lua_toboolean( L, -1 ) );
+		}
+		lua_pop( L, 1 );
+	}
+
+	if ( isCacheEnabled )
+	{
+		String path( GetRuntime().GetAllocator() );
+		fOwner.Platform().PathForFile( "shaders", MPlatform::kCachesDir, MPlatform::kDefaultPathFlags, path );
+
+		const char *directory = path.GetString();
+		if ( directory && ( Rtt_IsDirectory( directory ) || Rtt_MakeDirectory( directory ) ) )
+		{
+			fRenderer->SetProgramCacheDirectory( directory );
+		}
+	}
+
+	if ( index > 0 )
+	{
+		lua_getfield( L, index, "precompileShaders" );
+		if ( lua_istable( L, -1 ) )
+		{
+			for ( int i = 1, iMax = (int)lua_objlen( L, -1 ); i <= iMax; i++ )
+			{
+				lua_rawgeti( L, -1, i );
+				const char *name = lua_tostring( L, -1 );
+				if ( name )
+				{
+					Shader *shader = fShaderFactory->FindOrLoad( ShaderName( name ) );
+					if ( shader )
+					{
+						shader->Precompile( * fRenderer );
+						Rtt_DELETE( shader );
+					}
+				}
+				lua_pop( L, 1 );
+			}
+		}
+		lua_pop( L, 1 );
+	}
+}
+
 lua_State *
 Display::GetL() const
 {
@@ -208,12 +310,36 @@ Display::Update()
 {
 	Runtime& runtime = fOwner;
 	lua_State *L = fOwner.VMContext().L();
-	fSpritePlayer->Run( L, Rtt_AbsoluteToMilliseconds(runtime.GetElapsedTime()) );
+
+	fProfiler->BeginFrame();
+
+	{
+		Rtt_PROFILE_ZONE( * fProfiler, "FrameReadback::DispatchEvents" );
+		fReadback->DispatchEvents( L );
+	}
+
+	{
+		Rtt_PROFILE_ZONE( * fProfiler, "SpritePlayer::Run" );
+		fSpritePlayer->Run( L, Rtt_AbsoluteToMilliseconds(runtime.GetElapsedTime()) );
+	}
+
+	{
+		Rtt_PROFILE_ZONE( * fProfiler, "TweenPlayer::Run" );
+		fTweenPlayer->Run( Rtt_AbsoluteToMilliseconds(runtime.GetElapsedTime()) );
+
+		if ( fTweenPlayer->HasCompletions() )
+		{
+			LuaLibTransition::DispatchEvents( L );
+		}
+	}
 
 	GetScene().QueueUpdateOfUpdatables();
 
-	const FrameEvent& fe = FrameEvent::Constant();
-	fe.Dispatch( L, runtime );
+	{
+		Rtt_PROFILE_ZONE( * fProfiler, "enterFrame" );
+		const FrameEvent& fe = FrameEvent::Constant();
+		fe.Dispatch( L, runtime );
+	}
 	
 	const RenderEvent& re = RenderEvent::Constant();
 	re.Dispatch( L, runtime );
@@ -325,6 +451,12 @@ Display::ColorSample( float pos_x,
 	Rtt_DELETE( paint );
 }
 
+void
+Display::ProcessReadbacks()
+{
+	fReadback->Process( * fStream );
+}
+
 BitmapPaint *
 Display::Capture( DisplayObject *object,
 					Rect *screenBounds,
@@ -343,6 +475,9 @@ Display::Capture( DisplayObject *object,
 		}
 	}
 
+	// Renders and reads back on this thread
+	RenderThread::Lock lock( fRenderThread );
+
 	fRenderer->BeginFrame( 0.1f, 0.1f, GetScreenToContentScale() );
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -633,12 +768,18 @@ Display::Capture( DisplayObject *object,
 void
 Display::UnloadResources()
 {
+	RenderThread::Lock lock( fRenderThread );
+
+	fReadback->ReleaseGPUResources();
 	GetRenderer().ReleaseGPUResources();
 }
 
 void
 Display::ReloadResources()
 {
+	RenderThread::Lock lock( fRenderThread );
+
+	fReadback->ReleaseGPUResources();
 	GetRenderer().ReleaseGPUResources();
 	GetRenderer().Initialize();
 }
@@ -823,8 +964,11 @@ Display::GetMaxTextureSize()
 }
 
 const char *
-Display::GetGlString( const char *s )
+Display::GetGlString( const char *s ) const
 {
+	// Not cached, so the context must be taken from the RenderThread
+	RenderThread::Lock lock( fRenderThread );
+
 	return Renderer::GetGlString( s );
 }
 
@@ -38,9 +38,13 @@ struct Rect;
 class BitmapPaint;
 class DisplayDefaults;
 class DisplayObject;
+class HitTestObjectArena;
+class FrameProfiler;
+class FrameReadback;
 class GroupObject;
 class ProgramHeader;
 class Renderer;
+class RenderThread;
 class Runtime;
 class Scene;
 class ShaderFactory;
@@ -48,6 +52,7 @@ class SpritePlayer;
 class StageObject;
 class String;
 class TextureFactory;
+class TweenPlayer;
 class PlatformSurface;
 class RenderingStream;
 
@@ -66,6 +71,7 @@ class Display
 
 	protected:
 		void ReadRenderingConfig( lua_State *L, int index, ProgramHeader& programHeader );
+		void InitializeShaderCache( lua_State *L, int index );
 
 	public:
 		virtual void Start();
@@ -99,6 +105,9 @@ class Display
 							float pos_y,
 							RGBA &output_color );
 
+		// Called by Scene once a frame has been rendered, before it is presented
+		void ProcessReadbacks();
+
 	private:
 		virtual BitmapPaint *Capture( DisplayObject *object,
 										Rect *screenBounds,
@@ -168,14 +177,30 @@ class Display
 		Renderer& GetRenderer() { return *fRenderer; }
 		const Renderer& GetRenderer() const { return *fRenderer; }
 
+		// NULL unless frames are executed on a separate thread
+		RenderThread* GetRenderThread() const { return fRenderThread; }
+
+		// Called by platforms that delete the runtime while the surface is
+		// being destroyed. The rendering context is then left unselected
+		// once the render thread exits, instead of handed back.
+		void SetSurfaceDestroyed() { fIsSurfaceDestroyed = true; }
+
 		ShaderFactory& GetShaderFactory() const { return * fShaderFactory; }
 
 		SpritePlayer& GetSpritePlayer() const { return * fSpritePlayer; }
 
+		TweenPlayer& GetTweenPlayer() const { return * fTweenPlayer; }
+
 		TextureFactory& GetTextureFactory() const { return * fTextureFactory; }
+
+		FrameProfiler& GetProfiler() const { return * fProfiler; }
+
+		HitTestObjectArena& GetHitTestArena() const { return * fHitTestArena; }
+
+		FrameReadback& GetReadback() const { return * fReadback; }
 				
 		static U32 GetMaxTextureSize();
-		static const char *GetGlString( const char *s );
+		const char *GetGlString( const char *s ) const;
 		static bool GetGpuSupportsHighPrecisionFragmentShaders();
 		static size_t GetMaxVertexTextureUnits();
 
@@ -196,9 +221,14 @@ class Display
 		float fDeltaTimeInSeconds;
 		Rtt_AbsoluteTime fPreviousTime;
 		Renderer *fRenderer;
+		RenderThread *fRenderThread;
 		ShaderFactory *fShaderFactory;
 		SpritePlayer *fSpritePlayer;
+		TweenPlayer *fTweenPlayer;
 		TextureFactory *fTextureFactory;
+		FrameProfiler *fProfiler;
+		HitTestObjectArena *fHitTestArena;
+		FrameReadback *fReadback;
 		Scene *fScene;
 
 		// TODO: Refactor data structure portions out
@@ -208,6 +238,7 @@ class Display
 		PlatformSurface *fScreenSurface;
 
 		bool fIsCollecting; // guards against nested calls to Collect()
+		bool fIsSurfaceDestroyed;
 };
 
 // ----------------------------------------------------------------------------
@@ -38,9 +38,13 @@ DisplayDefaults::DisplayDefaults()
 	fMinTextureFilter( RenderTypes::kLinearTextureFilter ),
 	fWrapX( RenderTypes::kClampToEdgeWrap ),
 	fWrapY( RenderTypes::kClampToEdgeWrap ),
+	fTextureUploadBytesPerFrame( 4 * 1024 * 1024 ),
+	fTextureUploadTimePerFrame( 4000 ),
+	fImageAtlasMaxSize( 0 ),
 	fShaderCompilerVerbose( kShaderCompilerVerboseDefault ),
 	fIsAnchorClamped( true ),
-	fIsImageSheetSampledInsideFrame( false )
+	fIsImageSheetSampledInsideFrame( false ),
+	fIsHitTestIndexed( false )
 {
 }
 
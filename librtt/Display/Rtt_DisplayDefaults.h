@@ -54,6 +54,23 @@ class DisplayDefaults
 
 		bool IsImageSheetSampledInsideFrame() const { return fIsImageSheetSampledInsideFrame;}
 		void SetImageSheetSampledInsideFrame( bool newValue ) { fIsImageSheetSampledInsideFrame = newValue; }
+
+		// Per-frame limits on uploading asynchronously loaded textures
+		U32 GetTextureUploadBytesPerFrame() const { return fTextureUploadBytesPerFrame; }
+		void SetTextureUploadBytesPerFrame( U32 newValue ) { fTextureUploadBytesPerFrame = newValue; }
+
+		U32 GetTextureUploadTimePerFrame() const { return fTextureUploadTimePerFrame; } // microseconds
+		void SetTextureUploadTimePerFrame( U32 newValue ) { fTextureUploadTimePerFrame = newValue; }
+
+		// Images loaded afterwards that are no larger than this (in pixels)
+		// are packed into shared atlas pages. 0 turns atlasing off.
+		U32 GetImageAtlasMaxSize() const { return fImageAtlasMaxSize; }
+		void SetImageAtlasMaxSize( U32 newValue ) { fImageAtlasMaxSize = newValue; }
+
+		// When true, touch/mouse hit testing only visits candidates from a
+		// per-stage spatial index instead of walking the whole hierarchy
+		bool IsHitTestIndexed() const { return fIsHitTestIndexed; }
+		void SetHitTestIndexed( bool newValue ) { fIsHitTestIndexed = newValue; }
 	public:	
 		bool IsShaderCompilerVerbose() const { return fShaderCompilerVerbose; }
 		void SetShaderCompilerVerbose( bool newValue ) { fShaderCompilerVerbose = newValue; }
@@ -67,9 +84,13 @@ class DisplayDefaults
 		U8 fMinTextureFilter;
 		U8 fWrapX;
 		U8 fWrapY;
+		U32 fTextureUploadBytesPerFrame;
+		U32 fTextureUploadTimePerFrame;
+		U32 fImageAtlasMaxSize;
 		bool fShaderCompilerVerbose;
 		bool fIsAnchorClamped;
 		bool fIsImageSheetSampledInsideFrame;
+		bool fIsHitTestIndexed;
 };
 
 // ----------------------------------------------------------------------------
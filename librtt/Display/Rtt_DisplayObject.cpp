@@ -289,6 +289,9 @@ DisplayObject::CullOffscreen( const Rect& screenBounds )
 				// Has become visible.
 				WillMoveOnscreen();
 				SetOffScreen( false );
+
+				// Anything invalidated while offscreen was skipped by Prepare()
+				InvalidateAncestors();
 			}
 		}
 		else
@@ -812,6 +815,11 @@ DisplayObject::Invalidate( DirtyFlags flags )
 		fTransform.Invalidate();
 	}
 
+	if ( flags & kRenderDirty )
+	{
+		InvalidateAncestors();
+	}
+
 	InvalidateDisplay();
 }
 
@@ -857,6 +865,24 @@ DisplayObject::InvalidateStageBounds()
 	}
 }
 
+// Marks each ancestor as having a dirty descendant, so GroupObject's
+// UpdateTransform() and Prepare() traverse down to the receiver.
+// 
+// Terminate at the first ancestor that is already marked, since its own
+// ancestors were marked along with it. A hidden or offscreen subtree can stay
+// marked after its ancestors are prepared, so SetVisible() and CullOffscreen()
+// re-mark the chain when it is shown again.
+void
+DisplayObject::InvalidateAncestors()
+{
+	for ( GroupObject *ancestor = GetParent();
+		  ancestor && ! ancestor->HasDirtyDescendants();
+		  ancestor = ancestor->GetParent() )
+	{
+		ancestor->SetDirtyDescendants();
+	}
+}
+
 bool
 DisplayObject::IsStageBoundsValid() const
 {
@@ -1089,6 +1115,33 @@ DisplayObject::SetGeometricProperty( enum GeometricProperty p, Real newValue )
 	}
 }
 
+void
+DisplayObject::SetGeometricProperties( U32 mask, const Real values[kNumGeometricProperties] )
+{
+	DirtyFlags flags = 0;
+
+	for ( int i = kOriginX; i <= kRotation; i++ )
+	{
+		GeometricProperty p = (GeometricProperty)i;
+		if ( ( mask & ( 1 << p ) ) && fTransform.GetProperty( p ) != values[p] )
+		{
+			// Same flags as Translate(), Rotate() and SetGeometricProperty()
+			flags |= kGeometryFlag | kTransformFlag | ( kRotation == p ? kStageBoundsFlag : kMaskFlag );
+
+			Rtt_WARN_SIM(
+				( kScaleX != p && kScaleY != p ) || ! Rtt_RealIsZero( values[p] ),
+				( "WARNING: Cannot set %cScale property of display object to zero\n",
+					( kScaleY == p ? 'y' : 'x' ) ) );
+			fTransform.SetProperty( p, values[p] );
+		}
+	}
+
+	if ( flags )
+	{
+		Invalidate( flags );
+	}
+}
+
 Real
 DisplayObject::GetGeometricProperty( enum GeometricProperty p ) const
 {
@@ -1217,6 +1270,9 @@ DisplayObject::SetVisible( bool newValue )
 		SetProperty( kIsVisible, newValue );
 		InvalidateStageBounds();
 
+		// Ancestors skip hidden children, so ensure they revisit the receiver
+		InvalidateAncestors();
+
 		StageObject* canvas = GetStage();
 		if ( canvas )
 		{
@@ -1225,6 +1281,18 @@ DisplayObject::SetVisible( bool newValue )
 	}
 }
 
+void
+DisplayObject::SetHitTestable( bool newValue )
+{
+	if ( IsHitTestable() != newValue )
+	{
+		SetProperty( kIsHitTestable, newValue );
+
+		// Hit-testable objects are transformed even when hidden
+		InvalidateAncestors();
+	}
+}
+
 void
 DisplayObject::SetHitTestMasked( bool newValue )
 {
@@ -1235,6 +1303,9 @@ DisplayObject::SetHitTestMasked( bool newValue )
 		if ( fMask )
 		{
 			InvalidateStageBounds();
+
+			// Ensure UpdateTransform() revisits the receiver's bounds
+			InvalidateAncestors();
 		}
 	}
 }
@@ -265,6 +265,9 @@ class DisplayObject : public MLuaProxyable
 		// Reblits display list to screen
 		void InvalidateDisplay();
 
+		// Flags each ancestor group so that its traversal reaches the receiver
+		void InvalidateAncestors();
+
 	protected:
 		static void CalculateMaskMatrix( Matrix& dstToMask, const Matrix& srcToDst, const BitmapMask& mask );
 		static void UpdateMaskUniform( Uniform& maskUniform, const Matrix& srcToDst, const BitmapMask& mask );
@@ -285,6 +288,10 @@ class DisplayObject : public MLuaProxyable
 		void SetGeometricProperty( enum GeometricProperty p, Real newValue );
 		Real GetGeometricProperty( enum GeometricProperty p ) const;
 
+		// Sets each transform property whose bit ( 1 << p ) is set in 'mask'
+		// to values[p], then invalidates once. Width and height are ignored.
+		void SetGeometricProperties( U32 mask, const Real values[kNumGeometricProperties] );
+
 	protected:
 		Real GetInternalAnchorX() const { return fAnchorX; }
 		Real GetInternalAnchorY() const { return fAnchorY; }
@@ -306,7 +313,7 @@ class DisplayObject : public MLuaProxyable
 		void SetVisible( bool newValue );
 
 		Rtt_INLINE bool IsHitTestable() const { return (fProperties & kIsHitTestable) != 0; }
-		Rtt_INLINE void SetHitTestable( bool newValue ) { SetProperty( kIsHitTestable, newValue ); }
+		void SetHitTestable( bool newValue );
 
 		Rtt_INLINE bool IsForceDraw() const { return (fProperties & kIsForceDraw) != 0; }
 		Rtt_INLINE void SetForceDraw( bool newValue ) { SetProperty( kIsForceDraw, newValue ); }
@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_FrameProfiler.h"
+
+#include "Core/Rtt_FileSystem.h"
+
+#include <stdio.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+FrameProfiler::FrameProfiler( Rtt_Allocator *allocator )
+:	fAllocator( allocator ),
+	fZones( NULL ),
+	fSamples( NULL ),
+	fCapacity( 0 ),
+	fNumZones( 0 ),
+	fNextZone( 0 ),
+	fSampleCapacity( 0 ),
+	fNumSamples( 0 ),
+	fNextSample( 0 ),
+	fFrame( 0 ),
+	fOrigin( 0 ),
+	fEnabled( false )
+{
+}
+
+FrameProfiler::~FrameProfiler()
+{
+	Rtt_FREE( fSamples );
+	Rtt_FREE( fZones );
+}
+
+void
+FrameProfiler::Start( U32 capacity )
+{
+	if ( capacity < 1 )
+	{
+		capacity = kDefaultCapacity;
+	}
+
+	if ( capacity != fCapacity )
+	{
+		Rtt_FREE( fSamples );
+		Rtt_FREE( fZones );
+
+		// Keep counters for about as many frames as the zone ring covers
+		fCapacity = capacity;
+		fSampleCapacity = Max( capacity / kZonesPerFrame, (U32)1 );
+		fZones = (Zone *)Rtt_MALLOC( fAllocator, fCapacity * sizeof( Zone ) );
+		fSamples = (Sample *)Rtt_MALLOC( fAllocator, fSampleCapacity * sizeof( Sample ) );
+	}
+
+	fNumZones = 0;
+	fNextZone = 0;
+	fNumSamples = 0;
+	fNextSample = 0;
+	fFrame = 0;
+	fOrigin = Rtt_GetAbsoluteTime();
+	fEnabled = ( NULL != fZones && NULL != fSamples );
+}
+
+void
+FrameProfiler::Stop()
+{
+	// Retain what was recorded so it can still be written out
+	fEnabled = false;
+}
+
+void
+FrameProfiler::BeginFrame()
+{
+	++fFrame;
+}
+
+void
+FrameProfiler::Record( const char *name, Rtt_AbsoluteTime begin, Rtt_AbsoluteTime end )
+{
+	Rtt_ASSERT( fEnabled );
+
+	Zone& zone = fZones[fNextZone];
+	zone.fName = name;
+	zone.fBegin = begin;
+	zone.fEnd = end;
+	zone.fFrame = fFrame;
+
+	fNextZone = ( fNextZone + 1 ) % fCapacity;
+	fNumZones = Min( fNumZones + 1, fCapacity );
+}
+
+void
+FrameProfiler::RecordStatistics( const Renderer::Statistics& statistics )
+{
+	Rtt_ASSERT( fEnabled );
+
+	Sample& sample = fSamples[fNextSample];
+	sample.fTime = Rtt_GetAbsoluteTime();
+	sample.fStatistics = statistics;
+
+	fNextSample = ( fNextSample + 1 ) % fSampleCapacity;
+	fNumSamples = Min( fNumSamples + 1, fSampleCapacity );
+}
+
+bool
+FrameProfiler::GetLastStatistics( Renderer::Statistics& result ) const
+{
+	if ( 0 == fNumSamples )
+	{
+		return false;
+	}
+
+	result = fSamples[( fNextSample + fSampleCapacity - 1 ) % fSampleCapacity].fStatistics;
+	return true;
+}
+
+bool
+FrameProfiler::Write( const char *path ) const
+{
+	FILE *f = Rtt_FileOpen( path, "wb" );
+	if ( ! f )
+	{
+		return false;
+	}
+
+	// Timestamps are relative to Start(), in microseconds
+	fprintf( f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+
+	const char *separator = "";
+
+	// Oldest entries first
+	U32 first = ( fNextZone + fCapacity - fNumZones ) % Max( fCapacity, (U32)1 );
+	for ( U32 i = 0; i < fNumZones; i++ )
+	{
+		const Zone& zone = fZones[( first + i ) % fCapacity];
+		fprintf( f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%llu,\"dur\":%llu,\"args\":{\"frame\":%u}}",
+			separator,
+			zone.fName,
+			(unsigned long long)Rtt_AbsoluteToMicroseconds( zone.fBegin - fOrigin ),
+			(unsigned long long)Rtt_AbsoluteToMicroseconds( zone.fEnd - zone.fBegin ),
+			zone.fFrame );
+		separator = ",\n";
+	}
+
+	first = ( fNextSample + fSampleCapacity - fNumSamples ) % Max( fSampleCapacity, (U32)1 );
+	for ( U32 i = 0; i < fNumSamples; i++ )
+	{
+		const Sample& sample = fSamples[( first + i ) % fSampleCapacity];
+		const Renderer::Statistics& s = sample.fStatistics;
+		const unsigned long long ts = Rtt_AbsoluteToMicroseconds( sample.fTime - fOrigin );
+
+		fprintf( f, "%s{\"name\":\"draws\",\"ph\":\"C\",\"pid\":1,\"ts\":%llu,\"args\":{\"drawCalls\":%u,\"triangles\":%u,\"lines\":%u}}",
+			separator, ts, s.fDrawCallCount, s.fTriangleCount, s.fLineCount );
+		separator = ",\n";
+
+		fprintf( f, "%s{\"name\":\"binds\",\"ph\":\"C\",\"pid\":1,\"ts\":%llu,\"args\":{\"geometry\":%u,\"program\":%u,\"texture\":%u,\"uniform\":%u}}",
+			separator, ts, s.fGeometryBindCount, s.fProgramBindCount, s.fTextureBindCount, s.fUniformBindCount );
+
+		fprintf( f, "%s{\"name\":\"times (ms)\",\"ph\":\"C\",\"pid\":1,\"ts\":%llu,\"args\":{\"preparation\":%.3f,\"cpu\":%.3f,\"gpu\":%.3f}}",
+			separator, ts, (double)s.fPreparationTime, (double)s.fRenderTimeCPU, (double)s.fRenderTimeGPU );
+	}
+
+	fprintf( f, "\n]}\n" );
+
+	bool result = ( 0 == ferror( f ) );
+	result = ( 0 == fclose( f ) ) && result;
+
+	return result;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
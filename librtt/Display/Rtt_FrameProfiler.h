@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_FrameProfiler_H__
+#define _Rtt_FrameProfiler_H__
+
+#include "Core/Rtt_Types.h"
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Time.h"
+#include "Renderer/Rtt_Renderer.h"
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Records timed zones into a fixed-size ring buffer so that the most recent
+// frames can be written out in Chrome's trace event format (about:tracing).
+// Zones are only recorded on the main thread. While disabled, a zone costs a
+// single branch.
+class FrameProfiler
+{
+	Rtt_CLASS_NO_COPIES( FrameProfiler )
+
+	public:
+		enum
+		{
+			kDefaultCapacity = 16384
+		};
+
+	public:
+		FrameProfiler( Rtt_Allocator *allocator );
+		~FrameProfiler();
+
+	public:
+		bool IsEnabled() const { return fEnabled; }
+
+		// (Re)starts recording. 'capacity' is the number of zones retained;
+		// older zones are overwritten once the ring is full.
+		void Start( U32 capacity = kDefaultCapacity );
+		void Stop();
+
+		// Marks the start of a new frame
+		void BeginFrame();
+
+		// 'name' must be a string literal (or otherwise outlive the profiler)
+		void Record( const char *name, Rtt_AbsoluteTime begin, Rtt_AbsoluteTime end );
+
+		// Appends the renderer's counters for the current frame
+		void RecordStatistics( const Renderer::Statistics& statistics );
+
+		// Copies the counters recorded last. Returns false if there are none.
+		// Unlike Renderer::GetFrameStatistics(), safe to call while the render
+		// thread executes a frame.
+		bool GetLastStatistics( Renderer::Statistics& result ) const;
+
+		// Writes the retained zones as trace JSON. Returns false on I/O failure.
+		bool Write( const char *path ) const;
+
+	private:
+		enum
+		{
+			kZonesPerFrame = 12 // Roughly, for a typical frame
+		};
+
+		struct Zone
+		{
+			const char *fName;
+			Rtt_AbsoluteTime fBegin;
+			Rtt_AbsoluteTime fEnd;
+			U32 fFrame;
+		};
+
+		struct Sample
+		{
+			Rtt_AbsoluteTime fTime;
+			Renderer::Statistics fStatistics;
+		};
+
+	private:
+		Rtt_Allocator *fAllocator;
+		Zone *fZones;
+		Sample *fSamples;
+		U32 fCapacity;
+		U32 fNumZones;
+		U32 fNextZone;
+		U32 fSampleCapacity;
+		U32 fNumSamples;
+		U32 fNextSample;
+		U32 fFrame;
+		Rtt_AbsoluteTime fOrigin;
+		bool fEnabled;
+};
+
+// Times the enclosing scope
+class FrameProfilerZone
+{
+	Rtt_CLASS_NO_COPIES( FrameProfilerZone )
+
+	public:
+		FrameProfilerZone( FrameProfiler& profiler, const char *name )
+		:	fProfiler( profiler.IsEnabled() ? & profiler : NULL ),
+			fName( name ),
+			fBegin( fProfiler ? Rtt_GetAbsoluteTime() : 0 )
+		{
+		}
+
+		~FrameProfilerZone()
+		{
+			if ( fProfiler )
+			{
+				fProfiler->Record( fName, fBegin, Rtt_GetAbsoluteTime() );
+			}
+		}
+
+	private:
+		FrameProfiler *fProfiler;
+		const char *fName;
+		Rtt_AbsoluteTime fBegin;
+};
+
+#define Rtt_PROFILE_ZONE( profiler, name ) \
+	Rtt::FrameProfilerZone Rtt_CONCATENATE( zone_, __LINE__ )( profiler, name )
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_FrameProfiler_H__
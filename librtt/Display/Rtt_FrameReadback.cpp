@@ -0,0 +1,344 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_FrameReadback.h"
+
+#include "Core/Rtt_Math.h"
+#include "Display/Rtt_BitmapPaint.h"
+#include "Display/Rtt_BufferBitmap.h"
+#include "Display/Rtt_Display.h"
+#include "Display/Rtt_LuaLibDisplay.h"
+#include "Display/Rtt_ShapeObject.h"
+#include "Display/Rtt_TextureFactory.h"
+#include "Renderer/Rtt_GLReadback.h"
+#include "Rtt_Event.h"
+#include "Rtt_LuaResource.h"
+#include "Rtt_RenderingStream.h"
+
+#include <math.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+FrameReadback::FrameReadback( Rtt_Allocator *allocator, Display& display )
+:	fAllocator( allocator ),
+	fDisplay( display ),
+	fReadback( Rtt_NEW( allocator, GLReadback( allocator ) ) ),
+	fPending(),
+	fInFlight(),
+	fResolved(),
+	fFrame( 0 )
+{
+}
+
+FrameReadback::~FrameReadback()
+{
+	for ( size_t i = 0; i < fInFlight.size(); i++ )
+	{
+		fPending.insert( fPending.end(), fInFlight[i].fRequests.begin(), fInFlight[i].fRequests.end() );
+	}
+	fPending.insert( fPending.end(), fResolved.begin(), fResolved.end() );
+
+	for ( size_t i = 0; i < fPending.size(); i++ )
+	{
+		Rtt_DELETE( fPending[i].fPaint );
+		Rtt_DELETE( fPending[i].fListener );
+	}
+
+	Rtt_DELETE( fReadback );
+}
+
+void
+FrameReadback::RequestColorSample( Real x, Real y, LuaResource *listener )
+{
+	Request request;
+	memset( & request, 0, sizeof( request ) );
+	request.fX = x;
+	request.fY = y;
+	request.fListener = listener;
+
+	fPending.push_back( request );
+
+	// Make sure there is a frame to read from
+	fDisplay.Invalidate();
+}
+
+void
+FrameReadback::RequestCapture( LuaResource *listener )
+{
+	Request request;
+	memset( & request, 0, sizeof( request ) );
+	request.fListener = listener;
+	request.fIsCapture = true;
+
+	fPending.push_back( request );
+
+	fDisplay.Invalidate();
+}
+
+void
+FrameReadback::Process( RenderingStream& stream )
+{
+	++fFrame;
+
+	Issue( stream );
+
+	// Readbacks that went through a pixel buffer are left until a later frame
+	// so that mapping them does not wait on the GPU
+	for ( size_t i = 0; i < fInFlight.size(); )
+	{
+		Batch& batch = fInFlight[i];
+		if ( GLReadback::IsAsync() && batch.fFrame == fFrame )
+		{
+			++i;
+			continue;
+		}
+
+		const U8 *pixels = fReadback->Map( batch.fSlot );
+		Resolve( batch, pixels, stream.IsProperty( RenderingStream::kFlipHorizontalAxis ) );
+		fReadback->Release( batch.fSlot );
+
+		fInFlight.erase( fInFlight.begin() + i );
+	}
+
+	// Keep frames coming until everything has been read back
+	if ( fPending.size() > 0 || fInFlight.size() > 0 )
+	{
+		fDisplay.Invalidate();
+	}
+}
+
+void
+FrameReadback::Issue( RenderingStream& stream )
+{
+	if ( fPending.empty() )
+	{
+		return;
+	}
+
+	const S32 deviceWidth = stream.DeviceWidth();
+	const S32 deviceHeight = stream.DeviceHeight();
+	const bool isFlipped = stream.IsProperty( RenderingStream::kFlipHorizontalAxis );
+	const Real scale = stream.GetScreenToContentScale();
+
+	S32 xMin = deviceWidth;
+	S32 yMin = deviceHeight;
+	S32 xMax = -1;
+	S32 yMax = -1;
+
+	for ( size_t i = 0; i < fPending.size(); i++ )
+	{
+		Request& request = fPending[i];
+
+		if ( request.fIsCapture )
+		{
+			// Whole screen
+			request.fIsValid = ( deviceWidth > 0 && deviceHeight > 0 );
+			if ( request.fIsValid )
+			{
+				xMin = 0;
+				yMin = 0;
+				xMax = deviceWidth - 1;
+				yMax = deviceHeight - 1;
+			}
+			continue;
+		}
+
+		// Pixel containing the content point, relative to OpenGL's origin
+		S32 x = (S32)floorf( request.fX / scale + stream.GetXScreenOffset() );
+		S32 y = (S32)floorf( request.fY / scale + stream.GetYScreenOffset() );
+		if ( isFlipped )
+		{
+			y = deviceHeight - 1 - y;
+		}
+
+		request.fIsValid = ( x >= 0 && x < deviceWidth && y >= 0 && y < deviceHeight );
+		if ( request.fIsValid )
+		{
+			request.fPixelX = x;
+			request.fPixelY = y;
+
+			xMin = Min( xMin, x );
+			yMin = Min( yMin, y );
+			xMax = Max( xMax, x );
+			yMax = Max( yMax, y );
+		}
+	}
+
+	Batch batch;
+	batch.fSlot = -1;
+	batch.fX = xMin;
+	batch.fY = yMin;
+	batch.fWidth = xMax - xMin + 1;
+	batch.fHeight = yMax - yMin + 1;
+	batch.fFrame = fFrame;
+
+	if ( xMax < xMin || yMax < yMin )
+	{
+		// Nothing on screen to read
+		batch.fRequests.swap( fPending );
+		Resolve( batch, NULL, isFlipped );
+		return;
+	}
+
+	batch.fSlot = fReadback->Read( batch.fX, batch.fY, batch.fWidth, batch.fHeight );
+	if ( batch.fSlot < 0 )
+	{
+		// All slots in use; try again next frame
+		return;
+	}
+
+	batch.fRequests.swap( fPending );
+	fInFlight.push_back( batch );
+}
+
+void
+FrameReadback::Resolve( const Batch& batch, const U8 *pixels, bool isFlipped )
+{
+	const S32 stride = batch.fWidth * 4;
+
+	for ( size_t i = 0; i < batch.fRequests.size(); i++ )
+	{
+		Request request = batch.fRequests[i];
+
+		// Off screen, or the readback could not be mapped: the listener is
+		// told it failed rather than handed made-up pixels
+		if ( ! pixels )
+		{
+			request.fIsValid = false;
+		}
+
+		if ( request.fIsValid )
+		{
+			if ( request.fIsCapture )
+			{
+				const U8 *origin = pixels + ( -batch.fY * stride ) + ( -batch.fX * 4 );
+				request.fPaint = NewCapture( origin, stride, batch.fWidth, batch.fHeight, isFlipped );
+			}
+			else
+			{
+				const U8 *p = pixels + ( request.fPixelY - batch.fY ) * stride + ( request.fPixelX - batch.fX ) * 4;
+
+				// Match Display::ColorSample(), which undoes premultiplied alpha
+				RGBA& color = request.fColor;
+				color.r = p[0];
+				color.g = p[1];
+				color.b = p[2];
+				color.a = p[3];
+				if ( color.a > 0 && color.a < 255 )
+				{
+					color.r = (U8)Min( 255, color.r * 255 / color.a );
+					color.g = (U8)Min( 255, color.g * 255 / color.a );
+					color.b = (U8)Min( 255, color.b * 255 / color.a );
+				}
+			}
+		}
+
+		fResolved.push_back( request );
+	}
+}
+
+BitmapPaint *
+FrameReadback::NewCapture( const U8 *pixels, S32 stride, S32 w, S32 h, bool isFlipped ) const
+{
+	BufferBitmap *bitmap = Rtt_NEW( fAllocator, BufferBitmap( fAllocator, w, h, PlatformBitmap::kRGBA ) );
+
+	// Bitmaps are stored top row first
+	U8 *dst = static_cast< U8 * >( bitmap->WriteAccess() );
+	for ( S32 row = 0; row < h; row++ )
+	{
+		S32 srcRow = ( isFlipped ? h - 1 - row : row );
+		memcpy( dst + row * w * 4, pixels + srcRow * stride, w * 4 );
+	}
+
+	// Framebuffer contents are already premultiplied
+	bitmap->SetProperty( PlatformBitmap::kIsPremultiplied, true );
+
+	SharedPtr< TextureResource > tex = fDisplay.GetTextureFactory().FindOrCreate( bitmap, false );
+
+	return Rtt_NEW( fAllocator, BitmapPaint( tex ) );
+}
+
+void
+FrameReadback::DispatchEvents( lua_State *L )
+{
+	if ( fResolved.empty() )
+	{
+		return;
+	}
+
+	// Listeners may queue further requests, so work off a copy
+	std::vector< Request > resolved;
+	resolved.swap( fResolved );
+
+	for ( size_t i = 0; i < resolved.size(); i++ )
+	{
+		const Request& request = resolved[i];
+
+		if ( request.fIsCapture )
+		{
+			ShapeObject *image = NULL;
+			if ( request.fPaint )
+			{
+				// Same placement and scale as display.captureScreen()
+				Vertex2 topLeft = { Rtt_REAL_0, Rtt_REAL_0 };
+				image = LuaLibDisplay::PushImage( L, & topLeft, request.fPaint, fDisplay, NULL );
+				if ( image )
+				{
+					lua_pop( L, 1 );
+
+					Real scale = fDisplay.GetScreenToContentScale();
+					image->Scale( scale, scale, true );
+				}
+			}
+
+			ScreenCaptureEvent e( image );
+			request.fListener->DispatchEvent( e );
+		}
+		else if ( request.fIsValid )
+		{
+			RGBA color = request.fColor;
+			ColorSampleEvent e( request.fX, request.fY, color );
+			request.fListener->DispatchEvent( e );
+		}
+		else
+		{
+			ColorSampleEvent e( request.fX, request.fY );
+			request.fListener->DispatchEvent( e );
+		}
+
+		Rtt_DELETE( request.fListener );
+	}
+}
+
+void
+FrameReadback::ReleaseGPUResources()
+{
+	// Requests whose readback is lost are read again from the next frame
+	for ( size_t i = 0; i < fInFlight.size(); i++ )
+	{
+		fPending.insert( fPending.end(), fInFlight[i].fRequests.begin(), fInFlight[i].fRequests.end() );
+	}
+	fInFlight.clear();
+
+	fReadback->ReleaseGPUResources();
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_FrameReadback_H__
+#define _Rtt_FrameReadback_H__
+
+#include "Core/Rtt_Types.h"
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Real.h"
+#include "Renderer/Rtt_RenderTypes.h"
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+struct lua_State;
+
+namespace Rtt
+{
+
+class BitmapPaint;
+class Display;
+class GLReadback;
+class LuaResource;
+class RenderingStream;
+
+// ----------------------------------------------------------------------------
+
+// Non-blocking alternative to Display::ColorSample() and Display::Capture().
+//
+// Instead of re-rendering the stage into an FBO and stalling on glReadPixels
+// per request, requests are queued and resolved against the next frame that is
+// rendered to the screen: all requests of a frame share a single readback of
+// their bounding rect, which (where supported) completes on the GPU and is only
+// mapped a frame later. Listeners are called at the start of the following
+// frame, before "enterFrame".
+class FrameReadback
+{
+	Rtt_CLASS_NO_COPIES( FrameReadback )
+
+	public:
+		FrameReadback( Rtt_Allocator *allocator, Display& display );
+		~FrameReadback();
+
+	public:
+		// Both take ownership of 'listener'
+		void RequestColorSample( Real x, Real y, LuaResource *listener );
+		void RequestCapture( LuaResource *listener );
+
+		// Called once the frame has been rendered but not yet presented:
+		// collects finished readbacks and issues one for pending requests
+		void Process( RenderingStream& stream );
+
+		// Calls the listeners of resolved requests
+		void DispatchEvents( lua_State *L );
+
+		// Drops in-flight readbacks, e.g. when the GL context goes away.
+		// Their requests are re-queued.
+		void ReleaseGPUResources();
+
+	private:
+		struct Request
+		{
+			Real fX;
+			Real fY;
+			S32 fPixelX;
+			S32 fPixelY;
+			LuaResource *fListener;
+			BitmapPaint *fPaint;
+			RGBA fColor;
+			bool fIsCapture;
+			bool fIsValid;
+		};
+
+		struct Batch
+		{
+			std::vector< Request > fRequests;
+			S32 fSlot;
+			S32 fX;
+			S32 fY;
+			S32 fWidth;
+			S32 fHeight;
+			U32 fFrame;
+		};
+
+	private:
+		void Issue( RenderingStream& stream );
+		void Resolve( const Batch& batch, const U8 *pixels, bool isFlipped );
+		BitmapPaint *NewCapture( const U8 *pixels, S32 stride, S32 w, S32 h, bool isFlipped ) const;
+
+	private:
+		Rtt_Allocator *fAllocator;
+		Display& fDisplay;
+		GLReadback *fReadback;
+		std::vector< Request > fPending;
+		std::vector< Batch > fInFlight;
+		std::vector< Request > fResolved;
+		U32 fFrame;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_FrameReadback_H__
@@ -83,11 +83,24 @@ GroupObject::ReleaseChildrenLuaReferences( lua_State *L )
 GroupObject::GroupObject( Rtt_Allocator* pAllocator, StageObject* canvas )
 :	Super(),
 	fStage( canvas ),
+	fCullBounds(),
+	fHasDirtyDescendants( false ),
 	fChildren( pAllocator )
 {
     SetObjectDesc("GroupObject"); // for introspection
 }
 
+static bool
+IsSameCullBounds( const Rect& a, const Rect& b )
+{
+	if ( a.IsEmpty() || b.IsEmpty() )
+	{
+		return a.IsEmpty() == b.IsEmpty();
+	}
+
+	return a.xMin == b.xMin && a.yMin == b.yMin && a.xMax == b.xMax && a.yMax == b.yMax;
+}
+
 GroupObject*
 GroupObject::AsGroupObject()
 {
@@ -117,6 +130,18 @@ GroupObject::UpdateTransform( const Matrix& parentToDstSpace )
 				: stage->GetDisplay().GetScreenContentBounds() );
 		}
 
+		// Nothing below the receiver has changed, and children were already
+		// culled against the same bounds, so the subtree is up to date
+		if ( ! shouldUpdate
+			 && ! IsDirty()
+			 && ! fHasDirtyDescendants
+			 && IsSameCullBounds( screenBounds, fCullBounds ) )
+		{
+			return shouldUpdate;
+		}
+
+		fCullBounds = screenBounds;
+
 		const Matrix& xform = GetSrcToDstMatrix();
 
 		U8 alphaCumulativeFromAncestors = AlphaCumulative();
@@ -143,6 +168,11 @@ GroupObject::UpdateTransform( const Matrix& parentToDstSpace )
 // TODO: BuildStageBounds is expensive --- accumulate iteratively if numChildren is large
 				child->BuildStageBounds();
 				child->CullOffscreen( screenBounds );
+
+				if ( stage )
+				{
+					stage->UpdateHitTestIndex( * child );
+				}
 			}
 		}
 	}
@@ -158,7 +188,12 @@ GroupObject::Prepare( const Display& display )
 	// Only build if is visible in the hittest sense
 	if ( ShouldHitTest() )
 	{
-		// A child's build can be invalidated, so always traverse children
+		// A child's build can be invalidated, but that marks the receiver
+		// via InvalidateAncestors(), so only clean subtrees are skipped
+		if ( ! IsDirty() && ! fHasDirtyDescendants )
+		{
+			return;
+		}
 
 		// Propagate certain flags to children
 		DirtyFlags flags = kGroupPropagationMask & GetDirtyFlags();
@@ -186,6 +221,7 @@ GroupObject::Prepare( const Display& display )
 		}
 
 		SetValid();
+		fHasDirtyDescendants = false;
 	}
 }
 
@@ -272,9 +308,27 @@ GroupObject::ShouldOffsetWithAnchor() const
 	return IsProperty( kIsAnchorChildren );
 }
 
+void
+GroupObject::InvalidateRenderList()
+{
+	GroupObject *root = this;
+	for ( GroupObject *parent = GetParent(); parent; parent = parent->GetParent() )
+	{
+		root = parent;
+	}
+
+	// Only groups attached to a stage are part of its render list
+	if ( root->IsStage() )
+	{
+		static_cast< StageObject * >( root )->InvalidateRenderList();
+	}
+}
+
 void
 GroupObject::DidInsert( bool childParentChanged )
 {
+	InvalidateRenderList();
+
 	if ( childParentChanged )
 	{
 		Invalidate( kStageBoundsFlag );
@@ -288,6 +342,8 @@ GroupObject::DidInsert( bool childParentChanged )
 void
 GroupObject::DidRemove()
 {
+	InvalidateRenderList();
+
 	Invalidate( kStageBoundsFlag );
 }
 
@@ -66,10 +66,19 @@ class GroupObject : public DisplayObject
 		const DisplayObject& ChildAt( S32 index ) const { return * fChildren[index]; }
 		DisplayObject& ChildAt( S32 index ) { return * fChildren[index]; }
 
+	public:
+		// True when a descendant was invalidated since the receiver was last
+		// prepared. Clean subtrees are skipped by UpdateTransform()/Prepare().
+		bool HasDirtyDescendants() const { return fHasDirtyDescendants; }
+		void SetDirtyDescendants() { fHasDirtyDescendants = true; }
+
 	protected:
 		bool IsStage() const { return this == (GroupObject*)fStage; }
 
 	protected:
+		// Adding, removing or reordering children changes the stage's render list
+		void InvalidateRenderList();
+
 		virtual void DidInsert( bool childParentChanged );
 		virtual void DidRemove();
 
@@ -84,6 +93,8 @@ class GroupObject : public DisplayObject
 
 	private:
 		StageObject* fStage;
+		Rect fCullBounds;
+		bool fHasDirtyDescendants;
 
 	protected:
 		// Children are drawn in order, i.e. first child is drawn below the second
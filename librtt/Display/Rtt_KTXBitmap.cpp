@@ -0,0 +1,776 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_KTXBitmap.h"
+
+#include "Core/Rtt_Allocator.h"
+#include "Core/Rtt_FileSystem.h"
+#include "Renderer/Rtt_CommandBuffer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+	using namespace Rtt;
+
+	// ------------------------------------------------------------------------
+	// Containers
+	// ------------------------------------------------------------------------
+
+	const U8 kKTX1Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+	const U8 kKTX2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+	const size_t kKTX1HeaderSize = 64;
+	const size_t kKTX2HeaderSize = 80; // Including the index, up to the level index
+	const U32 kKTX1Endianness = 0x04030201;
+	const U32 kKTX1EndiannessSwapped = 0x01020304;
+
+	// KHR_DF_FLAG_ALPHA_PREMULTIPLIED, in the flags byte of the basic block of
+	// a KTX2 data format descriptor. The block follows the descriptor's total
+	// size, and its flags follow the block's 8 byte header and 3 other fields.
+	const size_t kDFDFlagsOffset = 4 + 8 + 3;
+	const U8 kDFDFlagAlphaPremultiplied = 1;
+
+	U32 readU32( const U8 *p, bool isSwapped )
+	{
+		return isSwapped
+			? ( (U32)p[3] | ( (U32)p[2] << 8 ) | ( (U32)p[1] << 16 ) | ( (U32)p[0] << 24 ) )
+			: ( (U32)p[0] | ( (U32)p[1] << 8 ) | ( (U32)p[2] << 16 ) | ( (U32)p[3] << 24 ) );
+	}
+
+	U64 readU64( const U8 *p )
+	{
+		return (U64)readU32( p, false ) | ( (U64)readU32( p + 4, false ) << 32 );
+	}
+
+	Texture::Format formatForGLInternalFormat( U32 internalFormat )
+	{
+		switch ( internalFormat )
+		{
+			case 0x8D64: return Texture::kETC1;			// GL_ETC1_RGB8_OES
+			case 0x9274:								// GL_COMPRESSED_RGB8_ETC2
+			case 0x9275: return Texture::kETC2_RGB;		// GL_COMPRESSED_SRGB8_ETC2
+			case 0x9278:								// GL_COMPRESSED_RGBA8_ETC2_EAC
+			case 0x9279: return Texture::kETC2_RGBA;	// GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+			case 0x93B0:								// GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+			case 0x93D0: return Texture::kASTC_4x4;		// GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
+			case 0x83F0:								// GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+			case 0x8C4C: return Texture::kBC1;			// GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+			case 0x83F3:								// GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+			case 0x8C4F: return Texture::kBC3;			// GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+			default: return Texture::kNumFormats;
+		}
+	}
+
+	Texture::Format formatForVkFormat( U32 vkFormat )
+	{
+		switch ( vkFormat )
+		{
+			case 147:									// VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+			case 148: return Texture::kETC2_RGB;		// VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+			case 151:									// VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+			case 152: return Texture::kETC2_RGBA;		// VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+			case 157:									// VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+			case 158: return Texture::kASTC_4x4;		// VK_FORMAT_ASTC_4x4_SRGB_BLOCK
+			case 131:									// VK_FORMAT_BC1_RGB_UNORM_BLOCK
+			case 132: return Texture::kBC1;				// VK_FORMAT_BC1_RGB_SRGB_BLOCK
+			case 137:									// VK_FORMAT_BC3_UNORM_BLOCK
+			case 138: return Texture::kBC3;				// VK_FORMAT_BC3_SRGB_BLOCK
+			default: return Texture::kNumFormats;
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	// Software decoders. Each decodes a 4x4 block to 16 RGBA pixels, row by row.
+	// ------------------------------------------------------------------------
+
+	U8 clampToByte( int value )
+	{
+		return (U8)( value < 0 ? 0 : ( value > 255 ? 255 : value ) );
+	}
+
+	int extend4( int v ) { return ( v << 4 ) | v; }
+	int extend5( int v ) { return ( v << 3 ) | ( v >> 2 ); }
+	int extend6( int v ) { return ( v << 2 ) | ( v >> 4 ); }
+	int extend7( int v ) { return ( v << 1 ) | ( v >> 6 ); }
+
+	int signExtend3( int v ) { return ( v >= 4 ? v - 8 : v ); }
+
+	const int kETCModifiers[8][4] =
+	{
+		{ 2, 8, -2, -8 },
+		{ 5, 17, -5, -17 },
+		{ 9, 29, -9, -29 },
+		{ 13, 42, -13, -42 },
+		{ 18, 60, -18, -60 },
+		{ 24, 80, -24, -80 },
+		{ 33, 106, -33, -106 },
+		{ 47, 183, -47, -183 },
+	};
+
+	const int kETCDistances[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+	const int kEACModifiers[16][8] =
+	{
+		{ -3, -6, -9, -15, 2, 5, 8, 14 },
+		{ -3, -7, -10, -13, 2, 6, 9, 12 },
+		{ -2, -5, -8, -13, 1, 4, 7, 12 },
+		{ -2, -4, -6, -13, 1, 3, 5, 12 },
+		{ -3, -6, -8, -12, 2, 5, 7, 11 },
+		{ -3, -7, -9, -11, 2, 6, 8, 10 },
+		{ -4, -7, -8, -11, 3, 6, 7, 10 },
+		{ -3, -5, -8, -11, 2, 4, 7, 10 },
+		{ -2, -6, -8, -10, 1, 5, 7, 9 },
+		{ -2, -5, -8, -10, 1, 4, 7, 9 },
+		{ -2, -4, -8, -10, 1, 3, 7, 9 },
+		{ -2, -5, -7, -10, 1, 4, 6, 9 },
+		{ -3, -4, -7, -10, 2, 3, 6, 9 },
+		{ -1, -2, -3, -10, 0, 1, 2, 9 },
+		{ -4, -6, -8, -9, 3, 5, 7, 8 },
+		{ -3, -5, -7, -9, 2, 4, 6, 8 },
+	};
+
+	void setRGB( U8 *pixel, int r, int g, int b )
+	{
+		pixel[0] = clampToByte( r );
+		pixel[1] = clampToByte( g );
+		pixel[2] = clampToByte( b );
+		pixel[3] = 255;
+	}
+
+	// ETC1 blocks are ETC2 blocks that never use the T, H or planar modes
+	void decodeETC2Color( const U8 *src, U8 *dst )
+	{
+		// Pixel (x,y) is selected by bit x*4+y of each half
+		const U32 indices = ( (U32)src[4] << 24 ) | ( (U32)src[5] << 16 ) | ( (U32)src[6] << 8 ) | src[7];
+
+		int r = src[0] >> 3, dr = signExtend3( src[0] & 7 );
+		int g = src[1] >> 3, dg = signExtend3( src[1] & 7 );
+		int b = src[2] >> 3, db = signExtend3( src[2] & 7 );
+
+		const bool isDifferential = ( 0 != ( src[3] & 2 ) );
+
+		if ( isDifferential && ( r + dr < 0 || r + dr > 31 ) )
+		{
+			// T mode
+			int paint[4][3];
+			int r1 = extend4( ( ( src[0] >> 1 ) & 0xC ) | ( src[0] & 3 ) );
+			int g1 = extend4( src[1] >> 4 ), b1 = extend4( src[1] & 0xF );
+			int r2 = extend4( src[2] >> 4 ), g2 = extend4( src[2] & 0xF ), b2 = extend4( src[3] >> 4 );
+			int d = kETCDistances[ ( ( src[3] >> 1 ) & 6 ) | ( src[3] & 1 ) ];
+
+			paint[0][0] = r1; paint[0][1] = g1; paint[0][2] = b1;
+			paint[1][0] = r2 + d; paint[1][1] = g2 + d; paint[1][2] = b2 + d;
+			paint[2][0] = r2; paint[2][1] = g2; paint[2][2] = b2;
+			paint[3][0] = r2 - d; paint[3][1] = g2 - d; paint[3][2] = b2 - d;
+
+			for ( int i = 0; i < 16; i++ )
+			{
+				int x = i & 3, y = i >> 2, bit = x * 4 + y;
+				const int *p = paint[ ( ( ( indices >> ( bit + 16 ) ) & 1 ) << 1 ) | ( ( indices >> bit ) & 1 ) ];
+				setRGB( dst + i * 4, p[0], p[1], p[2] );
+			}
+		}
+		else if ( isDifferential && ( g + dg < 0 || g + dg > 31 ) )
+		{
+			// H mode
+			int paint[4][3];
+			int r1 = ( src[0] >> 3 ) & 0xF;
+			int g1 = ( ( src[0] << 1 ) & 0xE ) | ( ( src[1] >> 4 ) & 1 );
+			int b1 = ( src[1] & 8 ) | ( ( src[1] << 1 ) & 6 ) | ( src[2] >> 7 );
+			int r2 = ( src[2] >> 3 ) & 0xF;
+			int g2 = ( ( src[2] << 1 ) & 0xE ) | ( src[3] >> 7 );
+			int b2 = ( src[3] >> 3 ) & 0xF;
+			int distance = ( src[3] & 4 ) | ( ( src[3] << 1 ) & 2 );
+			if ( ( ( r1 << 8 ) | ( g1 << 4 ) | b1 ) >= ( ( r2 << 8 ) | ( g2 << 4 ) | b2 ) )
+			{
+				distance |= 1;
+			}
+			int d = kETCDistances[distance];
+
+			r1 = extend4( r1 ); g1 = extend4( g1 ); b1 = extend4( b1 );
+			r2 = extend4( r2 ); g2 = extend4( g2 ); b2 = extend4( b2 );
+
+			paint[0][0] = r1 + d; paint[0][1] = g1 + d; paint[0][2] = b1 + d;
+			paint[1][0] = r1 - d; paint[1][1] = g1 - d; paint[1][2] = b1 - d;
+			paint[2][0] = r2 + d; paint[2][1] = g2 + d; paint[2][2] = b2 + d;
+			paint[3][0] = r2 - d; paint[3][1] = g2 - d; paint[3][2] = b2 - d;
+
+			for ( int i = 0; i < 16; i++ )
+			{
+				int x = i & 3, y = i >> 2, bit = x * 4 + y;
+				const int *p = paint[ ( ( ( indices >> ( bit + 16 ) ) & 1 ) << 1 ) | ( ( indices >> bit ) & 1 ) ];
+				setRGB( dst + i * 4, p[0], p[1], p[2] );
+			}
+		}
+		else if ( isDifferential && ( b + db < 0 || b + db > 31 ) )
+		{
+			// Planar mode
+			int ro = extend6( ( src[0] >> 1 ) & 0x3F );
+			int go = extend7( ( ( src[0] & 1 ) << 6 ) | ( ( src[1] >> 1 ) & 0x3F ) );
+			int bo = extend6( ( ( src[1] & 1 ) << 5 ) | ( src[2] & 0x18 ) | ( ( src[2] << 1 ) & 6 ) | ( src[3] >> 7 ) );
+			int rh = extend6( ( ( src[3] >> 1 ) & 0x3E ) | ( src[3] & 1 ) );
+			int gh = extend7( src[4] >> 1 );
+			int bh = extend6( ( ( src[4] & 1 ) << 5 ) | ( src[5] >> 3 ) );
+			int rv = extend6( ( ( src[5] & 7 ) << 3 ) | ( src[6] >> 5 ) );
+			int gv = extend7( ( ( src[6] & 0x1F ) << 2 ) | ( src[7] >> 6 ) );
+			int bv = extend6( src[7] & 0x3F );
+
+			for ( int i = 0; i < 16; i++ )
+			{
+				int x = i & 3, y = i >> 2;
+				setRGB( dst + i * 4,
+					( x * ( rh - ro ) + y * ( rv - ro ) + 4 * ro + 2 ) >> 2,
+					( x * ( gh - go ) + y * ( gv - go ) + 4 * go + 2 ) >> 2,
+					( x * ( bh - bo ) + y * ( bv - bo ) + 4 * bo + 2 ) >> 2 );
+			}
+		}
+		else
+		{
+			// Individual or differential mode: two sub-blocks with a base
+			// color and modifier table each
+			int base[2][3];
+			if ( isDifferential )
+			{
+				base[0][0] = extend5( r ); base[0][1] = extend5( g ); base[0][2] = extend5( b );
+				base[1][0] = extend5( r + dr ); base[1][1] = extend5( g + dg ); base[1][2] = extend5( b + db );
+			}
+			else
+			{
+				base[0][0] = extend4( src[0] >> 4 ); base[0][1] = extend4( src[1] >> 4 ); base[0][2] = extend4( src[2] >> 4 );
+				base[1][0] = extend4( src[0] & 0xF ); base[1][1] = extend4( src[1] & 0xF ); base[1][2] = extend4( src[2] & 0xF );
+			}
+
+			const int *tables[2] = { kETCModifiers[ src[3] >> 5 ], kETCModifiers[ ( src[3] >> 2 ) & 7 ] };
+			const bool isFlipped = ( 0 != ( src[3] & 1 ) );
+
+			for ( int i = 0; i < 16; i++ )
+			{
+				int x = i & 3, y = i >> 2, bit = x * 4 + y;
+				int sub = ( isFlipped ? y >> 1 : x >> 1 );
+				int m = tables[sub][ ( ( ( indices >> ( bit + 16 ) ) & 1 ) << 1 ) | ( ( indices >> bit ) & 1 ) ];
+				setRGB( dst + i * 4, base[sub][0] + m, base[sub][1] + m, base[sub][2] + m );
+			}
+		}
+	}
+
+	void decodeEACAlpha( const U8 *src, U8 *dst )
+	{
+		const int base = src[0];
+		const int multiplier = src[1] >> 4;
+		const int *modifiers = kEACModifiers[ src[1] & 0xF ];
+
+		U64 indices = 0;
+		for ( int i = 2; i < 8; i++ )
+		{
+			indices = ( indices << 8 ) | src[i];
+		}
+
+		// Pixel (x,y) is selected by the 3 bits at x*4+y, from the top
+		for ( int i = 0; i < 16; i++ )
+		{
+			int x = i & 3, y = i >> 2, n = x * 4 + y;
+			int index = (int)( ( indices >> ( 45 - 3 * n ) ) & 7 );
+			dst[i * 4 + 3] = clampToByte( base + modifiers[index] * multiplier );
+		}
+	}
+
+	void decodeBC1Color( const U8 *src, U8 *dst, bool isOpaqueOnly )
+	{
+		const int c0 = src[0] | ( src[1] << 8 );
+		const int c1 = src[2] | ( src[3] << 8 );
+		const U32 indices = readU32( src + 4, false );
+
+		int colors[4][3];
+		colors[0][0] = extend5( c0 >> 11 ); colors[0][1] = extend6( ( c0 >> 5 ) & 0x3F ); colors[0][2] = extend5( c0 & 0x1F );
+		colors[1][0] = extend5( c1 >> 11 ); colors[1][1] = extend6( ( c1 >> 5 ) & 0x3F ); colors[1][2] = extend5( c1 & 0x1F );
+
+		for ( int k = 0; k < 3; k++ )
+		{
+			if ( c0 > c1 || isOpaqueOnly )
+			{
+				colors[2][k] = ( 2 * colors[0][k] + colors[1][k] ) / 3;
+				colors[3][k] = ( colors[0][k] + 2 * colors[1][k] ) / 3;
+			}
+			else
+			{
+				// The 4th color would be transparent, which the RGB format
+				// (and so our upload token) treats as black
+				colors[2][k] = ( colors[0][k] + colors[1][k] ) / 2;
+				colors[3][k] = 0;
+			}
+		}
+
+		for ( int i = 0; i < 16; i++ )
+		{
+			const int *c = colors[ ( indices >> ( 2 * i ) ) & 3 ];
+			setRGB( dst + i * 4, c[0], c[1], c[2] );
+		}
+	}
+
+	void decodeBC3Alpha( const U8 *src, U8 *dst )
+	{
+		const int a0 = src[0];
+		const int a1 = src[1];
+
+		int alphas[8];
+		alphas[0] = a0;
+		alphas[1] = a1;
+		if ( a0 > a1 )
+		{
+			for ( int i = 1; i < 7; i++ )
+			{
+				alphas[i + 1] = ( ( 7 - i ) * a0 + i * a1 ) / 7;
+			}
+		}
+		else
+		{
+			for ( int i = 1; i < 5; i++ )
+			{
+				alphas[i + 1] = ( ( 5 - i ) * a0 + i * a1 ) / 5;
+			}
+			alphas[6] = 0;
+			alphas[7] = 255;
+		}
+
+		U64 indices = 0;
+		for ( int i = 7; i >= 2; i-- )
+		{
+			indices = ( indices << 8 ) | src[i];
+		}
+
+		for ( int i = 0; i < 16; i++ )
+		{
+			dst[i * 4 + 3] = (U8)alphas[ ( indices >> ( 3 * i ) ) & 7 ];
+		}
+	}
+
+	bool canDecode( Texture::Format format )
+	{
+		return Texture::kASTC_4x4 != format;
+	}
+
+	// BC1 is decoded and uploaded as RGB, see decodeBC1Color()
+	bool hasAlpha( Texture::Format format )
+	{
+		return Texture::kETC2_RGBA == format
+			|| Texture::kASTC_4x4 == format
+			|| Texture::kBC3 == format;
+	}
+
+	void decode( Texture::Format format, const U8 *src, U32 w, U32 h, U8 *dst )
+	{
+		const size_t kBlockSize = Texture::GetImageSizeInBytes( format, 4, 4 );
+
+		U8 block[16 * 4];
+		for ( U32 by = 0; by < h; by += 4 )
+		{
+			for ( U32 bx = 0; bx < w; bx += 4, src += kBlockSize )
+			{
+				switch ( format )
+				{
+					case Texture::kETC1:
+					case Texture::kETC2_RGB:
+						decodeETC2Color( src, block );
+						break;
+					case Texture::kETC2_RGBA:
+						decodeETC2Color( src + 8, block );
+						decodeEACAlpha( src, block );
+						break;
+					case Texture::kBC1:
+						decodeBC1Color( src, block, false );
+						break;
+					case Texture::kBC3:
+						decodeBC1Color( src + 8, block, true );
+						decodeBC3Alpha( src, block );
+						break;
+					default:
+						Rtt_ASSERT_NOT_REACHED();
+						return;
+				}
+
+				// Blocks on the right and bottom edges may be partially used
+				for ( U32 y = 0; y < 4 && by + y < h; y++ )
+				{
+					U32 numPixels = ( w - bx < 4 ? w - bx : 4 );
+					memcpy( dst + ( ( by + y ) * w + bx ) * 4, block + y * 16, numPixels * 4 );
+				}
+			}
+		}
+	}
+
+	// ------------------------------------------------------------------------
+
+	U8 *readFile( Rtt_Allocator *allocator, const char *path, long byteOffset, long byteCount, size_t& outLength )
+	{
+		U8 *result = NULL;
+		outLength = 0;
+
+		FILE *file = Rtt_FileOpen( path, "rb" );
+		if ( ! file )
+		{
+			return result;
+		}
+
+		if ( byteCount <= 0 && 0 == Rtt_FileSeek( file, 0, SEEK_END ) )
+		{
+			byteCount = Rtt_FileTell( file ) - byteOffset;
+		}
+
+		if ( byteCount > 0 && 0 == Rtt_FileSeek( file, byteOffset, SEEK_SET ) )
+		{
+			result = (U8 *)Rtt_MALLOC( allocator, byteCount );
+			if ( result && 1 == Rtt_FileRead( result, byteCount, 1, file ) )
+			{
+				outLength = byteCount;
+			}
+			else
+			{
+				Rtt_FREE( result );
+				result = NULL;
+			}
+		}
+		Rtt_FileClose( file );
+
+		return result;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+bool
+KTXBitmap::IsKTXFile( const char *filePath )
+{
+	const char *extension = filePath ? strrchr( filePath, '.' ) : NULL;
+
+	return extension
+		&& ( 0 == Rtt_StringCompareNoCase( extension, ".ktx" )
+			|| 0 == Rtt_StringCompareNoCase( extension, ".ktx2" ) );
+}
+
+KTXBitmap *
+KTXBitmap::Create( Rtt_Allocator *allocator, const char *filePath, long byteOffset, long byteCount )
+{
+	KTXBitmap *result = Rtt_NEW( allocator, KTXBitmap( allocator, filePath, byteOffset, byteCount ) );
+
+	if ( ! result->Parse() )
+	{
+		Rtt_DELETE( result );
+		result = NULL;
+	}
+
+	return result;
+}
+
+KTXBitmap::KTXBitmap( Rtt_Allocator *allocator, const char *filePath, long byteOffset, long byteCount )
+:	Super(),
+	fAllocator( allocator ),
+	fPath( allocator ),
+	fByteOffset( byteOffset ),
+	fByteCount( byteCount ),
+	fData( NULL ),
+	fDataLength( 0 ),
+	fBits( NULL ),
+	fFormat( Texture::kNumFormats ),
+	fWidth( 0 ),
+	fHeight( 0 ),
+	fNumLevels( 0 ),
+	fProperties( 0 ),
+	fIsPremultiplied( false )
+{
+	fPath.Set( filePath );
+}
+
+KTXBitmap::~KTXBitmap()
+{
+	FreeBits();
+}
+
+bool
+KTXBitmap::Parse()
+{
+	const U8 *data = GetData();
+	if ( ! data )
+	{
+		return false;
+	}
+
+	// Offsets of the levels, before validating them below
+	U64 offsets[kMaxLevels];
+	U64 lengths[kMaxLevels];
+	U32 numLevels = 0;
+	bool isPremultiplied = false;
+
+	if ( fDataLength >= kKTX1HeaderSize && 0 == memcmp( data, kKTX1Identifier, sizeof( kKTX1Identifier ) ) )
+	{
+		U32 endianness = readU32( data + 12, false );
+		if ( kKTX1Endianness != endianness && kKTX1EndiannessSwapped != endianness )
+		{
+			return false;
+		}
+
+		bool isSwapped = ( kKTX1EndiannessSwapped == endianness );
+		U32 glType = readU32( data + 16, isSwapped );
+		U32 glInternalFormat = readU32( data + 28, isSwapped );
+		U32 depth = readU32( data + 44, isSwapped );
+		U32 numArrayElements = readU32( data + 48, isSwapped );
+		U32 numFaces = readU32( data + 52, isSwapped );
+
+		// Only plain, compressed 2D images
+		if ( 0 != glType || 0 != depth || 0 != numArrayElements || 1 != numFaces )
+		{
+			return false;
+		}
+
+		fFormat = formatForGLInternalFormat( glInternalFormat );
+		fWidth = readU32( data + 36, isSwapped );
+		fHeight = readU32( data + 40, isSwapped );
+		numLevels = readU32( data + 56, isSwapped );
+		numLevels = ( 0 == numLevels ? 1 : ( numLevels > kMaxLevels ? kMaxLevels : numLevels ) );
+
+		// Each level is prefixed by its size, and padded to 4 bytes
+		U64 offset = (U64)kKTX1HeaderSize + readU32( data + 60, isSwapped );
+		for ( U32 i = 0; i < numLevels; i++ )
+		{
+			if ( offset + 4 > fDataLength )
+			{
+				return false;
+			}
+
+			lengths[i] = readU32( data + offset, isSwapped );
+			offsets[i] = offset + 4;
+			offset = offsets[i] + ( ( lengths[i] + 3 ) & ~(U64)3 );
+		}
+	}
+	else if ( fDataLength >= kKTX2HeaderSize && 0 == memcmp( data, kKTX2Identifier, sizeof( kKTX2Identifier ) ) )
+	{
+		U32 vkFormat = readU32( data + 12, false );
+		U32 depth = readU32( data + 28, false );
+		U32 numLayers = readU32( data + 32, false );
+		U32 numFaces = readU32( data + 36, false );
+		U32 supercompressionScheme = readU32( data + 44, false );
+
+		// Only plain 2D images, without supercompression (e.g. Basis or zstd)
+		if ( 0 != depth || numLayers > 1 || 1 != numFaces || 0 != supercompressionScheme )
+		{
+			return false;
+		}
+
+		fFormat = formatForVkFormat( vkFormat );
+		fWidth = readU32( data + 20, false );
+		fHeight = readU32( data + 24, false );
+		U32 numFileLevels = readU32( data + 40, false );
+		numFileLevels = ( 0 == numFileLevels ? 1 : numFileLevels );
+		numLevels = ( numFileLevels > kMaxLevels ? kMaxLevels : numFileLevels );
+
+		if ( kKTX2HeaderSize + 24 * (U64)numFileLevels > fDataLength )
+		{
+			return false;
+		}
+
+		U32 dfdOffset = readU32( data + 48, false );
+		U32 dfdLength = readU32( data + 52, false );
+		if ( dfdLength > kDFDFlagsOffset && (U64)dfdOffset + dfdLength <= fDataLength )
+		{
+			isPremultiplied = ( 0 != ( data[dfdOffset + kDFDFlagsOffset] & kDFDFlagAlphaPremultiplied ) );
+		}
+
+		for ( U32 i = 0; i < numLevels; i++ )
+		{
+			const U8 *entry = data + kKTX2HeaderSize + 24 * i;
+			offsets[i] = readU64( entry );
+			lengths[i] = readU64( entry + 8 );
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	if ( ! Texture::IsCompressed( fFormat ) || 0 == fWidth || 0 == fHeight )
+	{
+		return false;
+	}
+
+	// Also keeps the byte counts below, and of the decoded image, in range
+	const U32 maxSize = (U32)CommandBuffer::GetMaxTextureSize();
+	if ( fWidth > maxSize || fHeight > maxSize
+		|| (U64)fWidth * fHeight * 4 > (U64)(size_t)-1 )
+	{
+		Rtt_TRACE( ( "WARNING: The compressed image (%s) exceeds the maximum texture size (%u)\n", fPath.GetString(), maxSize ) );
+		return false;
+	}
+
+	fIsPremultiplied = isPremultiplied || ! hasAlpha( fFormat );
+
+	// Without a decoder, the GPU must support the format
+	if ( ! canDecode( fFormat ) && ! CommandBuffer::GetGpuSupportsCompressedFormat( fFormat ) )
+	{
+		Rtt_TRACE( ( "WARNING: The GPU does not support the format of the compressed image (%s)\n", fPath.GetString() ) );
+		return false;
+	}
+
+	// Keep levels up to the first one that's truncated
+	U32 w = fWidth;
+	U32 h = fHeight;
+	fNumLevels = 0;
+	for ( U32 i = 0; i < numLevels; i++ )
+	{
+		U64 expected = Texture::GetImageSizeInBytes( fFormat, w, h );
+		if ( lengths[i] < expected || offsets[i] > fDataLength || expected > fDataLength - offsets[i] )
+		{
+			break;
+		}
+
+		fLevels[i].fOffset = (size_t)offsets[i];
+		fLevels[i].fLength = (size_t)expected;
+		++fNumLevels;
+
+		w = ( w > 1 ? w >> 1 : 1 );
+		h = ( h > 1 ? h >> 1 : 1 );
+	}
+
+	return fNumLevels > 0;
+}
+
+const U8 *
+KTXBitmap::GetData() const
+{
+	if ( ! fData )
+	{
+		size_t length = 0;
+		fData = readFile( fAllocator, fPath.GetString(), fByteOffset, fByteCount, length );
+
+		// Levels were found by Parse(), so the file must not have changed since
+		if ( fData && fDataLength > 0 && length != fDataLength )
+		{
+			Rtt_FREE( fData );
+			fData = NULL;
+		}
+		else
+		{
+			fDataLength = length;
+		}
+	}
+
+	return fData;
+}
+
+const void*
+KTXBitmap::GetBits( Rtt_Allocator* context ) const
+{
+	if ( ! fBits && canDecode( fFormat ) )
+	{
+		const U8 *level = (const U8 *)GetLevelBits( 0 );
+		if ( level )
+		{
+			fBits = (U8 *)Rtt_MALLOC( fAllocator, Texture::GetImageSizeInBytes( Texture::kRGBA, fWidth, fHeight ) );
+			if ( fBits )
+			{
+				decode( fFormat, level, fWidth, fHeight, fBits );
+			}
+		}
+	}
+
+	return fBits;
+}
+
+void
+KTXBitmap::FreeBits() const
+{
+	if ( fBits )
+	{
+		Rtt_FREE( fBits );
+		fBits = NULL;
+	}
+
+	if ( fData )
+	{
+		Rtt_FREE( fData );
+		fData = NULL;
+	}
+}
+
+U32
+KTXBitmap::Width() const
+{
+	return fWidth;
+}
+
+U32
+KTXBitmap::Height() const
+{
+	return fHeight;
+}
+
+PlatformBitmap::Format
+KTXBitmap::GetFormat() const
+{
+	// Of the bits returned by GetBits()
+	return PlatformBitmap::kRGBA;
+}
+
+bool
+KTXBitmap::IsProperty( PropertyMask mask ) const
+{
+	// See the class comment
+	if ( kIsPremultiplied == mask )
+	{
+		return fIsPremultiplied;
+	}
+
+	return ( fProperties & mask ) ? true : false;
+}
+
+void
+KTXBitmap::SetProperty( PropertyMask mask, bool newValue )
+{
+	if ( ! IsPropertyReadOnly( mask ) )
+	{
+		const U8 p = fProperties;
+		const U8 propertyMask = (U8)mask;
+		fProperties = ( newValue ? p | propertyMask : p & ~propertyMask );
+	}
+}
+
+Texture::Format
+KTXBitmap::GetCompressedFormat() const
+{
+	return fFormat;
+}
+
+U32
+KTXBitmap::GetNumLevels() const
+{
+	return fNumLevels;
+}
+
+const void*
+KTXBitmap::GetLevelBits( U32 level ) const
+{
+	const U8 *data = ( level < fNumLevels ? GetData() : NULL );
+
+	return data ? data + fLevels[level].fOffset : NULL;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
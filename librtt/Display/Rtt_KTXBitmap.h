@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_KTXBitmap_H__
+#define _Rtt_KTXBitmap_H__
+
+#include "Display/Rtt_PlatformBitmap.h"
+#include "Core/Rtt_String.h"
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Image stored in a KTX (1.1) or KTX2 container, holding ETC1/ETC2, ASTC 4x4 or
+// BC1/BC3 (S3TC) data, optionally with pre-built mip levels. The data is
+// uploaded as is if the GPU supports its format. Otherwise, GetBits() decodes
+// level 0 to RGBA (there's no decoder for ASTC, so those files are rejected).
+//
+// Compressed data can't be converted on load, so unlike other images, alpha
+// is only premultiplied if the file says so: KTX2 files through their data
+// format descriptor. KTX 1.1 can't say, so its images with alpha are taken
+// to have straight alpha. Images without alpha count as premultiplied.
+//
+// The container's contents are read again on demand after FreeBits(), so only
+// the GPU holds on to the data once the texture is uploaded.
+class KTXBitmap : public PlatformBitmap
+{
+	public:
+		typedef PlatformBitmap Super;
+		typedef KTXBitmap Self;
+
+		static const U32 kMaxLevels = 16;
+
+	public:
+		// True if 'filePath' names a .ktx or .ktx2 file
+		static bool IsKTXFile( const char *filePath );
+
+		// Reads the container found 'byteOffset' bytes into the given file,
+		// e.g. an uncompressed asset inside a package. If 'byteCount' is 0,
+		// it extends to the end of the file. Returns NULL if the file can't
+		// be read or holds data that can be neither uploaded nor decoded.
+		static KTXBitmap *Create(
+			Rtt_Allocator *allocator,
+			const char *filePath,
+			long byteOffset = 0,
+			long byteCount = 0 );
+
+	protected:
+		KTXBitmap( Rtt_Allocator *allocator, const char *filePath, long byteOffset, long byteCount );
+
+		bool Parse();
+
+	public:
+		virtual ~KTXBitmap();
+
+	public:
+		virtual const void* GetBits( Rtt_Allocator* context ) const;
+		virtual void FreeBits() const;
+		virtual U32 Width() const;
+		virtual U32 Height() const;
+		virtual Format GetFormat() const;
+		virtual bool IsProperty( PropertyMask mask ) const;
+		virtual void SetProperty( PropertyMask mask, bool newValue );
+
+		virtual Texture::Format GetCompressedFormat() const;
+		virtual U32 GetNumLevels() const;
+		virtual const void* GetLevelBits( U32 level ) const;
+
+	private:
+		const U8 *GetData() const;
+
+	private:
+		struct Level
+		{
+			size_t fOffset;
+			size_t fLength;
+		};
+
+		Rtt_Allocator *fAllocator;
+		String fPath;
+		long fByteOffset;
+		long fByteCount;
+		mutable U8 *fData; // Container contents
+		mutable size_t fDataLength;
+		mutable U8 *fBits; // Decoded level 0
+		Texture::Format fFormat;
+		U32 fWidth;
+		U32 fHeight;
+		U32 fNumLevels;
+		Level fLevels[kMaxLevels];
+		U8 fProperties;
+		bool fIsPremultiplied;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_KTXBitmap_H__
@@ -18,6 +18,8 @@
 #include "Display/Rtt_ContainerObject.h"
 #include "Display/Rtt_Display.h"
 #include "Display/Rtt_DisplayDefaults.h"
+#include "Display/Rtt_FrameProfiler.h"
+#include "Display/Rtt_FrameReadback.h"
 #include "Display/Rtt_GradientPaint.h"
 #include "Display/Rtt_GroupObject.h"
 #include "Display/Rtt_ImageSheetPaint.h"
@@ -49,6 +51,7 @@
 #include "Rtt_LuaLibNative.h"
 #include "Rtt_LuaLibSystem.h"
 #include "Rtt_LuaProxy.h"
+#include "Rtt_LuaProxyVTable.h"
 #include "Rtt_Matrix.h"
 #include "Rtt_MPlatform.h"
 #include "Rtt_Runtime.h"
@@ -134,7 +137,16 @@ class DisplayLibrary
 		static int captureScreen( lua_State *L );
         static int save( lua_State *L );
 		static int colorSample( lua_State *L );
+		static int requestColorSample( lua_State *L );
+		static int requestCaptureScreen( lua_State *L );
 		static int getSafeAreaInsets( lua_State *L );
+		static int startProfiling( lua_State *L );
+		static int stopProfiling( lua_State *L );
+		static int writeProfile( lua_State *L );
+		static int getFrameStatistics( lua_State *L );
+		static int newFloatBuffer( lua_State *L );
+		static int setProperties( lua_State *L );
+		static int getProperties( lua_State *L );
 
 	private:
 		static void GetRect( lua_State *L, Rect &bounds );
@@ -148,6 +160,76 @@ const char DisplayLibrary::kName[] = "display";
 
 // ----------------------------------------------------------------------------
 
+// Userdata holding a fixed number of floats, see display.newFloatBuffer().
+// Elements are accessed as buffer[i], starting at 1, and #buffer is their
+// number.
+static const char kFloatBufferMetatableName[] = "display.floatBuffer";
+
+// Returns NULL unless the value at 'index' is a float buffer
+static float *
+ToFloatBuffer( lua_State *L, int index, int& count )
+{
+	float *result = NULL;
+
+	void *p = lua_touserdata( L, index );
+	if ( p && lua_getmetatable( L, index ) )
+	{
+		luaL_getmetatable( L, kFloatBufferMetatableName );
+		if ( lua_rawequal( L, -1, -2 ) )
+		{
+			result = (float *)p;
+			count = (int)( lua_objlen( L, index ) / sizeof( float ) );
+		}
+		lua_pop( L, 2 );
+	}
+
+	return result;
+}
+
+static int
+floatBufferIndex( lua_State *L )
+{
+	int count = 0;
+	float *buffer = ToFloatBuffer( L, 1, count );
+	int i = (int)lua_tointeger( L, 2 );
+
+	if ( buffer && lua_isnumber( L, 2 ) && i >= 1 && i <= count )
+	{
+		lua_pushnumber( L, buffer[i - 1] );
+	}
+	else
+	{
+		lua_pushnil( L );
+	}
+
+	return 1;
+}
+
+static int
+floatBufferNewIndex( lua_State *L )
+{
+	int count = 0;
+	float *buffer = ToFloatBuffer( L, 1, count );
+	int i = (int)luaL_checkinteger( L, 2 );
+
+	luaL_argcheck( L, buffer && i >= 1 && i <= count, 2, "index out of range" );
+	buffer[i - 1] = (float)luaL_checknumber( L, 3 );
+
+	return 0;
+}
+
+static int
+floatBufferLen( lua_State *L )
+{
+	int count = 0;
+	ToFloatBuffer( L, 1, count );
+	lua_pushinteger( L, count );
+
+	return 1;
+}
+
+// ----------------------------------------------------------------------------
+
 DisplayLibrary::DisplayLibrary( Display& display )
 :	fDisplay( display )
 {
@@ -187,11 +269,31 @@ DisplayLibrary::Open( lua_State *L )
 		{ "captureScreen", captureScreen },
 		{ "save", save },
 		{ "colorSample", colorSample },
+		{ "requestColorSample", requestColorSample },
+		{ "requestCaptureScreen", requestCaptureScreen },
 		{ "getSafeAreaInsets", getSafeAreaInsets },
+		{ "startProfiling", startProfiling },
+		{ "stopProfiling", stopProfiling },
+		{ "writeProfile", writeProfile },
+		{ "getFrameStatistics", getFrameStatistics },
+		{ "newFloatBuffer", newFloatBuffer },
+		{ "setProperties", setProperties },
+		{ "getProperties", getProperties },
 
 		{ NULL, NULL }
 	};
 
+	luaL_newmetatable( L, kFloatBufferMetatableName );
+	{
+		lua_pushcfunction( L, floatBufferIndex );
+		lua_setfield( L, -2, "__index" );
+		lua_pushcfunction( L, floatBufferNewIndex );
+		lua_setfield( L, -2, "__newindex" );
+		lua_pushcfunction( L, floatBufferLen );
+		lua_setfield( L, -2, "__len" );
+	}
+	lua_pop( L, 1 );
+
 	// Set library as upvalue for each library function
 	Self *library = Rtt_NEW( & display->GetRuntime().GetAllocator(), Self( * display ) );
 
@@ -960,6 +1062,24 @@ DisplayLibrary::getDefault( lua_State *L )
 		bool value = defaults.IsImageSheetSampledInsideFrame();
 		lua_pushboolean( L, value ? 1 : 0 );
 	}
+	else if ( Rtt_StringCompare( key, "isHitTestIndexed" ) == 0 )
+	{
+		bool value = defaults.IsHitTestIndexed();
+		lua_pushboolean( L, value ? 1 : 0 );
+	}
+	else if ( Rtt_StringCompare( key, "textureUploadBytesPerFrame" ) == 0 )
+	{
+		lua_pushinteger( L, defaults.GetTextureUploadBytesPerFrame() );
+	}
+	else if ( Rtt_StringCompare( key, "textureUploadTimePerFrame" ) == 0 )
+	{
+		// Exposed in milliseconds
+		lua_pushnumber( L, defaults.GetTextureUploadTimePerFrame() / 1000.0 );
+	}
+	else if ( Rtt_StringCompare( key, "imageAtlasMaxSize" ) == 0 )
+	{
+		lua_pushinteger( L, defaults.GetImageAtlasMaxSize() );
+	}
 	else if ( key )
 	{
 		luaL_error( L, "ERROR: display.getDefault() given invalid key (%s)", key );
@@ -1047,6 +1167,27 @@ DisplayLibrary::setDefault( lua_State *L )
 		bool value = lua_toboolean( L, index ) ? true : false;
 		defaults.SetImageSheetSampledInsideFrame( value );
 	}
+	else if ( Rtt_StringCompare( key, "isHitTestIndexed" ) == 0 )
+	{
+		bool value = lua_toboolean( L, index ) ? true : false;
+		defaults.SetHitTestIndexed( value );
+	}
+	else if ( Rtt_StringCompare( key, "textureUploadBytesPerFrame" ) == 0 )
+	{
+		lua_Integer value = luaL_checkinteger( L, index );
+		defaults.SetTextureUploadBytesPerFrame( (U32)Max( value, (lua_Integer)0 ) );
+	}
+	else if ( Rtt_StringCompare( key, "textureUploadTimePerFrame" ) == 0 )
+	{
+		// Given in milliseconds
+		lua_Number value = luaL_checknumber( L, index );
+		defaults.SetTextureUploadTimePerFrame( (U32)( Max( value, (lua_Number)0 ) * 1000 ) );
+	}
+	else if ( Rtt_StringCompare( key, "imageAtlasMaxSize" ) == 0 )
+	{
+		lua_Integer value = luaL_checkinteger( L, index );
+		defaults.SetImageAtlasMaxSize( (U32)Max( value, (lua_Integer)0 ) );
+	}
 	else if ( key )
 	{
 		luaL_error( L, "ERROR: display.setDefault() given invalid key (%s)", key );
@@ -1409,6 +1550,70 @@ DisplayLibrary::colorSample( lua_State *L )
 	return 0;
 }
 
+// display.requestColorSample( x, y, listener )
+//
+// Like display.colorSample(), but samples the next frame rendered to the screen
+// instead of re-rendering the stage for every call. All requests made within a
+// frame are read back together; listeners receive the same "colorSample" event
+// a frame or two later, with "isError" set instead of a color if the point is
+// off screen or the frame could not be read.
+int
+DisplayLibrary::requestColorSample( lua_State *L )
+{
+	Self *library = ToLibrary( L );
+	Display& display = library->GetDisplay();
+
+	float pos_x = lua_tonumber( L, 1 );
+	float pos_y = lua_tonumber( L, 2 );
+
+	if( ! Lua::IsListener( L, 3, ColorSampleEvent::kName ) )
+	{
+		char msg[ 128 ];
+		sprintf( msg,
+					"ERROR: display.requestColorSample() requires a function, or an object able to respond to %s",
+					ColorSampleEvent::kName );
+		luaL_argerror( L, 3, msg );
+		return 0;
+	}
+
+	LuaResource *resource = Rtt_NEW( LuaContext::GetAllocator( L ),
+										LuaResource( LuaContext::GetContext( L )->LuaState(),
+														3 /*!< Callback index. */ ) );
+
+	display.GetReadback().RequestColorSample( pos_x, pos_y, resource );
+
+	return 0;
+}
+
+// display.requestCaptureScreen( listener )
+//
+// Non-blocking display.captureScreen(): the listener receives a "screenCapture"
+// event whose target is the image object, once the next frame has been read back.
+int
+DisplayLibrary::requestCaptureScreen( lua_State *L )
+{
+	Self *library = ToLibrary( L );
+	Display& display = library->GetDisplay();
+
+	if( ! Lua::IsListener( L, 1, ScreenCaptureEvent::kName ) )
+	{
+		char msg[ 128 ];
+		sprintf( msg,
+					"ERROR: display.requestCaptureScreen() requires a function, or an object able to respond to %s",
+					ScreenCaptureEvent::kName );
+		luaL_argerror( L, 1, msg );
+		return 0;
+	}
+
+	LuaResource *resource = Rtt_NEW( LuaContext::GetAllocator( L ),
+										LuaResource( LuaContext::GetContext( L )->LuaState(),
+														1 /*!< Callback index. */ ) );
+
+	display.GetReadback().RequestCapture( resource );
+
+	return 0;
+}
+
 int
 DisplayLibrary::getSafeAreaInsets( lua_State *L )
 {
@@ -1425,6 +1630,350 @@ DisplayLibrary::getSafeAreaInsets( lua_State *L )
 	return 4;
 }
 
+// display.startProfiling( [maxZones] )
+int
+DisplayLibrary::startProfiling( lua_State *L )
+{
+	Self *library = ToLibrary( L );
+	Display& display = library->GetDisplay();
+
+	U32 capacity = FrameProfiler::kDefaultCapacity;
+	if ( lua_isnumber( L, 1 ) )
+	{
+		capacity = (U32)Max( (int)lua_tointeger( L, 1 ), 1 );
+	}
+
+	display.GetRenderer().SetStatisticsEnabled( true );
+	display.GetProfiler().Start( capacity );
+
+	return 0;
+}
+
+// display.stopProfiling()
+int
+DisplayLibrary::stopProfiling( lua_State *L )
+{
+	Self *library = ToLibrary( L );
+	Display& display = library->GetDisplay();
+
+	display.GetProfiler().Stop();
+	display.GetRenderer().SetStatisticsEnabled( false );
+
+	return 0;
+}
+
+// display.writeProfile( filename [, baseDir] )
+// Writes the most recent zones in Chrome's trace format (about:tracing).
+int
+DisplayLibrary::writeProfile( lua_State *L )
+{
+	Self *library = ToLibrary( L );
+	Display& display = library->GetDisplay();
+
+	const char *filename = luaL_checkstring( L, 1 );
+	MPlatform::Directory baseDir = LuaLibSystem::ToDirectory( L, 2, MPlatform::kDocumentsDir );
+	if ( ! LuaLibSystem::IsWritableDirectory( baseDir ) )
+	{
+		CoronaLuaError( L, "display.writeProfile() requires a writable base directory" );
+		lua_pushboolean( L, 0 );
+		return 1;
+	}
+
+	String path( display.GetAllocator() );
+	display.GetRuntime().Platform().PathForFile( filename, baseDir, MPlatform::kDefaultPathFlags, path );
+
+	bool result = ! path.IsEmpty() && display.GetProfiler().Write( path.GetString() );
+	lua_pushboolean( L, result ? 1 : 0 );
+	return 1;
+}
+
+// display.getFrameStatistics()
+// Returns the renderer's counters for the last frame recorded while profiling,
+// with times in milliseconds, or nil if none were recorded.
+int
+DisplayLibrary::getFrameStatistics( lua_State *L )
+{
+	Self *library = ToLibrary( L );
+	Display& display = library->GetDisplay();
+
+	Renderer::Statistics statistics;
+	if ( ! display.GetProfiler().GetLastStatistics( statistics ) )
+	{
+		lua_pushnil( L );
+		return 1;
+	}
+
+	lua_createtable( L, 0, 14 );
+
+	lua_pushnumber( L, statistics.fPreparationTime );
+	lua_setfield( L, -2, "preparationTime" );
+	lua_pushnumber( L, statistics.fRenderTimeCPU );
+	lua_setfield( L, -2, "renderTimeCPU" );
+	lua_pushnumber( L, statistics.fRenderTimeGPU );
+	lua_setfield( L, -2, "renderTimeGPU" );
+	lua_pushnumber( L, statistics.fResourceCreateTime );
+	lua_setfield( L, -2, "resourceCreateTime" );
+	lua_pushnumber( L, statistics.fResourceUpdateTime );
+	lua_setfield( L, -2, "resourceUpdateTime" );
+	lua_pushnumber( L, statistics.fResourceDestroyTime );
+	lua_setfield( L, -2, "resourceDestroyTime" );
+	lua_pushinteger( L, statistics.fDrawCallCount );
+	lua_setfield( L, -2, "drawCallCount" );
+	lua_pushinteger( L, statistics.fTriangleCount );
+	lua_setfield( L, -2, "triangleCount" );
+	lua_pushinteger( L, statistics.fLineCount );
+	lua_setfield( L, -2, "lineCount" );
+	lua_pushinteger( L, statistics.fGeometryBindCount );
+	lua_setfield( L, -2, "geometryBindCount" );
+	lua_pushinteger( L, statistics.fProgramBindCount );
+	lua_setfield( L, -2, "programBindCount" );
+	lua_pushinteger( L, statistics.fTextureBindCount );
+	lua_setfield( L, -2, "textureBindCount" );
+	lua_pushinteger( L, statistics.fUniformBindCount );
+	lua_setfield( L, -2, "uniformBindCount" );
+	lua_pushinteger( L, statistics.fVertexBytes );
+	lua_setfield( L, -2, "vertexBytes" );
+
+	return 1;
+}
+
+// display.newFloatBuffer( count )
+int
+DisplayLibrary::newFloatBuffer( lua_State *L )
+{
+	int count = (int)luaL_checkinteger( L, 1 );
+	luaL_argcheck( L, count >= 0, 1, "count must not be negative" );
+
+	float *buffer = (float *)lua_newuserdata( L, count * sizeof( float ) );
+	memset( buffer, 0, count * sizeof( float ) );
+
+	luaL_getmetatable( L, kFloatBufferMetatableName );
+	lua_setmetatable( L, -2 );
+
+	return 1;
+}
+
+// Properties handled by display.setProperties() and display.getProperties()
+struct BulkProperty
+{
+	const char *fName;
+	int fGeometricProperty; // Or -1 for alpha
+};
+
+static const BulkProperty kBulkProperties[] =
+{
+	{ "x", kOriginX },
+	{ "y", kOriginY },
+	{ "xScale", kScaleX },
+	{ "yScale", kScaleY },
+	{ "rotation", kRotation },
+	{ "alpha", -1 },
+};
+
+static const int kNumBulkProperties = sizeof( kBulkProperties ) / sizeof( kBulkProperties[0] );
+
+// One array of values, parallel to the array of objects
+struct BulkArray
+{
+	int fGeometricProperty;
+	int fIndex; // Stack index of the array, unless it's a float buffer
+	float *fBuffer;
+};
+
+static bool
+IsDisplayObject( const LuaProxy& proxy )
+{
+	const LuaProxyVTable& expected = LuaDisplayObjectProxyVTable::Constant();
+
+	for ( const LuaProxyVTable *child = & proxy.Delegate(), *parent = & child->Parent();
+		  ;
+		  child = parent, parent = & child->Parent() )
+	{
+		if ( child == & expected ) { return true; }
+		if ( child == parent ) { break; }
+	}
+
+	return false;
+}
+
+// Returns the display object at 'index', or NULL if it was removed or the
+// value is not a display object
+static DisplayObject *
+ToBulkObject( lua_State *L, int index )
+{
+	LuaProxy *proxy = LuaProxy::GetProxy( L, index );
+	if ( ! proxy || ! IsDisplayObject( * proxy ) )
+	{
+		return NULL;
+	}
+
+	return static_cast< DisplayObject * >( proxy->Object() );
+}
+
+// Pushes the arrays of the values table at 'index' onto the stack, and
+// returns how many there are. Float buffers must hold 'numObjects' values.
+static int
+PushBulkArrays( lua_State *L, int index, int numObjects, const char *name, BulkArray *result )
+{
+	int numArrays = 0;
+
+	for ( int i = 0; i < kNumBulkProperties; i++ )
+	{
+		lua_getfield( L, index, kBulkProperties[i].fName );
+
+		int count = 0;
+		float *buffer = ToFloatBuffer( L, -1, count );
+		if ( buffer )
+		{
+			if ( count < numObjects )
+			{
+				luaL_error( L, "display.%s(): '%s' holds %d values, but there are %d objects",
+					name, kBulkProperties[i].fName, count, numObjects );
+			}
+		}
+		else if ( ! lua_istable( L, -1 ) )
+		{
+			if ( ! lua_isnil( L, -1 ) )
+			{
+				luaL_error( L, "display.%s(): '%s' must be an array or a float buffer",
+					name, kBulkProperties[i].fName );
+			}
+			lua_pop( L, 1 );
+			continue;
+		}
+
+		BulkArray& array = result[numArrays++];
+		array.fGeometricProperty = kBulkProperties[i].fGeometricProperty;
+		array.fIndex = lua_gettop( L );
+		array.fBuffer = buffer;
+	}
+
+	return numArrays;
+}
+
+// display.setProperties( objects, { x = xs, y = ys, xScale = ..., yScale = ...,
+//		rotation = ..., alpha = ... } )
+//
+// Each array, or float buffer, holds the values of the objects at the same
+// indices. Objects without a numeric value in an array keep that property.
+// Entries that are not display objects, or were removed, are skipped.
+int
+DisplayLibrary::setProperties( lua_State *L )
+{
+	luaL_checktype( L, 1, LUA_TTABLE );
+	luaL_checktype( L, 2, LUA_TTABLE );
+
+	int numObjects = (int)lua_objlen( L, 1 );
+
+	BulkArray arrays[kNumBulkProperties];
+	int numArrays = PushBulkArrays( L, 2, numObjects, "setProperties", arrays );
+
+	for ( int i = 1; i <= numObjects; i++ )
+	{
+		lua_rawgeti( L, 1, i );
+		DisplayObject *o = ToBulkObject( L, -1 );
+		lua_pop( L, 1 );
+
+		if ( ! o ) { continue; }
+
+		bool isChanged = false;
+		U32 mask = 0;
+		Real values[kNumGeometricProperties];
+		for ( int j = 0; j < numArrays; j++ )
+		{
+			const BulkArray& array = arrays[j];
+
+			lua_Number value = 0.;
+			if ( array.fBuffer )
+			{
+				value = array.fBuffer[i - 1];
+			}
+			else
+			{
+				lua_rawgeti( L, array.fIndex, i );
+				bool isNumber = lua_isnumber( L, -1 );
+				value = lua_tonumber( L, -1 );
+				lua_pop( L, 1 );
+
+				if ( ! isNumber ) { continue; }
+			}
+
+			if ( array.fGeometricProperty >= 0 )
+			{
+				mask |= 1 << array.fGeometricProperty;
+				values[array.fGeometricProperty] = Rtt_FloatToReal( (float)value );
+			}
+			else
+			{
+				lua_Integer alpha = (lua_Integer)( value * 255.0f );
+				o->SetAlpha( (U8)Max( (lua_Integer)0, Min( (lua_Integer)255, alpha ) ) );
+				isChanged = true;
+			}
+		}
+
+		if ( mask )
+		{
+			o->SetGeometricProperties( mask, values );
+			isChanged = true;
+		}
+
+		// Same "_lastChange" bookkeeping as setting the properties one by one
+		if ( isChanged )
+		{
+			LuaDisplayObjectProxyVTable::RecordLastChange( L, * o );
+		}
+	}
+
+	return 0;
+}
+
+// display.getProperties( objects, { x = xs, y = ys, ... } )
+//
+// The reverse of display.setProperties(): fills the given arrays, or float
+// buffers, with the values of the objects. Entries of removed objects, or of
+// values that are not display objects, are left as they are.
+int
+DisplayLibrary::getProperties( lua_State *L )
+{
+	luaL_checktype( L, 1, LUA_TTABLE );
+	luaL_checktype( L, 2, LUA_TTABLE );
+
+	int numObjects = (int)lua_objlen( L, 1 );
+
+	BulkArray arrays[kNumBulkProperties];
+	int numArrays = PushBulkArrays( L, 2, numObjects, "getProperties", arrays );
+
+	for ( int i = 1; i <= numObjects; i++ )
+	{
+		lua_rawgeti( L, 1, i );
+		const DisplayObject *o = ToBulkObject( L, -1 );
+		lua_pop( L, 1 );
+
+		if ( ! o ) { continue; }
+
+		for ( int j = 0; j < numArrays; j++ )
+		{
+			const BulkArray& array = arrays[j];
+
+			float value = array.fGeometricProperty >= 0
+				? Rtt_RealToFloat( o->GetGeometricProperty( (GeometricProperty)array.fGeometricProperty ) )
+				: o->Alpha() / 255.0f;
+
+			if ( array.fBuffer )
+			{
+				array.fBuffer[i - 1] = value;
+			}
+			else
+			{
+				lua_pushnumber( L, value );
+				lua_rawseti( L, array.fIndex, i );
+			}
+		}
+	}
+
+	return 0;
+}
+
 
 // ----------------------------------------------------------------------------
 
@@ -24,11 +24,14 @@
 #include "Display/Rtt_ShaderFactory.h"
 #include "Display/Rtt_ShaderTypes.h"
 #include "Display/Rtt_TextureResource.h"
+#include "Rtt_Event.h"
+#include "Rtt_Lua.h"
 #include "Rtt_LuaAux.h"
 #include "Rtt_LuaLibSystem.h"
 #include "Display/Rtt_BitmapPaint.h"
 #include "Rtt_TextureFactory.h"
 #include "Rtt_LuaContext.h"
+#include "Rtt_LuaResource.h"
 #include "Rtt_LuaLibNative.h"
 
 #include <float.h>
@@ -259,6 +262,44 @@ GraphicsLibrary::listEffects( lua_State *L )
 	return 1;
 }
 
+//helper function to override the default filters of a loaded image, e.g. minFilter="trilinear"
+static void SetResourceBitmapFiltersFromTable( TextureResource& resource, lua_State *L, int index )
+{
+	PlatformBitmap *bitmap = resource.GetBitmap();
+
+	// Images that are still loading, or that share an atlas page, keep theirs
+	if ( ! bitmap || resource.GetAtlasRegion() )
+	{
+		return;
+	}
+
+	RenderTypes::TextureFilter minFilter = bitmap->GetMinFilter();
+	RenderTypes::TextureFilter magFilter = bitmap->GetMagFilter();
+
+	lua_getfield( L, index, "minFilter" );
+	if ( lua_type( L, -1 ) == LUA_TSTRING )
+	{
+		minFilter = RenderTypes::TextureFilterForString( lua_tostring( L, -1 ) );
+	}
+	lua_pop( L, 1 );
+
+	lua_getfield( L, index, "magFilter" );
+	if ( lua_type( L, -1 ) == LUA_TSTRING )
+	{
+		magFilter = RenderTypes::TextureFilterForString( lua_tostring( L, -1 ) );
+	}
+	lua_pop( L, 1 );
+
+	if ( minFilter != bitmap->GetMinFilter() || magFilter != bitmap->GetMagFilter() )
+	{
+		bitmap->SetMinFilter( minFilter );
+		bitmap->SetMagFilter( magFilter );
+
+		// Already uploaded images pick up the new filters on their next update
+		resource.GetTexture().Invalidate();
+	}
+}
+
 //helper funciton to parse lua table to create bitmap resource
 SharedPtr<TextureResource> CreateResourceBitmapFromTable(Rtt::TextureFactory &factory, lua_State *L, int index)
 {
@@ -272,13 +313,33 @@ SharedPtr<TextureResource> CreateResourceBitmapFromTable(Rtt::TextureFactory &fa
 	bool isMask = lua_isboolean( L, -1 ) && lua_toboolean( L, -1 );
 	lua_pop( L, 1 );
 	
+	lua_getfield( L, index, "async" );
+	bool isAsync = lua_isboolean( L, -1 ) && lua_toboolean( L, -1 );
+	lua_pop( L, 1 );
+
 	lua_getfield( L, index, "filename" );
 	const char *filename = luaL_checkstring( L, -1);
 	if( filename )
 	{
-		SharedPtr<TextureResource> texSource = factory.FindOrCreate(filename, baseDir, PlatformBitmap::kIsBitsFullResolution, isMask);
+		LuaResource *listener = NULL;
+		if ( isAsync )
+		{
+			lua_getfield( L, index, "listener" );
+			if ( Lua::IsListener( L, -1, TextureLoadEvent::kName ) )
+			{
+				listener = Rtt_NEW( LuaContext::GetAllocator( L ),
+									LuaResource( LuaContext::GetContext( L )->LuaState(), -1 ) );
+			}
+			lua_pop( L, 1 );
+		}
+
+		SharedPtr<TextureResource> texSource = isAsync
+			? factory.FindOrCreateAsync(filename, baseDir, PlatformBitmap::kIsBitsFullResolution, isMask, listener)
+			: factory.FindOrCreate(filename, baseDir, PlatformBitmap::kIsBitsFullResolution, isMask);
 		if( texSource.NotNull() )
 		{
+			SetResourceBitmapFiltersFromTable( * texSource, L, index );
+
 			factory.Retain(texSource);
 			ret = texSource;
 		}
@@ -385,6 +385,13 @@ namespace Rtt
 				observer->Invalidate(DisplayObject::kProgramFlag | DisplayObject::kPaintFlag);
 			}
 
+			// Atlased images are only sampled from their page without an
+			// effect, so texture coordinates change along with the shader
+			if (fResource.NotNull() && fResource->GetAtlasRegion())
+			{
+				Invalidate(kTextureTransformFlag);
+			}
+
 			// Delete shader b/c we have a new effect
 			Rtt_DELETE(fShader);
 
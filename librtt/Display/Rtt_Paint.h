@@ -136,6 +136,7 @@ class Paint
 
 	public:
 		void SetShader( Shader *newValue );
+		bool HasShader() const { return NULL != fShader; }
 		const Shader *GetShader(ShaderFactory &factory) const;
 		Shader *GetShader(ShaderFactory &factory);
 
@@ -75,6 +75,36 @@ PlatformBitmap::HitTest( Rtt_Allocator *context, int i, int j, U8 threshold ) co
 	return result;
 }
 
+bool
+PlatformBitmap::CanDecodeInBackground() const
+{
+	return false;
+}
+
+Texture::Format
+PlatformBitmap::GetCompressedFormat() const
+{
+	return Texture::kNumFormats;
+}
+
+U32
+PlatformBitmap::GetNumLevels() const
+{
+	return 1;
+}
+
+const void*
+PlatformBitmap::GetLevelBits( U32 level ) const
+{
+	return NULL;
+}
+
+U32
+PlatformBitmap::GetDirtyRects( Texture::DirtyRect* rects, U32 maxRects ) const
+{
+	return 0;
+}
+
 bool
 PlatformBitmap::WasScaled() const
 {
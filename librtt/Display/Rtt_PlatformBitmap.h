@@ -15,6 +15,7 @@
 #include "Core/Rtt_Types.h"
 
 #include "Renderer/Rtt_RenderTypes.h"
+#include "Renderer/Rtt_Texture.h"
 
 // ----------------------------------------------------------------------------
 
@@ -68,6 +69,26 @@ class PlatformBitmap
 		virtual const void* GetBits( Rtt_Allocator* context ) const = 0;
 		virtual void FreeBits() const = 0;
 
+		// Returns true if GetBits() may be called on a worker thread while the
+		// main thread keeps using the bitmap. Such bitmaps must serialize
+		// GetBits() and FreeBits(), so that a call on the main thread waits for
+		// the decode in flight. Used by the async texture loader; decoding stays
+		// lazy otherwise.
+		virtual bool CanDecodeInBackground() const;
+
+		// Bitmaps holding GPU-compressed data (see KTXBitmap) return its
+		// format, or Texture::kNumFormats otherwise. Their GetBits() still
+		// returns uncompressed pixels, for GPUs lacking the format.
+		virtual Texture::Format GetCompressedFormat() const;
+		bool IsCompressed() const { return Texture::kNumFormats != GetCompressedFormat(); }
+
+		// Compressed data of each pre-built mip level, see Texture::GetLevelData()
+		virtual U32 GetNumLevels() const;
+		virtual const void* GetLevelBits( U32 level ) const;
+
+		// Areas changed since the last upload, see Texture::GetDirtyRects()
+		virtual U32 GetDirtyRects( Texture::DirtyRect* rects, U32 maxRects ) const;
+
 		// Returns true if the value (0-100%) of the pixel at row,col (i,j) is greater than threshold
 		bool HitTest( Rtt_Allocator *context, int i, int j, U8 threshold = 0 ) const;
 
@@ -12,6 +12,7 @@
 #include "Display/Rtt_PlatformBitmapTexture.h"
 
 #include "Display/Rtt_PlatformBitmap.h"
+#include "Renderer/Rtt_CommandBuffer.h"
 
 // ----------------------------------------------------------------------------
 
@@ -22,7 +23,8 @@ namespace Rtt
 
 PlatformBitmapTexture::PlatformBitmapTexture( Rtt_Allocator *allocator, PlatformBitmap& bitmap )
 :	Super( allocator ),
-	fBitmap( bitmap )
+	fBitmap( bitmap ),
+	fIsPending( false )
 {
 }
 
@@ -39,13 +41,13 @@ PlatformBitmapTexture::Deallocate()
 U32
 PlatformBitmapTexture::GetWidth() const
 {
-	return fBitmap.Width();
+	return fIsPending ? 1 : fBitmap.Width();
 }
 
 U32 
 PlatformBitmapTexture::GetHeight() const
 {
-	return fBitmap.Height();
+	return fIsPending ? 1 : fBitmap.Height();
 }
 
 Texture::Format
@@ -95,13 +97,28 @@ PlatformBitmapTexture::ConvertFormat( PlatformBitmap::Format format )
 Texture::Format
 PlatformBitmapTexture::GetFormat() const
 {
+	if ( IsUploadedCompressed() )
+	{
+		return fBitmap.GetCompressedFormat();
+	}
+
 	return ConvertFormat( fBitmap.GetFormat() );
 }
 
 Texture::Filter
 PlatformBitmapTexture::GetFilter() const
 {
-	return RenderTypes::Convert( fBitmap.GetMagFilter() );
+	Texture::Filter result = RenderTypes::Convert( fBitmap.GetMagFilter() );
+
+	// GL has a single filter setting covering mip levels, so a trilinear
+	// minification filter makes the whole texture mipmapped.
+	if ( Texture::kLinear == result
+		 && RenderTypes::kTrilinearTextureFilter == fBitmap.GetMinFilter() )
+	{
+		result = Texture::kLinearMipmap;
+	}
+
+	return result;
 }
 
 Texture::Wrap
@@ -119,6 +136,11 @@ PlatformBitmapTexture::GetWrapY() const
 size_t 
 PlatformBitmapTexture::GetSizeInBytes() const
 {
+	if ( IsUploadedCompressed() )
+	{
+		return Super::GetSizeInBytes();
+	}
+
 	return fBitmap.NumBytes();
 }
 
@@ -131,13 +153,59 @@ PlatformBitmapTexture::GetByteAlignment() const
 const U8*
 PlatformBitmapTexture::GetData() const
 {
+	if ( fIsPending )
+	{
+		// Large enough for a single pixel in any format
+		static const U8 kPlaceholder[4] = { 0, 0, 0, 0 };
+		return kPlaceholder;
+	}
+
+	if ( IsUploadedCompressed() )
+	{
+		return GetLevelData( 0 );
+	}
+
 	return (const U8 *)fBitmap.GetBits( GetAllocator() );
 }
 
 void
 PlatformBitmapTexture::ReleaseData()
 {
-	fBitmap.FreeBits();
+	if ( ! fIsPending )
+	{
+		fBitmap.FreeBits();
+	}
+}
+
+U32
+PlatformBitmapTexture::GetNumLevels() const
+{
+	return IsUploadedCompressed() ? fBitmap.GetNumLevels() : 1;
+}
+
+const U8*
+PlatformBitmapTexture::GetLevelData( U32 level ) const
+{
+	if ( IsUploadedCompressed() )
+	{
+		return (const U8 *)fBitmap.GetLevelBits( level );
+	}
+
+	return Super::GetLevelData( level );
+}
+
+U32
+PlatformBitmapTexture::GetDirtyRects( DirtyRect* rects, U32 maxRects )
+{
+	return IsUploadedCompressed() ? 0 : fBitmap.GetDirtyRects( rects, maxRects );
+}
+
+bool
+PlatformBitmapTexture::IsUploadedCompressed() const
+{
+	return ! fIsPending
+		&& fBitmap.IsCompressed()
+		&& CommandBuffer::GetGpuSupportsCompressedFormat( fBitmap.GetCompressedFormat() );
 }
 
 // ----------------------------------------------------------------------------
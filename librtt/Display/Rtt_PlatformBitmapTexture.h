@@ -47,12 +47,24 @@ class PlatformBitmapTexture : public Texture
 		virtual U8 GetByteAlignment() const;
 		virtual const U8* GetData() const;
 		virtual void ReleaseData();
+		virtual U32 GetNumLevels() const;
+		virtual const U8* GetLevelData( U32 level ) const;
+		virtual U32 GetDirtyRects( DirtyRect* rects, U32 maxRects );
 
 	public:
 		PlatformBitmap& GetBitmap() const { return fBitmap; }
 
+		// True if the bitmap's compressed data is uploaded instead of its bits
+		bool IsUploadedCompressed() const;
+
+		// While pending, the texture presents a 1x1 transparent placeholder and
+		// never touches the bitmap's bits, so they can be decoded off-thread.
+		bool IsPending() const { return fIsPending; }
+		void SetPending( bool newValue ) { fIsPending = newValue; }
+
 	protected:
 		PlatformBitmap& fBitmap;
+		bool fIsPending;
 };
 
 // ----------------------------------------------------------------------------
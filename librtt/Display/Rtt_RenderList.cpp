@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_RenderList.h"
+
+#include "Display/Rtt_GroupObject.h"
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+RenderList::RenderList( Rtt_Allocator *allocator )
+:	fEntries( allocator ),
+	fGeneration( 0 ),
+	fIsValid( false )
+{
+}
+
+void
+RenderList::Build( const GroupObject& root )
+{
+	fEntries.Clear();
+
+	Append( root );
+
+	++fGeneration;
+	fIsValid = true;
+}
+
+const DisplayObject*
+RenderList::LeafAt( S32 index ) const
+{
+	const Entry& entry = fEntries[index];
+	return ( kObject == entry.fType ? entry.fObject : NULL );
+}
+
+void
+RenderList::Append( const GroupObject& group )
+{
+	Entry entry = { & group, kBeginGroup };
+	fEntries.Append( entry );
+
+	for ( S32 i = 0, iMax = group.NumChildren(); i < iMax; i++ )
+	{
+		const DisplayObject& child = group.ChildAt( i );
+		const GroupObject *childGroup = const_cast< DisplayObject& >( child ).AsGroupObject();
+
+		if ( childGroup )
+		{
+			Append( * childGroup );
+		}
+		else
+		{
+			Entry leaf = { & child, kObject };
+			fEntries.Append( leaf );
+		}
+	}
+
+	Entry end = { & group, kEndGroup };
+	fEntries.Append( end );
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_RenderList_H__
+#define _Rtt_RenderList_H__
+
+#include "Core/Rtt_Types.h"
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Array.h"
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+
+namespace Rtt
+{
+
+class DisplayObject;
+class GroupObject;
+
+// ----------------------------------------------------------------------------
+
+// Flattened copy of a display hierarchy, in draw order. Hit testing indexes its
+// leaves (see SpatialIndex) instead of walking the tree.
+//
+// Only the structure is retained: bounds and visibility are read from the
+// objects when they are used. The list must therefore be rebuilt whenever
+// children are added, removed or reordered (see GroupObject::DidInsert).
+class RenderList
+{
+	Rtt_CLASS_NO_COPIES( RenderList )
+
+	public:
+		RenderList( Rtt_Allocator *allocator );
+
+	public:
+		bool IsValid() const { return fIsValid; }
+		void Invalidate() { fIsValid = false; }
+
+		void Build( const GroupObject& root );
+
+	public:
+		// Entries are in draw order. LeafAt() returns NULL for group markers.
+		S32 Length() const { return fEntries.Length(); }
+		const DisplayObject* LeafAt( S32 index ) const;
+
+		// Incremented on every Build()
+		U32 GetGeneration() const { return fGeneration; }
+
+	protected:
+		void Append( const GroupObject& group );
+
+	private:
+		enum EntryType
+		{
+			kObject = 0,
+			kBeginGroup,
+			kEndGroup
+		};
+
+		struct Entry
+		{
+			const DisplayObject *fObject;
+			S32 fType;
+		};
+
+	private:
+		Array< Entry > fEntries;
+		U32 fGeneration;
+		bool fIsValid;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_RenderList_H__
@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_RenderThread.h"
+
+#include "Renderer/Rtt_Renderer.h"
+#include "Rtt_PlatformSurface.h"
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+bool
+RenderThread::IsSupported( const PlatformSurface& surface )
+{
+	return surface.SupportsRenderThread() && std::thread::hardware_concurrency() > 1;
+}
+
+RenderThread::RenderThread( Renderer& renderer, const PlatformSurface& surface )
+:	fRenderer( renderer ),
+	fSurface( surface ),
+	fHasFrame( false ),
+	fExiting( false ),
+	fIsPresentPending( false ),
+	fLockDepth( 0 ),
+	fThread()
+{
+	// Started last: everything above must be set up before it runs
+	fThread = std::thread( &RenderThread::ThreadMain, this );
+}
+
+RenderThread::~RenderThread()
+{
+	Rtt_ASSERT( 0 == fLockDepth );
+
+	{
+		std::lock_guard< std::mutex > lock( fMutex );
+		fExiting = true;
+	}
+	fCondition.notify_all();
+
+	// A frame still in flight is executed first
+	fThread.join();
+}
+
+void
+RenderThread::Submit()
+{
+	Rtt_ASSERT( 0 == fLockDepth );
+
+	{
+		std::lock_guard< std::mutex > lock( fMutex );
+		Rtt_ASSERT( ! fHasFrame ); // Swap() must have waited for it
+		fHasFrame = true;
+	}
+	fCondition.notify_all();
+
+	fIsPresentPending = true;
+}
+
+void
+RenderThread::Wait()
+{
+	std::unique_lock< std::mutex > lock( fMutex );
+	while ( fHasFrame )
+	{
+		fCondition.wait( lock );
+	}
+}
+
+void
+RenderThread::ThreadMain()
+{
+	for ( ;; )
+	{
+		{
+			std::unique_lock< std::mutex > lock( fMutex );
+			while ( ! fHasFrame && ! fExiting )
+			{
+				fCondition.wait( lock );
+			}
+
+			if ( ! fHasFrame )
+			{
+				break;
+			}
+		}
+
+		// Released after every frame, so that a Lock can take it
+		fSurface.SetCurrent();
+		fRenderer.Render();
+		fSurface.ReleaseCurrent();
+
+		{
+			std::lock_guard< std::mutex > lock( fMutex );
+			fHasFrame = false;
+		}
+		fCondition.notify_all();
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+RenderThread::Lock::Lock( RenderThread* thread )
+:	fThread( thread )
+{
+	if ( fThread && 0 == fThread->fLockDepth++ )
+	{
+		fThread->Wait();
+		fThread->fSurface.SetCurrent();
+	}
+}
+
+RenderThread::Lock::~Lock()
+{
+	if ( fThread && 0 == --fThread->fLockDepth )
+	{
+		fThread->fSurface.ReleaseCurrent();
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
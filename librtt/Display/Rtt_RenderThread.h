@@ -0,0 +1,106 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_RenderThread_H__
+#define _Rtt_RenderThread_H__
+
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Types.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+class PlatformSurface;
+class Renderer;
+
+// ----------------------------------------------------------------------------
+
+// Executes frames on a thread that owns the rendering context, so that frame
+// N's command buffer runs on the GPU while the main thread (Lua, physics and
+// the scene traversal) prepares frame N+1.
+//
+// Only Renderer::Render() runs on the render thread. GPU resources are still
+// created, updated and destroyed by Renderer::Swap() on the main thread,
+// while it holds a Lock, because uploads read CPU data that Lua can change at
+// any time. Command buffers and the GeometryPool are double-buffered, so the
+// frame being prepared never touches what is being executed.
+//
+// A frame is presented (and read back, see FrameReadback) once the next one
+// has been prepared, which adds a frame of latency.
+class RenderThread
+{
+	Rtt_CLASS_NO_COPIES( RenderThread )
+
+	public:
+		// The surface's context must be able to move between threads (see
+		// PlatformSurface::SupportsRenderThread()), and a spare core must
+		// be available for the pipeline to pay off.
+		static bool IsSupported( const PlatformSurface& surface );
+
+	public:
+		// The calling thread must not have the context current
+		RenderThread( Renderer& renderer, const PlatformSurface& surface );
+		~RenderThread();
+
+	public:
+		// Executes the front command buffer on the render thread. Call after
+		// Renderer::Swap(), once any Lock is released.
+		void Submit();
+
+		// True if a submitted frame has yet to be presented. The flag is
+		// only accessed by the main thread.
+		bool IsPresentPending() const { return fIsPresentPending; }
+		void ClearPresentPending() { fIsPresentPending = false; }
+
+	public:
+		// Gives the calling thread the rendering context for its lifetime,
+		// once the frame in flight, if any, has been executed. Anything that
+		// calls the GPU outside of Renderer::Render() must hold one. Locks
+		// nest; a NULL thread makes them no-ops.
+		class Lock
+		{
+			Rtt_CLASS_NO_COPIES( Lock )
+
+			public:
+				Lock( RenderThread* thread );
+				~Lock();
+
+			private:
+				RenderThread* fThread;
+		};
+
+	private:
+		void Wait();
+		void ThreadMain();
+
+	private:
+		Renderer& fRenderer;
+		const PlatformSurface& fSurface;
+		std::mutex fMutex;
+		std::condition_variable fCondition;
+		bool fHasFrame; // Guarded by fMutex
+		bool fExiting; // Guarded by fMutex
+		bool fIsPresentPending;
+		U32 fLockDepth;
+		std::thread fThread;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_RenderThread_H__
@@ -13,6 +13,8 @@
 
 #include "Display/Rtt_Display.h"
 #include "Display/Rtt_DisplayDefaults.h"
+#include "Display/Rtt_FrameProfiler.h"
+#include "Display/Rtt_RenderThread.h"
 #include "Rtt_MUpdatable.h"
 #include "Display/Rtt_TextureFactory.h"
 #include "Renderer/Rtt_Renderer.h"
@@ -171,6 +173,9 @@ Scene::Render( Renderer& renderer, PlatformSurface& rTarget )
 {
 	Rtt_ASSERT( fCurrentStage );
 
+	FrameProfiler& profiler = fOwner.GetProfiler();
+	RenderThread *renderThread = fOwner.GetRenderThread();
+
 	if ( ! IsValid() )
 	{
 		const Rtt::Real kMillisecondsPerSecond = 1000.0f;
@@ -194,9 +199,18 @@ Scene::Render( Renderer& renderer, PlatformSurface& rTarget )
 
 		Matrix identity;
 		StageObject *canvas = fCurrentStage;
-		canvas->UpdateTransform( identity );
-		canvas->Prepare( fOwner );
-		canvas->Draw( renderer );
+		{
+			Rtt_PROFILE_ZONE( profiler, "UpdateTransform" );
+			canvas->UpdateTransform( identity );
+		}
+		{
+			Rtt_PROFILE_ZONE( profiler, "Prepare" );
+			canvas->Prepare( fOwner );
+		}
+		{
+			Rtt_PROFILE_ZONE( profiler, "Draw" );
+			canvas->Draw( renderer );
+		}
 		
 		renderer.EndFrame();
 
@@ -207,18 +221,78 @@ Scene::Render( Renderer& renderer, PlatformSurface& rTarget )
 			fIsValid = true;
 		}
 		
-		renderer.Swap(); // Swap back and front command buffers
-		renderer.Render(); // Render front command buffer
-		
-//		renderer.GetFrameStatistics().Log();
-		
-		rTarget.Flush();
+		if ( renderThread )
+		{
+			{
+				// Waits for the previous frame to finish executing
+				Rtt_PROFILE_ZONE( profiler, "Renderer::Swap" );
+				RenderThread::Lock lock( renderThread );
+
+				PresentPendingFrame( rTarget );
+
+				if ( profiler.IsEnabled() && renderer.GetStatisticsEnabled() )
+				{
+					profiler.RecordStatistics( renderer.GetFrameStatistics() );
+				}
+
+				renderer.Swap(); // Swap back and front command buffers
+			}
+
+			// Render front command buffer while the next frame is prepared
+			renderThread->Submit();
+		}
+		else
+		{
+			{
+				Rtt_PROFILE_ZONE( profiler, "Renderer::Swap" );
+				renderer.Swap(); // Swap back and front command buffers
+			}
+			{
+				Rtt_PROFILE_ZONE( profiler, "Renderer::Render" );
+				renderer.Render(); // Render front command buffer
+			}
+			{
+				// Read back from the frame before it is presented
+				Rtt_PROFILE_ZONE( profiler, "ProcessReadbacks" );
+				fOwner.ProcessReadbacks();
+			}
+
+//			renderer.GetFrameStatistics().Log();
+			if ( profiler.IsEnabled() && renderer.GetStatisticsEnabled() )
+			{
+				profiler.RecordStatistics( renderer.GetFrameStatistics() );
+			}
+
+			rTarget.Flush();
+		}
+	}
+	else if ( renderThread && renderThread->IsPresentPending() )
+	{
+		// Nothing changed, but the last frame has yet to be presented
+		RenderThread::Lock lock( renderThread );
+		PresentPendingFrame( rTarget );
 	}
 	
 	// This needs to be done at the sync point (DMZ)
+	Rtt_PROFILE_ZONE( profiler, "Scene::Collect" );
 	Collect();
 }
 
+void
+Scene::PresentPendingFrame( PlatformSurface& rTarget )
+{
+	RenderThread *renderThread = fOwner.GetRenderThread();
+	if ( renderThread && renderThread->IsPresentPending() )
+	{
+		// Read back from the frame before it is presented
+		Rtt_PROFILE_ZONE( fOwner.GetProfiler(), "ProcessReadbacks" );
+		fOwner.ProcessReadbacks();
+
+		rTarget.Flush();
+		renderThread->ClearPresentPending();
+	}
+}
+
 void
 Scene::Render( Renderer& renderer, PlatformSurface& rTarget, DisplayObject& object )
 {
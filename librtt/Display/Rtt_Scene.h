@@ -78,6 +78,10 @@ class Scene
 		void Render( Renderer& renderer, PlatformSurface& rTarget );
 		void Render( Renderer& renderer, PlatformSurface& rTarget, DisplayObject& object );
 
+	private:
+		// Presents the frame last submitted to the RenderThread, if any
+		void PresentPendingFrame( PlatformSurface& rTarget );
+
 	public:
 		StageObject* PushStage();
 		void PopStage();
@@ -242,6 +242,20 @@ Shader::Draw( Renderer& renderer, const RenderData& objectData ) const
 	renderer.Insert( & objectData );
 }
 
+void
+Shader::Precompile( Renderer& renderer ) const
+{
+	if ( fResource.NotNull() )
+	{
+		Program *program = fResource->GetProgramMod( ShaderResource::kDefault );
+		if ( program && ! program->GetGPUResource() )
+		{
+			program->SetPrecompiled( true );
+			renderer.QueueCreate( program );
+		}
+	}
+}
+
 void
 Shader::PushProxy( lua_State *L ) const
 {
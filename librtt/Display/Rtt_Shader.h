@@ -69,6 +69,11 @@ class Shader
 		virtual void Prepare( RenderData& objectData, int w, int h, ShaderResource::ProgramMod mod );
 
 		virtual void Draw( Renderer& renderer, const RenderData& objectData ) const;
+
+		// Have the renderer compile and link the programs this shader draws
+		// with when they are created, instead of on first use.
+		virtual void Precompile( Renderer& renderer ) const;
+
 		virtual void Log(std::string preprend, bool last);
 		virtual void Log();
 
@@ -313,6 +313,22 @@ ShaderComposite::Draw( Renderer& renderer, const RenderData& objectData ) const
 	
 }	
 
+void
+ShaderComposite::Precompile( Renderer& renderer ) const
+{
+	if ( fInput0.NotNull() )
+	{
+		fInput0->Precompile( renderer );
+	}
+
+	if ( fInput1.NotNull() )
+	{
+		fInput1->Precompile( renderer );
+	}
+
+	Super::Precompile( renderer );
+}
+
 void
 ShaderComposite::SetNamedShader(std::string key, Shader* shader)
 {
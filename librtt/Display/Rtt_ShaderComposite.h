@@ -55,6 +55,7 @@ class ShaderComposite : public Shader
 	public:
 		virtual void Prepare( RenderData& objectData, int w, int h, ShaderResource::ProgramMod mod );
 		virtual void Draw( Renderer& renderer, const RenderData& objectData ) const;
+		virtual void Precompile( Renderer& renderer ) const;
 		
 	public:
 		virtual void PushProxy( lua_State *L ) const;
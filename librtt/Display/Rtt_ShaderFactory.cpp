@@ -28,6 +28,8 @@
 #include "Display/Rtt_ShaderProxy.h"
 #include "Rtt_LuaContainer.h"
 
+#include <string.h>
+
 // ----------------------------------------------------------------------------
 
 namespace Rtt
@@ -172,6 +174,15 @@ ShaderFactory::Initialize()
 	return result;
 }
 
+// Whether a kernel reads the per-vertex user data (directly or via the macro)
+static bool
+UsesVertexUserData( const char *kernel )
+{
+	return NULL != strstr( kernel, "CoronaVertexUserData" )
+		|| NULL != strstr( kernel, "a_UserData" )
+		|| NULL != strstr( kernel, "v_UserData" );
+}
+
 Program *
 ShaderFactory::NewProgram(
 		const char *shellVert,
@@ -243,6 +254,15 @@ ShaderFactory::NewProgram(
 			header = header + std::string("#define TEX_COORD_Z 1\n");
 		}
 
+		// Only 2.5D programs read q, so unless the kernels read the user data
+		// the program can be batched with the smaller vertex format
+		if ( ShaderResource::k25D != mod
+			 && ! UsesVertexUserData( kernelVert )
+			 && ! UsesVertexUserData( kernelFrag ) )
+		{
+			program->SetVertexFormat( Program::kCompactVertexFormat );
+		}
+
 #if defined( Rtt_EMSCRIPTEN_ENV )
 		header = header +  "#define Rtt_WEBGL_ENV\n";
 #endif
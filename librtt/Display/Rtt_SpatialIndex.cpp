@@ -0,0 +1,233 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_SpatialIndex.h"
+
+#include "Core/Rtt_Math.h"
+#include "Display/Rtt_DisplayObject.h"
+#include "Display/Rtt_RenderList.h"
+
+#include <algorithm>
+#include <math.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Keeps cell coordinates well inside S32 for absurdly large bounds
+static const float kMaxCellCoordinate = (float)( 1 << 24 );
+
+static S32
+CellCoordinate( Real value )
+{
+	float result = floorf( value / SpatialIndex::kCellSize );
+	result = Max( result, -kMaxCellCoordinate );
+	result = Min( result, kMaxCellCoordinate );
+	return (S32)result;
+}
+
+// ----------------------------------------------------------------------------
+
+SpatialIndex::SpatialIndex()
+:	fGrid(),
+	fEntries(),
+	fCells(),
+	fOversized(),
+	fCandidates(),
+	fList( NULL ),
+	fGeneration( 0 )
+{
+}
+
+bool
+SpatialIndex::IsBuiltFrom( const RenderList& list ) const
+{
+	return & list == fList
+		&& list.IsValid()
+		&& list.GetGeneration() == fGeneration;
+}
+
+void
+SpatialIndex::Build( const RenderList& list )
+{
+	Rtt_ASSERT( list.IsValid() );
+
+	fGrid.clear();
+	fEntries.clear();
+	fOversized.clear();
+
+	const S32 length = list.Length();
+	fCells.resize( length );
+
+	for ( S32 i = 0; i < length; i++ )
+	{
+		const DisplayObject *object = list.LeafAt( i );
+		if ( object )
+		{
+			fEntries[object] = i;
+
+			fCells[i] = CellsForObject( * object );
+			Insert( i, fCells[i] );
+		}
+	}
+
+	fList = & list;
+	fGeneration = list.GetGeneration();
+}
+
+void
+SpatialIndex::Update( const DisplayObject& object )
+{
+	std::unordered_map< const DisplayObject*, S32 >::const_iterator iter = fEntries.find( & object );
+	if ( iter != fEntries.end() )
+	{
+		const S32 entry = iter->second;
+		Cells cells = CellsForObject( object );
+
+		if ( ! ( cells == fCells[entry] ) )
+		{
+			Remove( entry, fCells[entry] );
+			fCells[entry] = cells;
+			Insert( entry, cells );
+		}
+	}
+}
+
+const std::vector< S32 >&
+SpatialIndex::Query( Real x, Real y ) const
+{
+	std::vector< S32 >& outCandidates = fCandidates;
+	outCandidates.clear();
+
+	std::unordered_map< U64, std::vector< S32 > >::const_iterator iter =
+		fGrid.find( Key( CellCoordinate( x ), CellCoordinate( y ) ) );
+	if ( iter != fGrid.end() )
+	{
+		outCandidates.insert( outCandidates.end(), iter->second.begin(), iter->second.end() );
+	}
+
+	outCandidates.insert( outCandidates.end(), fOversized.begin(), fOversized.end() );
+
+	// An entry is either oversized or in each of its cells once, so there
+	// are no duplicates to remove
+	std::sort( outCandidates.begin(), outCandidates.end() );
+
+	return outCandidates;
+}
+
+bool
+SpatialIndex::IsOversized( const Cells& cells )
+{
+	S64 numCells = (S64)( cells.xMax - cells.xMin + 1 ) * (S64)( cells.yMax - cells.yMin + 1 );
+	return numCells > kMaxCellsPerObject;
+}
+
+SpatialIndex::Cells
+SpatialIndex::CellsForObject( const DisplayObject& object )
+{
+	Cells result = { 0, 0, -1, -1 };
+
+	// Hidden objects can't be hit. They are re-binned by UpdateTransform()
+	// once they are shown again.
+	if ( ! object.ShouldHitTest() )
+	{
+		return result;
+	}
+
+	const Rect& bounds = object.StageBounds();
+	if ( bounds.NotEmpty() )
+	{
+		result.xMin = CellCoordinate( bounds.xMin );
+		result.yMin = CellCoordinate( bounds.yMin );
+		result.xMax = CellCoordinate( bounds.xMax );
+		result.yMax = CellCoordinate( bounds.yMax );
+	}
+
+	return result;
+}
+
+void
+SpatialIndex::Insert( S32 entry, const Cells& cells )
+{
+	if ( cells.IsEmpty() )
+	{
+		return;
+	}
+
+	if ( IsOversized( cells ) )
+	{
+		fOversized.push_back( entry );
+		return;
+	}
+
+	for ( S32 y = cells.yMin; y <= cells.yMax; y++ )
+	{
+		for ( S32 x = cells.xMin; x <= cells.xMax; x++ )
+		{
+			fGrid[Key( x, y )].push_back( entry );
+		}
+	}
+}
+
+void
+SpatialIndex::Remove( S32 entry, const Cells& cells )
+{
+	if ( cells.IsEmpty() )
+	{
+		return;
+	}
+
+	if ( IsOversized( cells ) )
+	{
+		std::vector< S32 >::iterator iter = std::find( fOversized.begin(), fOversized.end(), entry );
+		if ( Rtt_VERIFY( iter != fOversized.end() ) )
+		{
+			fOversized.erase( iter );
+		}
+		return;
+	}
+
+	for ( S32 y = cells.yMin; y <= cells.yMax; y++ )
+	{
+		for ( S32 x = cells.xMin; x <= cells.xMax; x++ )
+		{
+			std::unordered_map< U64, std::vector< S32 > >::iterator cell = fGrid.find( Key( x, y ) );
+			if ( ! Rtt_VERIFY( cell != fGrid.end() ) )
+			{
+				continue;
+			}
+
+			// Order within a cell does not matter, Query() sorts
+			std::vector< S32 >& entries = cell->second;
+			std::vector< S32 >::iterator iter = std::find( entries.begin(), entries.end(), entry );
+			if ( Rtt_VERIFY( iter != entries.end() ) )
+			{
+				* iter = entries.back();
+				entries.pop_back();
+			}
+
+			// Don't accumulate cells that objects have moved out of
+			if ( entries.empty() )
+			{
+				fGrid.erase( cell );
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
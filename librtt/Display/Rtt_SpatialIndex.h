@@ -0,0 +1,105 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_SpatialIndex_H__
+#define _Rtt_SpatialIndex_H__
+
+#include "Core/Rtt_Types.h"
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Real.h"
+
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+class DisplayObject;
+class RenderList;
+
+// ----------------------------------------------------------------------------
+
+// Uniform grid over the stage bounds of the leaves of a RenderList, used to
+// find hit-test candidates without visiting every object.
+//
+// Objects are identified by their RenderList entry index, so candidates sort
+// into draw order for free. The index is built from a specific generation of
+// the list and must be rebuilt once the list is (see IsBuiltFrom()); between
+// rebuilds, GroupObject::UpdateTransform() keeps bounds current via Update().
+class SpatialIndex
+{
+	Rtt_CLASS_NO_COPIES( SpatialIndex )
+
+	public:
+		enum
+		{
+			kCellSize = 64, // content units
+
+			// Objects spanning more cells are tested for every query
+			kMaxCellsPerObject = 256
+		};
+
+	public:
+		SpatialIndex();
+
+	public:
+		bool IsBuiltFrom( const RenderList& list ) const;
+		void Build( const RenderList& list );
+
+		// Re-bins 'object' if its stage bounds now cover different cells.
+		// Objects that are not leaves of the indexed list are ignored.
+		void Update( const DisplayObject& object );
+
+		// Entry indices of objects whose cells contain (x,y), in draw order.
+		// Candidates are conservative: callers still test the actual bounds.
+		// The result is only valid until the next call.
+		const std::vector< S32 >& Query( Real x, Real y ) const;
+
+	private:
+		struct Cells
+		{
+			S32 xMin;
+			S32 yMin;
+			S32 xMax;
+			S32 yMax;
+
+			bool IsEmpty() const { return xMin > xMax; }
+			bool operator==( const Cells& rhs ) const
+			{
+				return xMin == rhs.xMin && yMin == rhs.yMin
+					&& xMax == rhs.xMax && yMax == rhs.yMax;
+			}
+		};
+
+		static U64 Key( S32 x, S32 y ) { return ( ( (U64)(U32)x ) << 32 ) | (U32)y; }
+		static bool IsOversized( const Cells& cells );
+		static Cells CellsForObject( const DisplayObject& object );
+
+		void Insert( S32 entry, const Cells& cells );
+		void Remove( S32 entry, const Cells& cells );
+
+	private:
+		std::unordered_map< U64, std::vector< S32 > > fGrid;
+		std::unordered_map< const DisplayObject*, S32 > fEntries;
+		std::vector< Cells > fCells; // Indexed by entry; unused for group markers
+		std::vector< S32 > fOversized;
+		mutable std::vector< S32 > fCandidates;
+		const RenderList *fList;
+		U32 fGeneration;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_SpatialIndex_H__
@@ -32,7 +32,9 @@ StageObject::StageObject( Rtt_Allocator* pAllocator, Scene& owner )
 	fNext( NULL ),
 	fFocus( NULL ),
 	fFocusObjects( pAllocator ),
-	fSnapshotBounds( NULL )
+	fSnapshotBounds( NULL ),
+	fRenderList( pAllocator ),
+	fHitTestIndex()
 {
     SetObjectDesc("StageObject"); // for introspection
 }
@@ -55,6 +57,40 @@ StageObject::InvalidateDisplay()
 	fOwner.Invalidate();
 }
 
+const RenderList&
+StageObject::GetRenderList()
+{
+	if ( ! fRenderList.IsValid() )
+	{
+		fRenderList.Build( * this );
+	}
+
+	return fRenderList;
+}
+
+const SpatialIndex&
+StageObject::GetHitTestIndex()
+{
+	const RenderList& list = GetRenderList();
+
+	if ( ! fHitTestIndex.IsBuiltFrom( list ) )
+	{
+		fHitTestIndex.Build( list );
+	}
+
+	return fHitTestIndex;
+}
+
+void
+StageObject::UpdateHitTestIndex( const DisplayObject& object )
+{
+	// Once the hierarchy changes, the index is rebuilt on next use instead
+	if ( fHitTestIndex.IsBuiltFrom( fRenderList ) )
+	{
+		fHitTestIndex.Update( object );
+	}
+}
+
 const LuaProxyVTable&
 StageObject::ProxyVTable() const
 {
@@ -12,6 +12,8 @@
 
 #include "Core/Rtt_Types.h"
 #include "Display/Rtt_GroupObject.h"
+#include "Display/Rtt_RenderList.h"
+#include "Display/Rtt_SpatialIndex.h"
 
 // ----------------------------------------------------------------------------
 
@@ -61,6 +63,16 @@ class StageObject : public GroupObject
 		void SetFocus( DisplayObject *newValue, const void *focusId );
 		DisplayObject* GetFocus( const void *focusId );
 
+	public:
+		// The hierarchy as a flattened list, only rebuilt when children are
+		// added, removed or reordered
+		void InvalidateRenderList() { fRenderList.Invalidate(); }
+		const RenderList& GetRenderList();
+
+		// Spatial index over the render list, built on first use by hit testing
+		const SpatialIndex& GetHitTestIndex();
+		void UpdateHitTestIndex( const DisplayObject& object );
+
 	public:
 		const Rect *GetSnapshotBounds() const { return fSnapshotBounds; }
 		void SetSnapshotBounds( const Rect *r ) { fSnapshotBounds = r; }
@@ -73,6 +85,8 @@ class StageObject : public GroupObject
 		DisplayObject* fFocus; // Does not own
 		LightPtrArray< DisplayObject > fFocusObjects; // Use light array b/c we don't own
 		const Rect *fSnapshotBounds;
+		RenderList fRenderList;
+		SpatialIndex fHitTestIndex;
 };
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,588 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_TextureAtlas.h"
+
+#include "Display/Rtt_BufferBitmap.h"
+#include "Display/Rtt_Display.h"
+#include "Display/Rtt_TextureFactory.h"
+#include "Display/Rtt_TextureResource.h"
+#include "Display/Rtt_TextureResourceBitmap.h"
+#include "Renderer/Rtt_Texture.h"
+#include "Core/Rtt_Math.h"
+
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+TextureAtlasRegion::TextureAtlasRegion( TextureAtlasPage& page, S32 x, S32 y, S32 w, S32 h )
+:	fPage( page ),
+	fX( x ),
+	fY( y ),
+	fWidth( w ),
+	fHeight( h )
+{
+}
+
+Texture&
+TextureAtlasRegion::GetTexture() const
+{
+	return fPage.GetTexture();
+}
+
+void
+TextureAtlasRegion::MapTexCoords( ArrayVertex2& vertices ) const
+{
+	const S32 kPadding = TextureAtlasPage::kPadding;
+	const Real kInvSize = Rtt_REAL_1 / TextureAtlasPage::kSize;
+
+	Real u0 = ( fX + kPadding ) * kInvSize;
+	Real v0 = ( fY + kPadding ) * kInvSize;
+	Real du = ( fWidth - 2 * kPadding ) * kInvSize;
+	Real dv = ( fHeight - 2 * kPadding ) * kInvSize;
+
+	Vertex2 *v = vertices.WriteAccess();
+	for ( S32 i = 0, iMax = vertices.Length(); i < iMax; i++ )
+	{
+		v[i].x = u0 + v[i].x * du;
+		v[i].y = v0 + v[i].y * dv;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+TextureAtlasPage::TextureAtlasPage( TextureFactory& factory, const PlatformBitmap& prototype )
+:	fResource(),
+	fBitmap( Rtt_NEW( factory.GetDisplay().GetAllocator(),
+		BufferBitmap( factory.GetDisplay().GetAllocator(), kSize, kSize, prototype.GetFormat() ) ) ),
+	fSkyline(),
+	fFreeRects(),
+	fNumRegions( 0 ),
+	fIsDirty( false )
+{
+	fBitmap->SetMagFilter( prototype.GetMagFilter() );
+	fBitmap->SetMinFilter( prototype.GetMinFilter() );
+	fBitmap->SetWrapX( prototype.GetWrapX() );
+	fBitmap->SetWrapY( prototype.GetWrapY() );
+	fBitmap->SetProperty( PlatformBitmap::kIsPremultiplied, prototype.IsPremultiplied() );
+
+	// The resource takes ownership of the bitmap
+	fResource = SharedPtr< TextureResource >( TextureResourceBitmap::Create( factory, fBitmap ) );
+
+	Segment s = { 0, 0, kSize };
+	fSkyline.push_back( s );
+}
+
+bool
+TextureAtlasPage::IsCompatible( const PlatformBitmap& bitmap ) const
+{
+	return bitmap.GetFormat() == fBitmap->GetFormat()
+		&& bitmap.GetMagFilter() == fBitmap->GetMagFilter()
+		&& bitmap.GetMinFilter() == fBitmap->GetMinFilter()
+		&& bitmap.IsPremultiplied() == fBitmap->IsPremultiplied();
+}
+
+Texture&
+TextureAtlasPage::GetTexture() const
+{
+	return fResource->GetTexture();
+}
+
+TextureAtlasRegion *
+TextureAtlasPage::Insert( Rtt_Allocator *allocator, const PlatformBitmap& bitmap )
+{
+	S32 w = bitmap.Width() + 2 * kPadding;
+	S32 h = bitmap.Height() + 2 * kPadding;
+
+	Rect rect;
+	if ( ! FindFree( w, h, rect ) )
+	{
+		if ( ! FindSkyline( w, h, rect ) )
+		{
+			return NULL;
+		}
+		AddSkyline( rect );
+	}
+
+	if ( ! Copy( bitmap, rect.x, rect.y ) )
+	{
+		// Give the area back, as if an image had been removed from it
+		fFreeRects.push_back( rect );
+		Coalesce();
+		return NULL;
+	}
+	++fNumRegions;
+
+	return Rtt_NEW( allocator, TextureAtlasRegion( * this, rect.x, rect.y, w, h ) );
+}
+
+void
+TextureAtlasPage::Remove( TextureAtlasRegion *region )
+{
+	Rtt_ASSERT( & region->GetPage() == this );
+	Rtt_ASSERT( fNumRegions > 0 );
+
+	Rect rect = { region->GetX(), region->GetY(), region->GetWidth(), region->GetHeight() };
+	fFreeRects.push_back( rect );
+	--fNumRegions;
+
+	Coalesce();
+}
+
+void
+TextureAtlasPage::Update()
+{
+	if ( fIsDirty )
+	{
+		GetTexture().Invalidate();
+		fIsDirty = false;
+	}
+}
+
+bool
+TextureAtlasPage::FindFree( S32 w, S32 h, Rect& result )
+{
+	// Smallest released area the image fits in
+	S32 best = -1;
+	for ( size_t i = 0, iMax = fFreeRects.size(); i < iMax; i++ )
+	{
+		const Rect& r = fFreeRects[i];
+		if ( r.w >= w && r.h >= h
+			&& ( best < 0 || r.w * r.h < fFreeRects[best].w * fFreeRects[best].h ) )
+		{
+			best = (S32)i;
+		}
+	}
+
+	if ( best < 0 )
+	{
+		return false;
+	}
+
+	Rect r = fFreeRects[best];
+	fFreeRects.erase( fFreeRects.begin() + best );
+
+	result.x = r.x;
+	result.y = r.y;
+	result.w = w;
+	result.h = h;
+
+	// Return what's left of the area, split along its longer leftover side
+	Rect right = { r.x + w, r.y, r.w - w, h };
+	Rect below = { r.x, r.y + h, r.w, r.h - h };
+	if ( r.w - w > r.h - h )
+	{
+		right.h = r.h;
+		below.w = w;
+	}
+
+	if ( right.w > 0 && right.h > 0 ) { fFreeRects.push_back( right ); }
+	if ( below.w > 0 && below.h > 0 ) { fFreeRects.push_back( below ); }
+
+	return true;
+}
+
+bool
+TextureAtlasPage::FindSkyline( S32 w, S32 h, Rect& result )
+{
+	S32 bestY = kSize;
+	S32 bestX = -1;
+
+	for ( size_t i = 0, iMax = fSkyline.size(); i < iMax; i++ )
+	{
+		S32 x = fSkyline[i].x;
+		if ( x + w > kSize )
+		{
+			break;
+		}
+
+		// Lowest position the image rests on, spanning segments i, i+1, ...
+		S32 y = 0;
+		S32 remaining = w;
+		for ( size_t j = i; remaining > 0 && j < iMax; j++ )
+		{
+			y = Max( y, fSkyline[j].y );
+			remaining -= fSkyline[j].w;
+		}
+
+		if ( y + h <= kSize && y < bestY )
+		{
+			bestY = y;
+			bestX = x;
+		}
+	}
+
+	if ( bestX < 0 )
+	{
+		return false;
+	}
+
+	result.x = bestX;
+	result.y = bestY;
+	result.w = w;
+	result.h = h;
+
+	return true;
+}
+
+void
+TextureAtlasPage::AddSkyline( const Rect& rect )
+{
+	size_t index = 0;
+	while ( fSkyline[index].x != rect.x )
+	{
+		++index;
+	}
+
+	// The image rests on the highest segment it spans. The gaps left below
+	// it over lower segments are free areas, too.
+	S32 right = rect.x + rect.w;
+	for ( size_t i = index, iMax = fSkyline.size(); i < iMax && fSkyline[i].x < right; i++ )
+	{
+		const Segment& covered = fSkyline[i];
+		if ( covered.y < rect.y )
+		{
+			Rect gap = { covered.x, covered.y, Min( covered.x + covered.w, right ) - covered.x, rect.y - covered.y };
+			fFreeRects.push_back( gap );
+		}
+	}
+
+	Segment s = { rect.x, rect.y + rect.h, rect.w };
+	fSkyline.insert( fSkyline.begin() + index, s );
+
+	// Trim the segments now covered by the new one
+	for ( size_t i = index + 1; i < fSkyline.size(); )
+	{
+		Segment& next = fSkyline[i];
+		if ( next.x >= right )
+		{
+			break;
+		}
+
+		S32 overlap = right - next.x;
+		if ( overlap >= next.w )
+		{
+			fSkyline.erase( fSkyline.begin() + i );
+		}
+		else
+		{
+			next.x += overlap;
+			next.w -= overlap;
+			break;
+		}
+	}
+
+	MergeSkyline();
+}
+
+void
+TextureAtlasPage::MergeSkyline()
+{
+	// Merge neighbors at the same height
+	for ( size_t i = 0; i + 1 < fSkyline.size(); )
+	{
+		if ( fSkyline[i].y == fSkyline[i + 1].y )
+		{
+			fSkyline[i].w += fSkyline[i + 1].w;
+			fSkyline.erase( fSkyline.begin() + i + 1 );
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void
+TextureAtlasPage::Coalesce()
+{
+	bool isChanged = true;
+	while ( isChanged )
+	{
+		isChanged = MergeFree();
+
+		for ( size_t i = 0; i < fFreeRects.size(); )
+		{
+			if ( ReturnToSkyline( fFreeRects[i] ) )
+			{
+				fFreeRects.erase( fFreeRects.begin() + i );
+				isChanged = true;
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+}
+
+// Merges pairs of free areas that share a whole edge. Returns true if any were.
+bool
+TextureAtlasPage::MergeFree()
+{
+	bool result = false;
+
+	for ( size_t i = 0; i < fFreeRects.size(); i++ )
+	{
+		for ( size_t j = i + 1; j < fFreeRects.size(); )
+		{
+			Rect& a = fFreeRects[i];
+			const Rect& b = fFreeRects[j];
+
+			bool isMerged = true;
+			if ( a.x == b.x && a.w == b.w && ( a.y + a.h == b.y || b.y + b.h == a.y ) )
+			{
+				a.y = Min( a.y, b.y );
+				a.h += b.h;
+			}
+			else if ( a.y == b.y && a.h == b.h && ( a.x + a.w == b.x || b.x + b.w == a.x ) )
+			{
+				a.x = Min( a.x, b.x );
+				a.w += b.w;
+			}
+			else
+			{
+				isMerged = false;
+			}
+
+			if ( isMerged )
+			{
+				fFreeRects.erase( fFreeRects.begin() + j );
+				result = true;
+
+				// 'a' grew, so earlier areas may now share an edge with it
+				j = i + 1;
+			}
+			else
+			{
+				++j;
+			}
+		}
+	}
+
+	return result;
+}
+
+// Lowers the skyline over 'rect' to its top if the skyline rests right on it
+// across its whole width, i.e. nothing was placed above it.
+bool
+TextureAtlasPage::ReturnToSkyline( const Rect& rect )
+{
+	const S32 left = rect.x;
+	const S32 right = rect.x + rect.w;
+	const S32 top = rect.y + rect.h;
+
+	for ( size_t i = 0, iMax = fSkyline.size(); i < iMax; i++ )
+	{
+		const Segment& s = fSkyline[i];
+		if ( s.x < right && s.x + s.w > left && s.y != top )
+		{
+			return false;
+		}
+	}
+
+	std::vector< Segment > skyline;
+	skyline.reserve( fSkyline.size() + 2 );
+
+	for ( size_t i = 0, iMax = fSkyline.size(); i < iMax; i++ )
+	{
+		const Segment& s = fSkyline[i];
+		const S32 sRight = s.x + s.w;
+		if ( sRight <= left || s.x >= right )
+		{
+			skyline.push_back( s );
+			continue;
+		}
+
+		if ( s.x < left )
+		{
+			Segment before = { s.x, s.y, left - s.x };
+			skyline.push_back( before );
+		}
+
+		S32 x0 = Max( s.x, left );
+		Segment lowered = { x0, rect.y, Min( sRight, right ) - x0 };
+		skyline.push_back( lowered );
+
+		if ( sRight > right )
+		{
+			Segment after = { right, s.y, sRight - right };
+			skyline.push_back( after );
+		}
+	}
+
+	fSkyline.swap( skyline );
+	MergeSkyline();
+
+	return true;
+}
+
+bool
+TextureAtlasPage::Copy( const PlatformBitmap& bitmap, S32 x, S32 y )
+{
+	const size_t bpp = PlatformBitmap::BytesPerPixel( bitmap.GetFormat() );
+	const S32 w = bitmap.Width();
+	const S32 h = bitmap.Height();
+
+	const U8 *src = (const U8 *)bitmap.GetBits( fResource->GetTextureFactory().GetDisplay().GetAllocator() );
+	U8 *dst = (U8 *)fBitmap->WriteAccess();
+	if ( ! src )
+	{
+		return false;
+	}
+
+	const size_t srcPitch = w * bpp;
+	const size_t dstPitch = kSize * bpp;
+
+	// Rows of the padding repeat the image's first and last rows. Likewise,
+	// within a row, for the first and last pixels.
+	for ( S32 row = -kPadding; row < h + kPadding; row++ )
+	{
+		const U8 *srcRow = src + Min( Max( row, 0 ), h - 1 ) * srcPitch;
+		U8 *dstRow = dst + ( y + kPadding + row ) * dstPitch + ( x + kPadding ) * bpp;
+
+		memcpy( dstRow, srcRow, srcPitch );
+		for ( S32 i = 1; i <= kPadding; i++ )
+		{
+			memcpy( dstRow - i * bpp, srcRow, bpp );
+			memcpy( dstRow + ( w - 1 + i ) * bpp, srcRow + ( w - 1 ) * bpp, bpp );
+		}
+	}
+
+	fIsDirty = true;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+
+TextureAtlas::TextureAtlas( TextureFactory& factory )
+:	fFactory( factory ),
+	fPages( factory.GetDisplay().GetAllocator() )
+{
+}
+
+bool
+TextureAtlas::Insert( TextureResource& resource, U32 maxSize )
+{
+	PlatformBitmap *bitmap = resource.GetBitmap();
+	if ( ! bitmap || resource.GetAtlasRegion() )
+	{
+		return false;
+	}
+
+	const U32 kMaxSize = TextureAtlasPage::kSize - 2 * TextureAtlasPage::kPadding;
+	U32 w = bitmap->Width();
+	U32 h = bitmap->Height();
+
+	// Pages are sampled with clamping, so images that wrap must keep their
+	// own texture. Other formats aren't uploaded as is, and compressed ones
+	// would take more memory decoded. Mip levels of a page would blend
+	// neighboring images, well beyond the padding.
+	PlatformBitmap::Format format = bitmap->GetFormat();
+	bool isEligible = w > 0 && h > 0
+		&& w <= maxSize && h <= maxSize
+		&& w <= kMaxSize && h <= kMaxSize
+		&& ( PlatformBitmap::kRGBA == format || PlatformBitmap::kBGRA == format || PlatformBitmap::kARGB == format )
+		&& RenderTypes::kClampToEdgeWrap == bitmap->GetWrapX()
+		&& RenderTypes::kClampToEdgeWrap == bitmap->GetWrapY()
+		&& RenderTypes::kTrilinearTextureFilter != bitmap->GetMinFilter()
+		&& RenderTypes::kTrilinearTextureFilter != bitmap->GetMagFilter()
+		&& Rtt_REAL_1 == bitmap->GetNormalizationScaleX()
+		&& Rtt_REAL_1 == bitmap->GetNormalizationScaleY()
+		&& ! bitmap->IsCompressed();
+
+	if ( ! isEligible )
+	{
+		return false;
+	}
+
+	Rtt_Allocator *allocator = fFactory.GetDisplay().GetAllocator();
+
+	// Without pixels, the image can only be drawn from its own texture
+	if ( ! bitmap->GetBits( allocator ) )
+	{
+		return false;
+	}
+
+	TextureAtlasRegion *region = NULL;
+	for ( S32 i = 0, iMax = fPages.Length(); i < iMax && ! region; i++ )
+	{
+		TextureAtlasPage *page = fPages[i];
+		if ( page->IsCompatible( * bitmap ) )
+		{
+			region = page->Insert( allocator, * bitmap );
+		}
+	}
+
+	if ( ! region )
+	{
+		TextureAtlasPage *page = Rtt_NEW( allocator, TextureAtlasPage( fFactory, * bitmap ) );
+
+		region = page->Insert( allocator, * bitmap );
+		if ( region )
+		{
+			fPages.Append( page );
+		}
+		else
+		{
+			Rtt_DELETE( page );
+			return false;
+		}
+	}
+
+	// Pixels are only needed again if the image is drawn from its own texture
+	bitmap->FreeBits();
+
+	resource.SetAtlasRegion( region );
+
+	return NULL != region;
+}
+
+void
+TextureAtlas::Remove( TextureAtlasRegion *region )
+{
+	TextureAtlasPage *page = & region->GetPage();
+	page->Remove( region );
+	Rtt_DELETE( region );
+
+	if ( page->IsEmpty() )
+	{
+		for ( S32 i = 0, iMax = fPages.Length(); i < iMax; i++ )
+		{
+			if ( fPages[i] == page )
+			{
+				fPages.Remove( i, 1 );
+				break;
+			}
+		}
+	}
+}
+
+void
+TextureAtlas::Update()
+{
+	for ( S32 i = 0, iMax = fPages.Length(); i < iMax; i++ )
+	{
+		fPages[i]->Update();
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
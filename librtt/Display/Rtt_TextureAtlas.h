@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_TextureAtlas_H__
+#define _Rtt_TextureAtlas_H__
+
+#include "Core/Rtt_Array.h"
+#include "Core/Rtt_SharedPtr.h"
+#include "Display/Rtt_PlatformBitmap.h"
+#include "Display/Rtt_DisplayTypes.h"
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+class BufferBitmap;
+class Texture;
+class TextureAtlasPage;
+class TextureFactory;
+class TextureResource;
+
+// ----------------------------------------------------------------------------
+
+// The area of a TextureAtlas page an image was copied to
+class TextureAtlasRegion
+{
+	public:
+		TextureAtlasRegion( TextureAtlasPage& page, S32 x, S32 y, S32 w, S32 h );
+
+	public:
+		Texture& GetTexture() const;
+
+		// Maps texture coordinates spanning the image, i.e. [0,1], to the
+		// corresponding ones of the page.
+		void MapTexCoords( ArrayVertex2& vertices ) const;
+
+		TextureAtlasPage& GetPage() const { return fPage; }
+
+		// Allocated area, including padding
+		S32 GetX() const { return fX; }
+		S32 GetY() const { return fY; }
+		S32 GetWidth() const { return fWidth; }
+		S32 GetHeight() const { return fHeight; }
+
+	private:
+		TextureAtlasPage& fPage;
+		S32 fX;
+		S32 fY;
+		S32 fWidth;
+		S32 fHeight;
+};
+
+// ----------------------------------------------------------------------------
+
+// A shared texture that small images are packed into. New images are placed
+// using a skyline (bottom-left) packer. Areas of released images are kept on
+// a free list and reused, so live images never move: paints cache their
+// texture coordinates. Free areas that share an edge are merged, and those
+// right below the skyline are given back to it, so a page does not fragment
+// into areas too small for any image.
+class TextureAtlasPage
+{
+	public:
+		typedef TextureAtlasPage Self;
+
+		static const S32 kSize = 1024;
+
+		// Each image is surrounded by a copy of its edge pixels, so that
+		// linear filtering never picks up texels of a neighbor.
+		static const S32 kPadding = 1;
+
+	public:
+		TextureAtlasPage( TextureFactory& factory, const PlatformBitmap& prototype );
+
+	public:
+		// Pages only hold images with the same format and sampling state
+		bool IsCompatible( const PlatformBitmap& bitmap ) const;
+
+		// Copies the bitmap's pixels to a free area of the page. Returns NULL
+		// if the page is full, or the bitmap's pixels can't be read.
+		TextureAtlasRegion *Insert( Rtt_Allocator *allocator, const PlatformBitmap& bitmap );
+		void Remove( TextureAtlasRegion *region );
+
+		bool IsEmpty() const { return 0 == fNumRegions; }
+		Texture& GetTexture() const;
+
+		// Queues a single upload of the images inserted since the last call
+		void Update();
+
+	private:
+		struct Rect
+		{
+			S32 x, y, w, h;
+		};
+
+		struct Segment
+		{
+			S32 x, y, w;
+		};
+
+		bool FindFree( S32 w, S32 h, Rect& result );
+		bool FindSkyline( S32 w, S32 h, Rect& result );
+		void AddSkyline( const Rect& rect );
+		void MergeSkyline();
+		void Coalesce();
+		bool MergeFree();
+		bool ReturnToSkyline( const Rect& rect );
+		bool Copy( const PlatformBitmap& bitmap, S32 x, S32 y );
+
+	private:
+		SharedPtr< TextureResource > fResource;
+		BufferBitmap *fBitmap; // Owned by fResource
+		std::vector< Segment > fSkyline;
+		std::vector< Rect > fFreeRects;
+		S32 fNumRegions;
+		bool fIsDirty;
+};
+
+// ----------------------------------------------------------------------------
+
+// Packs loose images (see TextureFactory::AddToAtlas()) into shared pages, so
+// that objects drawn with different images can still be batched.
+class TextureAtlas
+{
+	public:
+		typedef TextureAtlas Self;
+
+	public:
+		TextureAtlas( TextureFactory& factory );
+
+	public:
+		// Copies the bitmap of 'resource' into a page if it's no larger than
+		// 'maxSize' pixels in either dimension and can be sampled from a page
+		// (clamped, 4 bytes per pixel, not scaled). On success, the resource's
+		// atlas region is set.
+		bool Insert( TextureResource& resource, U32 maxSize );
+
+		// Releases the region of a resource that is being destroyed. Empty
+		// pages are evicted.
+		void Remove( TextureAtlasRegion *region );
+
+		// Called once per frame, see TextureAtlasPage::Update()
+		void Update();
+
+		S32 GetNumPages() const { return fPages.Length(); }
+
+	private:
+		TextureFactory& fFactory;
+		PtrArray< TextureAtlasPage > fPages;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_TextureAtlas_H__
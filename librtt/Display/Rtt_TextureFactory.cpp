@@ -10,11 +10,15 @@
 #include "Core/Rtt_Build.h"
 
 #include "Core/Rtt_String.h"
+#include "Core/Rtt_Time.h"
 #include "Display/Rtt_BufferBitmap.h"
 #include "Display/Rtt_Display.h"
 #include "Display/Rtt_DisplayDefaults.h"
+#include "Display/Rtt_KTXBitmap.h"
 #include "Display/Rtt_PlatformBitmap.h"
+#include "Display/Rtt_PlatformBitmapTexture.h"
 #include "Display/Rtt_Scene.h"
+#include "Display/Rtt_TextureAtlas.h"
 #include "Display/Rtt_TextureFactory.h"
 #include "Display/Rtt_TextureResource.h"
 #include "Renderer/Rtt_Renderer.h"
@@ -23,9 +27,12 @@
 #include "Display/Rtt_TextureResourceCanvas.h"
 #include "Display/Rtt_TextureResourceExternal.h"
 
+#include "Rtt_Event.h"
 #include "Rtt_FilePath.h"
+#include "Rtt_LuaResource.h"
 #include "Rtt_MPlatform.h"
 #include "Rtt_Runtime.h"
+#include "Rtt_Scheduler.h"
 #include "CoronaLua.h"
 
 // ----------------------------------------------------------------------------
@@ -40,14 +47,23 @@ TextureFactory::TextureFactory( Display& display )
 	fDisplay( display ),
 	fDefault(),
 	fContainerMask(),
+	fAtlas( NULL ),
 	fTextureMemoryUsed( 0 ),
-	fPreloadQueue( display.GetAllocator() )
+	fPreloadQueue( display.GetAllocator() ),
+	fUploadQueue( display.GetAllocator() )
 {
+	fAtlas = Rtt_NEW( display.GetAllocator(), TextureAtlas( * this ) );
 }
 
 TextureFactory::~TextureFactory()
 {
 	fPreloadQueue.Empty();
+	fUploadQueue.Empty();
+
+	// Pages release their textures through WillRemoveTexture()
+	TextureAtlas *atlas = fAtlas;
+	fAtlas = NULL;
+	Rtt_DELETE( atlas );
 }
 
 void
@@ -84,7 +100,19 @@ TextureFactory::CreateBitmap(
 	// Load the given image file.
 	const Display& display = fDisplay;
 	const MPlatform& platform = display.GetRuntime().Platform();
-	PlatformBitmap* pBitmap = platform.CreateBitmap( filePath, convertToGrayscale );
+	PlatformBitmap* pBitmap = NULL;
+
+	// GPU-compressed images are read directly when the path is a plain file.
+	// Platforms resolve packaged ones (e.g. APK assets) in CreateBitmap().
+	if ( ! convertToGrayscale && KTXBitmap::IsKTXFile( filePath ) )
+	{
+		pBitmap = KTXBitmap::Create( display.GetAllocator(), filePath );
+	}
+
+	if ( ! pBitmap )
+	{
+		pBitmap = platform.CreateBitmap( filePath, convertToGrayscale );
+	}
 	if (!pBitmap)
 	{
 		return NULL;
@@ -196,7 +224,9 @@ TextureFactory::Preload( Renderer& renderer )
 			{
 				Texture &tex = texResource->GetTexture();
 				GPUResource *gpuResource = tex.GetGPUResource();
-				if ( NULL == gpuResource )
+
+				// Atlased images are drawn from their page instead
+				if ( NULL == gpuResource && ! texResource->GetAtlasRegion() )
 				{
 					renderer.QueueCreate( & tex );
 				}
@@ -204,6 +234,105 @@ TextureFactory::Preload( Renderer& renderer )
 		}
 	}
 	fPreloadQueue.Empty();
+
+	fAtlas->Update();
+
+	UploadPending( renderer );
+}
+
+bool
+TextureFactory::AddToAtlas( const SharedPtr< TextureResource >& resource )
+{
+	U32 maxSize = fDisplay.GetDefaults().GetImageAtlasMaxSize();
+	if ( 0 == maxSize || ! fAtlas || resource.IsNull() )
+	{
+		return false;
+	}
+
+	// Async images are uploaded by UploadPending() once decoded
+	if ( TextureResource::kTextureResourceBitmap != resource->GetType()
+		 || IsLoading( resource->GetCacheKey() ) )
+	{
+		return false;
+	}
+
+	const PlatformBitmap *bitmap = resource->GetBitmap();
+	if ( ! bitmap || bitmap->IsMask() )
+	{
+		return false;
+	}
+
+	return fAtlas->Insert( * resource, maxSize );
+}
+
+void
+TextureFactory::QueueUpload( const SharedPtr< TextureResource >& resource )
+{
+	fUploadQueue.Append( resource );
+}
+
+// Uploads decoded async textures in order, stopping once either per-frame
+// budget is exhausted. At least one texture goes through every frame so a
+// single oversized image cannot stall the queue.
+void
+TextureFactory::UploadPending( Renderer& renderer )
+{
+	if ( fUploadQueue.Length() <= 0 )
+	{
+		return;
+	}
+
+	const DisplayDefaults& defaults = fDisplay.GetDefaults();
+	const size_t maxBytes = defaults.GetTextureUploadBytesPerFrame();
+	const U32 maxTime = defaults.GetTextureUploadTimePerFrame();
+
+	const Rtt_AbsoluteTime start = Rtt_GetAbsoluteTime();
+	size_t numBytes = 0;
+	int numUploaded = 0;
+
+	int i = 0;
+	for ( int iMax = fUploadQueue.Length(); i < iMax; i++ )
+	{
+		SharedPtr< TextureResource > texture( fUploadQueue[i] );
+		if ( texture.IsNull() )
+		{
+			continue;
+		}
+
+		PlatformBitmapTexture& tex = static_cast< PlatformBitmapTexture& >( texture->GetTexture() );
+		const size_t texBytes = tex.GetSizeInBytes();
+		if ( numUploaded > 0
+			 && ( numBytes + texBytes > maxBytes
+				  || Rtt_AbsoluteToMicroseconds( Rtt_GetAbsoluteTime() - start ) >= maxTime ) )
+		{
+			break;
+		}
+
+		tex.SetPending( false );
+		fAsyncLoads.erase( texture->GetCacheKey() );
+
+		// Bitmaps that could not be decoded on a worker thread decode here,
+		// so the time budget accounts for them.
+		tex.GetData();
+
+		// The placeholder may already be on the GPU if it was drawn while pending
+		if ( NULL == tex.GetGPUResource() )
+		{
+			renderer.QueueCreate( & tex );
+		}
+		else
+		{
+			renderer.QueueUpdate( & tex );
+		}
+
+		numBytes += texBytes;
+		++numUploaded;
+	}
+
+	if ( i > 0 )
+	{
+		fUploadQueue.Remove( 0, i );
+	}
 }
 
 SharedPtr< TextureResource >
@@ -256,6 +385,161 @@ TextureFactory::FindOrCreate(
 	return FindOrCreate( filePath.GetFilename(), filePath.GetBaseDir(), flags, isMask );
 }
 
+// ----------------------------------------------------------------------------
+
+// Decodes the bitmap of an async texture off the main thread, then queues it
+// for upload and notifies the listener.
+class TextureLoadTask : public AsyncTask
+{
+	public:
+		TextureLoadTask( Rtt_Allocator *allocator, const SharedPtr< TextureResource >& resource, const char *filename, LuaResource *listener )
+		:	fAllocator( allocator ),
+			fResource( resource ),
+			fFilename( filename ),
+			fListener( listener )
+		{
+		}
+
+		virtual ~TextureLoadTask()
+		{
+			Rtt_DELETE( fListener );
+		}
+
+	public:
+		virtual void RunInBackground()
+		{
+			const PlatformBitmapTexture& tex = static_cast< const PlatformBitmapTexture& >( fResource->GetTexture() );
+			const PlatformBitmap& bitmap = tex.GetBitmap();
+			if ( bitmap.CanDecodeInBackground() )
+			{
+				bitmap.GetBits( fAllocator );
+			}
+		}
+
+		virtual void operator()( Scheduler& sender )
+		{
+			fResource->GetTextureFactory().QueueUpload( fResource );
+
+			if ( fListener )
+			{
+				TextureLoadEvent e( fFilename.c_str(), & (*fResource) );
+				fListener->DispatchEvent( e );
+			}
+		}
+
+	private:
+		Rtt_Allocator *fAllocator;
+		SharedPtr< TextureResource > fResource;
+		std::string fFilename;
+		LuaResource *fListener;
+};
+
+// Notifies the listener of an async request that was satisfied by the cache,
+// waiting for an in-flight load of the same image if there is one.
+class TextureLoadNotifyTask : public Task
+{
+	public:
+		TextureLoadNotifyTask( const SharedPtr< TextureResource >& resource, const char *filename, LuaResource *listener )
+		:	Task( true ),
+			fResource( resource ),
+			fFilename( filename ),
+			fListener( listener )
+		{
+		}
+
+		virtual ~TextureLoadNotifyTask()
+		{
+			Rtt_DELETE( fListener );
+		}
+
+	public:
+		virtual void operator()( Scheduler& sender )
+		{
+			// The Scheduler checks keep-alive before running, so this runs
+			// once more after the event has been dispatched
+			if ( ! getKeepAlive() )
+			{
+				return;
+			}
+
+			TextureResource *resource = NULL;
+			if ( fResource.NotNull() )
+			{
+				resource = & (*fResource);
+				if ( resource->GetTextureFactory().IsLoading( resource->GetCacheKey() ) )
+				{
+					return;
+				}
+			}
+
+			TextureLoadEvent e( fFilename.c_str(), resource );
+			fListener->DispatchEvent( e );
+			setKeepAlive( false );
+		}
+
+	private:
+		SharedPtr< TextureResource > fResource;
+		std::string fFilename;
+		LuaResource *fListener;
+};
+
+SharedPtr< TextureResource >
+TextureFactory::FindOrCreateAsync(
+	const char *filename,
+	MPlatform::Directory baseDir,
+	U32 flags,
+	bool isMask,
+	LuaResource *listener )
+{
+	Rtt_Allocator *allocator = fDisplay.GetAllocator();
+	Scheduler& scheduler = fDisplay.GetRuntime().GetScheduler();
+
+	SharedPtr< TextureResource > result;
+
+	String filePath( allocator );
+	if ( MPlatform::kVirtualTexturesDir == baseDir )
+	{
+		// Virtual textures can come only from Cache.
+		result = Find( filename );
+	}
+	else
+	{
+		PathForFile( filePath, filename, baseDir );
+		if ( filePath.IsEmpty() )
+		{
+			CoronaLuaWarning( fDisplay.GetL(), "Failed to find image '%s'", filename );
+		}
+		else
+		{
+			std::string key( filePath.GetString() );
+			result = Find( key );
+
+			PlatformBitmap *bitmap = NULL;
+			if ( result.IsNull() && NULL != ( bitmap = CreateBitmap( filePath.GetString(), flags, isMask ) ) )
+			{
+				// Bypass the preload queue; UploadPending() creates the texture once decoded
+				result = SharedPtr< TextureResource >( TextureResourceBitmap::Create( * this, bitmap ) );
+				fCache[key] = CacheEntry( result );
+				result->SetCacheKey( key );
+
+				static_cast< PlatformBitmapTexture& >( result->GetTexture() ).SetPending( true );
+				fAsyncLoads.insert( key );
+
+				scheduler.AppendAsync( Rtt_NEW( allocator, TextureLoadTask( allocator, result, filename, listener ) ) );
+				return result;
+			}
+		}
+	}
+
+	// Cache hit or failure. Either way, the listener hears back asynchronously.
+	if ( listener )
+	{
+		scheduler.Append( Rtt_NEW( allocator, TextureLoadNotifyTask( result, filename, listener ) ) );
+	}
+
+	return result;
+}
+
 SharedPtr< TextureResource >
 TextureFactory::FindOrCreate(
 	PlatformBitmap *bitmap,
@@ -422,6 +706,20 @@ TextureFactory::DidAddTexture( const TextureResource& resource )
 void
 TextureFactory::WillRemoveTexture( const TextureResource& resource )
 {
+	TextureAtlasRegion *region = resource.GetAtlasRegion();
+	if ( region )
+	{
+		if ( fAtlas )
+		{
+			fAtlas->Remove( region );
+		}
+		else
+		{
+			// The atlas, and so the region's page, is already gone
+			Rtt_DELETE( region );
+		}
+	}
+
 	// Only count images from application towards total texture memory count.
 	// In the Corona simulator, we may remove images
 	// which should *not* count towards the total.
@@ -433,6 +731,11 @@ TextureFactory::WillRemoveTexture( const TextureResource& resource )
 		fTextureMemoryUsed -= numTextureBytes;
 		Rtt_ASSERT( fTextureMemoryUsed >= 0 );
 	}
+
+	if ( ! fAsyncLoads.empty() )
+	{
+		fAsyncLoads.erase( resource.GetCacheKey() );
+	}
 }
 
 
@@ -30,6 +30,8 @@ namespace Rtt
 
 class Display;
 class FilePath;
+class LuaResource;
+class TextureAtlas;
 class TextureResource;
 
 // ----------------------------------------------------------------------------
@@ -81,6 +83,31 @@ class TextureFactory
 			const CoronaExternalTextureCallbacks* callbacks,
 			void* context);
 
+	// Asynchronously loaded texture resources
+	public:
+		// Returns immediately with a resource that draws as a transparent 1x1
+		// placeholder. The image is decoded on a worker thread (if the platform
+		// bitmap supports it) and uploaded from Preload() within the per-frame
+		// budget in DisplayDefaults. Cached like FindOrCreate(). Takes ownership
+		// of 'listener', which may be NULL.
+		SharedPtr< TextureResource > FindOrCreateAsync(
+			const char *filename,
+			MPlatform::Directory baseDir,
+			U32 flags,
+			bool isMask,
+			LuaResource *listener );
+
+		void QueueUpload( const SharedPtr< TextureResource >& resource );
+		bool IsLoading( const std::string& key ) const { return fAsyncLoads.count( key ) > 0; }
+
+		// Copies small images into a shared atlas page, so that objects
+		// drawn with them can be batched. See DisplayDefaults::GetImageAtlasMaxSize().
+		bool AddToAtlas( const SharedPtr< TextureResource >& resource );
+		const TextureAtlas *GetAtlas() const { return fAtlas; }
+
+	protected:
+		void UploadPending( Renderer& renderer );
+
 
 	// One-off texture resources
 	public:
@@ -153,9 +180,12 @@ class TextureFactory
 	private:
 		Cache fCache;
 		Array< WeakPtr< TextureResource > > fPreloadQueue;
+		Array< WeakPtr< TextureResource > > fUploadQueue;
+		TextureKeySet fAsyncLoads; // Keys of async textures not yet uploaded
 		Display &fDisplay;
 		WeakPtr< TextureResource > fDefault;
 		WeakPtr< TextureResource > fContainerMask;
+		TextureAtlas *fAtlas;
 		
 		S32 fTextureMemoryUsed;
 		
@@ -27,6 +27,7 @@ TextureResource::TextureResource(TextureFactory &factory, Texture *texture,  Pla
 	, fBitmap(bitmap)
 	, fType(type)
 	, fProxy(NULL)
+	, fAtlasRegion(NULL)
 {
 	if (fTexture)
 	{
@@ -27,6 +27,7 @@ class MLuaUserdataAdapter;
 class LuaUserdataProxy;
 class TextureFactory;
 class PlatformBitmap;
+class TextureAtlasRegion;
 // ----------------------------------------------------------------------------
 
 class TextureResource
@@ -81,6 +82,10 @@ class TextureResource
 	
 		void SetCacheKey( const std::string & cacheKey ) {fCacheKey = cacheKey;}
 		void ReleaseSelfFromFactoryOwnership();
+
+		// Non-NULL if the bitmap was also copied to a TextureAtlas page
+		TextureAtlasRegion *GetAtlasRegion() const { return fAtlasRegion; }
+		void SetAtlasRegion( TextureAtlasRegion *newValue ) { fAtlasRegion = newValue; }
 	
 	private:
 		virtual const MLuaUserdataAdapter& GetAdapter() const = 0;
@@ -92,6 +97,7 @@ class TextureResource
 		PlatformBitmap *fBitmap;
 		TextureResourceType fType;
 		mutable LuaUserdataProxy *fProxy;
+		TextureAtlasRegion *fAtlasRegion;
 };
 
 // ----------------------------------------------------------------------------
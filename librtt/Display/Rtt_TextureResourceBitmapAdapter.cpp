@@ -28,9 +28,11 @@ TextureResourceBitmapAdapter::GetHash( lua_State *L ) const
 	{
 		"wrapX",              //0
 		"wrapY",              //1
+		"minFilter",          //2
+		"magFilter",          //3
 	};
 	
-	static StringHash sHash( *LuaContext::GetAllocator( L ), keys, sizeof( keys ) / sizeof( const char * ), 2, 1, 1, __FILE__, __LINE__ );
+	static StringHash sHash( *LuaContext::GetAllocator( L ), keys, sizeof( keys ) / sizeof( const char * ), 4, 1, 1, __FILE__, __LINE__ );
 	return &sHash;
 }
 
@@ -70,6 +72,24 @@ TextureResourceBitmapAdapter::ValueForKey(
 					results = 1;
 				} // else return nothing - no texture was loaded yet.
 				break;
+
+			case 2:
+				if( entry->GetBitmap() )
+				{
+					RenderTypes::TextureFilter filter = entry->GetBitmap()->GetMinFilter();
+					lua_pushstring( L, RenderTypes::StringForTextureFilter( filter ) );
+					results = 1;
+				} // else return nothing - no texture was loaded yet.
+				break;
+
+			case 3:
+				if( entry->GetBitmap() )
+				{
+					RenderTypes::TextureFilter filter = entry->GetBitmap()->GetMagFilter();
+					lua_pushstring( L, RenderTypes::StringForTextureFilter( filter ) );
+					results = 1;
+				} // else return nothing - no texture was loaded yet.
+				break;
 				
 			default:
 				Rtt_ASSERT_NOT_REACHED();
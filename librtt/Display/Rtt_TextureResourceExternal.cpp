@@ -28,10 +28,11 @@ class ExternalBitmap : public PlatformBitmap
 {
 public:
 	ExternalBitmap(const CoronaExternalTextureCallbacks* sourceCallbacks, void* context)
-	: fSrc(*sourceCallbacks)
-	, fContext(context)
+	: fContext(context)
 	{
-		
+		// Older plugins pass a shorter structure; callbacks it lacks stay NULL
+		memset(&fSrc, 0, sizeof(fSrc));
+		memcpy(&fSrc, sourceCallbacks, Min((size_t)sourceCallbacks->size, sizeof(fSrc)));
 	}
 	
 	void Finalize()
@@ -70,6 +71,32 @@ public:
 		}
 	}
 	
+	virtual U32 GetDirtyRects( Texture::DirtyRect* rects, U32 maxRects ) const override
+	{
+		U32 result = 0;
+		if ( fSrc.getDirtyRects )
+		{
+			// Same layout, but don't rely on it
+			CoronaExternalTextureRect srcRects[Texture::kMaxDirtyRects];
+			maxRects = Min( maxRects, Texture::kMaxDirtyRects );
+
+			result = fSrc.getDirtyRects(srcRects, maxRects, GetUserData());
+			if ( result > maxRects )
+			{
+				result = 0;
+			}
+
+			for ( U32 i = 0; i < result; i++ )
+			{
+				rects[i].x = srcRects[i].x;
+				rects[i].y = srcRects[i].y;
+				rects[i].width = srcRects[i].width;
+				rects[i].height = srcRects[i].height;
+			}
+		}
+		return result;
+	}
+	
 	virtual U32 Width() const override
 	{
 		if(fSrc.getWidth)
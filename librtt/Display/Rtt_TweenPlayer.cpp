@@ -0,0 +1,612 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_TweenPlayer.h"
+
+#include "Core/Rtt_SharedPtr.h"
+#include "Display/Rtt_ClosedPath.h"
+#include "Display/Rtt_Display.h"
+#include "Display/Rtt_Paint.h"
+#include "Display/Rtt_Shader.h"
+#include "Display/Rtt_ShaderData.h"
+#include "Display/Rtt_ShaderResource.h"
+#include "Display/Rtt_ShapeObject.h"
+#include "Renderer/Rtt_Uniform.h"
+#include "Rtt_LuaProxy.h"
+
+#include <math.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+static const float kPi = 3.14159265358979f;
+
+static const U32 kTransformMask =
+	( 1 << TweenPlayer::kPropertyX ) | ( 1 << TweenPlayer::kPropertyY )
+	| ( 1 << TweenPlayer::kPropertyRotation )
+	| ( 1 << TweenPlayer::kPropertyXScale ) | ( 1 << TweenPlayer::kPropertyYScale );
+
+static const U32 kFillMask =
+	( 1 << TweenPlayer::kPropertyFillR ) | ( 1 << TweenPlayer::kPropertyFillG )
+	| ( 1 << TweenPlayer::kPropertyFillB ) | ( 1 << TweenPlayer::kPropertyFillA );
+
+static const U32 kEffectMask =
+	( 1 << TweenPlayer::kPropertyEffect0 ) | ( 1 << TweenPlayer::kPropertyEffect1 )
+	| ( 1 << TweenPlayer::kPropertyEffect2 ) | ( 1 << TweenPlayer::kPropertyEffect3 );
+
+// Indexed by TweenPlayer::kPropertyX..kPropertyYScale
+static const GeometricProperty kGeometricProperties[] =
+{
+	kOriginX,
+	kOriginY,
+	kRotation,
+	kScaleX,
+	kScaleY,
+};
+
+static float
+EaseBounceOut( float t )
+{
+	const float n = 7.5625f;
+	const float d = 2.75f;
+
+	if ( t < 1.f / d )
+	{
+		return n * t * t;
+	}
+	else if ( t < 2.f / d )
+	{
+		t -= 1.5f / d;
+		return n * t * t + 0.75f;
+	}
+	else if ( t < 2.5f / d )
+	{
+		t -= 2.25f / d;
+		return n * t * t + 0.9375f;
+	}
+
+	t -= 2.625f / d;
+	return n * t * t + 0.984375f;
+}
+
+// The "in" flavor of each curve. The others are derived from it.
+static float
+EaseIn( TweenPlayer::Curve curve, float t )
+{
+	switch ( curve )
+	{
+		case TweenPlayer::kSine:
+			return 1.f - cosf( t * kPi * 0.5f );
+		case TweenPlayer::kQuad:
+			return t * t;
+		case TweenPlayer::kCubic:
+			return t * t * t;
+		case TweenPlayer::kQuart:
+			return t * t * t * t;
+		case TweenPlayer::kQuint:
+			return t * t * t * t * t;
+		case TweenPlayer::kExpo:
+			return t <= 0.f ? 0.f : powf( 2.f, 10.f * t - 10.f );
+		case TweenPlayer::kCirc:
+			return 1.f - sqrtf( 1.f - t * t );
+		case TweenPlayer::kBack:
+			{
+				const float s = 1.70158f;
+				return t * t * ( ( s + 1.f ) * t - s );
+			}
+		case TweenPlayer::kElastic:
+			if ( t <= 0.f || t >= 1.f )
+			{
+				return t <= 0.f ? 0.f : 1.f;
+			}
+			return -powf( 2.f, 10.f * t - 10.f ) * sinf( ( t * 10.f - 10.75f ) * ( 2.f * kPi / 3.f ) );
+		case TweenPlayer::kBounce:
+			return 1.f - EaseBounceOut( 1.f - t );
+		default:
+			return t;
+	}
+}
+
+float
+TweenPlayer::Ease( Easing easing, float t )
+{
+	Curve curve = (Curve)easing.fCurve;
+
+	if ( kLinear == curve )
+	{
+		return t;
+	}
+	else if ( kContinuousLoop == curve )
+	{
+		return t < 0.5f ? 2.f * t : 2.f - 2.f * t;
+	}
+
+	switch ( easing.fMode )
+	{
+		case kEaseOut:
+			return 1.f - EaseIn( curve, 1.f - t );
+		case kEaseInOut:
+			return t < 0.5f
+				? 0.5f * EaseIn( curve, 2.f * t )
+				: 1.f - 0.5f * EaseIn( curve, 2.f - 2.f * t );
+		case kEaseOutIn:
+			return t < 0.5f
+				? 0.5f - 0.5f * EaseIn( curve, 1.f - 2.f * t )
+				: 0.5f + 0.5f * EaseIn( curve, 2.f * t - 1.f );
+		default:
+			return EaseIn( curve, t );
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+static U8
+ToByte( float value )
+{
+	return (U8)( Min( Max( value, 0.f ), 1.f ) * 255.0f );
+}
+
+static float
+GetEffectValue( ShaderData& data, int index )
+{
+	ShaderData::DataIndex dataIndex = (ShaderData::DataIndex)index;
+
+	Uniform *uniform = data.GetUniform( dataIndex );
+	if ( uniform )
+	{
+		Real result = Rtt_REAL_0;
+		if ( Uniform::kScalar == uniform->GetDataType() )
+		{
+			uniform->GetValue( result );
+		}
+		return Rtt_RealToFloat( result );
+	}
+
+	return Rtt_RealToFloat( data.GetVertexData( dataIndex ) );
+}
+
+static void
+SetEffectValue( ShaderData& data, int index, float value )
+{
+	ShaderData::DataIndex dataIndex = (ShaderData::DataIndex)index;
+
+	SharedPtr< ShaderResource > resource( data.GetShaderResource() );
+	if ( resource.IsNull() ) { return; }
+
+	if ( resource->UsesUniforms() )
+	{
+		// LuaLibTransition initializes the uniforms of animated params
+		Uniform *uniform = data.GetUniform( dataIndex );
+		if ( uniform && Uniform::kScalar == uniform->GetDataType() )
+		{
+			uniform->SetValue( Rtt_FloatToReal( value ) );
+			data.DidUpdateUniform( dataIndex );
+		}
+	}
+	else
+	{
+		data.SetVertexData( dataIndex, Rtt_FloatToReal( value ) );
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+TweenPlayer::TweenPlayer( Display& display )
+:	fDisplay( display ),
+	fTweens(),
+	fIndices(),
+	fFreeIds(),
+	fCompletions(),
+	fNextCompletion( 0 ),
+	fTime( 0 ),
+	fNumTweens( 0 ),
+	fNeedsCollect( false )
+{
+}
+
+S32
+TweenPlayer::Add( U64 time, LuaProxy *target, const Params& params, const char *tag )
+{
+	Rtt_ASSERT( target );
+
+	S32 id;
+	if ( fFreeIds.empty() )
+	{
+		id = (S32)fIndices.size();
+		fIndices.push_back( kFreeIndex );
+	}
+	else
+	{
+		id = fFreeIds.back();
+		fFreeIds.pop_back();
+	}
+
+	fIndices[id] = (S32)fTweens.size();
+	fTweens.push_back( Tween() );
+	++fNumTweens;
+
+	Tween& tween = fTweens.back();
+	tween.fTarget = target;
+	tween.fStart = time + params.fDelay;
+	tween.fPauseTime = 0;
+	tween.fMask = params.fMask;
+	tween.fDuration = params.fDuration;
+	tween.fIterations = params.fIterations > 0 ? params.fIterations : 0;
+	tween.fId = id;
+	tween.fEasing = params.fEasing;
+	tween.fState = kWaiting;
+	tween.fIsPaused = false;
+	tween.fIsDelta = params.fIsDelta;
+	tween.fIsFrom = params.fIsFrom;
+	if ( tag )
+	{
+		tween.fTag = tag;
+	}
+
+	// The start values are only known once the delay has elapsed
+	for ( int i = 0; i < kNumProperties; i++ )
+	{
+		tween.fFrom[i] = 0.f;
+		tween.fTo[i] = params.fValues[i];
+	}
+
+	return id;
+}
+
+void
+TweenPlayer::Remove( S32 id )
+{
+	if ( IsValid( id ) )
+	{
+		Tween& tween = fTweens[fIndices[id]];
+		tween.fState = kRemoved;
+		tween.fTarget = NULL;
+
+		fIndices[id] = kFreeIndex;
+		fFreeIds.push_back( id );
+		--fNumTweens;
+
+		fNeedsCollect = true;
+	}
+}
+
+bool
+TweenPlayer::Pause( S32 id, U64 time )
+{
+	bool result = IsValid( id );
+
+	if ( result )
+	{
+		Tween& tween = fTweens[fIndices[id]];
+		result = ! tween.fIsPaused;
+		if ( result )
+		{
+			tween.fIsPaused = true;
+			tween.fPauseTime = time;
+		}
+	}
+
+	return result;
+}
+
+bool
+TweenPlayer::Resume( S32 id, U64 time )
+{
+	bool result = IsValid( id );
+
+	if ( result )
+	{
+		Tween& tween = fTweens[fIndices[id]];
+		result = tween.fIsPaused;
+		if ( result )
+		{
+			// Pick up where it left off, delay included
+			tween.fIsPaused = false;
+			tween.fStart += time - tween.fPauseTime;
+		}
+	}
+
+	return result;
+}
+
+bool
+TweenPlayer::IsValid( S32 id ) const
+{
+	return id >= 0 && id < (S32)fIndices.size() && fIndices[id] >= 0;
+}
+
+void
+TweenPlayer::GetTweens( const LuaProxy *target, const char *tag, std::vector< S32 >& result ) const
+{
+	for ( size_t i = 0, iMax = fTweens.size(); i < iMax; i++ )
+	{
+		const Tween& tween = fTweens[i];
+		if ( kRemoved != tween.fState
+			 && ( ! target || target == tween.fTarget )
+			 && ( ! tag || tween.fTag == tag ) )
+		{
+			result.push_back( tween.fId );
+		}
+	}
+}
+
+ShaderData *
+TweenPlayer::GetEffectData( ShapeObject& object ) const
+{
+	Paint *paint = object.GetPath().GetFill();
+	if ( paint && paint->HasShader() )
+	{
+		return paint->GetShader( fDisplay.GetShaderFactory() )->GetData();
+	}
+
+	return NULL;
+}
+
+void
+TweenPlayer::Start( Tween& tween )
+{
+	DisplayObject& object = * (DisplayObject *)tween.fTarget->Object();
+	U32 mask = tween.fMask;
+
+	float current[kNumProperties];
+	for ( int i = 0; i < kNumProperties; i++ )
+	{
+		current[i] = tween.fTo[i];
+	}
+
+	for ( int i = kPropertyX; i <= kPropertyYScale; i++ )
+	{
+		if ( mask & ( 1 << i ) )
+		{
+			current[i] = Rtt_RealToFloat( object.GetGeometricProperty( kGeometricProperties[i] ) );
+		}
+	}
+
+	if ( mask & ( 1 << kPropertyAlpha ) )
+	{
+		current[kPropertyAlpha] = object.Alpha() / 255.0f;
+	}
+
+	if ( mask & ( kFillMask | kEffectMask ) )
+	{
+		ShapeObject& shape = static_cast< ShapeObject& >( object );
+
+		const Paint *paint = shape.GetPath().GetFill();
+		if ( paint && ( mask & kFillMask ) )
+		{
+			ColorUnion c;
+			c.pixel = paint->GetColor();
+			for ( int i = 0; i < 4; i++ )
+			{
+				current[kPropertyFillR + i] = c.channels[i] / 255.0f;
+			}
+		}
+
+		ShaderData *data = GetEffectData( shape );
+		if ( data && ( mask & kEffectMask ) )
+		{
+			for ( int i = 0; i < ShaderData::kNumData; i++ )
+			{
+				if ( mask & ( 1 << ( kPropertyEffect0 + i ) ) )
+				{
+					current[kPropertyEffect0 + i] = GetEffectValue( * data, i );
+				}
+			}
+		}
+	}
+
+	for ( int i = 0; i < kNumProperties; i++ )
+	{
+		float value = tween.fTo[i] + ( tween.fIsDelta ? current[i] : 0.f );
+		tween.fFrom[i] = tween.fIsFrom ? value : current[i];
+		tween.fTo[i] = tween.fIsFrom ? current[i] : value;
+	}
+
+	tween.fState = kRunning;
+}
+
+void
+TweenPlayer::Apply( Tween& tween, float t )
+{
+	DisplayObject& object = * (DisplayObject *)tween.fTarget->Object();
+	U32 mask = tween.fMask;
+	const float *from = tween.fFrom;
+	const float *to = tween.fTo;
+
+	if ( mask & kTransformMask )
+	{
+		U32 geometricMask = 0;
+		Real values[kNumGeometricProperties];
+		for ( int i = kPropertyX; i <= kPropertyYScale; i++ )
+		{
+			if ( mask & ( 1 << i ) )
+			{
+				GeometricProperty p = kGeometricProperties[i];
+				geometricMask |= 1 << p;
+				values[p] = Rtt_FloatToReal( from[i] + ( to[i] - from[i] ) * t );
+			}
+		}
+		object.SetGeometricProperties( geometricMask, values );
+	}
+
+	if ( mask & ( 1 << kPropertyAlpha ) )
+	{
+		object.SetAlpha( ToByte( from[kPropertyAlpha] + ( to[kPropertyAlpha] - from[kPropertyAlpha] ) * t ) );
+	}
+
+	if ( mask & ( kFillMask | kEffectMask ) )
+	{
+		ShapeObject& shape = static_cast< ShapeObject& >( object );
+
+		const Paint *paint = shape.GetPath().GetFill();
+		if ( paint && ( mask & kFillMask ) )
+		{
+			ColorUnion c;
+			c.pixel = paint->GetColor();
+			for ( int i = 0; i < 4; i++ )
+			{
+				int p = kPropertyFillR + i;
+				if ( mask & ( 1 << p ) )
+				{
+					c.channels[i] = ToByte( from[p] + ( to[p] - from[p] ) * t );
+				}
+			}
+			shape.SetFillColor( c.pixel );
+		}
+
+		ShaderData *data = GetEffectData( shape );
+		if ( data && ( mask & kEffectMask ) )
+		{
+			for ( int i = 0; i < ShaderData::kNumData; i++ )
+			{
+				int p = kPropertyEffect0 + i;
+				if ( mask & ( 1 << p ) )
+				{
+					SetEffectValue( * data, i, from[p] + ( to[p] - from[p] ) * t );
+				}
+			}
+		}
+	}
+}
+
+void
+TweenPlayer::Finish( Tween& tween, bool isFinished )
+{
+	Completion completion = { tween.fId, isFinished };
+	fCompletions.push_back( completion );
+
+	fIndices[tween.fId] = kPendingIndex;
+	--fNumTweens;
+
+	tween.fState = kRemoved;
+	tween.fTarget = NULL;
+	fNeedsCollect = true;
+}
+
+void
+TweenPlayer::Collect()
+{
+	size_t j = 0;
+	for ( size_t i = 0, iMax = fTweens.size(); i < iMax; i++ )
+	{
+		if ( kRemoved != fTweens[i].fState )
+		{
+			if ( i != j )
+			{
+				fTweens[j] = fTweens[i];
+				fIndices[fTweens[j].fId] = (S32)j;
+			}
+			++j;
+		}
+	}
+	fTweens.resize( j );
+
+	fNeedsCollect = false;
+}
+
+void
+TweenPlayer::Run( U64 time )
+{
+	fTime = time;
+
+	if ( ! HasCompletions() )
+	{
+		fCompletions.clear();
+		fNextCompletion = 0;
+	}
+
+	for ( size_t i = 0, iMax = fTweens.size(); i < iMax; i++ )
+	{
+		Tween& tween = fTweens[i];
+		if ( kRemoved == tween.fState )
+		{
+			continue;
+		}
+
+		// The proxy outlives its object, which may have been removed
+		if ( ! tween.fTarget->Object() )
+		{
+			Finish( tween, false );
+			continue;
+		}
+
+		if ( tween.fIsPaused || time < tween.fStart )
+		{
+			continue;
+		}
+
+		if ( kWaiting == tween.fState )
+		{
+			Start( tween );
+		}
+
+		U64 elapsed = time - tween.fStart;
+		if ( elapsed < tween.fDuration )
+		{
+			Apply( tween, Ease( tween.fEasing, (float)elapsed / (float)tween.fDuration ) );
+		}
+		else
+		{
+			Apply( tween, Ease( tween.fEasing, 1.f ) );
+
+			if ( 1 == tween.fIterations )
+			{
+				Finish( tween, true );
+			}
+			else
+			{
+				if ( tween.fIterations > 1 )
+				{
+					--tween.fIterations;
+				}
+
+				// Don't try to catch up on iterations missed by a long frame
+				tween.fStart += tween.fDuration;
+				if ( time - tween.fStart >= tween.fDuration )
+				{
+					tween.fStart = time;
+				}
+			}
+		}
+	}
+
+	if ( fNeedsCollect )
+	{
+		Collect();
+	}
+}
+
+bool
+TweenPlayer::PopCompletion( Completion& result )
+{
+	bool hasCompletion = HasCompletions();
+
+	if ( hasCompletion )
+	{
+		result = fCompletions[fNextCompletion++];
+
+		// Only now can the id be handed out again
+		fIndices[result.fId] = kFreeIndex;
+		fFreeIds.push_back( result.fId );
+	}
+
+	return hasCompletion;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
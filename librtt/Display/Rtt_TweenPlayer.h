@@ -0,0 +1,228 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_TweenPlayer_H__
+#define _Rtt_TweenPlayer_H__
+
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Types.h"
+
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+class Display;
+class LuaProxy;
+class ShaderData;
+class ShapeObject;
+
+// ----------------------------------------------------------------------------
+
+// Animates properties of display objects for the Lua "transition" library
+// (see LuaLibTransition). Display runs it once per frame, right after the
+// SpritePlayer, and it writes the interpolated values straight into the
+// objects, so a frame costs no Lua calls no matter how many tweens run.
+//
+// A tween reads its start values when its delay has elapsed, so tweens of
+// the same property can be chained by delaying each one by the duration of
+// those before it.
+//
+// Tweens are referred to by an id, which is reused once they are removed.
+// Ids of finished tweens are only reused after PopCompletion() reported them.
+class TweenPlayer
+{
+	Rtt_CLASS_NO_COPIES( TweenPlayer )
+
+	public:
+		typedef TweenPlayer Self;
+
+		static const S32 kInvalidId = -1;
+
+		typedef enum _Property
+		{
+			kPropertyX = 0,
+			kPropertyY,
+			kPropertyRotation,
+			kPropertyXScale,
+			kPropertyYScale,
+			kPropertyAlpha,
+
+			// Fill color, shape objects only
+			kPropertyFillR,
+			kPropertyFillG,
+			kPropertyFillB,
+			kPropertyFillA,
+
+			// Params of the fill effect, by ShaderData::DataIndex. Only scalar
+			// params can be animated.
+			kPropertyEffect0,
+			kPropertyEffect1,
+			kPropertyEffect2,
+			kPropertyEffect3,
+
+			kNumProperties
+		}
+		Property;
+
+		typedef enum _Curve
+		{
+			kLinear = 0,
+			kSine,
+			kQuad,
+			kCubic,
+			kQuart,
+			kQuint,
+			kExpo,
+			kCirc,
+			kBack,
+			kElastic,
+			kBounce,
+			kContinuousLoop, // Linear, there and back
+
+			kNumCurves
+		}
+		Curve;
+
+		typedef enum _EaseMode
+		{
+			kEaseIn = 0,
+			kEaseOut,
+			kEaseInOut,
+			kEaseOutIn,
+
+			kNumEaseModes
+		}
+		EaseMode;
+
+		struct Easing
+		{
+			U8 fCurve;
+			U8 fMode;
+		};
+
+		// Maps 't' in [0,1] to the eased progress, 0 at 0 and 1 at 1
+		static float Ease( Easing easing, float t );
+
+		struct Params
+		{
+			U32 fMask; // Bit per Property
+			float fValues[kNumProperties];
+			U32 fDuration; // ms
+			U32 fDelay;
+			S32 fIterations; // Forever if <= 0
+			Easing fEasing;
+			bool fIsDelta; // Values are relative to the start values
+			bool fIsFrom; // Animate from the values to the start values
+		};
+
+		struct Completion
+		{
+			S32 fId;
+			bool fIsFinished; // Otherwise, its target was destroyed
+		};
+
+	public:
+		TweenPlayer( Display& display );
+
+	public:
+		// Adds a tween that starts 'params.fDelay' ms after 'time'. 'target'
+		// must be the proxy of a display object, and of a shape object if any
+		// fill or effect property is animated. The caller keeps the proxy
+		// alive until the tween is removed. 'tag' may be NULL.
+		S32 Add( U64 time, LuaProxy *target, const Params& params, const char *tag );
+		void Remove( S32 id );
+
+		// Both return false if the tween was not running, resp. paused
+		bool Pause( S32 id, U64 time );
+		bool Resume( S32 id, U64 time );
+
+		bool IsValid( S32 id ) const;
+
+		// Appends the tweens of 'target' with the given tag to 'result'.
+		// NULL matches any target, resp. tag.
+		void GetTweens( const LuaProxy *target, const char *tag, std::vector< S32 >& result ) const;
+
+		// Fill shader data of 'object' if its effect has params, or NULL
+		ShaderData *GetEffectData( ShapeObject& object ) const;
+
+	public:
+		// Applies the values of all running tweens at 'time' (ms). Tweens that
+		// finish, or whose target was destroyed, are removed and queued.
+		void Run( U64 time );
+
+		bool PopCompletion( Completion& result );
+
+		bool HasCompletions() const { return fNextCompletion < fCompletions.size(); }
+
+		// Time of the last call to Run()
+		U64 GetTime() const { return fTime; }
+
+		S32 GetNumTweens() const { return fNumTweens; }
+
+	private:
+		enum
+		{
+			kFreeIndex = -1,
+			kPendingIndex = -2, // Finished, not popped yet
+		};
+
+		enum State
+		{
+			kRemoved = 0,
+			kWaiting, // Delay not elapsed yet
+			kRunning,
+		};
+
+		struct Tween
+		{
+			LuaProxy *fTarget;
+			U64 fStart;
+			U64 fPauseTime;
+			U32 fMask;
+			U32 fDuration;
+			S32 fIterations;
+			S32 fId;
+			float fFrom[kNumProperties];
+			float fTo[kNumProperties];
+			std::string fTag;
+			Easing fEasing;
+			U8 fState;
+			bool fIsPaused;
+			bool fIsDelta;
+			bool fIsFrom;
+		};
+
+		void Start( Tween& tween );
+		void Apply( Tween& tween, float t );
+		void Finish( Tween& tween, bool isFinished );
+		void Collect();
+
+	private:
+		Display& fDisplay;
+		std::vector< Tween > fTweens; // In the order they were added
+		std::vector< S32 > fIndices; // Index in fTweens of each id
+		std::vector< S32 > fFreeIds;
+		std::vector< Completion > fCompletions;
+		size_t fNextCompletion;
+		U64 fTime;
+		S32 fNumTweens;
+		bool fNeedsCollect;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_TweenPlayer_H__
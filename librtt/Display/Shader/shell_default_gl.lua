@@ -9,7 +9,15 @@ shell.name = "default"
 shell.vertex =
 [[
 attribute vec2 a_Position;
-attribute vec3 a_TexCoord;
+#ifdef INSTANCED
+	// a_Position is the corner of a unit quad. The quad itself comes from
+	// the instance (see Geometry::Instance).
+	attribute vec4 a_InstancePosition;
+	attribute vec4 a_InstanceEdge;
+	attribute vec4 a_InstanceTexCoord;
+#else
+	attribute vec3 a_TexCoord;
+#endif
 attribute vec4 a_ColorScale;
 attribute vec4 a_UserData;
 
@@ -21,7 +29,16 @@ uniform P_POSITION vec2 u_ContentScale;
 uniform P_POSITION mat4 u_ViewProjectionMatrix;
 
 #define CoronaVertexUserData a_UserData
-#define CoronaTexCoord a_TexCoord.xy
+#ifdef INSTANCED
+	P_UV vec2 CoronaInstanceTexCoord;
+	#define CoronaTexCoord CoronaInstanceTexCoord
+
+	// For vertex kernels that read the attribute directly. Instances always
+	// have a q (z) of 1, see Geometry::Instance.
+	#define a_TexCoord vec3( CoronaInstanceTexCoord, 1.0 )
+#else
+	#define CoronaTexCoord a_TexCoord.xy
+#endif
 
 #define CoronaTotalTime u_TotalTime
 #define CoronaDeltaTime u_DeltaTime
@@ -76,14 +93,31 @@ void main()
 	// Certain devices, like the "Samsung Galaxy Tab 2", DON'T allow you to
 	// use "varying" variable like any other local variables.
 
+#ifdef INSTANCED
+	P_POSITION vec2 vertexPosition = a_InstancePosition.xy
+		+ a_Position.x * a_InstancePosition.zw
+		+ a_Position.y * a_InstanceEdge.xy;
+
+	CoronaInstanceTexCoord = a_InstanceEdge.zw
+		+ a_Position.x * a_InstanceTexCoord.xy
+		+ a_Position.y * a_InstanceTexCoord.zw;
+
+	v_TexCoord = CoronaInstanceTexCoord;
+	#ifdef TEX_COORD_Z
+		v_TexCoordZ = 1.0;
+	#endif
+#else
+	P_POSITION vec2 vertexPosition = a_Position;
+
 	v_TexCoord = a_TexCoord.xy;
-#ifdef TEX_COORD_Z
-	v_TexCoordZ = a_TexCoord.z;
+	#ifdef TEX_COORD_Z
+		v_TexCoordZ = a_TexCoord.z;
+	#endif
 #endif
 	v_ColorScale = a_ColorScale;
 	v_UserData = a_UserData;
 
-	P_POSITION vec2 position = VertexKernel( a_Position );
+	P_POSITION vec2 position = VertexKernel( vertexPosition );
 
     #if MASK_COUNT > 0
         v_MaskUV0 = ( u_MaskMatrix0 * vec3( position, 1.0 ) ).xy;
@@ -13,6 +13,7 @@
 #include "Renderer/Rtt_Geometry_Renderer.h"
 #include "Renderer/Rtt_Program.h"
 #include "Renderer/Rtt_RenderTypes.h"
+#include "Renderer/Rtt_Texture.h"
 #include "Core/Rtt_Types.h"
 #include "Core/Rtt_Real.h"
 
@@ -53,6 +54,13 @@ class CommandBuffer
 		static size_t GetMaxTextureSize();
 		static const char *GetGlString( const char *s );
 		static bool GetGpuSupportsHighPrecisionFragmentShaders();
+		static bool GetGpuSupportsInstancing();
+
+		// Whether data in the given Texture::IsCompressed() format can be
+		// uploaded as is. Otherwise, it must be decoded first. The result is
+		// cached by the first call, which needs a current context (see
+		// Display::Initialize).
+		static bool GetGpuSupportsCompressedFormat( Texture::Format format );
 
 	public:
 		CommandBuffer( Rtt_Allocator* allocator );
@@ -85,6 +93,16 @@ class CommandBuffer
 		virtual void Clear( Real r, Real g, Real b, Real a ) = 0;
 		virtual void Draw( U32 offset, U32 count, Geometry::PrimitiveType type ) = 0;
 		virtual void DrawIndexed( U32 offset, U32 count, Geometry::PrimitiveType type ) = 0;
+
+		// Like Draw(), but 'count' Geometry::CompactVertex are read, tightly
+		// packed, from vertex 'offset' of the bound Geometry on.
+		virtual void DrawCompact( U32 offset, U32 count, Geometry::PrimitiveType type ) = 0;
+
+		// Draw 'count' quads whose Geometry::Instance data is stored, tightly
+		// packed, from vertex 'offset' of the bound Geometry. Only valid when
+		// GetGpuSupportsInstancing() is true.
+		virtual void DrawInstanced( U32 offset, U32 count ) = 0;
+
 		virtual S32 GetCachedParam( CommandBuffer::QueryableParams param ) = 0;
 		
 		// Execute the generated command buffer. This function should only be
@@ -77,6 +77,7 @@ void GLLogError( const char* message, const char* file, int line );
 	#define Rtt_glBindFragDataLocation
 	#define Rtt_glClearDepth			glClearDepthf
 	#define Rtt_glDepthRange			glDepthRangef
+	#define Rtt_glGenerateMipmap( target )						glGenerateMipmap( target )
 
 #else
 
@@ -84,16 +85,24 @@ void GLLogError( const char* message, const char* file, int line );
 		#define Rtt_glBindVertexArray( id )								glBindVertexArrayAPPLE( id )
 		#define Rtt_glDeleteVertexArrays( count, names )				glDeleteVertexArraysAPPLE( count, names )
 		#define Rtt_glGenVertexArrays( count, names )					glGenVertexArraysAPPLE( count, names )
+		#define Rtt_glGenerateMipmap( target )						glGenerateMipmapEXT( target )
 	#else
 		#define Rtt_glBindVertexArray( id )								glBindVertexArray( id )
 		#define Rtt_glDeleteVertexArrays( count, names )				glDeleteVertexArrays( count, names )
 		#define Rtt_glGenVertexArrays( count, names )					glGenVertexArrays( count, names )
+		#define Rtt_glGenerateMipmap( target )						glGenerateMipmap( target )
 	#endif
 
 	#define Rtt_glBindFragDataLocation( program, colorNumber, name )	glBindFragDataLocation( program, colorNumber, name )
 	#define Rtt_glClearDepth											glClearDepth
 	#define Rtt_glDepthRange											glDepthRange
 
+	// Instanced drawing (GL_ARB_instanced_arrays, GL_ARB_draw_instanced).
+	// Availability is checked at runtime, see CommandBuffer::GetGpuSupportsInstancing()
+	#define Rtt_GL_INSTANCING
+	#define Rtt_glVertexAttribDivisor( index, divisor )						glVertexAttribDivisorARB( index, divisor )
+	#define Rtt_glDrawArraysInstanced( mode, first, count, instances )		glDrawArraysInstancedARB( mode, first, count, instances )
+
 #endif
     
 // Enable GPU timer queries on supported platforms
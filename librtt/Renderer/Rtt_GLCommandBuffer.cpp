@@ -15,6 +15,7 @@
 #include "Renderer/Rtt_GLFrameBufferObject.h"
 #include "Renderer/Rtt_GLGeometry.h"
 #include "Renderer/Rtt_GLProgram.h"
+#include "Renderer/Rtt_GLStreamBuffer.h"
 #include "Renderer/Rtt_GLTexture.h"
 #include "Renderer/Rtt_Program.h"
 #include "Renderer/Rtt_Texture.h"
@@ -64,6 +65,8 @@ namespace /*anonymous*/
 		kCommandClear,
 		kCommandDraw,
 		kCommandDrawIndexed,
+		kCommandDrawCompact,
+		kCommandDrawInstanced,
 		kNumCommands
 	};
 
@@ -279,11 +282,80 @@ CommandBuffer::GetGpuSupportsHighPrecisionFragmentShaders()
 #endif
 }
 
-GLCommandBuffer::GLCommandBuffer( Rtt_Allocator* allocator )
+bool
+CommandBuffer::GetGpuSupportsInstancing()
+{
+#ifdef Rtt_GL_INSTANCING
+	static bool sIsInitialized = false;
+	static bool sIsSupported = false;
+
+	if ( ! sIsInitialized )
+	{
+		sIsInitialized = true;
+
+		// Both entry points are core in OpenGL 3.3, but the legacy
+		// contexts used on desktop only advertise them as extensions
+		const char *extensions = (const char *)glGetString( GL_EXTENSIONS );
+		sIsSupported = extensions
+			&& NULL != strstr( extensions, "GL_ARB_instanced_arrays" )
+			&& NULL != strstr( extensions, "GL_ARB_draw_instanced" );
+		GL_CHECK_ERROR();
+	}
+
+	return sIsSupported;
+#else
+	return false;
+#endif
+}
+
+bool
+CommandBuffer::GetGpuSupportsCompressedFormat( Texture::Format format )
+{
+	static bool sIsInitialized = false;
+	static bool sIsSupported[Texture::kNumFormats];
+
+	if ( ! sIsInitialized )
+	{
+		sIsInitialized = true;
+
+		// Covers extensions, and formats that are core (e.g. ETC2 in ES 3.0)
+		GLint numFormats = 0;
+		glGetIntegerv( GL_NUM_COMPRESSED_TEXTURE_FORMATS, & numFormats );
+
+		GLint *formats = numFormats > 0 ? new GLint[numFormats] : NULL;
+		if ( formats )
+		{
+			glGetIntegerv( GL_COMPRESSED_TEXTURE_FORMATS, formats );
+		}
+		GL_CHECK_ERROR();
+
+		for ( int i = 0; i < Texture::kNumFormats; i++ )
+		{
+			GLenum token = GLTexture::GetCompressedFormatToken( (Texture::Format)i );
+
+			sIsSupported[i] = false;
+			for ( GLint j = 0; j < numFormats && 0 != token; j++ )
+			{
+				if ( (GLenum)formats[j] == token )
+				{
+					sIsSupported[i] = true;
+					break;
+				}
+			}
+		}
+
+		delete [] formats;
+	}
+
+	return format >= 0 && format < Texture::kNumFormats && sIsSupported[format];
+}
+
+GLCommandBuffer::GLCommandBuffer( Rtt_Allocator* allocator, GLStreamBuffer* streamBuffer )
 :    CommandBuffer( allocator ),
 	 fCurrentPrepVersion( Program::kMaskCount0 ),
 	 fCurrentDrawVersion( Program::kMaskCount0 ),
 	 fProgram( NULL ),
+	 fStreamBuffer( streamBuffer ),
      fDefaultFBO( 0 ),
 	 fTimeTransform( NULL ),
 	 fTimerQueries( new U32[kTimerQueryCount] ),
@@ -600,6 +672,24 @@ GLCommandBuffer::Clear(Real r, Real g, Real b, Real a)
 	Write<GLfloat>(a);
 }
 
+static GLenum
+GLenumForPrimitiveType( Geometry::PrimitiveType type )
+{
+	GLenum result = GL_TRIANGLE_STRIP;
+
+	switch( type )
+	{
+		case Geometry::kTriangleStrip:	result = GL_TRIANGLE_STRIP;	break;
+		case Geometry::kTriangleFan:	result = GL_TRIANGLE_FAN;	break;
+		case Geometry::kTriangles:		result = GL_TRIANGLES;		break;
+		case Geometry::kLines:			result = GL_LINES;			break;
+		case Geometry::kLineLoop:		result = GL_LINE_LOOP;		break;
+		default: Rtt_ASSERT_NOT_REACHED(); break;
+	}
+
+	return result;
+}
+
 void 
 GLCommandBuffer::Draw( U32 offset, U32 count, Geometry::PrimitiveType type )
 {
@@ -607,19 +697,23 @@ GLCommandBuffer::Draw( U32 offset, U32 count, Geometry::PrimitiveType type )
 	ApplyUniforms( fProgram->GetGPUResource() );
 	
 	WRITE_COMMAND( kCommandDraw );
-	switch( type )
-	{
-		case Geometry::kTriangleStrip:	Write<GLenum>(GL_TRIANGLE_STRIP);	break;
-		case Geometry::kTriangleFan:	Write<GLenum>(GL_TRIANGLE_FAN);		break;
-		case Geometry::kTriangles:		Write<GLenum>(GL_TRIANGLES);		break;
-		case Geometry::kLines:			Write<GLenum>(GL_LINES);			break;
-		case Geometry::kLineLoop:		Write<GLenum>(GL_LINE_LOOP);		break;
-		default: Rtt_ASSERT_NOT_REACHED(); break;
-	}
+	Write<GLenum>( GLenumForPrimitiveType( type ) );
 	Write<GLint>(offset);
 	Write<GLsizei>(count);
 }
 
+void 
+GLCommandBuffer::DrawCompact( U32 offset, U32 count, Geometry::PrimitiveType type )
+{
+	Rtt_ASSERT( fProgram && fProgram->GetGPUResource() );
+	ApplyUniforms( fProgram->GetGPUResource() );
+	
+	WRITE_COMMAND( kCommandDrawCompact );
+	Write<GLenum>( GLenumForPrimitiveType( type ) );
+	Write<U32>( offset );
+	Write<GLsizei>( count );
+}
+
 void 
 GLCommandBuffer::DrawIndexed( U32, U32 count, Geometry::PrimitiveType type )
 {
@@ -638,6 +732,18 @@ GLCommandBuffer::DrawIndexed( U32, U32 count, Geometry::PrimitiveType type )
 	Write<GLsizei>(count);
 }
 
+void
+GLCommandBuffer::DrawInstanced( U32 offset, U32 count )
+{
+	Rtt_ASSERT( fProgram && fProgram->GetGPUResource() );
+	Rtt_ASSERT( fCurrentPrepVersion >= Program::kInstancedMaskCount0 );
+	ApplyUniforms( fProgram->GetGPUResource() );
+
+	WRITE_COMMAND( kCommandDrawInstanced );
+	Write<U32>( offset );
+	Write<GLsizei>( count );
+}
+
 S32
 GLCommandBuffer::GetCachedParam( CommandBuffer::QueryableParams param )
 {
@@ -688,8 +794,14 @@ GLCommandBuffer::Execute( bool measureGPU )
 	// on another CommandBuffer while this one is executing.
 	fOffset = fBuffer;
 
+	// Batches bound below are streamed into the next buffer of the ring
+	fStreamBuffer->BeginFrame();
+
 	//GL_CHECK_ERROR();
 
+	// Packed data is read relative to the most recently bound Geometry
+	GLGeometry* currentGeometry = NULL;
+
 	for( U32 i = 0; i < fNumCommands; ++i )
 	{
 		Command command = Read<Command>();
@@ -718,6 +830,7 @@ GLCommandBuffer::Execute( bool measureGPU )
 			{
 				GLGeometry* geometry = Read<GLGeometry*>();
 				geometry->Bind();
+				currentGeometry = geometry;
 				DEBUG_PRINT( "Bind Geometry %p", geometry );
 				CHECK_ERROR_AND_BREAK;
 			}
@@ -917,6 +1030,33 @@ GLCommandBuffer::Execute( bool measureGPU )
 				DEBUG_PRINT( "Draw indexed: mode=%i, count=%i", mode, count );
 				CHECK_ERROR_AND_BREAK;
 			}
+			case kCommandDrawCompact:
+			{
+				GLenum mode = Read<GLenum>();
+				U32 offset = Read<U32>();
+				GLsizei count = Read<GLsizei>();
+				Rtt_ASSERT( currentGeometry );
+				currentGeometry->BindCompactVertices( offset );
+				glDrawArrays( mode, 0, count );
+				currentGeometry->UnbindCompactVertices();
+				DEBUG_PRINT( "Draw compact: mode=%i, offset=%i, count=%i", mode, offset, count );
+				CHECK_ERROR_AND_BREAK;
+			}
+			case kCommandDrawInstanced:
+			{
+				U32 offset = Read<U32>();
+				GLsizei count = Read<GLsizei>();
+			#ifdef Rtt_GL_INSTANCING
+				Rtt_ASSERT( currentGeometry );
+				currentGeometry->BindInstances( offset );
+				Rtt_glDrawArraysInstanced( GL_TRIANGLE_STRIP, 0, 4, count );
+				currentGeometry->UnbindInstances();
+			#else
+				Rtt_ASSERT_NOT_REACHED();
+			#endif
+				DEBUG_PRINT( "Draw instanced: offset=%i, count=%i", offset, count );
+				CHECK_ERROR_AND_BREAK;
+			}
 			default:
 				DEBUG_PRINT( "Unknown command(%d)", command );
 				Rtt_ASSERT_NOT_REACHED();
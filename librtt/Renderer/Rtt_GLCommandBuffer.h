@@ -20,6 +20,7 @@ namespace Rtt
 
 // ----------------------------------------------------------------------------
 
+class GLStreamBuffer;
 struct TimeTransform;
 
 // 
@@ -30,7 +31,8 @@ class GLCommandBuffer : public CommandBuffer
 		typedef GLCommandBuffer Self;
 
 	public:
-		GLCommandBuffer( Rtt_Allocator* allocator );
+		// Batched vertices are written to 'streamBuffer' as they are bound
+		GLCommandBuffer( Rtt_Allocator* allocator, GLStreamBuffer* streamBuffer );
 		virtual ~GLCommandBuffer();
 
 		virtual void Initialize();
@@ -55,6 +57,8 @@ class GLCommandBuffer : public CommandBuffer
 		virtual void Clear( Real r, Real g, Real b, Real a );
 		virtual void Draw( U32 offset, U32 count, Geometry::PrimitiveType type );
 		virtual void DrawIndexed( U32 offset, U32 count, Geometry::PrimitiveType type );
+		virtual void DrawCompact( U32 offset, U32 count, Geometry::PrimitiveType type );
+		virtual void DrawInstanced( U32 offset, U32 count );
 		virtual S32 GetCachedParam( CommandBuffer::QueryableParams param );
 		
 		// Execute all buffered commands. A valid OpenGL context must be active.
@@ -91,6 +95,7 @@ class GLCommandBuffer : public CommandBuffer
 		Program::Version fCurrentDrawVersion;
 	
 		Program* fProgram;
+		GLStreamBuffer* fStreamBuffer;
 		S32 fDefaultFBO;
 		U32* fTimerQueries;
 		U32 fTimerQueryIndex;
@@ -13,11 +13,13 @@
 
 #include "Renderer/Rtt_Geometry_Renderer.h"
 #include "Renderer/Rtt_GL.h"
+#include "Renderer/Rtt_GLStreamBuffer.h"
 
 #if defined( Rtt_EGL )
 	#include <EGL/egl.h>
 #endif
 
+#include <stddef.h>
 #include <stdio.h>
 
 // ----------------------------------------------------------------------------
@@ -187,8 +189,12 @@ namespace Rtt
 
 // ----------------------------------------------------------------------------
 
-GLGeometry::GLGeometry()
-:	fPositionStart( NULL ),
+GLGeometry::GLGeometry( GLStreamBuffer* streamBuffer )
+:	fStreamBuffer( streamBuffer ),
+	fStreamSource( NULL ),
+	fStreamName( 0 ),
+	fStreamGeneration( 0 ),
+	fPositionStart( NULL ),
 	fTexCoordStart( NULL ),
 	fColorScaleStart( NULL ),
 	fUserDataStart( NULL ),
@@ -256,8 +262,9 @@ GLGeometry::Update( CPUResource* resource )
 		const Geometry::Vertex* vertexData = geometry->GetVertexData();
 		if ( vertexData )
 		{
+			// Only the used portion is drawn, so the rest need not be copied
 			glBindBuffer( GL_ARRAY_BUFFER, fVBO );
-			glBufferSubData( GL_ARRAY_BUFFER, 0, fVertexCount * sizeof(Geometry::Vertex), vertexData );
+			glBufferSubData( GL_ARRAY_BUFFER, 0, geometry->GetVerticesUsed() * sizeof(Geometry::Vertex), vertexData );
 			glBindBuffer( GL_ARRAY_BUFFER, 0 );
 			
 			const Geometry::Index* indexData = geometry->GetIndexData();
@@ -265,7 +272,7 @@ GLGeometry::Update( CPUResource* resource )
 			{
 				Rtt_glBindVertexArray( 0 );
 				glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, fIBO );
-				glBufferSubData( GL_ELEMENT_ARRAY_BUFFER, 0, fIndexCount * sizeof(Geometry::Index), indexData );
+				glBufferSubData( GL_ELEMENT_ARRAY_BUFFER, 0, geometry->GetIndicesUsed() * sizeof(Geometry::Index), indexData );
 				glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );				
 			}
 		}
@@ -292,7 +299,7 @@ GLGeometry::Update( CPUResource* resource )
 		if ( vertexData )
 		{
 			glBindBuffer( GL_ARRAY_BUFFER, fVBO );
-			glBufferSubData( GL_ARRAY_BUFFER, 0, fVertexCount * sizeof(Geometry::Vertex), vertexData );
+			glBufferSubData( GL_ARRAY_BUFFER, 0, geometry->GetVerticesUsed() * sizeof(Geometry::Vertex), vertexData );
 			glBindBuffer( GL_ARRAY_BUFFER, 0 );
 		}
 		else
@@ -302,11 +309,10 @@ GLGeometry::Update( CPUResource* resource )
 	}
 	else
 	{
-		Geometry::Vertex* data = geometry->GetVertexData();
-		fPositionStart = data;
-		fTexCoordStart = &data[0].u;
-		fColorScaleStart = &data[0].rs;
-		fUserDataStart = &data[0].ux;
+		// Batches are filled anew every frame (see GeometryPool), so their
+		// vertices are streamed when bound instead.
+		fStreamSource = geometry;
+		fStreamGeneration = fStreamBuffer->GetGeneration() - 1;
 	}
 	GL_CHECK_ERROR();
 }
@@ -330,6 +336,9 @@ GLGeometry::Destroy()
 			fIBO = 0;
 		}
 
+		fStreamSource = NULL;
+		fStreamName = 0;
+
 		fPositionStart = NULL;
 		fTexCoordStart = NULL;
 		fColorScaleStart = NULL;
@@ -337,6 +346,28 @@ GLGeometry::Destroy()
 	}
 }
 
+void
+GLGeometry::Stream()
+{
+	if ( fStreamGeneration == fStreamBuffer->GetGeneration() )
+	{
+		return;
+	}
+
+	// Only the used portion is drawn
+	const size_t size = fStreamSource->GetVerticesUsed() * sizeof(Geometry::Vertex);
+	const U8* start = (const U8*)fStreamBuffer->Write( fStreamSource->GetVertexData(), size );
+
+	// Writing may have started a new generation
+	fStreamGeneration = fStreamBuffer->GetGeneration();
+	fStreamName = fStreamBuffer->GetName();
+
+	fPositionStart = (GLvoid*)( start + offsetof( Geometry::Vertex, x ) );
+	fTexCoordStart = (GLvoid*)( start + offsetof( Geometry::Vertex, u ) );
+	fColorScaleStart = (GLvoid*)( start + offsetof( Geometry::Vertex, rs ) );
+	fUserDataStart = (GLvoid*)( start + offsetof( Geometry::Vertex, ux ) );
+}
+
 void 
 GLGeometry::Bind()
 {
@@ -346,11 +377,6 @@ GLGeometry::Bind()
 	}
 	else
 	{
-		Rtt_ASSERT( fPositionStart || fVBO); // offset is 0 when VBO is available
-		Rtt_ASSERT( fTexCoordStart );
-		Rtt_ASSERT( fColorScaleStart );
-		Rtt_ASSERT( fUserDataStart );
-		
 		// A previous GLGeometry may have left a VAO (and its VBO bound). Unbinding a
 		// VAO does not alter its VBO, however, so both are explicitly unbound here.
 		if(isVertexArrayObjectSupported())
@@ -358,7 +384,17 @@ GLGeometry::Bind()
 			Rtt_glBindVertexArray( 0 );
 		}
 
-		glBindBuffer( GL_ARRAY_BUFFER, fVBO ); GL_CHECK_ERROR();
+		if ( fStreamSource )
+		{
+			Stream();
+		}
+
+		Rtt_ASSERT( fStreamSource || fVBO ); // offsets are relative to either buffer
+		Rtt_ASSERT( fTexCoordStart );
+		Rtt_ASSERT( fColorScaleStart );
+		Rtt_ASSERT( fUserDataStart );
+
+		glBindBuffer( GL_ARRAY_BUFFER, GetArrayBuffer() ); GL_CHECK_ERROR();
 		
 		const size_t size = sizeof(Geometry::Vertex);
 		glVertexAttribPointer( Geometry::kVertexPositionAttribute, 3, GL_FLOAT, GL_FALSE, size, fPositionStart ); GL_CHECK_ERROR();
@@ -372,6 +408,92 @@ GLGeometry::Bind()
 	}
 }
 
+void
+GLGeometry::BindCompactVertices( U32 offset )
+{
+	Rtt_ASSERT( ! fVAO );
+
+	// Same base as Bind(): an offset into the VBO or the stream buffer
+	const size_t size = sizeof(Geometry::CompactVertex);
+	const U8* start = (const U8*)fPositionStart + offset * sizeof(Geometry::Vertex);
+
+	glBindBuffer( GL_ARRAY_BUFFER, GetArrayBuffer() );
+	glVertexAttribPointer( Geometry::kVertexPositionAttribute, 2, GL_FLOAT, GL_FALSE, size, start + offsetof( Geometry::CompactVertex, x ) );
+	glVertexAttribPointer( Geometry::kVertexTexCoordAttribute, 2, GL_FLOAT, GL_FALSE, size, start + offsetof( Geometry::CompactVertex, u ) );
+	glVertexAttribPointer( Geometry::kVertexColorScaleAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, size, start + offsetof( Geometry::CompactVertex, rs ) );
+
+	// The program does not read the user data (see Program::GetVertexFormat())
+	glDisableVertexAttribArray( Geometry::kVertexUserDataAttribute );
+	GL_CHECK_ERROR();
+}
+
+void
+GLGeometry::UnbindCompactVertices()
+{
+	glEnableVertexAttribArray( Geometry::kVertexUserDataAttribute );
+	GL_CHECK_ERROR();
+
+	// Later draws from this Geometry expect the regular vertex layout
+	Bind();
+}
+
+void
+GLGeometry::BindInstances( U32 offset )
+{
+#ifdef Rtt_GL_INSTANCING
+	Rtt_ASSERT( ! fVAO );
+
+	// Same base as Bind(): an offset into the VBO or the stream buffer
+	const size_t size = sizeof(Geometry::Instance);
+	const U8* start = (const U8*)fPositionStart + offset * sizeof(Geometry::Vertex);
+
+	// Corners of the unit quad shared by all instances
+	glBindBuffer( GL_ARRAY_BUFFER, fStreamBuffer->GetQuadCornersName() );
+	glVertexAttribPointer( Geometry::kVertexPositionAttribute, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *)0 );
+
+	glBindBuffer( GL_ARRAY_BUFFER, GetArrayBuffer() );
+	glVertexAttribPointer( Geometry::kInstancePositionAttribute, 4, GL_FLOAT, GL_FALSE, size, start + offsetof( Geometry::Instance, x ) );
+	glVertexAttribPointer( Geometry::kInstanceEdgeAttribute, 4, GL_FLOAT, GL_FALSE, size, start + offsetof( Geometry::Instance, bx ) );
+	glVertexAttribPointer( Geometry::kInstanceTexCoordAttribute, 4, GL_FLOAT, GL_FALSE, size, start + offsetof( Geometry::Instance, au ) );
+	glVertexAttribPointer( Geometry::kVertexColorScaleAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, size, start + offsetof( Geometry::Instance, rs ) );
+	glVertexAttribPointer( Geometry::kVertexUserDataAttribute, 4, GL_FLOAT, GL_FALSE, size, start + offsetof( Geometry::Instance, ux ) );
+	GL_CHECK_ERROR();
+
+	glEnableVertexAttribArray( Geometry::kInstancePositionAttribute );
+	glEnableVertexAttribArray( Geometry::kInstanceEdgeAttribute );
+	glEnableVertexAttribArray( Geometry::kInstanceTexCoordAttribute );
+
+	Rtt_glVertexAttribDivisor( Geometry::kInstancePositionAttribute, 1 );
+	Rtt_glVertexAttribDivisor( Geometry::kInstanceEdgeAttribute, 1 );
+	Rtt_glVertexAttribDivisor( Geometry::kInstanceTexCoordAttribute, 1 );
+	Rtt_glVertexAttribDivisor( Geometry::kVertexColorScaleAttribute, 1 );
+	Rtt_glVertexAttribDivisor( Geometry::kVertexUserDataAttribute, 1 );
+	GL_CHECK_ERROR();
+#else
+	Rtt_ASSERT_NOT_REACHED();
+#endif
+}
+
+void
+GLGeometry::UnbindInstances()
+{
+#ifdef Rtt_GL_INSTANCING
+	Rtt_glVertexAttribDivisor( Geometry::kInstancePositionAttribute, 0 );
+	Rtt_glVertexAttribDivisor( Geometry::kInstanceEdgeAttribute, 0 );
+	Rtt_glVertexAttribDivisor( Geometry::kInstanceTexCoordAttribute, 0 );
+	Rtt_glVertexAttribDivisor( Geometry::kVertexColorScaleAttribute, 0 );
+	Rtt_glVertexAttribDivisor( Geometry::kVertexUserDataAttribute, 0 );
+
+	glDisableVertexAttribArray( Geometry::kInstancePositionAttribute );
+	glDisableVertexAttribArray( Geometry::kInstanceEdgeAttribute );
+	glDisableVertexAttribArray( Geometry::kInstanceTexCoordAttribute );
+	GL_CHECK_ERROR();
+
+	// Later draws from this Geometry expect the regular vertex layout
+	Bind();
+#endif
+}
+
 // ----------------------------------------------------------------------------
 
 } // namespace Rtt
@@ -18,6 +18,9 @@
 namespace Rtt
 {
 
+class Geometry;
+class GLStreamBuffer;
+
 // ----------------------------------------------------------------------------
 
 class GLGeometry : public GPUResource
@@ -27,14 +30,36 @@ class GLGeometry : public GPUResource
 		typedef GLGeometry Self;
 
 	public:
-		GLGeometry();
+		GLGeometry( GLStreamBuffer* streamBuffer );
 
 		virtual void Create( CPUResource* resource );
 		virtual void Update( CPUResource* resource );
 		virtual void Destroy();
 		virtual void Bind();
 
+		// Point the attributes at the Geometry::CompactVertex data stored from
+		// vertex 'offset' on. Must be followed by UnbindCompactVertices().
+		void BindCompactVertices( U32 offset );
+		void UnbindCompactVertices();
+
+		// Point the attributes at the Geometry::Instance data stored from
+		// vertex 'offset' on, for drawing instanced quads. Must be followed
+		// by UnbindInstances() after the draw.
+		void BindInstances( U32 offset );
+		void UnbindInstances();
+
+	private:
+		// Copies the vertices of geometry that isn't stored on the GPU to
+		// the stream buffer, unless they are there already.
+		void Stream();
+
+		GLuint GetArrayBuffer() const { return fStreamSource ? fStreamName : fVBO; }
+
 	private:
+		GLStreamBuffer* fStreamBuffer;
+		Geometry* fStreamSource;
+		GLuint fStreamName;
+		U32 fStreamGeneration;
 		GLvoid* fPositionStart;
 		GLvoid* fTexCoordStart;
 		GLvoid* fColorScaleStart;
@@ -10,6 +10,7 @@
 #include "Renderer/Rtt_GLProgram.h"
 
 #include "Renderer/Rtt_CommandBuffer.h"
+#include "Renderer/Rtt_GLProgramCache.h"
 #include "Renderer/Rtt_Geometry_Renderer.h"
 #include "Renderer/Rtt_Texture.h"
 #include "Core/Rtt_Assert.h"
@@ -89,7 +90,9 @@ namespace Rtt
 
 // ----------------------------------------------------------------------------
 
-GLProgram::GLProgram()
+GLProgram::GLProgram( GLProgramCache* cache )
+:	fResource( NULL ),
+	fCache( cache )
 {
 	for( U32 i = 0; i < Program::kNumVersions; ++i )
 	{
@@ -108,6 +111,16 @@ GLProgram::Create( CPUResource* resource )
 		{
 			Create( fData[i], i );
 		}
+	#else
+		// Pay for the unmasked versions now rather than on first use
+		if( static_cast<Program*>( resource )->IsPrecompiled() )
+		{
+			Create( Program::kMaskCount0, fData[Program::kMaskCount0] );
+			if( CommandBuffer::GetGpuSupportsInstancing() )
+			{
+				Create( Program::kInstancedMaskCount0, fData[Program::kInstancedMaskCount0] );
+			}
+		}
 	#endif
 }
 
@@ -115,10 +128,10 @@ void
 GLProgram::Update( CPUResource* resource )
 {
 	Rtt_ASSERT( CPUResource::kProgram == resource->GetType() );	
-	if( fData[Program::kMaskCount0].fProgram ) Update( Program::kMaskCount0, fData[Program::kMaskCount0] );
-	if( fData[Program::kMaskCount1].fProgram ) Update( Program::kMaskCount1, fData[Program::kMaskCount1] );
-	if( fData[Program::kMaskCount2].fProgram ) Update( Program::kMaskCount2, fData[Program::kMaskCount2] );
-	if( fData[Program::kMaskCount3].fProgram ) Update( Program::kMaskCount3, fData[Program::kMaskCount3] );
+	for( U32 i = 0; i < Program::kNumVersions; ++i )
+	{
+		if( fData[i].fProgram ) Update( static_cast<Program::Version>( i ), fData[i] );
+	}
 }
 
 void 
@@ -184,18 +197,24 @@ CountLines( const char **segments, int numSegments )
 	return result;
 }
 
-void
+U64
 GLProgram::UpdateShaderSource( Program* program, Program::Version version, VersionData& data )
 {
 	char maskBuffer[] = "#define MASK_COUNT 0\n";
 	switch( version )
 	{
-		case Program::kMaskCount1:	maskBuffer[sizeof( maskBuffer ) - 3] = '1'; break;
-		case Program::kMaskCount2:	maskBuffer[sizeof( maskBuffer ) - 3] = '2'; break;
-		case Program::kMaskCount3:	maskBuffer[sizeof( maskBuffer ) - 3] = '3'; break;
+		case Program::kMaskCount1:
+		case Program::kInstancedMaskCount1:	maskBuffer[sizeof( maskBuffer ) - 3] = '1'; break;
+		case Program::kMaskCount2:
+		case Program::kInstancedMaskCount2:	maskBuffer[sizeof( maskBuffer ) - 3] = '2'; break;
+		case Program::kMaskCount3:
+		case Program::kInstancedMaskCount3:	maskBuffer[sizeof( maskBuffer ) - 3] = '3'; break;
 		default: break;
 	}
 
+	// The shell reads per-instance attributes instead of per-vertex ones
+	const char *instancedBuffer = ( version >= Program::kInstancedMaskCount0 ? "#define INSTANCED 1\n" : "" );
+
 	char highp_support[] = "#define FRAGMENT_SHADER_SUPPORTS_HIGHP 0\n";
 	highp_support[ sizeof( highp_support ) - 3 ] = ( CommandBuffer::GetGpuSupportsHighPrecisionFragmentShaders() ? '1' : '0' );
 
@@ -205,12 +224,13 @@ GLProgram::UpdateShaderSource( Program* program, Program::Version version, Versi
 	const char *program_header_source = program->GetHeaderSource();
 	const char *header = ( program_header_source ? program_header_source : "" );
 
-	const char* shader_source[5];
+	const char* shader_source[6];
 	memset( shader_source, 0, sizeof( shader_source ) );
 	shader_source[0] = header;
 	shader_source[1] = highp_support;
 	shader_source[2] = maskBuffer;
 	shader_source[3] = texCoordZBuffer;
+	shader_source[4] = instancedBuffer;
 
 	if ( program->IsCompilerVerbose() )
 	{
@@ -219,9 +239,19 @@ GLProgram::UpdateShaderSource( Program* program, Program::Version version, Versi
 		data.fHeaderNumLines = CountLines( shader_source, numSegments );
 	}
 
+	// Identifies the linked program in GLProgramCache. The segments
+	// above already distinguish the versions.
+	U64 cacheKey = GLProgramCache::kHashSeed;
+	for ( size_t i = 0; i < sizeof( shader_source ) / sizeof( shader_source[0] ) - 1; i++ )
+	{
+		cacheKey = GLProgramCache::Hash( shader_source[i], cacheKey );
+	}
+	cacheKey = GLProgramCache::Hash( program->GetVertexShaderSource(), cacheKey );
+	cacheKey = GLProgramCache::Hash( program->GetFragmentShaderSource(), cacheKey );
+
 	// Vertex shader.
 	{
-		shader_source[4] = program->GetVertexShaderSource();
+		shader_source[5] = program->GetVertexShaderSource();
 
 		glShaderSource( data.fVertexShader,
 						( sizeof(shader_source) / sizeof(shader_source[0]) ),
@@ -232,13 +262,15 @@ GLProgram::UpdateShaderSource( Program* program, Program::Version version, Versi
 
 	// Fragment shader.
 	{
-		shader_source[4] = program->GetFragmentShaderSource();
+		shader_source[5] = program->GetFragmentShaderSource();
 		glShaderSource( data.fFragmentShader,
 						( sizeof(shader_source) / sizeof(shader_source[0]) ),
 						shader_source,
 						NULL );
 		GL_CHECK_ERROR();
 	}
+
+	return cacheKey;
 }
 
 void
@@ -250,35 +282,51 @@ GLProgram::Update( Program::Version version, VersionData& data )
 	glBindAttribLocation( data.fProgram, Geometry::kVertexTexCoordAttribute, "a_TexCoord" );
 	glBindAttribLocation( data.fProgram, Geometry::kVertexColorScaleAttribute, "a_ColorScale" );
 	glBindAttribLocation( data.fProgram, Geometry::kVertexUserDataAttribute, "a_UserData" );
+	glBindAttribLocation( data.fProgram, Geometry::kInstancePositionAttribute, "a_InstancePosition" );
+	glBindAttribLocation( data.fProgram, Geometry::kInstanceEdgeAttribute, "a_InstanceEdge" );
+	glBindAttribLocation( data.fProgram, Geometry::kInstanceTexCoordAttribute, "a_InstanceTexCoord" );
 	GL_CHECK_ERROR();
 
-	UpdateShaderSource( program,
+	U64 cacheKey = UpdateShaderSource( program,
 						version,
 						data );
 
+	// Skip compiling and linking if this version was linked on an earlier run
+	if ( ! fCache || ! fCache->Load( cacheKey, data.fProgram ) )
+	{
+		bool isVerbose = program->IsCompilerVerbose();
+		int kernelStartLine = 0;
+
+		glCompileShader( data.fVertexShader );
+		if ( isVerbose )
+		{
+			kernelStartLine = data.fHeaderNumLines + program->GetVertexShellNumLines();
+		}
+		CheckShaderCompilationStatus( data.fVertexShader, isVerbose, "vertex", kernelStartLine );
+		GL_CHECK_ERROR();
+
+		glCompileShader( data.fFragmentShader );
+		if ( isVerbose )
+		{
+			kernelStartLine = data.fHeaderNumLines + program->GetFragmentShellNumLines();
+		}
+		CheckShaderCompilationStatus( data.fFragmentShader, isVerbose, "fragment", kernelStartLine );
+		GL_CHECK_ERROR();
 
-	bool isVerbose = program->IsCompilerVerbose();
-	int kernelStartLine = 0;
+		if ( fCache )
+		{
+			fCache->WillLink( data.fProgram );
+		}
 
-	glCompileShader( data.fVertexShader );
-	if ( isVerbose )
-	{
-		kernelStartLine = data.fHeaderNumLines + program->GetVertexShellNumLines();
-	}
-	CheckShaderCompilationStatus( data.fVertexShader, isVerbose, "vertex", kernelStartLine );
-	GL_CHECK_ERROR();
+		glLinkProgram( data.fProgram );
+		CheckProgramLinkStatus( data.fProgram, isVerbose );
+		GL_CHECK_ERROR();
 
-	glCompileShader( data.fFragmentShader );
-	if ( isVerbose )
-	{
-		kernelStartLine = data.fHeaderNumLines + program->GetFragmentShellNumLines();
+		if ( fCache )
+		{
+			fCache->Save( cacheKey, data.fProgram );
+		}
 	}
-	CheckShaderCompilationStatus( data.fFragmentShader, isVerbose, "fragment", kernelStartLine );
-	GL_CHECK_ERROR();
-
-	glLinkProgram( data.fProgram );
-	CheckProgramLinkStatus( data.fProgram, isVerbose );
-	GL_CHECK_ERROR();
 
 	data.fUniformLocations[Uniform::kViewProjectionMatrix] = glGetUniformLocation( data.fProgram, "u_ViewProjectionMatrix" );
 	GL_CHECK_ERROR();
@@ -23,6 +23,10 @@ namespace Rtt
 
 // ----------------------------------------------------------------------------
 
+class GLProgramCache;
+
+// ----------------------------------------------------------------------------
+
 class GLProgram : public GPUResource
 {
 	public:
@@ -30,7 +34,8 @@ class GLProgram : public GPUResource
 		typedef GLProgram Self;
 
 	public:
-		GLProgram();
+		// If 'cache' is non-NULL, linked versions are stored in and restored from it
+		GLProgram( GLProgramCache* cache = NULL );
 
 		virtual void Create( CPUResource* resource );
 		virtual void Update( CPUResource* resource );
@@ -74,11 +79,12 @@ class GLProgram : public GPUResource
 
 		void Create( Program::Version version, VersionData& data );
 		void Update( Program::Version version, VersionData& data );
-		void UpdateShaderSource( Program* program, Program::Version version, VersionData& data );
+		U64 UpdateShaderSource( Program* program, Program::Version version, VersionData& data );
 		void Reset( VersionData& data );
 
 		VersionData fData[Program::kNumVersions];
 		CPUResource* fResource;
+		GLProgramCache* fCache;
 };
 
 // ----------------------------------------------------------------------------
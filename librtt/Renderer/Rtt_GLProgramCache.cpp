@@ -0,0 +1,415 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Renderer/Rtt_GLProgramCache.h"
+
+#include "Core/Rtt_Allocator.h"
+#include "Core/Rtt_Assert.h"
+#include "Core/Rtt_FileSystem.h"
+
+#if defined( Rtt_OPENGLES )
+	#if defined( Rtt_EGL ) && ! defined( Rtt_EMSCRIPTEN_ENV )
+		#include <EGL/egl.h>
+		#define Rtt_GL_PROGRAM_BINARY_OES
+	#endif
+#elif ! defined( Rtt_MAC_ENV )
+	#define Rtt_GL_PROGRAM_BINARY
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+	using namespace Rtt;
+
+	// Drivers whose binaries are kept, counting the current one. Devices can
+	// switch between GPUs (e.g. laptops), so it is more than one.
+	const size_t kMaxDriverDirectories = 4;
+
+	// Rewritten each time a driver's directory is used
+	const char kStampFilename[] = "/stamp";
+
+	// Bump when the layout below changes
+	const U32 kFileMagic = 0x50545452; // 'RTTP'
+	const U32 kFileVersion = 2;
+
+	struct FileHeader
+	{
+		U32 fMagic;
+		U32 fVersion;
+		U64 fKey;
+		U32 fFormat;
+		U32 fLength;
+	};
+
+#if defined( Rtt_GL_PROGRAM_BINARY_OES )
+	PFNGLGETPROGRAMBINARYOESPROC sGetProgramBinary = NULL;
+	PFNGLPROGRAMBINARYOESPROC sProgramBinary = NULL;
+
+	const GLenum kNumProgramBinaryFormats = GL_NUM_PROGRAM_BINARY_FORMATS_OES;
+	const GLenum kProgramBinaryLength = GL_PROGRAM_BINARY_LENGTH_OES;
+
+	bool isProgramBinarySupported()
+	{
+		sGetProgramBinary = (PFNGLGETPROGRAMBINARYOESPROC) eglGetProcAddress( "glGetProgramBinaryOES" );
+		sProgramBinary = (PFNGLPROGRAMBINARYOESPROC) eglGetProcAddress( "glProgramBinaryOES" );
+
+		return ( NULL != sGetProgramBinary ) && ( NULL != sProgramBinary );
+	}
+
+	void getProgramBinary( GLuint program, GLsizei bufSize, GLsizei *length, GLenum *format, void *binary )
+	{
+		sGetProgramBinary( program, bufSize, length, format, binary );
+	}
+
+	void programBinary( GLuint program, GLenum format, const void *binary, GLint length )
+	{
+		sProgramBinary( program, format, binary, length );
+	}
+#elif defined( Rtt_GL_PROGRAM_BINARY )
+	const GLenum kNumProgramBinaryFormats = GL_NUM_PROGRAM_BINARY_FORMATS;
+	const GLenum kProgramBinaryLength = GL_PROGRAM_BINARY_LENGTH;
+
+	bool isProgramBinarySupported()
+	{
+		// Drivers without GL_ARB_get_program_binary report no formats below
+		return true;
+	}
+
+	void getProgramBinary( GLuint program, GLsizei bufSize, GLsizei *length, GLenum *format, void *binary )
+	{
+		glGetProgramBinary( program, bufSize, length, format, binary );
+	}
+
+	void programBinary( GLuint program, GLenum format, const void *binary, GLint length )
+	{
+		glProgramBinary( program, format, binary, length );
+	}
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+U64
+GLProgramCache::Hash( const char *s, U64 hash )
+{
+	const U64 kPrime = 1099511628211ULL;
+
+	if ( s )
+	{
+		for ( const unsigned char *p = (const unsigned char *)s; *p; ++p )
+		{
+			hash = ( hash ^ *p ) * kPrime;
+		}
+	}
+
+	// Separate consecutive strings, so "ab" + "c" differs from "a" + "bc"
+	hash = ( hash ^ 0xFF ) * kPrime;
+
+	return hash;
+}
+
+GLProgramCache::GLProgramCache( Rtt_Allocator* allocator )
+:	fAllocator( allocator ),
+	fDirectory( allocator ),
+	fDriverDirectory( allocator ),
+	fDriverHash( kHashSeed ),
+	fSupported( -1 )
+{
+}
+
+void
+GLProgramCache::SetDirectory( const char *path )
+{
+	fDirectory.Set( path );
+	fDriverDirectory.Set( NULL );
+}
+
+bool
+GLProgramCache::IsEnabled()
+{
+	if ( fSupported < 0 )
+	{
+		fSupported = 0;
+
+#if defined( Rtt_GL_PROGRAM_BINARY ) || defined( Rtt_GL_PROGRAM_BINARY_OES )
+		GLint numFormats = 0;
+		if ( isProgramBinarySupported() )
+		{
+			glGetIntegerv( kNumProgramBinaryFormats, & numFormats );
+
+			// Unknown to drivers without the extension; don't leave that error
+			// for GL_CHECK_ERROR() to report.
+			while ( GL_NO_ERROR != glGetError() ) {}
+		}
+
+		if ( numFormats > 0 )
+		{
+			fSupported = 1;
+
+			// A driver update invalidates every binary it produced before
+			const GLenum kStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+			for ( size_t i = 0; i < sizeof( kStrings ) / sizeof( kStrings[0] ); i++ )
+			{
+				fDriverHash = Hash( (const char *)glGetString( kStrings[i] ), fDriverHash );
+			}
+		}
+#endif
+	}
+
+	if ( fSupported > 0 && ! fDirectory.IsEmpty() && fDriverDirectory.IsEmpty() )
+	{
+		PrepareDriverDirectory();
+	}
+
+	return fSupported > 0 && ! fDriverDirectory.IsEmpty();
+}
+
+void
+GLProgramCache::PrepareDriverDirectory()
+{
+	char name[32];
+	snprintf( name, sizeof( name ), "%08x%08x", (U32)( fDriverHash >> 32 ), (U32)fDriverHash );
+
+	String path( fAllocator );
+	path.Set( fDirectory.GetString() );
+	path.Append( "/" );
+	path.Append( name );
+
+	if ( Rtt_IsDirectory( path.GetString() ) || Rtt_MakeDirectory( path.GetString() ) )
+	{
+		fDriverDirectory.Set( path.GetString() );
+
+		// Mark the directory as the most recently used one
+		String stamp( fAllocator );
+		stamp.Set( path.GetString() );
+		stamp.Append( kStampFilename );
+
+		FILE *file = Rtt_FileOpen( stamp.GetString(), "wb" );
+		if ( file )
+		{
+			fwrite( name, 1, strlen( name ), file );
+			Rtt_FileClose( file );
+		}
+	}
+
+	RemoveStaleDriverDirectories( name );
+}
+
+// Binaries of other drivers are only loaded again if the device switches back
+// to that driver, so only the most recently used few are kept
+void
+GLProgramCache::RemoveStaleDriverDirectories( const char *currentName ) const
+{
+	typedef std::pair< time_t, std::string > Entry;
+	std::vector< Entry > others;
+
+	std::vector< std::string > entries = Rtt_ListFiles( fDirectory.GetString() );
+	for ( size_t i = 0, iMax = entries.size(); i < iMax; i++ )
+	{
+		// Entries are full paths, with platform specific separators
+		const std::string& entry = entries[i];
+		size_t nameLength = strlen( currentName );
+		if ( entry.length() > nameLength
+			&& 0 == entry.compare( entry.length() - nameLength, nameLength, currentName ) )
+		{
+			continue;
+		}
+
+		if ( ! Rtt_IsDirectory( entry.c_str() ) )
+		{
+			continue;
+		}
+
+		// Directories from before stamps were written count as the oldest
+		struct stat info;
+		std::string stamp = entry + kStampFilename;
+		time_t lastUsed = ( 0 == Rtt_FileStatus( stamp.c_str(), & info ) ? info.st_mtime : 0 );
+
+		others.push_back( Entry( lastUsed, entry ) );
+	}
+
+	if ( others.size() < kMaxDriverDirectories )
+	{
+		return;
+	}
+
+	std::sort( others.begin(), others.end(), std::greater< Entry >() );
+	for ( size_t i = kMaxDriverDirectories - 1, iMax = others.size(); i < iMax; i++ )
+	{
+		Rtt_DeleteDirectory( others[i].second.c_str() );
+	}
+}
+
+void
+GLProgramCache::PathForKey( U64 key, String& result ) const
+{
+	char filename[32];
+	snprintf( filename, sizeof( filename ), "/%08x%08x.bin", (U32)( key >> 32 ), (U32)key );
+
+	result.Set( fDriverDirectory.GetString() );
+	result.Append( filename );
+}
+
+void
+GLProgramCache::WillLink( GLuint program )
+{
+#if defined( Rtt_GL_PROGRAM_BINARY )
+	if ( IsEnabled() )
+	{
+		glProgramParameteri( program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+		GL_CHECK_ERROR();
+	}
+#endif
+}
+
+bool
+GLProgramCache::Load( U64 key, GLuint program )
+{
+	bool result = false;
+
+#if defined( Rtt_GL_PROGRAM_BINARY ) || defined( Rtt_GL_PROGRAM_BINARY_OES )
+	if ( ! IsEnabled() )
+	{
+		return result;
+	}
+
+	String path( fAllocator );
+	PathForKey( key, path );
+
+	FILE *file = Rtt_FileOpen( path.GetString(), "rb" );
+	if ( ! file )
+	{
+		return result;
+	}
+
+	FileHeader header;
+	bool isValid = ( 1 == Rtt_FileRead( & header, sizeof( header ), 1, file ) )
+		&& kFileMagic == header.fMagic
+		&& kFileVersion == header.fVersion
+		&& key == header.fKey
+		&& header.fLength > 0;
+
+	void *binary = NULL;
+	if ( isValid )
+	{
+		binary = Rtt_MALLOC( fAllocator, header.fLength );
+		isValid = binary && ( 1 == Rtt_FileRead( binary, header.fLength, 1, file ) );
+	}
+	Rtt_FileClose( file );
+
+	if ( isValid )
+	{
+		programBinary( program, header.fFormat, binary, header.fLength );
+
+		// Drivers may reject binaries they produced, e.g. after an update
+		GLint status = GL_FALSE;
+		glGetProgramiv( program, GL_LINK_STATUS, & status );
+		while ( GL_NO_ERROR != glGetError() ) {}
+
+		result = ( GL_TRUE == status );
+	}
+
+	if ( binary )
+	{
+		Rtt_FREE( binary );
+	}
+
+	if ( ! result )
+	{
+		Rtt_DeleteFile( path.GetString() );
+	}
+#endif
+
+	return result;
+}
+
+void
+GLProgramCache::Save( U64 key, GLuint program )
+{
+#if defined( Rtt_GL_PROGRAM_BINARY ) || defined( Rtt_GL_PROGRAM_BINARY_OES )
+	if ( ! IsEnabled() )
+	{
+		return;
+	}
+
+	GLint status = GL_FALSE;
+	glGetProgramiv( program, GL_LINK_STATUS, & status );
+
+	GLint length = 0;
+	if ( GL_TRUE == status )
+	{
+		glGetProgramiv( program, kProgramBinaryLength, & length );
+	}
+	GL_CHECK_ERROR();
+
+	if ( length <= 0 )
+	{
+		return;
+	}
+
+	FileHeader header;
+	header.fMagic = kFileMagic;
+	header.fVersion = kFileVersion;
+	header.fKey = key;
+	header.fFormat = 0;
+	header.fLength = 0;
+
+	void *binary = Rtt_MALLOC( fAllocator, length );
+	if ( binary )
+	{
+		GLsizei written = 0;
+		GLenum format = 0;
+		getProgramBinary( program, length, & written, & format, binary );
+		GL_CHECK_ERROR();
+
+		header.fFormat = format;
+		header.fLength = written;
+	}
+
+	if ( header.fLength > 0 )
+	{
+		String path( fAllocator );
+		PathForKey( header.fKey, path );
+
+		FILE *file = Rtt_FileOpen( path.GetString(), "wb" );
+		if ( file )
+		{
+			// A partially written file fails the length check in Load()
+			fwrite( & header, sizeof( header ), 1, file );
+			fwrite( binary, header.fLength, 1, file );
+			Rtt_FileClose( file );
+		}
+	}
+
+	if ( binary )
+	{
+		Rtt_FREE( binary );
+	}
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_GLProgramCache_H__
+#define _Rtt_GLProgramCache_H__
+
+#include "Renderer/Rtt_GL.h"
+#include "Core/Rtt_String.h"
+#include "Core/Rtt_Types.h"
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Stores linked program binaries on disk so that each version of a program is
+// compiled and linked from source only once per device and driver, instead of
+// on every launch. Binaries are keyed by a hash of the program's source, which
+// GLProgram builds with Hash(), and stored in a subdirectory named after the
+// driver that produced them. Only the subdirectories of the few most recently
+// used drivers are kept; older ones (e.g. from before a driver update) are
+// deleted when the cache is first used.
+//
+// Apart from SetDirectory(), all functions must be called from a thread with an
+// active rendering context. They are no-ops when the driver cannot provide
+// program binaries (GL_ARB_get_program_binary / GL_OES_get_program_binary).
+class GLProgramCache
+{
+	public:
+		typedef GLProgramCache Self;
+
+		static const U64 kHashSeed = 14695981039346656037ULL;
+
+		// Incremental FNV-1a hash of the given string
+		static U64 Hash( const char *s, U64 hash );
+
+	public:
+		GLProgramCache( Rtt_Allocator* allocator );
+
+		// Directory the binaries are stored in. Caching is off until set.
+		void SetDirectory( const char *path );
+
+		// Call before linking a program whose binary will be saved.
+		void WillLink( GLuint program );
+
+		// Returns true if the binary stored for 'key' was loaded into 'program'
+		// and linked successfully. Otherwise, 'program' must be linked from
+		// source as usual.
+		bool Load( U64 key, GLuint program );
+
+		// Stores the binary of 'program', if it linked successfully.
+		void Save( U64 key, GLuint program );
+
+	private:
+		bool IsEnabled();
+		void PrepareDriverDirectory();
+		void RemoveStaleDriverDirectories( const char *currentName ) const;
+		void PathForKey( U64 key, String& result ) const;
+
+	private:
+		Rtt_Allocator* fAllocator;
+		String fDirectory;
+		String fDriverDirectory; // Empty until prepared
+		U64 fDriverHash;
+		S8 fSupported; // -1 until queried
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_GLProgramCache_H__
@@ -0,0 +1,267 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Renderer/Rtt_GLReadback.h"
+
+#include "Core/Rtt_Allocator.h"
+
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+#if ! defined( Rtt_OPENGLES ) && defined( GL_PIXEL_PACK_BUFFER )
+	#define Rtt_GL_READBACK_PBO
+#elif defined( Rtt_ANDROID_ENV ) || defined( Rtt_IPHONE_ENV ) || defined( Rtt_TVOS_ENV )
+	// Pack buffers are core in ES 3, but we build against the ES 2 headers,
+	// so the entry points are looked up once an ES 3 context is current
+	#define Rtt_GL_READBACK_PBO
+	#define Rtt_GL_READBACK_ES3
+
+	#include <dlfcn.h>
+
+	#ifndef GL_PIXEL_PACK_BUFFER
+		#define GL_PIXEL_PACK_BUFFER 0x88EB
+	#endif
+	#ifndef GL_STREAM_READ
+		#define GL_STREAM_READ 0x88E1
+	#endif
+	#ifndef GL_MAP_READ_BIT
+		#define GL_MAP_READ_BIT 0x0001
+	#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+#ifdef Rtt_GL_READBACK_ES3
+
+namespace /*anonymous*/
+{
+	typedef void *( GL_APIENTRY *MapBufferRangeProc )( GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access );
+	typedef GLboolean ( GL_APIENTRY *UnmapBufferProc )( GLenum target );
+
+	MapBufferRangeProc sMapBufferRange = NULL;
+	UnmapBufferProc sUnmapBuffer = NULL;
+
+	bool supportsPackBuffers()
+	{
+		static int sSupportsPackBuffers = -1;
+		if ( sSupportsPackBuffers < 0 )
+		{
+			const char *version = (const char *)glGetString( GL_VERSION );
+			if ( version && strstr( version, "OpenGL ES 3" ) )
+			{
+				sMapBufferRange = (MapBufferRangeProc)dlsym( RTLD_DEFAULT, "glMapBufferRange" );
+				sUnmapBuffer = (UnmapBufferProc)dlsym( RTLD_DEFAULT, "glUnmapBuffer" );
+			}
+			sSupportsPackBuffers = ( sMapBufferRange && sUnmapBuffer );
+		}
+
+		return sSupportsPackBuffers > 0;
+	}
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+bool
+GLReadback::IsAsync()
+{
+#if defined( Rtt_GL_READBACK_ES3 )
+	return supportsPackBuffers();
+#elif defined( Rtt_GL_READBACK_PBO )
+	return true;
+#else
+	return false;
+#endif
+}
+
+GLReadback::GLReadback( Rtt_Allocator *allocator )
+:	fAllocator( allocator )
+{
+	memset( fSlots, 0, sizeof( fSlots ) );
+}
+
+GLReadback::~GLReadback()
+{
+	// GL buffers are released in ReleaseGPUResources(), while the context
+	// is still current
+	for ( S32 i = 0; i < kNumSlots; i++ )
+	{
+		if ( ! fSlots[i].fIsMapped )
+		{
+			Rtt_FREE( fSlots[i].fPixels );
+		}
+	}
+}
+
+S32
+GLReadback::Read( S32 x, S32 y, S32 w, S32 h )
+{
+	Rtt_ASSERT( w > 0 && h > 0 );
+
+	S32 result = -1;
+	for ( S32 i = 0; i < kNumSlots && result < 0; i++ )
+	{
+		if ( ! fSlots[i].fIsBusy )
+		{
+			result = i;
+		}
+	}
+
+	if ( result < 0 )
+	{
+		return result;
+	}
+
+	Slot& slot = fSlots[result];
+	U32 size = w * h * 4;
+
+	glPixelStorei( GL_PACK_ALIGNMENT, 4 );
+
+#ifdef Rtt_GL_READBACK_PBO
+	if ( IsAsync() )
+	{
+		ReadToBuffer( slot, x, y, w, h, size );
+	}
+	else
+#endif
+	{
+		if ( slot.fCapacity < size )
+		{
+			Rtt_FREE( slot.fPixels );
+			slot.fPixels = (U8 *)Rtt_MALLOC( fAllocator, size );
+			slot.fCapacity = ( slot.fPixels ? size : 0 );
+		}
+
+		if ( ! slot.fPixels )
+		{
+			return -1;
+		}
+
+		glReadPixels( x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, slot.fPixels );
+	}
+
+	GL_CHECK_ERROR();
+
+	slot.fIsBusy = true;
+
+	return result;
+}
+
+void
+GLReadback::ReadToBuffer( Slot& slot, S32 x, S32 y, S32 w, S32 h, U32 size )
+{
+#ifdef Rtt_GL_READBACK_PBO
+	if ( 0 == slot.fBuffer )
+	{
+		glGenBuffers( 1, & slot.fBuffer );
+	}
+
+	glBindBuffer( GL_PIXEL_PACK_BUFFER, slot.fBuffer );
+	if ( slot.fCapacity < size )
+	{
+		glBufferData( GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ );
+		slot.fCapacity = size;
+	}
+
+	// With a pack buffer bound, the last argument is an offset into it
+	glReadPixels( x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
+	glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+#endif
+}
+
+const U8 *
+GLReadback::Map( S32 slotIndex )
+{
+	Rtt_ASSERT( slotIndex >= 0 && slotIndex < kNumSlots );
+
+	Slot& slot = fSlots[slotIndex];
+	Rtt_ASSERT( slot.fIsBusy );
+
+#ifdef Rtt_GL_READBACK_PBO
+	if ( slot.fBuffer && ! slot.fIsMapped )
+	{
+		glBindBuffer( GL_PIXEL_PACK_BUFFER, slot.fBuffer );
+#ifdef Rtt_GL_READBACK_ES3
+		slot.fPixels = (U8 *)sMapBufferRange( GL_PIXEL_PACK_BUFFER, 0, slot.fCapacity, GL_MAP_READ_BIT );
+#else
+		slot.fPixels = (U8 *)glMapBuffer( GL_PIXEL_PACK_BUFFER, GL_READ_ONLY );
+#endif
+		glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+		slot.fIsMapped = ( NULL != slot.fPixels );
+
+		GL_CHECK_ERROR();
+	}
+#endif
+
+	return slot.fPixels;
+}
+
+void
+GLReadback::Release( S32 slotIndex )
+{
+	Rtt_ASSERT( slotIndex >= 0 && slotIndex < kNumSlots );
+
+	Slot& slot = fSlots[slotIndex];
+
+#ifdef Rtt_GL_READBACK_PBO
+	if ( slot.fIsMapped )
+	{
+		glBindBuffer( GL_PIXEL_PACK_BUFFER, slot.fBuffer );
+#ifdef Rtt_GL_READBACK_ES3
+		sUnmapBuffer( GL_PIXEL_PACK_BUFFER );
+#else
+		glUnmapBuffer( GL_PIXEL_PACK_BUFFER );
+#endif
+		glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+
+		// The mapped pointer is not ours to free
+		slot.fPixels = NULL;
+		slot.fIsMapped = false;
+	}
+#endif
+
+	slot.fIsBusy = false;
+}
+
+void
+GLReadback::ReleaseGPUResources()
+{
+	for ( S32 i = 0; i < kNumSlots; i++ )
+	{
+		Slot& slot = fSlots[i];
+
+#ifdef Rtt_GL_READBACK_PBO
+		Release( i );
+
+		if ( slot.fBuffer )
+		{
+			glDeleteBuffers( 1, & slot.fBuffer );
+			slot.fBuffer = 0;
+			slot.fCapacity = 0;
+		}
+#endif
+
+		slot.fIsBusy = false;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_GLReadback_H__
+#define _Rtt_GLReadback_H__
+
+#include "Renderer/Rtt_GL.h"
+#include "Core/Rtt_Types.h"
+#include "Core/Rtt_Macros.h"
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Reads RGBA8 pixels back from the currently bound framebuffer through a small
+// ring of slots. Where pixel buffer objects are available (desktop GL, ES 3)
+// the copy is only queued on the GPU, so the caller should wait at least a frame
+// before calling Map() to avoid stalling. On GL ES 2 the pixels are read
+// immediately.
+//
+// All methods must be called with the GL context current.
+class GLReadback
+{
+	Rtt_CLASS_NO_COPIES( GLReadback )
+
+	public:
+		enum
+		{
+			kNumSlots = 3
+		};
+
+	public:
+		// Whether reads go through pixel buffers. Depends on the context on ES.
+		static bool IsAsync();
+
+	public:
+		GLReadback( Rtt_Allocator *allocator );
+		~GLReadback();
+
+	public:
+		// Starts reading the given rect (in pixels, relative to OpenGL's origin).
+		// Returns the slot, or -1 if every slot is still in use.
+		S32 Read( S32 x, S32 y, S32 w, S32 h );
+
+		// Returns the pixels of a slot, bottom row first. Rows are tightly packed.
+		const U8 *Map( S32 slot );
+
+		// Unmaps the slot and makes it available again
+		void Release( S32 slot );
+
+		// Releases the GL buffers. Call when the context is torn down.
+		void ReleaseGPUResources();
+
+	private:
+		struct Slot
+		{
+			GLuint fBuffer;
+			U8 *fPixels;
+			U32 fCapacity;
+			bool fIsBusy;
+			bool fIsMapped;
+		};
+
+	private:
+		void ReadToBuffer( Slot& slot, S32 x, S32 y, S32 w, S32 h, U32 size );
+
+	private:
+		Rtt_Allocator *fAllocator;
+		Slot fSlots[kNumSlots];
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_GLReadback_H__
@@ -13,6 +13,8 @@
 #include "Renderer/Rtt_GLFrameBufferObject.h"
 #include "Renderer/Rtt_GLGeometry.h"
 #include "Renderer/Rtt_GLProgram.h"
+#include "Renderer/Rtt_GLProgramCache.h"
+#include "Renderer/Rtt_GLStreamBuffer.h"
 #include "Renderer/Rtt_GLTexture.h"
 #include "Renderer/Rtt_CPUResource.h"
 #include "Core/Rtt_Assert.h"
@@ -25,10 +27,34 @@ namespace Rtt
 // ----------------------------------------------------------------------------
 
 GLRenderer::GLRenderer( Rtt_Allocator* allocator )
-:   Super( allocator )
+:   Super( allocator ),
+	fProgramCache( Rtt_NEW( allocator, GLProgramCache( allocator ) ) ),
+	fStreamBuffer( Rtt_NEW( allocator, GLStreamBuffer() ) )
 {
-	fFrontCommandBuffer = Rtt_NEW( allocator, GLCommandBuffer( allocator ) );
-	fBackCommandBuffer = Rtt_NEW( allocator, GLCommandBuffer( allocator ) );
+	fFrontCommandBuffer = Rtt_NEW( allocator, GLCommandBuffer( allocator, fStreamBuffer ) );
+	fBackCommandBuffer = Rtt_NEW( allocator, GLCommandBuffer( allocator, fStreamBuffer ) );
+}
+
+GLRenderer::~GLRenderer()
+{
+	fStreamBuffer->ReleaseGPUResources();
+
+	Rtt_DELETE( fStreamBuffer );
+	Rtt_DELETE( fProgramCache );
+}
+
+void
+GLRenderer::SetProgramCacheDirectory( const char* path )
+{
+	fProgramCache->SetDirectory( path );
+}
+
+void
+GLRenderer::ReleaseGPUResources()
+{
+	Super::ReleaseGPUResources();
+
+	fStreamBuffer->ReleaseGPUResources();
 }
 
 GPUResource* 
@@ -37,8 +63,8 @@ GLRenderer::Create( const CPUResource* resource )
 	switch( resource->GetType() )
 	{
 		case CPUResource::kFrameBufferObject: return new GLFrameBufferObject;
-		case CPUResource::kGeometry: return new GLGeometry;
-		case CPUResource::kProgram: return new GLProgram;
+		case CPUResource::kGeometry: return new GLGeometry( fStreamBuffer );
+		case CPUResource::kProgram: return new GLProgram( fProgramCache );
 		case CPUResource::kTexture: return new GLTexture;
 		case CPUResource::kUniform: return NULL;
 		default: Rtt_ASSERT_NOT_REACHED(); return NULL;
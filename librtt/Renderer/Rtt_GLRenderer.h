@@ -21,6 +21,8 @@ namespace Rtt
 
 class GPUResource;
 class CPUResource;
+class GLProgramCache;
+class GLStreamBuffer;
 
 // ----------------------------------------------------------------------------
 
@@ -32,10 +34,18 @@ class GLRenderer : public Renderer
 
 	public:
 		GLRenderer( Rtt_Allocator* allocator );
+		virtual ~GLRenderer();
+
+		virtual void SetProgramCacheDirectory( const char* path );
+		virtual void ReleaseGPUResources();
 
 	protected:
 		// Create an OpenGL resource appropriate for the given CPUResource.
 		virtual GPUResource* Create( const CPUResource* resource );
+
+	private:
+		GLProgramCache* fProgramCache;
+		GLStreamBuffer* fStreamBuffer;
 };
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,163 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Renderer/Rtt_GLStreamBuffer.h"
+
+#include "Core/Rtt_Assert.h"
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+	// Keeps every write aligned for any vertex attribute
+	const size_t kAlignment = 16;
+
+	size_t alignSize( size_t size )
+	{
+		return ( size + kAlignment - 1 ) & ~( kAlignment - 1 );
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+GLStreamBuffer::GLStreamBuffer()
+:	fQuadCornersName( 0 ),
+	fOffset( 0 ),
+	fIndex( 0 ),
+	fGeneration( 0 )
+{
+	for ( U32 i = 0; i < kNumFrames; i++ )
+	{
+		fNames[i] = 0;
+		fSizes[i] = kMinSize;
+	}
+}
+
+void
+GLStreamBuffer::BeginFrame()
+{
+	fIndex = ( fIndex + 1 ) % kNumFrames;
+	fOffset = 0;
+	++fGeneration;
+
+	if ( 0 == fNames[fIndex] )
+	{
+		glGenBuffers( 1, &fNames[fIndex] );
+		GL_CHECK_ERROR();
+	}
+
+	Orphan( fSizes[fIndex] );
+}
+
+GLintptr
+GLStreamBuffer::Write( const void* data, size_t size )
+{
+	Rtt_ASSERT( 0 != fNames[fIndex] ); // Must follow BeginFrame()
+
+	const size_t alignedSize = alignSize( size );
+	if ( fOffset + alignedSize > fSizes[fIndex] )
+	{
+		// Draws issued so far keep the old storage. Data that's still to be
+		// drawn is written again, see GetGeneration(), so make room for all
+		// of this frame.
+		size_t newSize = fSizes[fIndex];
+		while ( newSize < fOffset + alignedSize )
+		{
+			newSize *= 2;
+		}
+
+		Orphan( newSize );
+		fOffset = 0;
+		++fGeneration;
+	}
+	else
+	{
+		glBindBuffer( GL_ARRAY_BUFFER, fNames[fIndex] );
+	}
+
+	GLintptr result = fOffset;
+	if ( size > 0 )
+	{
+		glBufferSubData( GL_ARRAY_BUFFER, result, size, data );
+		GL_CHECK_ERROR();
+	}
+	fOffset += alignedSize;
+
+	return result;
+}
+
+GLuint
+GLStreamBuffer::GetQuadCornersName()
+{
+	if ( 0 == fQuadCornersName )
+	{
+		// In triangle strip order
+		const GLfloat kQuadCorners[] =
+		{
+			0.0f, 0.0f,
+			0.0f, 1.0f,
+			1.0f, 0.0f,
+			1.0f, 1.0f
+		};
+
+		glGenBuffers( 1, & fQuadCornersName );
+		glBindBuffer( GL_ARRAY_BUFFER, fQuadCornersName );
+		glBufferData( GL_ARRAY_BUFFER, sizeof( kQuadCorners ), kQuadCorners, GL_STATIC_DRAW );
+		GL_CHECK_ERROR();
+	}
+
+	return fQuadCornersName;
+}
+
+void
+GLStreamBuffer::ReleaseGPUResources()
+{
+	for ( U32 i = 0; i < kNumFrames; i++ )
+	{
+		if ( 0 != fNames[i] )
+		{
+			glDeleteBuffers( 1, & fNames[i] );
+			fNames[i] = 0;
+		}
+	}
+
+	if ( 0 != fQuadCornersName )
+	{
+		glDeleteBuffers( 1, & fQuadCornersName );
+		fQuadCornersName = 0;
+	}
+	GL_CHECK_ERROR();
+
+	// Geometry written to the deleted buffers must be written again
+	fOffset = 0;
+	++fGeneration;
+}
+
+void
+GLStreamBuffer::Orphan( size_t size )
+{
+	glBindBuffer( GL_ARRAY_BUFFER, fNames[fIndex] );
+	glBufferData( GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW );
+	GL_CHECK_ERROR();
+
+	fSizes[fIndex] = size;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
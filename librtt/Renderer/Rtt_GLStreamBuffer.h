@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_GLStreamBuffer_H__
+#define _Rtt_GLStreamBuffer_H__
+
+#include "Renderer/Rtt_GL.h"
+#include "Core/Rtt_Types.h"
+
+#include <stddef.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Vertex buffers for data that is rewritten every frame, i.e. the batches
+// filled from the GeometryPool. Instead of the driver copying client-side
+// arrays at every draw, each frame's data is appended once to the next of
+// kNumFrames buffers. A buffer is orphaned whenever it is reused, so writes
+// never wait on draws that are still in flight.
+//
+// All functions must be called from a thread with an active rendering
+// context. Buffers are created on demand, so BeginFrame() recreates them
+// after ReleaseGPUResources().
+class GLStreamBuffer
+{
+	public:
+		typedef GLStreamBuffer Self;
+
+		static const U32 kNumFrames = 3;
+
+		// Initial size of each buffer. Buffers grow to the largest frame.
+		static const size_t kMinSize = 1024 * 1024;
+
+	public:
+		GLStreamBuffer();
+
+	public:
+		// Moves on to the next buffer. Call before writing a frame's data.
+		void BeginFrame();
+
+		// Copies 'size' bytes to the current buffer, which is left bound to
+		// GL_ARRAY_BUFFER, and returns the offset they start at.
+		GLintptr Write( const void* data, size_t size );
+
+		GLuint GetName() const { return fNames[fIndex]; }
+
+		// Static buffer holding the corners of the unit quad that instanced
+		// draws expand (see GLGeometry::BindInstances()), created on first use.
+		GLuint GetQuadCornersName();
+
+		// Deletes the buffers. Call before the context is torn down.
+		void ReleaseGPUResources();
+
+		// Changes whenever earlier writes become unavailable: on a new frame,
+		// or when the current buffer had to grow. Data written under another
+		// generation must be written again before it is drawn.
+		U32 GetGeneration() const { return fGeneration; }
+
+	private:
+		void Orphan( size_t size );
+
+	private:
+		GLuint fNames[kNumFrames];
+		GLuint fQuadCornersName;
+		size_t fSizes[kNumFrames];
+		size_t fOffset;
+		U32 fIndex;
+		U32 fGeneration;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_GLStreamBuffer_H__
@@ -14,6 +14,9 @@
 #include "Renderer/Rtt_GL.h"
 #include "Renderer/Rtt_Texture.h"
 #include "Core/Rtt_Assert.h"
+#include "Core/Rtt_Math.h"
+
+#include <string.h>
 
 // ----------------------------------------------------------------------------
 
@@ -25,6 +28,39 @@
 	#define DEBUG_PRINT( ... )
 #endif
 
+// Compressed format tokens, which not every GL header defines
+
+#ifndef GL_ETC1_RGB8_OES
+	#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+	#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+	#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+	#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+// Unpack state for subloading part of a larger image (ES 3, EXT_unpack_subimage)
+
+#ifndef GL_UNPACK_ROW_LENGTH
+	#define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+#ifndef GL_UNPACK_SKIP_ROWS
+	#define GL_UNPACK_SKIP_ROWS 0x0CF3
+#endif
+#ifndef GL_UNPACK_SKIP_PIXELS
+	#define GL_UNPACK_SKIP_PIXELS 0x0CF4
+#endif
+
 // ----------------------------------------------------------------------------
 
 namespace /*anonymous*/ 
@@ -54,8 +90,134 @@ namespace /*anonymous*/
 			// case Texture::kABGR:		internalFormat = GL_RGBA;		sourceFormat = GL_RGBA;			sourceType = GL_UNSIGNED_BYTE; break;
 #endif
 
+			// Compressed data is passed as is, see GLTexture::UploadCompressed()
+			case Texture::kETC1:
+			case Texture::kETC2_RGB:
+			case Texture::kETC2_RGBA:
+			case Texture::kASTC_4x4:
+			case Texture::kBC1:
+			case Texture::kBC3:
+				internalFormat = GLTexture::GetCompressedFormatToken( format ); sourceFormat = 0; sourceType = 0; break;
+
+			default: Rtt_ASSERT_NOT_REACHED();
+		}
+	}
+
+	bool hasCompleteMipChain( U32 w, U32 h, U32 numLevels )
+	{
+		U32 numRequired = 1;
+		for ( U32 size = ( w > h ? w : h ); size > 1; size >>= 1 )
+		{
+			++numRequired;
+		}
+
+		return numLevels >= numRequired;
+	}
+
+	GLenum getMipmapFilterToken( Texture::Filter filter )
+	{
+		GLenum result = GL_LINEAR_MIPMAP_NEAREST;
+
+		switch( filter )
+		{
+			case Texture::kNearest:			result = GL_NEAREST_MIPMAP_NEAREST; break;
+			case Texture::kLinear:			result = GL_LINEAR_MIPMAP_NEAREST; break;
+			case Texture::kLinearMipmap:	result = GL_LINEAR_MIPMAP_LINEAR; break;
 			default: Rtt_ASSERT_NOT_REACHED();
 		}
+
+		return result;
+	}
+
+	bool isPowerOfTwo( U32 value )
+	{
+		return 0 != value && 0 == ( value & ( value - 1 ) );
+	}
+
+	// ES 2.0 only generates levels for power-of-two sizes
+	bool canGenerateMipmaps( U32 w, U32 h )
+	{
+#if defined( Rtt_OPENGLES )
+		static int sSupportsNPOT = -1;
+		if ( sSupportsNPOT < 0 )
+		{
+			const char *version = (const char *)glGetString( GL_VERSION );
+			const char *extensions = (const char *)glGetString( GL_EXTENSIONS );
+			sSupportsNPOT = ( version && strstr( version, "OpenGL ES 3" ) )
+				|| ( extensions && strstr( extensions, "GL_OES_texture_npot" ) );
+		}
+
+		return sSupportsNPOT || ( isPowerOfTwo( w ) && isPowerOfTwo( h ) );
+#else
+		return true;
+#endif
+	}
+
+	// ES 2.0 can only read whole rows of the source image
+	bool canUnpackSubimage()
+	{
+#if defined( Rtt_OPENGLES )
+		static int sSupportsSubimage = -1;
+		if ( sSupportsSubimage < 0 )
+		{
+			const char *version = (const char *)glGetString( GL_VERSION );
+			const char *extensions = (const char *)glGetString( GL_EXTENSIONS );
+			sSupportsSubimage = ( version && strstr( version, "OpenGL ES 3" ) )
+				|| ( extensions && strstr( extensions, "GL_EXT_unpack_subimage" ) );
+		}
+
+		return sSupportsSubimage > 0;
+#else
+		return true;
+#endif
+	}
+
+	// Subloads the given areas of a w x h image, which matches the bound texture
+	void subloadRects(
+		const U8* data, U32 w, U32 h, Texture::Format textureFormat, GLenum format, GLenum type,
+		const Texture::DirtyRect* rects, U32 numRects )
+	{
+		const bool isSubimage = canUnpackSubimage();
+		if ( isSubimage )
+		{
+			glPixelStorei( GL_UNPACK_ROW_LENGTH, w );
+		}
+
+		const size_t bytesPerRow = Texture::GetImageSizeInBytes( textureFormat, w, 1 );
+		for ( U32 i = 0; i < numRects; i++ )
+		{
+			const Texture::DirtyRect& rect = rects[i];
+			if ( rect.x >= w || rect.y >= h )
+			{
+				continue;
+			}
+
+			const U32 rectW = Min( rect.width, w - rect.x );
+			const U32 rectH = Min( rect.height, h - rect.y );
+			if ( 0 == rectW || 0 == rectH )
+			{
+				continue;
+			}
+
+			if ( isSubimage )
+			{
+				glPixelStorei( GL_UNPACK_SKIP_PIXELS, rect.x );
+				glPixelStorei( GL_UNPACK_SKIP_ROWS, rect.y );
+				glTexSubImage2D( GL_TEXTURE_2D, 0, rect.x, rect.y, rectW, rectH, format, type, data );
+			}
+			else
+			{
+				// Rows spanning the area are contiguous in the source
+				glTexSubImage2D( GL_TEXTURE_2D, 0, 0, rect.y, w, rectH, format, type, data + rect.y * bytesPerRow );
+			}
+		}
+
+		if ( isSubimage )
+		{
+			glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+			glPixelStorei( GL_UNPACK_SKIP_PIXELS, 0 );
+			glPixelStorei( GL_UNPACK_SKIP_ROWS, 0 );
+		}
 	}
 
 	void getFilterTokens( Texture::Filter filter, GLenum& minFilter, GLenum& magFilter )
@@ -64,6 +226,9 @@ namespace /*anonymous*/
 		{
 			case Texture::kNearest:	minFilter = GL_NEAREST;	magFilter = GL_NEAREST;	break;
 			case Texture::kLinear:	minFilter = GL_LINEAR;	magFilter = GL_LINEAR;	break;
+
+			// Until levels exist, see GLTexture::ApplyFilter()
+			case Texture::kLinearMipmap:	minFilter = GL_LINEAR;	magFilter = GL_LINEAR;	break;
 			default: Rtt_ASSERT_NOT_REACHED();
 		}
 	}
@@ -91,6 +256,25 @@ namespace Rtt
 
 // ----------------------------------------------------------------------------
 
+GLenum
+GLTexture::GetCompressedFormatToken( Texture::Format format )
+{
+	GLenum result = 0;
+
+	switch ( format )
+	{
+		case Texture::kETC1:		result = GL_ETC1_RGB8_OES; break;
+		case Texture::kETC2_RGB:	result = GL_COMPRESSED_RGB8_ETC2; break;
+		case Texture::kETC2_RGBA:	result = GL_COMPRESSED_RGBA8_ETC2_EAC; break;
+		case Texture::kASTC_4x4:	result = GL_COMPRESSED_RGBA_ASTC_4x4_KHR; break;
+		case Texture::kBC1:			result = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+		case Texture::kBC3:			result = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+		default: break;
+	}
+
+	return result;
+}
+
 void 
 GLTexture::Create( CPUResource* resource )
 {
@@ -125,8 +309,17 @@ GLTexture::Create( CPUResource* resource )
 
 	const U32 w = texture->GetWidth();
 	const U32 h = texture->GetHeight();
-	const U8* data = texture->GetData();
+	if ( Texture::IsCompressed( textureFormat ) )
 	{
+		UploadCompressed( texture, internalFormat );
+
+		fCachedFormat = internalFormat;
+		fCachedWidth = w;
+		fCachedHeight = h;
+	}
+	else
+	{
+		const U8* data = texture->GetData();
 #if defined( Rtt_EMSCRIPTEN_ENV )
 		glPixelStorei( GL_UNPACK_ALIGNMENT, texture->GetByteAlignment() );
 		GL_CHECK_ERROR();
@@ -140,6 +333,7 @@ GLTexture::Create( CPUResource* resource )
 		fCachedWidth = w;
 		fCachedHeight = h;
 	}
+	ApplyFilter( texture );
 	texture->ReleaseData();
 
 	DEBUG_PRINT( "%s : OpenGL name: %d\n",
@@ -153,6 +347,26 @@ GLTexture::Update( CPUResource* resource )
 	Rtt_ASSERT( CPUResource::kTexture == resource->GetType() );
 	Texture* texture = static_cast<Texture*>( resource );
 
+	if ( Texture::IsCompressed( texture->GetFormat() ) )
+	{
+		// Compressed images can't be partially replaced here
+		GLenum internalFormat = GetCompressedFormatToken( texture->GetFormat() );
+		glBindTexture( GL_TEXTURE_2D, GetName() );
+		UploadCompressed( texture, internalFormat );
+
+		fCachedFormat = internalFormat;
+		fCachedWidth = texture->GetWidth();
+		fCachedHeight = texture->GetHeight();
+
+		ApplyFilter( texture );
+		texture->ReleaseData();
+		return;
+	}
+
+	// Queried first, so sources can report areas before handing over data
+	Texture::DirtyRect rects[Texture::kMaxDirtyRects];
+	const U32 numRects = texture->GetDirtyRects( rects, Texture::kMaxDirtyRects );
+
 	const U8* data = texture->GetData();		
 	if( data )
 	{		
@@ -166,7 +380,14 @@ GLTexture::Update( CPUResource* resource )
 		glBindTexture( GL_TEXTURE_2D, GetName() );
 		if (internalFormat == fCachedFormat && w == fCachedWidth && h == fCachedHeight )
 		{
-			glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, w, h, format, type, data );
+			if ( numRects > 0 && numRects <= Texture::kMaxDirtyRects )
+			{
+				subloadRects( data, w, h, texture->GetFormat(), format, type, rects, numRects );
+			}
+			else
+			{
+				glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, w, h, format, type, data );
+			}
 		}
 		else
 		{
@@ -176,10 +397,47 @@ GLTexture::Update( CPUResource* resource )
 			fCachedHeight = h;
 		}
 		GL_CHECK_ERROR();
+
+		ApplyFilter( texture );
 	}
 	texture->ReleaseData();
 }
 
+void
+GLTexture::ApplyFilter( Texture* texture )
+{
+	const U32 w = texture->GetWidth();
+	const U32 h = texture->GetHeight();
+	const Texture::Filter filter = texture->GetFilter();
+
+	bool isMipmapped = false;
+	if ( Texture::IsCompressed( texture->GetFormat() ) )
+	{
+		// Sample the pre-built levels, if there are enough to be complete
+		isMipmapped = texture->GetNumLevels() > 1 && hasCompleteMipChain( w, h, texture->GetNumLevels() );
+	}
+	else if ( Texture::kLinearMipmap == filter && texture->GetData() && canGenerateMipmaps( w, h ) )
+	{
+		// Regenerated on every upload, so levels always match level 0
+		Rtt_glGenerateMipmap( GL_TEXTURE_2D );
+		GL_CHECK_ERROR();
+
+		isMipmapped = true;
+	}
+
+	GLenum minFilter;
+	GLenum magFilter;
+	getFilterTokens( filter, minFilter, magFilter );
+	if ( isMipmapped )
+	{
+		minFilter = getMipmapFilterToken( filter );
+	}
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter );
+	GL_CHECK_ERROR();
+}
+
 void 
 GLTexture::Destroy()
 {
@@ -210,6 +468,30 @@ GLTexture::GetName()
 	return HandleToName( fHandle );
 }
 
+void
+GLTexture::UploadCompressed( Texture* texture, GLenum internalFormat )
+{
+	const Texture::Format format = texture->GetFormat();
+	U32 w = texture->GetWidth();
+	U32 h = texture->GetHeight();
+
+	for ( U32 level = 0, iMax = texture->GetNumLevels(); level < iMax; level++ )
+	{
+		const U8* data = texture->GetLevelData( level );
+		if ( ! data )
+		{
+			break;
+		}
+
+		GLsizei numBytes = (GLsizei)Texture::GetImageSizeInBytes( format, w, h );
+		glCompressedTexImage2D( GL_TEXTURE_2D, level, internalFormat, w, h, 0, numBytes, data );
+		GL_CHECK_ERROR();
+
+		w = ( w > 1 ? w >> 1 : 1 );
+		h = ( h > 1 ? h >> 1 : 1 );
+	}
+}
+
 // ----------------------------------------------------------------------------
 
 } // namespace Rtt
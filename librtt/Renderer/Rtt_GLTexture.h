@@ -12,6 +12,7 @@
 
 #include "Renderer/Rtt_GL.h"
 #include "Renderer/Rtt_GPUResource.h"
+#include "Renderer/Rtt_Texture.h"
 
 // ----------------------------------------------------------------------------
 
@@ -26,6 +27,10 @@ class GLTexture : public GPUResource
 		typedef GPUResource Super;
 		typedef GLTexture Self;
 
+	public:
+		// Returns 0 for formats that aren't compressed
+		static GLenum GetCompressedFormatToken( Texture::Format format );
+
 	public:
 		virtual void Create( CPUResource* resource );
 		virtual void Update( CPUResource* resource );
@@ -33,6 +38,14 @@ class GLTexture : public GPUResource
 		virtual void Bind( U32 unit );
 
 		virtual GLuint GetName();
+
+	private:
+		void UploadCompressed( Texture* texture, GLenum internalFormat );
+
+		// Sets the sampling filters of the bound texture once its data is
+		// uploaded. Mip levels are generated here if the filter asks for them.
+		void ApplyFilter( Texture* texture );
+
 private:
 	GLint fCachedFormat;
 	unsigned long fCachedWidth, fCachedHeight;
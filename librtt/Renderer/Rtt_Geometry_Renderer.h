@@ -68,6 +68,30 @@ class Geometry : public CPUResource
 			Real ux, uy, uz, uw; // 16 bytes
 		};
 
+		// Batched vertices for programs that use neither the user data nor
+		// q (see Program::GetVertexFormat()). z is not used by any program.
+		struct CompactVertex
+		{
+			Real x, y;			 // 8 bytes
+			Real u, v;			 // 8 bytes
+			U8 rs, gs, bs, as;	 // 4 bytes
+		};
+
+		// A quad drawn through the instanced path (see Renderer::Insert()).
+		// Its corners, in triangle strip order, are the origin, origin + b,
+		// origin + a and origin + a + b. Texture coordinates vary the same way.
+		struct Instance
+		{
+			Real x, y;			 // Origin
+			Real ax, ay;		 // Edge a
+			Real bx, by;		 // Edge b
+			Real u, v;			 // Texture coordinates at the origin
+			Real au, av;		 // Change along edge a
+			Real bu, bv;		 // Change along edge b
+			U8 rs, gs, bs, as;
+			Real ux, uy, uz, uw;
+		};
+
 		typedef U16 Index;
 
 		// Generic vertex attribute indices
@@ -76,6 +100,12 @@ class Geometry : public CPUResource
 		static const U32 kVertexColorScaleAttribute = 2;
 		static const U32 kVertexUserDataAttribute = 3;
 
+		// Additional attributes of the instanced path. The quad's corner,
+		// color scale and user data use the attributes above.
+		static const U32 kInstancePositionAttribute = 4; // x, y, ax, ay
+		static const U32 kInstanceEdgeAttribute = 5; // bx, by, u, v
+		static const U32 kInstanceTexCoordAttribute = 6; // au, av, bu, bv
+
 	public:
 		// If storeOnGPU is true, a copy of the vertex data will be stored
 		// in GPU memory. For large, infrequently changing data, this can
@@ -79,7 +79,9 @@ Program::Program( Rtt_Allocator* allocator )
 	fHeaderSource( NULL ),
 	fVertexShellNumLines( 0 ),
 	fFragmentShellNumLines( 0 ),
-	fCompilerVerbose( false )
+	fCompilerVerbose( false ),
+	fVertexFormat( kFullVertexFormat ),
+	fPrecompiled( false )
 {
 
 }
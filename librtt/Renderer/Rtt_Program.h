@@ -48,10 +48,25 @@ class Program : public CPUResource
 			kMaskCount1,
 			kMaskCount2,
 			kMaskCount3,
+
+			// Same as above, for quads drawn through the instanced path
+			kInstancedMaskCount0,
+			kInstancedMaskCount1,
+			kInstancedMaskCount2,
+			kInstancedMaskCount3,
+
 			kNumVersions
 		}
 		Version;
 
+		// Layout of the vertices the program is fed when batched
+		typedef enum _VertexFormat
+		{
+			kFullVertexFormat = 0,	// Geometry::Vertex
+			kCompactVertexFormat	// Geometry::CompactVertex
+		}
+		VertexFormat;
+
 		static const char *HeaderForLanguage( Language language, const ProgramHeader& headerData );
 
 		static int CountLines( const char *str );
@@ -84,6 +99,16 @@ class Program : public CPUResource
 		bool IsCompilerVerbose() const { return fCompilerVerbose; }
 		void SetCompilerVerbose( bool newValue ) { fCompilerVerbose = newValue; }
 
+		// Programs that read neither the vertex user data nor the texture
+		// coordinate's q can be fed the compact format. Defaults to full.
+		VertexFormat GetVertexFormat() const { return fVertexFormat; }
+		void SetVertexFormat( VertexFormat newValue ) { fVertexFormat = newValue; }
+
+		// Precompiled programs compile and link their unmasked versions as
+		// soon as they are created, instead of when first drawn.
+		bool IsPrecompiled() const { return fPrecompiled; }
+		void SetPrecompiled( bool newValue ) { fPrecompiled = newValue; }
+
 
 	private:
 		char *fVertexShaderSource;
@@ -94,6 +119,8 @@ class Program : public CPUResource
 		int fFragmentShellNumLines;
 		ShaderResource *fResource;
 		bool fCompilerVerbose;
+		VertexFormat fVertexFormat;
+		bool fPrecompiled;
 };
 
 // ----------------------------------------------------------------------------
@@ -538,6 +538,7 @@ RenderTypes::BlendEquationForString( const char *str )
 
 static const char kLinearTextureFilterKey[] = "linear";
 static const char kNearestTextureFilterKey[] = "nearest";
+static const char kTrilinearTextureFilterKey[] = "trilinear";
 
 RenderTypes::TextureFilter
 RenderTypes::TextureFilterForString( const char *str )
@@ -550,6 +551,10 @@ RenderTypes::TextureFilterForString( const char *str )
 		{
 			result = kNearestTextureFilter;
 		}
+		else if ( 0 == strcmp( str, kTrilinearTextureFilterKey ) )
+		{
+			result = kTrilinearTextureFilter;
+		}
 	}
 
 	return result;
@@ -565,6 +570,9 @@ RenderTypes::StringForTextureFilter( TextureFilter filter )
 		case kNearestTextureFilter:
 			result = kNearestTextureFilterKey;
 			break;
+		case kTrilinearTextureFilter:
+			result = kTrilinearTextureFilterKey;
+			break;
 		default:
 			break;
 	}
@@ -633,6 +641,9 @@ RenderTypes::Convert( Texture::Filter filter )
 		case Texture::kLinear:
 			result = RenderTypes::kLinearTextureFilter;
 			break;
+		case Texture::kLinearMipmap:
+			result = RenderTypes::kTrilinearTextureFilter;
+			break;
 		default:
 			Rtt_ASSERT_NOT_IMPLEMENTED();
 			break;
@@ -654,6 +665,9 @@ RenderTypes::Convert( RenderTypes::TextureFilter filter )
 		case RenderTypes::kLinearTextureFilter:
 			result = Texture::kLinear;
 			break;
+		case RenderTypes::kTrilinearTextureFilter:
+			result = Texture::kLinearMipmap;
+			break;
 		default:
 			Rtt_ASSERT_NOT_IMPLEMENTED();
 			break;
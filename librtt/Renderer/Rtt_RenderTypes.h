@@ -121,6 +121,7 @@ class RenderTypes
 		{
 			kLinearTextureFilter = 0,
 			kNearestTextureFilter,
+			kTrilinearTextureFilter, // Linear, between mip levels too
 
 			kNumTextureFilters
 		}
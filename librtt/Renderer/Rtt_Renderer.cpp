@@ -65,6 +65,86 @@ namespace /*anonymous*/
 				return geometry->GetVerticesUsed();
 		}
 	}
+
+	// Instances and compact vertices are packed tightly into the pooled
+	// Geometry. Returns how many (full) vertices the given bytes occupy.
+	U32 ComputePackedVertices( U32 bytes )
+	{
+		const U32 vertexSize = sizeof( Rtt::Geometry::Vertex );
+		return ( bytes + vertexSize - 1 ) / vertexSize;
+	}
+
+	void CopyCompactVertex( const Rtt::Geometry::Vertex& src, Rtt::Geometry::CompactVertex& dst )
+	{
+		dst.x = src.x;
+		dst.y = src.y;
+		dst.u = src.u;
+		dst.v = src.v;
+		dst.rs = src.rs;
+		dst.gs = src.gs;
+		dst.bs = src.bs;
+		dst.as = src.as;
+	}
+
+	bool IsNear( Rtt::Real a, Rtt::Real b, Rtt::Real tolerance )
+	{
+		return Rtt_RealAbs( a - b ) <= tolerance;
+	}
+
+	// Rects, image sheet frames, etc. arrive as a 4 vertex strip whose corners
+	// form a parallelogram. If the texture coordinates vary linearly across it
+	// and the color and user data are shared, the geometry is fully described
+	// by a Geometry::Instance. Anything else (e.g. distorted paths) is not.
+	bool ComputeInstance( Rtt::Geometry* geometry, Rtt::Geometry::Instance& instance )
+	{
+		using namespace Rtt;
+
+		if( geometry->GetPrimitiveType() != Geometry::kTriangleStrip || geometry->GetVerticesUsed() != 4 )
+		{
+			return false;
+		}
+
+		const Geometry::Vertex* v = geometry->GetVertexData();
+
+		// Positions are in content units, texture coordinates are normalized
+		const Real kPositionTolerance = Rtt_REAL_1 / 256;
+		const Real kTexCoordTolerance = Rtt_REAL_1 / 65536;
+
+		instance.x = v[0].x;
+		instance.y = v[0].y;
+		instance.ax = v[2].x - v[0].x;
+		instance.ay = v[2].y - v[0].y;
+		instance.bx = v[1].x - v[0].x;
+		instance.by = v[1].y - v[0].y;
+
+		instance.u = v[0].u;
+		instance.v = v[0].v;
+		instance.au = v[2].u - v[0].u;
+		instance.av = v[2].v - v[0].v;
+		instance.bu = v[1].u - v[0].u;
+		instance.bv = v[1].v - v[0].v;
+
+		bool result =
+			IsNear( v[3].x, instance.x + instance.ax + instance.bx, kPositionTolerance )
+			&& IsNear( v[3].y, instance.y + instance.ay + instance.by, kPositionTolerance )
+			&& IsNear( v[3].u, instance.u + instance.au + instance.bu, kTexCoordTolerance )
+			&& IsNear( v[3].v, instance.v + instance.av + instance.bv, kTexCoordTolerance );
+
+		for( U32 i = 0; i < 4 && result; ++i )
+		{
+			result = Rtt_REAL_1 == v[i].q
+				&& 0 == memcmp( & v[0].rs, & v[i].rs, 4 * sizeof( U8 ) )
+				&& 0 == memcmp( & v[0].ux, & v[i].ux, 4 * sizeof( Real ) );
+		}
+
+		if( result )
+		{
+			memcpy( & instance.rs, & v[0].rs, 4 * sizeof( U8 ) );
+			memcpy( & instance.ux, & v[0].ux, 4 * sizeof( Real ) );
+		}
+
+		return result;
+	}
 }
 
 // ----------------------------------------------------------------------------
@@ -89,7 +169,8 @@ Renderer::Statistics::Statistics()
 	fGeometryBindCount( 0 ),
 	fProgramBindCount( 0 ),
 	fTextureBindCount( 0 ),
-	fUniformBindCount( 0 )
+	fUniformBindCount( 0 ),
+	fVertexBytes( 0 )
 {
 }
 
@@ -97,7 +178,7 @@ void Renderer::Statistics::Log() const
 {
 	//Make sure Statistics are enabled before calling!
 	Rtt_LogException("PrepTime(%3.2f) CPUTime(%3.2f) GPUTime(%3.2f)",fPreparationTime, fRenderTimeCPU, fRenderTimeGPU );
-	Rtt_LogException("\tDrawCount(%d) TriangleCount(%d) LineCount(%d)\n", fDrawCallCount, fTriangleCount, fLineCount );
+	Rtt_LogException("\tDrawCount(%d) TriangleCount(%d) LineCount(%d) VertexBytes(%d)\n", fDrawCallCount, fTriangleCount, fLineCount, fVertexBytes );
 	Rtt_LogException("\tResourceTimes (create, update, destroy) = (%3.2f, %3.2f, %3.2f)\n", fResourceCreateTime, fResourceUpdateTime, fResourceDestroyTime );
 }
 
@@ -118,7 +199,10 @@ Renderer::Renderer( Rtt_Allocator* allocator )
 	fMaskCountIndex( 0 ),
 	fMaskCount( allocator ),
 	fCurrentProgramMaskCount( 0 ),
+	fCurrentProgramInstanced( false ),
+	fInstancingSupported( false ),
 	fStatisticsEnabled( false ),
+	fFrontStatisticsEnabled( false ),
 	fScissorEnabled( false ),
 	fFrameBufferObject( NULL ),
 	fInsertionLimit( std::numeric_limits<U32>::max() ),
@@ -153,6 +237,8 @@ Renderer::Initialize()
 {
 	fBackCommandBuffer->Initialize();
 	fFrontCommandBuffer->Initialize();
+
+	fInstancingSupported = CommandBuffer::GetGpuSupportsInstancing();
 }
 
 void 
@@ -168,6 +254,8 @@ Renderer::BeginFrame( Real totalTime, Real deltaTime, Real contentScaleX )
 	fIndexOffset = 0;
 	fIndexCount = 0;
 	fRenderDataCount = 0;
+	fInstanceCount = 0;
+	fCompactVertexCount = 0;
 	fPreviousPrimitiveType = Geometry::kTriangleStrip;
 	fCurrentVertex = NULL;
 	fCurrentGeometry = NULL;
@@ -441,6 +529,17 @@ Renderer::Insert( const RenderData* data )
 	Rtt_ASSERT( geometry );
 	fDegenerateVertexCount = 0;
 
+	// Rect-like geometry is drawn as instances of a single quad where the
+	// GPU allows it, which needs far less data than batched triangle strips.
+	// Runs of these with the same state are drawn with one instanced call.
+	Geometry::Instance instance;
+	bool instanced = fInstancingSupported
+		&& !geometry->GetStoredOnGPU()
+		&& ComputeInstance( geometry, instance );
+
+	// Instanced quads use their own version of the program
+	programDirty = programDirty || instanced != fCurrentProgramInstanced;
+
 	// Geometry that is stored on the GPU does not need to be copied
 	// over each frame. As a consequence, they can not be batched.	
 	if( geometry->GetStoredOnGPU() )
@@ -499,7 +598,23 @@ Renderer::Insert( const RenderData* data )
 		
 		// Depending on batching, etc, the amount of space
 		// needed may be more than what is used by the Geometry itself.
-		const U32 verticesRequired = ComputeRequiredVertices( geometry );
+		U32 verticesRequired = ComputeRequiredVertices( geometry );
+
+		// Programs that ignore the user data and q are fed smaller vertices
+		bool compact = !instanced
+			&& data->fProgram->GetVertexFormat() == Program::kCompactVertexFormat
+			&& primitiveType != Geometry::kIndexedTriangles;
+
+		// Packed data may need fewer vertices than this once appended to the
+		// current batch. Only the vertices it spans are marked as used below.
+		if( instanced )
+		{
+			verticesRequired = ComputePackedVertices( sizeof( Geometry::Instance ) );
+		}
+		else if( compact )
+		{
+			verticesRequired = ComputePackedVertices( verticesRequired * sizeof( Geometry::CompactVertex ) );
+		}
 //		bool enoughSpace = fCurrentGeometry;
 //		if ( enoughSpace )
 //		{
@@ -516,12 +631,27 @@ Renderer::Insert( const RenderData* data )
 			UpdateBatch( batch, enoughSpace, storedOnGPU, verticesRequired );
 		}
 
-		// Copy the the incoming vertex data into the current Geometry
-		// pool instance, even if the data will not be batched.
-		CopyVertexData( geometry, fCurrentVertex, batch && enoughSpace );
-		fCurrentVertex += verticesRequired;
-		fVertexCount += verticesRequired;
-		fCurrentGeometry->SetVerticesUsed( fCurrentGeometry->GetVerticesUsed() + verticesRequired );
+		if( instanced )
+		{
+			CopyInstanceData( instance );
+			INCREMENT_N( fStatistics.fVertexBytes, sizeof( Geometry::Instance ) );
+		}
+		else if( compact )
+		{
+			const U32 compactVertexCount = fCompactVertexCount;
+			CopyCompactVertexData( geometry );
+			INCREMENT_N( fStatistics.fVertexBytes, ( fCompactVertexCount - compactVertexCount ) * sizeof( Geometry::CompactVertex ) );
+		}
+		else
+		{
+			// Copy the the incoming vertex data into the current Geometry
+			// pool instance, even if the data will not be batched.
+			CopyVertexData( geometry, fCurrentVertex, batch && enoughSpace );
+			INCREMENT_N( fStatistics.fVertexBytes, verticesRequired * sizeof( Geometry::Vertex ) );
+			fCurrentVertex += verticesRequired;
+			fVertexCount += verticesRequired;
+			fCurrentGeometry->SetVerticesUsed( fCurrentGeometry->GetVerticesUsed() + verticesRequired );
+		}
 
 		// Update previous batch
 		fPreviousPrimitiveType = primitiveType;
@@ -635,18 +765,20 @@ Renderer::Insert( const RenderData* data )
 
 	// NOTE: The mask count is incremented just in time to select the correct program version, so we re-compare
 	// instead of using programDirty which does the equivalent calculation for batching purposes.
-	if( data->fProgram != fPrevious.fProgram || MaskCount() != fCurrentProgramMaskCount )
+	if( data->fProgram != fPrevious.fProgram || MaskCount() != fCurrentProgramMaskCount || instanced != fCurrentProgramInstanced )
 	{
 		if( !data->fProgram->fGPUResource )
 		{
 			QueueCreate( data->fProgram );
 		}
 
-		Program::Version version = static_cast<Program::Version>( MaskCount() );
+		U32 first = instanced ? Program::kInstancedMaskCount0 : Program::kMaskCount0;
+		Program::Version version = static_cast<Program::Version>( first + MaskCount() );
 		fBackCommandBuffer->BindProgram( data->fProgram, version );
 		fPrevious.fProgram = data->fProgram;
 		INCREMENT( fStatistics.fProgramBindCount );
 		fCurrentProgramMaskCount = MaskCount();
+		fCurrentProgramInstanced = instanced;
 	}
 
 	// Mask texture
@@ -701,9 +833,13 @@ Renderer::Insert( const RenderData* data )
 void 
 Renderer::Render()
 {
-	Rtt_AbsoluteTime start = START_TIMING();
-	fStatistics.fRenderTimeGPU = fFrontCommandBuffer->Execute( fStatisticsEnabled );
-	fStatistics.fRenderTimeCPU = STOP_TIMING(start);
+	// May run on the RenderThread, so only the front frame's state is used
+	// (see START_TIMING and STOP_TIMING)
+	const bool isTimed = fFrontStatisticsEnabled;
+
+	Rtt_AbsoluteTime start = isTimed ? Rtt_GetPreciseAbsoluteTime() : 0;
+	fFrontStatistics.fRenderTimeGPU = fFrontCommandBuffer->Execute( isTimed );
+	fFrontStatistics.fRenderTimeCPU = isTimed ? Rtt_PreciseAbsoluteToMilliseconds( Rtt_GetPreciseAbsoluteTime() - start ) : 0.0f;
 }
 
 void 
@@ -739,6 +875,9 @@ Renderer::Swap()
 	fFrontCommandBuffer = fBackCommandBuffer;
 	fBackCommandBuffer = temp;
 	fGeometryPool->Swap();
+
+	fFrontStatistics = fStatistics;
+	fFrontStatisticsEnabled = fStatisticsEnabled;
 }
 
 void
@@ -797,6 +936,12 @@ Renderer::QueueDestroy( GPUResource* resource )
 	fDestroyQueue.Append( resource );
 }
 
+void
+Renderer::SetProgramCacheDirectory( const char* path )
+{
+	// No-op. Renderers that can reuse program binaries override this.
+}
+
 void
 Renderer::DestroyQueuedGPUResources()
 {
@@ -849,7 +994,7 @@ Renderer::SetStatisticsEnabled( bool enabled )
 const Renderer::Statistics&
 Renderer::GetFrameStatistics() const
 {
-	return fStatistics;
+	return fFrontStatistics;
 }
 
 U32
@@ -891,15 +1036,34 @@ Renderer::BindUniform( Uniform* uniform, U32 unit )
 void 
 Renderer::CheckAndInsertDrawCommand()
 {
-	if( fRenderDataCount != 0 )
+	if( fInstanceCount != 0 )
 	{
+		fBackCommandBuffer->DrawInstanced( fVertexOffset, fInstanceCount );
+		INCREMENT( fStatistics.fDrawCallCount );
+		INCREMENT_N( fStatistics.fTriangleCount, 2 * fInstanceCount );
+
+		// Further instances must not overwrite the ones just drawn
+		fVertexOffset += fVertexCount;
+		fVertexCount = 0;
+
+		fInstanceCount = 0;
+		fRenderDataCount = 0;
+	}
+	else if( fRenderDataCount != 0 )
+	{
+		const U32 vertexCount = fCompactVertexCount ? fCompactVertexCount : fVertexCount;
+
 		if( fPreviousPrimitiveType == Geometry::kIndexedTriangles )
 		{
 			fBackCommandBuffer->DrawIndexed( fIndexOffset, fIndexCount, fPreviousPrimitiveType );
 		}
+		else if( fCompactVertexCount )
+		{
+			fBackCommandBuffer->DrawCompact( fVertexOffset, vertexCount - fDegenerateVertexCount, fPreviousPrimitiveType );
+		}
 		else
 		{
-			fBackCommandBuffer->Draw( fVertexOffset, fVertexCount - fDegenerateVertexCount, fPreviousPrimitiveType );
+			fBackCommandBuffer->Draw( fVertexOffset, vertexCount - fDegenerateVertexCount, fPreviousPrimitiveType );
 		}
 		INCREMENT( fStatistics.fDrawCallCount );
 
@@ -909,24 +1073,32 @@ Renderer::CheckAndInsertDrawCommand()
 			{
 				case Geometry::kTriangleStrip:
 				case Geometry::kTriangleFan:
-					fStatistics.fTriangleCount += fVertexCount - ( 2 + fDegenerateVertexCount );
+					fStatistics.fTriangleCount += vertexCount - ( 2 + fDegenerateVertexCount );
 					break;
 				case Geometry::kTriangles:
-					fStatistics.fTriangleCount += fVertexCount / 3;
+					fStatistics.fTriangleCount += vertexCount / 3;
 					break;
 				case Geometry::kIndexedTriangles:
 					fStatistics.fTriangleCount += fIndexCount / 3;
 					break;
 				case Geometry::kLines:
-					fStatistics.fLineCount += fVertexCount / 2;
+					fStatistics.fLineCount += vertexCount / 2;
 					break;
 				case Geometry::kLineLoop:
-					fStatistics.fLineCount += fVertexCount;
+					fStatistics.fLineCount += vertexCount;
 					break;
 				default:
 					Rtt_ASSERT_NOT_REACHED();
 			};
 		}
+
+		if( fCompactVertexCount )
+		{
+			// As with instances, keep further data from overwriting this batch
+			fVertexOffset += fVertexCount;
+			fVertexCount = 0;
+			fCompactVertexCount = 0;
+		}
 		fRenderDataCount = 0;
 	}
 }
@@ -973,6 +1145,63 @@ Renderer::UpdateBatch( bool batch, bool enoughSpace, bool storedOnGPU, U32 verti
 	}
 }
 
+void
+Renderer::CopyInstanceData( const Geometry::Instance& instance )
+{
+	// Instances of the current batch start at fVertexOffset
+	Geometry::Instance* destination = reinterpret_cast<Geometry::Instance*>( fCurrentGeometry->GetVertexData() + fVertexOffset );
+	destination[fInstanceCount++] = instance;
+
+	UsePackedBytes( fInstanceCount * sizeof( Geometry::Instance ) );
+}
+
+void
+Renderer::CopyCompactVertexData( Geometry* geometry )
+{
+	// Compact vertices of the current batch start at fVertexOffset
+	Geometry::CompactVertex* destination = reinterpret_cast<Geometry::CompactVertex*>( fCurrentGeometry->GetVertexData() + fVertexOffset );
+	destination += fCompactVertexCount;
+
+	const Geometry::Vertex* source = geometry->GetVertexData();
+	const U32 verticesUsed = geometry->GetVerticesUsed();
+	if( geometry->GetPrimitiveType() == Geometry::kTriangleStrip )
+	{
+		// Degenerate triangles, as in CopyVertexData()
+		CopyCompactVertex( source[0], *destination++ );
+		for( U32 i = 0; i < verticesUsed; ++i )
+		{
+			CopyCompactVertex( source[i], *destination++ );
+		}
+		CopyCompactVertex( source[verticesUsed - 1], *destination++ );
+
+		fCompactVertexCount += verticesUsed + 2;
+		fDegenerateVertexCount = 1;
+	}
+	else
+	{
+		for( U32 i = 0; i < verticesUsed; ++i )
+		{
+			CopyCompactVertex( source[i], *destination++ );
+		}
+
+		fCompactVertexCount += verticesUsed;
+	}
+
+	UsePackedBytes( fCompactVertexCount * sizeof( Geometry::CompactVertex ) );
+}
+
+void
+Renderer::UsePackedBytes( U32 bytes )
+{
+	// The current batch's packed data starts at fVertexOffset and now spans
+	// 'bytes'. Mark the vertices it has grown into as used.
+	const U32 verticesUsed = ComputePackedVertices( bytes );
+	const U32 verticesAdded = verticesUsed - fVertexCount;
+	fCurrentVertex += verticesAdded;
+	fVertexCount = verticesUsed;
+	fCurrentGeometry->SetVerticesUsed( fCurrentGeometry->GetVerticesUsed() + verticesAdded );
+}
+
 void
 Renderer::CopyVertexData( Geometry* geometry, Geometry::Vertex* destination, bool interior )
 {
@@ -152,6 +152,11 @@ class Renderer
 		// the next time a valid rendering context is available.
 		void QueueDestroy( GPUResource* resource );
 
+		// Linked programs may be stored in the given directory and reused
+		// on later launches. Not all renderers and drivers support this; the
+		// base implementation is a no-op.
+		virtual void SetProgramCacheDirectory( const char* path );
+
 		static U32 GetMaxTextureSize();
 		static const char *GetGlString( const char *s );
 		static bool GetGpuSupportsHighPrecisionFragmentShaders();
@@ -175,6 +180,7 @@ class Renderer
 			U32 fProgramBindCount;		// Number of Program bindings
 			U32 fTextureBindCount;		// Number of Texture bindings
 			U32 fUniformBindCount;		// Number of Uniform bindings
+			U32 fVertexBytes;			// Bytes of vertex data copied into batches
 		};
 
 		// Return true if statistics gathering is enabled. Disabled by default.
@@ -184,8 +190,9 @@ class Renderer
 		// when needed.
 		void SetStatisticsEnabled( bool enabled );
 
-		// Get the previous frame's statistics. For accurate results, do not
-		// call this function during preparation or rendering.
+		// Get the statistics of the frame last swapped to the front, i.e. the
+		// previous frame. They are complete once Render() has returned, and
+		// are replaced by the next Swap().
 		const Statistics& GetFrameStatistics() const;
 
 		// Get the maximum number of RenderData that may be inserted each frame. 
@@ -197,7 +204,7 @@ class Renderer
 		void SetMaximumRenderDataCount( U32 count );
 		
 		void SetCPUResourceObserver(MCPUResourceObserver *resourceObserver);
-		void ReleaseGPUResources();
+		virtual void ReleaseGPUResources();
 
 		// When there is a GPU-dependency on time, e.g. the shader code,
 		// we need to ensure re-blitting. These functions help tally each
@@ -234,6 +241,9 @@ class Renderer
 	protected:
 		void UpdateBatch( bool batch, bool enoughSpace, bool storedOnGPU, U32 verticesRequired );
 		void CopyVertexData( Geometry* geometry, Geometry::Vertex* destination, bool interior );
+		void CopyInstanceData( const Geometry::Instance& instance );
+		void CopyCompactVertexData( Geometry* geometry );
+		void UsePackedBytes( U32 bytes );
 		void CopyTriangleStripsAsLines( Geometry* geometry, Geometry::Vertex* destination );
 		void CopyTriangleFanAsLines( Geometry* geometry, Geometry::Vertex* destination );
 		void CopyIndexedTrianglesAsLines( Geometry* geometry, Geometry::Vertex* destination );
@@ -266,11 +276,18 @@ class Renderer
 		int fMaskCountIndex;
 		Array< U32 > fMaskCount; // "Stack" of mask counts
 		U32 fCurrentProgramMaskCount;
+		bool fCurrentProgramInstanced;
+		bool fInstancingSupported;
 
 		bool fStatisticsEnabled;
-		Statistics fStatistics;
+		Statistics fStatistics; // Of the frame being prepared
 		Rtt_AbsoluteTime fStartTime;
 
+		// Swapped in with the front command buffer. Render() only writes
+		// these, so the next frame can be prepared while it runs.
+		Statistics fFrontStatistics;
+		bool fFrontStatisticsEnabled;
+
 		Real fViewMatrix[16];
 		Real fProjMatrix[16];
 		S32 fViewport[4];
@@ -287,6 +304,8 @@ class Renderer
 		U32 fInsertionCount;
 		U32 fInsertionLimit;
 		U32 fDegenerateVertexCount;
+		U32 fInstanceCount; // Nonzero if the current batch is drawn instanced
+		U32 fCompactVertexCount; // Nonzero if the current batch uses Geometry::CompactVertex
 		U32 fCachedVertexOffset;
 		U32 fCachedVertexCount;
 		Geometry::PrimitiveType fPreviousPrimitiveType;
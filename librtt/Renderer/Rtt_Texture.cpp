@@ -18,6 +18,40 @@ namespace Rtt
 
 // ----------------------------------------------------------------------------
 
+bool
+Texture::IsCompressed( Format format )
+{
+	return format >= kETC1 && format < kNumFormats;
+}
+
+size_t
+Texture::GetImageSizeInBytes( Format format, U32 w, U32 h )
+{
+	// Compressed formats encode 4x4 pixel blocks
+	size_t numBlocks = ( ( (size_t)w + 3 ) / 4 ) * ( ( (size_t)h + 3 ) / 4 );
+	size_t numPixels = (size_t)w * h;
+
+	switch(format)
+	{
+		case kAlpha:		return numPixels * 1;
+		case kLuminance:	return numPixels * 1;
+		case kRGB:			return numPixels * 3;
+		case kRGBA:			return numPixels * 4;
+		case kBGRA:			return numPixels * 4;
+		case kABGR:			return numPixels * 4;
+		case kARGB:			return numPixels * 4;
+		case kETC1:			return numBlocks * 8;
+		case kETC2_RGB:		return numBlocks * 8;
+		case kETC2_RGBA:	return numBlocks * 16;
+		case kASTC_4x4:		return numBlocks * 16;
+		case kBC1:			return numBlocks * 8;
+		case kBC3:			return numBlocks * 16;
+		default:			return 0;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
 Texture::Texture( Rtt_Allocator* allocator )
 :	Super( allocator ),
 	fIsRetina( false )
@@ -63,16 +97,16 @@ Texture::GetSizeInBytes() const
 	U32 w = GetWidth();
 	U32 h = GetHeight();
 
-	switch(format)
+	size_t result = 0;
+	for ( U32 level = 0, iMax = GetNumLevels(); level < iMax; level++ )
 	{
-		case kLuminance:	return w * h * 1;
-		case kRGB:			return w * h * 3;
-		case kRGBA:			return w * h * 4;
-		case kBGRA:			return w * h * 4;
-		case kABGR:			return w * h * 4;
-		case kARGB:			return w * h * 4;
-		default:			return 0;
+		result += GetImageSizeInBytes( format, w, h );
+
+		w = ( w > 1 ? w >> 1 : 1 );
+		h = ( h > 1 ? h >> 1 : 1 );
 	}
+
+	return result;
 }
 
 U8
@@ -92,6 +126,24 @@ Texture::ReleaseData()
 {
 }
 
+U32
+Texture::GetNumLevels() const
+{
+	return 1;
+}
+
+const U8*
+Texture::GetLevelData( U32 level ) const
+{
+	return ( 0 == level ? GetData() : NULL );
+}
+
+U32
+Texture::GetDirtyRects( DirtyRect* rects, U32 maxRects )
+{
+	return 0;
+}
+
 void
 Texture::SetFilter( Filter newValue )
 {
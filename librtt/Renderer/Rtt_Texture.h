@@ -36,6 +36,15 @@ class Texture : public CPUResource
 			kBGRA,
 			kABGR,
 			kARGB,
+
+			// GPU-compressed formats, made of 4x4 pixel blocks
+			kETC1,
+			kETC2_RGB,
+			kETC2_RGBA,
+			kASTC_4x4,
+			kBC1,
+			kBC3,
+
 			kNumFormats
 		}
 		Format;
@@ -44,6 +53,11 @@ class Texture : public CPUResource
 		{
 			kNearest,
 			kLinear,
+
+			// Linear, also between mip levels. Levels are generated on upload,
+			// unless pre-built ones are provided (see GetNumLevels()).
+			kLinearMipmap,
+
 			kNumFilters
 		}
 		Filter;
@@ -69,6 +83,25 @@ class Texture : public CPUResource
 		}
 		Unit;
 
+		// Area of the image, in pixels from the top left
+		struct DirtyRect
+		{
+			U32 x;
+			U32 y;
+			U32 width;
+			U32 height;
+		};
+
+		static const U32 kMaxDirtyRects = 16;
+
+	public:
+		static bool IsCompressed( Format format );
+
+		// Bytes taken by a single w x h image. Compressed images are padded
+		// to whole blocks. Callers must bound w and h (e.g. by the maximum
+		// texture size) so the result fits in a size_t.
+		static size_t GetImageSizeInBytes( Format format, U32 w, U32 h );
+
 	public:
 
 		Texture( Rtt_Allocator* allocator );
@@ -90,6 +123,18 @@ class Texture : public CPUResource
 		virtual const U8* GetData() const;
 		virtual void ReleaseData();
 
+		// Pre-built mip levels, only supported for compressed formats. Level
+		// 0 is the image returned by GetData(); each further level halves
+		// the dimensions of the previous one.
+		virtual U32 GetNumLevels() const;
+		virtual const U8* GetLevelData( U32 level ) const;
+
+		// Called on updates, before GetData(). Writes up to 'maxRects' areas
+		// changed since the last upload and returns how many there are, so
+		// only those are subloaded. A result of 0 (the default) means the
+		// whole image is uploaded.
+		virtual U32 GetDirtyRects( DirtyRect* rects, U32 maxRects );
+
 		virtual void SetFilter( Filter newValue );
 		virtual void SetWrapX( Wrap newValue );
 		virtual void SetWrapY( Wrap newValue );
@@ -17,7 +17,8 @@ namespace Rtt
 // ----------------------------------------------------------------------------
 
 TextureBitmap::TextureBitmap( Rtt_Allocator* allocator, U32 width, U32 height, Format format, Filter filter)
-:	Super( allocator ), fWidth( width ), fHeight( height ), fFormat( format ), fFilter( filter ), fData( NULL )
+:	Super( allocator ), fWidth( width ), fHeight( height ), fFormat( format ), fFilter( filter ), fData( NULL ),
+	fNumDirtyRects( 0 ), fIsFullyDirty( false )
 {
 	Allocate();
 }
@@ -73,6 +74,50 @@ TextureBitmap::GetData() const
 	return fData;
 }
 
+U32
+TextureBitmap::GetDirtyRects( DirtyRect* rects, U32 maxRects )
+{
+	U32 result = 0;
+
+	if ( ! fIsFullyDirty && fNumDirtyRects <= maxRects )
+	{
+		for ( U32 i = 0; i < fNumDirtyRects; i++ )
+		{
+			rects[i] = fDirtyRects[i];
+		}
+
+		result = fNumDirtyRects;
+	}
+
+	fNumDirtyRects = 0;
+	fIsFullyDirty = false;
+
+	return result;
+}
+
+void
+TextureBitmap::Invalidate()
+{
+	fIsFullyDirty = true;
+
+	Super::Invalidate();
+}
+
+void
+TextureBitmap::InvalidateRect( const DirtyRect& rect )
+{
+	if ( fNumDirtyRects < kMaxDirtyRects )
+	{
+		fDirtyRects[fNumDirtyRects++] = rect;
+	}
+	else
+	{
+		fIsFullyDirty = true;
+	}
+
+	Super::Invalidate();
+}
+
 // ----------------------------------------------------------------------------
 
 } // namespace Rtt
@@ -38,17 +38,27 @@ class TextureBitmap : public Texture
 		virtual Filter GetFilter() const;
 
 		virtual const U8 *GetData() const;
+		virtual U32 GetDirtyRects( DirtyRect* rects, U32 maxRects );
+
+		virtual void Invalidate();
 
 		// To avoid excess copying, image data may be manipulated directly.
 		// Invalidate() will result in the data being subloaded to the GPU.
 		U8 *WriteAccess() { return fData; }
 
+		// Like Invalidate(), but only 'rect' is subloaded. Past kMaxDirtyRects
+		// areas, the whole image is.
+		void InvalidateRect( const DirtyRect& rect );
+
 	private:
 		U32 fWidth;
 		U32 fHeight;
 		Format fFormat;
 		Filter fFilter;
 		U8* fData;
+		DirtyRect fDirtyRects[kMaxDirtyRects];
+		U32 fNumDirtyRects;
+		bool fIsFullyDirty;
 };
 
 // ----------------------------------------------------------------------------
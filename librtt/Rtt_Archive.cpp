@@ -40,6 +40,10 @@
 #include <errno.h>
 #include <sys/stat.h>
 
+#if defined( Rtt_ARCHIVE_COMPRESSION )
+	#include <zlib.h>
+#endif
+
 // #define Rtt_DEBUG_ARCHIVE 1
 
 // ----------------------------------------------------------------------------
@@ -163,6 +167,41 @@ GetBasename( const char* path )
     return result;
 }
 
+// 32-bit FNV-1a. Used to build the index of (version 2) archives,
+// so the writer and the runtime must agree on this function.
+static U32
+HashName( const char *name )
+{
+	Rtt_ASSERT( name );
+
+	U32 result = 2166136261U;
+	for ( const U8 *p = (const U8*)name; '\0' != *p; p++ )
+	{
+		result ^= *p;
+		result *= 16777619U;
+	}
+
+	return result;
+}
+
+// Entries smaller than this, or that do not shrink by at least 1/8th,
+// are stored raw since inflating them would cost more than it saves.
+static const size_t kMinCompressibleBytes = 256;
+
+// Inflates src into dst. dstLen must be the exact uncompressed length.
+static bool
+InflateData( const void *src, U32 srcLen, void *dst, U32 dstLen )
+{
+#if defined( Rtt_ARCHIVE_COMPRESSION )
+	uLongf len = dstLen;
+	int result = uncompress( (Bytef*)dst, & len, (const Bytef*)src, srcLen );
+	return ( Z_OK == result && len == dstLen );
+#else
+	Rtt_UNUSED( src ); Rtt_UNUSED( srcLen ); Rtt_UNUSED( dst ); Rtt_UNUSED( dstLen );
+	return false;
+#endif
+}
+
 // ----------------------------------------------------------------------------
 
 struct ArchiveWriterEntry
@@ -173,15 +212,43 @@ struct ArchiveWriterEntry
 	size_t nameLen;
 	const char* srcPath;
 	size_t srcLen;
+	U32 hash;
+	U32 recordOffset;
+	U8* compressed; // NULL if the entry is stored raw
+	size_t compressedLen;
+	size_t index; // Position in the source list
 };
 
+// Orders entries by hash, then by name, then by source position, so the
+// archive is the same for the same input even though qsort is not stable
+static int
+CompareWriterEntries( const void *lhs, const void *rhs )
+{
+	const ArchiveWriterEntry *a = (const ArchiveWriterEntry*)lhs;
+	const ArchiveWriterEntry *b = (const ArchiveWriterEntry*)rhs;
+
+	if ( a->hash != b->hash )
+	{
+		return ( a->hash < b->hash ? -1 : 1 );
+	}
+
+	int result = strcmp( a->name, b->name );
+	if ( 0 == result && a->index != b->index )
+	{
+		result = ( a->index < b->index ? -1 : 1 );
+	}
+
+	return result;
+}
+
 class ArchiveWriter
 {
 	public:
 		enum
 		{
 			kTagSize = sizeof(U32)*2,
-			kVersion = 0x1
+			kLegacyVersion = 0x1, // Contents table only
+			kVersion = 0x2 // Contents table sorted by hash, followed by an index
 		};
 
 	public:
@@ -189,13 +256,17 @@ class ArchiveWriter
 		~ArchiveWriter();
 
 	public:
-		int Initialize( const char *dstPath );
+		int Initialize( const char *dstPath, U8 version );
 
 	public:
 		int Serialize( Archive::Tag tag, U32 len ) const;
 		int Serialize( U32 value ) const;
 		int Serialize( const char *value, size_t len ) const;
 		int Serialize( const char *filepath ) const;
+		int Serialize( const U8 *bytes, size_t len ) const;
+
+	public:
+		static bool Compress( ArchiveWriterEntry& entry );
 
 	public:
 //		int Serialize( ArchiveWriterEntry& entry );
@@ -223,7 +294,7 @@ ArchiveWriter::~ArchiveWriter()
 }
 
 int
-ArchiveWriter::Initialize( const char *dstPath )
+ArchiveWriter::Initialize( const char *dstPath, U8 version )
 {
 	int result = 0;
 
@@ -239,7 +310,7 @@ ArchiveWriter::Initialize( const char *dstPath )
 		result += fprintf( dst, "%c", 'r');
 		result += fprintf( dst, "%c", 'a');
 		result += fprintf( dst, "%c", 'c');
-		result += fprintf( dst, "%c", kVersion );
+		result += fprintf( dst, "%c", version );
 	}
 
 	return result;
@@ -346,6 +417,77 @@ ArchiveWriter::Serialize( const char *filepath ) const
 	return result;
 }
 
+int
+ArchiveWriter::Serialize( const U8 *bytes, size_t len ) const
+{
+	Rtt_ASSERT( fDst );
+	Rtt_ASSERT( bytes || 0 == len );
+
+	size_t len4 = GetByteAlignedValue< 4 >( len );
+	const U8 kPadding[4] = { 0, 0, 0, 0 };
+
+	int result = 0;
+	if ( len == fwrite( bytes, 1, len, fDst )
+		 && ( len4 - len ) == fwrite( kPadding, 1, len4 - len, fDst ) )
+	{
+		result = (int)len4;
+	}
+
+	return result;
+}
+
+// Deflates the entry's source file into entry.compressed. Returns false
+// (leaving the entry to be stored raw) if compression is unavailable
+// or not worthwhile.
+bool
+ArchiveWriter::Compress( ArchiveWriterEntry& entry )
+{
+	entry.compressed = NULL;
+	entry.compressedLen = 0;
+
+#if defined( Rtt_ARCHIVE_COMPRESSION )
+	if ( entry.srcLen < kMinCompressibleBytes )
+	{
+		return false;
+	}
+
+	FILE *src = Rtt_FileOpen( entry.srcPath, "rb" );
+	if ( NULL == src )
+	{
+		return false;
+	}
+
+	U8 *raw = (U8*)malloc( entry.srcLen );
+	bool result = ( raw && entry.srcLen == fread( raw, 1, entry.srcLen, src ) );
+	Rtt_FileClose( src );
+
+	if ( result )
+	{
+		uLongf len = compressBound( (uLong)entry.srcLen );
+		U8 *compressed = (U8*)malloc( len );
+		result = ( compressed
+			&& Z_OK == compress2( compressed, & len, raw, (uLong)entry.srcLen, Z_BEST_COMPRESSION )
+			&& len <= entry.srcLen - ( entry.srcLen >> 3 ) );
+
+		if ( result )
+		{
+			entry.compressed = compressed;
+			entry.compressedLen = len;
+		}
+		else
+		{
+			free( compressed );
+		}
+	}
+
+	free( raw );
+
+	return result;
+#else
+	return false;
+#endif
+}
+
 /*
 int
 ArchiveWriter::Serialize( ArchiveWriterEntry& entry )
@@ -375,10 +517,15 @@ class ArchiveReader
 		U32 ParseU32();
 		const char* ParseString();
 		void* ParseData( U32& rLength );
+		void* ParseCompressedData( U32& rLength, U32& rCompressedLength );
 
 	public:
 		bool Seek( S32 offset, bool fromOrigin );
 
+	public:
+		U8 GetVersion() const { return fVersion; }
+		const void* GetPosition() const { return fPos; }
+
 	protected:
 		void VerifyBounds() const;
 
@@ -400,15 +547,22 @@ ArchiveReader::ArchiveReader()
 bool
 ArchiveReader::Initialize( const void* data, size_t numBytes )
 {
-	const U8 kHeader[] = { 'r', 'a', 'c', ArchiveWriter::kVersion };
-	const size_t kHeaderSize = sizeof( kHeader );
-	bool result = ( numBytes > kHeaderSize && 0 == memcmp( data, kHeader, kHeaderSize ) );
+	const U8 kHeader[] = { 'r', 'a', 'c' };
+	const size_t kHeaderSize = sizeof( kHeader ) + sizeof( U8 ); // magic + version
+	bool result = ( numBytes > kHeaderSize && 0 == memcmp( data, kHeader, sizeof( kHeader ) ) );
+	if ( result )
+	{
+		// Legacy archives are still readable; they just lack the index
+		U8 version = ((const U8*)data)[sizeof( kHeader )];
+		result = ( ArchiveWriter::kVersion == version || ArchiveWriter::kLegacyVersion == version );
+	}
+
 	if ( result )
 	{
 		fPos = ((U8*)data) + kHeaderSize;
 		fData = data;
 		fDataLen = numBytes;
-		fVersion = ArchiveWriter::kVersion;
+		fVersion = ((const U8*)data)[sizeof( kHeader )];
 
 #if Rtt_DEBUG_ARCHIVE
 		Rtt_TRACE( ( "[ArchiveReader::Initialize] inData(%p) fPos(%p) fData(%p) headerSize(%ld) fDataLen(%ld)\n",
@@ -427,12 +581,12 @@ ArchiveReader::Initialize( const void* data, size_t numBytes )
 }
 
 static U32
-ReadU32( U32 *p )
+ReadU32( const U32 *p )
 {
 	#ifdef Rtt_LITTLE_ENDIAN
 		return *p;
 	#else
-		U8 *pp = (U8*)p;
+		const U8 *pp = (const U8*)p;
 		return ((U32)pp[0])
 				| (((U32)pp[1]) << 8)
 				| (((U32)pp[2]) << 16)
@@ -504,6 +658,24 @@ ArchiveReader::ParseData( U32& rLength )
 	return result;
 }
 
+void*
+ArchiveReader::ParseCompressedData( U32& rLength, U32& rCompressedLength )
+{
+	VerifyBounds();
+
+	U32 *p = (U32*)fPos;
+
+	rLength = ReadU32( p ); p++; // *p++;
+	U32 len = ReadU32( p ); p++; // *p++;
+	rCompressedLength = len;
+	void* result = p;
+
+	fPos = p + GetByteAlignedValue< 4 >( len ) / sizeof( *p );
+
+	VerifyBounds();
+	return result;
+}
+
 bool
 ArchiveReader::Seek( S32 offset, bool fromOrigin )
 {
@@ -544,8 +716,22 @@ ArchiveReader::VerifyBounds() const
 // ----------------------------------------------------------------------------
 
 void
-Archive::Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[] )
+Archive::Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[], bool compress, bool isLegacyFormat )
 {
+#if !defined( Rtt_ARCHIVE_COMPRESSION )
+	if ( compress )
+	{
+		fprintf( stderr, "car: compression is not supported by this build; storing files uncompressed\n" );
+		compress = false;
+	}
+#endif
+
+	if ( compress && isLegacyFormat )
+	{
+		fprintf( stderr, "car: version 1 archives cannot hold compressed files; storing files uncompressed\n" );
+		compress = false;
+	}
+
 	std::vector<std::string> fileList;
 	size_t fileCount = 0;
 
@@ -613,7 +799,8 @@ Archive::Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[]
 	}
 
 	ArchiveWriter writer;
-	int startPos = writer.Initialize( dstPath );
+	int startPos = writer.Initialize(
+		dstPath, (U8)( isLegacyFormat ? ArchiveWriter::kLegacyVersion : ArchiveWriter::kVersion ) );
 	if ( Rtt_VERIFY( startPos > 0 ) )
 	{
 		ArchiveWriterEntry* entries = new ArchiveWriterEntry[fileCount];
@@ -631,12 +818,34 @@ Archive::Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[]
 			entry.nameLen = strlen( entry.name );
 			entry.srcPath = path;
 			entry.srcLen = GetFileSize( path );
+			entry.hash = HashName( entry.name );
+			entry.recordOffset = 0;
+			entry.compressed = NULL;
+			entry.compressedLen = 0;
+			entry.index = entryIdx - 1;
+
+			if ( compress )
+			{
+				ArchiveWriter::Compress( entry );
+			}
 
 			// type, offset, numChars, string data
 			contentsLen += 3*sizeof(U32) + GetByteAlignedValue< 4 >( entry.nameLen + 1 );
 		}
 
+		// Contents are stored in index order so the runtime can binary search
+		// the index in place without ever parsing the contents table.
+		// Version 1 archives have no index and keep the source order.
 		U32 offsetBase = startPos + contentsLen;
+		U32 indexLen = 0;
+		if ( ! isLegacyFormat )
+		{
+			qsort( entries, fileCount, sizeof( ArchiveWriterEntry ), CompareWriterEntries );
+
+			// numElements, { hash, record offset }[]
+			indexLen = (U32)( sizeof(U32) + fileCount*2*sizeof(U32) );
+			offsetBase += ArchiveWriter::kTagSize + indexLen;
+		}
 
 		offsetBase += writer.Serialize( Archive::kContentsTag, contentsLen );
 
@@ -657,6 +866,7 @@ Archive::Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[]
 		for ( size_t i = 0; i < fileCount; i++ )
 		{
 			ArchiveWriterEntry& entry = entries[i];
+			entry.recordOffset = writer.GetPosition();
 			writer.Serialize( entry.type );
 			writer.Serialize( offsetBase );
 			writer.Serialize( entry.name, entry.nameLen );
@@ -665,15 +875,51 @@ Archive::Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[]
 			entry.offset = offsetBase;
 
 			// For next offset, add srcLen *and* bytes for tag, length 
-			offsetBase +=
-				GetByteAlignedValue< 4 >( entry.srcLen )
-				+ ArchiveWriter::kTagSize
-				+ sizeof(U32);
+			// (compressed entries also store the compressed length)
+			if ( entry.compressed )
+			{
+				offsetBase +=
+					GetByteAlignedValue< 4 >( entry.compressedLen )
+					+ ArchiveWriter::kTagSize
+					+ 2*sizeof(U32);
+			}
+			else
+			{
+				offsetBase +=
+					GetByteAlignedValue< 4 >( entry.srcLen )
+					+ ArchiveWriter::kTagSize
+					+ sizeof(U32);
+			}
+		}
+
+		// Index
+		// --------------------------
+		//   U32        numElements
+		//   Record[]   {
+		//                U32 hash (of name)
+		//                U32 offset (of Contents record)
+		//              }
+		if ( ! isLegacyFormat )
+		{
+			writer.Serialize( kIndexTag, indexLen );
+			writer.Serialize( (U32)fileCount );
+			for ( size_t i = 0; i < fileCount; i++ )
+			{
+				const ArchiveWriterEntry& entry = entries[i];
+				writer.Serialize( entry.hash );
+				writer.Serialize( entry.recordOffset );
+			}
 		}
 
 		// Data
 		// --------------------------
 		//   String     data
+		//
+		// CompressedData
+		// --------------------------
+		//   U32        length (uncompressed)
+		//   U32        compressedLength
+		//   U8[]       zlib stream (4 byte-aligned padding)
 		for ( size_t i = 0; i < fileCount; i++ )
 		{
 			ArchiveWriterEntry& entry = entries[i];
@@ -682,10 +928,23 @@ Archive::Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[]
 				writer.GetPosition() >= 0
 				&& (size_t)writer.GetPosition() == entry.offset );
 
-			// data tag length = sizeof( length ) + byte-aligned len of bytes buffer
-			writer.Serialize( kDataTag, sizeof( U32 ) + (U32) GetByteAlignedValue< 4 >( entry.srcLen ) );
-			writer.Serialize( (U32) entry.srcLen );
-			writer.Serialize( entry.srcPath );
+			if ( entry.compressed )
+			{
+				writer.Serialize( kCompressedDataTag, 2*sizeof( U32 ) + (U32) GetByteAlignedValue< 4 >( entry.compressedLen ) );
+				writer.Serialize( (U32) entry.srcLen );
+				writer.Serialize( (U32) entry.compressedLen );
+				writer.Serialize( entry.compressed, entry.compressedLen );
+
+				free( entry.compressed );
+				entry.compressed = NULL;
+			}
+			else
+			{
+				// data tag length = sizeof( length ) + byte-aligned len of bytes buffer
+				writer.Serialize( kDataTag, sizeof( U32 ) + (U32) GetByteAlignedValue< 4 >( entry.srcLen ) );
+				writer.Serialize( (U32) entry.srcLen );
+				writer.Serialize( entry.srcPath );
+			}
 		}
 
 		// EOF
@@ -740,6 +999,13 @@ WriteFile( const char *dstDir, const char *filename, const void *src, size_t src
 	}
 }
 
+bool
+Archive::CanDecompress( const char *platform )
+{
+	// Must match the runtimes that define Rtt_ARCHIVE_COMPRESSION (see Rtt_Archive.h)
+	return ( platform && 0 == strcmp( platform, "android" ) );
+}
+
 size_t
 Archive::Deserialize( const char *dstDir, const char *srcCarFile )
 {
@@ -800,7 +1066,23 @@ Archive::Deserialize( const char *dstDir, const char *srcCarFile )
 							reader.Seek( entry.offset, true );
 							U32 tagLen;
 							U32 tag = reader.ParseTag( tagLen );
-							if ( Rtt_VERIFY( Archive::kDataTag == tag ) )
+							if ( Archive::kCompressedDataTag == tag )
+							{
+								U32 resourceLen = 0, compressedLen = 0;
+								void* compressed = reader.ParseCompressedData( resourceLen, compressedLen );
+								void* resource = malloc( resourceLen );
+								if ( resource && InflateData( compressed, compressedLen, resource, resourceLen ) )
+								{
+									WriteFile( dstDir, entry.name, resource, resourceLen );
+									++count;
+								}
+								else
+								{
+									fprintf(stderr, "car: cannot decompress '%s'\n", entry.name);
+								}
+								free( resource );
+							}
+							else if ( Rtt_VERIFY( Archive::kDataTag == tag ) )
 							{
 								U32 resourceLen = 0;
 								void* resource = reader.ParseData( resourceLen );
@@ -885,7 +1167,13 @@ Archive::List(const char *srcCarFile)
 					reader.Seek( entry.offset, true );
 					U32 tagLen;
 					U32 tag = reader.ParseTag( tagLen );
-					if ( Rtt_VERIFY( Archive::kDataTag == tag ) )
+					if ( Archive::kCompressedDataTag == tag )
+					{
+						U32 resourceLen = 0, compressedLen = 0;
+						reader.ParseCompressedData( resourceLen, compressedLen );
+						printf("%7d %s (compressed %d)\n", resourceLen, entry.name, compressedLen);
+					}
+					else if ( Rtt_VERIFY( Archive::kDataTag == tag ) )
 					{
 						U32 resourceLen = 0;
 						reader.ParseData( resourceLen );
@@ -918,11 +1206,14 @@ Archive::List(const char *srcCarFile)
 Archive::Archive( Rtt_Allocator& allocator, const char *srcPath )
 :	fAllocator( allocator ),
 	fEntries( NULL ),
+	fIndex( NULL ),
 	fNumEntries( 0 ),
 #if defined( Rtt_ARCHIVE_COPY_DATA )
 	fBits( &allocator ),
 #endif
-	fData( NULL )
+	fData( NULL ),
+	fScratch( NULL ),
+	fScratchLen( 0 )
 {
 #if defined( Rtt_ANDROID_ENV )
 	bool ok = NativeToJavaBridge::GetRawAsset( srcPath, fBits );
@@ -994,6 +1285,18 @@ Archive::Archive( Rtt_Allocator& allocator, const char *srcPath )
 			switch( tag )
 			{
 				case kContentsTag:
+					if ( ArchiveWriter::kLegacyVersion != reader.GetVersion() )
+					{
+						// Skip the contents; the index that follows is used in place
+						reader.Seek( tagLen, false );
+						tag = reader.ParseTag( tagLen );
+						if ( Rtt_VERIFY( kIndexTag == tag ) )
+						{
+							fNumEntries = reader.ParseU32();
+							fIndex = (const U32*)reader.GetPosition();
+						}
+					}
+					else
 					{
 						U32 numElements = reader.ParseU32();
 						fEntries = (ArchiveEntry*)Rtt_MALLOC( & allocator, sizeof( ArchiveEntry )*numElements );
@@ -1037,7 +1340,7 @@ Archive::~Archive()
 #endif
 
 	Rtt_FREE( fEntries );
-
+	Rtt_FREE( fScratch );
 }
 
 // This will be added to the list of Lua loaders called via "require"
@@ -1075,6 +1378,91 @@ Archive::ResourceLoader( lua_State *L )
 	return 1;
 }
 
+bool
+Archive::FindEntry( const char *name, U32& rOffset ) const
+{
+	if ( fIndex )
+	{
+		// Binary search for the first index record with a matching hash
+		const U32 hash = HashName( name );
+		size_t lo = 0, hi = fNumEntries;
+		while ( lo < hi )
+		{
+			size_t mid = lo + ( hi - lo ) / 2;
+			if ( ReadU32( fIndex + 2*mid ) < hash )
+			{
+				lo = mid + 1;
+			}
+			else
+			{
+				hi = mid;
+			}
+		}
+
+		ArchiveReader reader;
+		reader.Initialize( fData, fDataLen );
+
+		// Resolve hash collisions by comparing names of the Contents records
+		for ( size_t i = lo; i < fNumEntries && ReadU32( fIndex + 2*i ) == hash; i++ )
+		{
+			reader.Seek( ReadU32( fIndex + 2*i + 1 ), true );
+			reader.ParseU32(); // type
+			U32 offset = reader.ParseU32();
+			if ( 0 == Rtt_StringCompare( reader.ParseString(), name ) )
+			{
+				rOffset = offset;
+				return true;
+			}
+		}
+	}
+	else
+	{
+		for ( size_t i = 0, iMax = fNumEntries; i < iMax; i++ )
+		{
+			const ArchiveEntry& entry = fEntries[i];
+			if ( 0 == Rtt_StringCompare( entry.name, name ) )
+			{
+				rOffset = entry.offset;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+// Compressed entries are inflated into a scratch buffer that is reused
+// across loads. Entries larger than this get a temporary buffer instead,
+// so one large file does not pin memory for the lifetime of the archive.
+static const size_t kMaxScratchBytes = 256 * 1024;
+
+char*
+Archive::AcquireScratch( size_t numBytes )
+{
+	if ( numBytes > kMaxScratchBytes )
+	{
+		return (char*)Rtt_MALLOC( & fAllocator, numBytes );
+	}
+
+	if ( numBytes > fScratchLen )
+	{
+		Rtt_FREE( fScratch );
+		fScratch = (char*)Rtt_MALLOC( & fAllocator, numBytes );
+		fScratchLen = ( fScratch ? numBytes : 0 );
+	}
+
+	return fScratch;
+}
+
+void
+Archive::ReleaseScratch( char *scratch )
+{
+	if ( scratch != fScratch )
+	{
+		Rtt_FREE( scratch );
+	}
+}
+
 int
 Archive::LoadResource( lua_State *L, const char *name )
 {
@@ -1082,30 +1470,48 @@ Archive::LoadResource( lua_State *L, const char *name )
 
 	const char kFormatResourceNotFound[] = "resource (%s) does not exist in archive";
 	const char kFormatAchiveCorrupted[] = "archive is corrupted. could not resolve resource (%s)";
+	const char kFormatDecompressFailed[] = "could not decompress resource (%s) in archive";
 	const char *errorFormat = kFormatResourceNotFound;
 
 	ArchiveReader reader;
+	U32 offset = 0;
 
 	if ( fData == NULL )
 		goto exit_gracefully;
 
 	reader.Initialize( fData, fDataLen );
 
-	for ( size_t i = 0, iMax = fNumEntries; i < iMax; i++ )
+	if ( FindEntry( name, offset ) )
 	{
-		ArchiveEntry& entry = fEntries[i];
-		if ( 0 == Rtt_StringCompare( entry.name, name ) )
+		reader.Seek( offset, true );
+		U32 tagLen;
+		U32 tag = reader.ParseTag( tagLen );
+		if ( Archive::kDataTag == tag )
 		{
-			reader.Seek( entry.offset, true );
-			U32 tagLen;
-			U32 tag = reader.ParseTag( tagLen );
-			if ( Rtt_VERIFY( Archive::kDataTag == tag ) )
+			U32 resourceLen = 0;
+			void* resource = reader.ParseData( resourceLen );
+			status = luaL_loadbuffer( L, static_cast< const char* >( resource ), resourceLen, name );
+			goto exit_gracefully;
+		}
+		else if ( Archive::kCompressedDataTag == tag )
+		{
+			// Inflate lazily, on first use. luaL_loadbuffer copies what it
+			// needs, so the scratch buffer can be recycled immediately.
+			U32 resourceLen = 0, compressedLen = 0;
+			void* compressed = reader.ParseCompressedData( resourceLen, compressedLen );
+			char* resource = AcquireScratch( resourceLen );
+			if ( resource && InflateData( compressed, compressedLen, resource, resourceLen ) )
 			{
-				U32 resourceLen = 0;
-				void* resource = reader.ParseData( resourceLen );
-				status = luaL_loadbuffer( L, static_cast< const char* >( resource ), resourceLen, name );
+				status = luaL_loadbuffer( L, resource, resourceLen, name );
+				ReleaseScratch( resource );
 				goto exit_gracefully;
 			}
+			ReleaseScratch( resource );
+			errorFormat = kFormatDecompressFailed;
+		}
+		else
+		{
+			Rtt_ASSERT_NOT_REACHED();
 			errorFormat = kFormatAchiveCorrupted;
 		}
 	}
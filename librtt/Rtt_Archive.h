@@ -21,6 +21,14 @@
 	#include "Core/Rtt_Data.h"
 #endif
 
+// Compressed entries require zlib. Tools that write archives (car) opt in
+// by defining Rtt_ARCHIVE_COMPRESSION and linking against libz. Of the
+// runtimes, only Android links zlib, so only its archives may be compressed
+// (see Archive::CanDecompress).
+#if defined( Rtt_ANDROID_ENV ) && !defined( Rtt_ARCHIVE_COMPRESSION )
+	#define Rtt_ARCHIVE_COMPRESSION 1
+#endif
+
 // ----------------------------------------------------------------------------
 
 namespace Rtt
@@ -41,6 +49,8 @@ class Archive
 			kUnknownTag = 0x0,
 			kContentsTag = 0x1,
 			kDataTag = 0x2,
+			kIndexTag = 0x3,
+			kCompressedDataTag = 0x4,
 			
 			kEOFTag = 0xFFFFFFFF
 		}
@@ -56,10 +66,18 @@ class Archive
 		};
 
 	public:
-		static void Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[] );
+		// Writes a version 2 archive (hashed index, optionally compressed
+		// entries), which runtimes that predate the index cannot read. Set
+		// 'isLegacyFormat' to write a version 1 archive instead; 'compress'
+		// is ignored then.
+		static void Serialize( const char *dstPath, int numSrcPaths, const char *srcPaths[], bool compress = false, bool isLegacyFormat = false );
 		static size_t Deserialize( const char *dstDir, const char *srcCarFile );
 		static void List(const char *srcCarFile);
 
+		// Whether the runtime of 'platform' (e.g. "android") can read
+		// compressed entries
+		static bool CanDecompress( const char *platform );
+
 #if !defined( Rtt_NO_ARCHIVE )
 	public:
 		Archive( Rtt_Allocator& allocator, const char *srcPath );
@@ -72,13 +90,21 @@ class Archive
 		int LoadResource( lua_State *L, const char* name );
 		int DoResource( lua_State *L, const char *name, int narg );
 
+	protected:
+		bool FindEntry( const char *name, U32& rOffset ) const;
+		char* AcquireScratch( size_t numBytes );
+		void ReleaseScratch( char *scratch );
+
 	private:
 		Rtt_Allocator& fAllocator;
 //		int fDescriptor;
-		ArchiveEntry* fEntries;
+		ArchiveEntry* fEntries; // Only used by legacy (unindexed) archives
+		const U32* fIndex; // Points into fData; { hash, record offset } pairs sorted by hash
 		size_t fNumEntries;
 		const void* fData;
 		size_t fDataLen;
+		char* fScratch; // Reused for inflating compressed entries; never exceeds kMaxScratchBytes
+		size_t fScratchLen;
 #if defined( Rtt_ARCHIVE_COPY_DATA )
 		Data<char> fBits;
 #endif
@@ -13,8 +13,10 @@
 
 #include "Display/Rtt_BitmapPaint.h"
 #include "Display/Rtt_Display.h"
+#include "Display/Rtt_DisplayDefaults.h"
 #include "Display/Rtt_DisplayObject.h"
 #include "Display/Rtt_StageObject.h"
+#include "Display/Rtt_TextureResource.h"
 #include "Input/Rtt_PlatformInputAxis.h"
 #include "Input/Rtt_PlatformInputDevice.h"
 #include "Rtt_Lua.h"
@@ -26,6 +28,8 @@
 #include "Rtt_Runtime.h"
 #include "Display/Rtt_SpriteObject.h"
 
+#include <vector>
+
 // ----------------------------------------------------------------------------
 
 namespace Rtt
@@ -72,10 +76,24 @@ VirtualEvent::Dispatch( lua_State *L, Runtime& ) const
 int
 VirtualEvent::Push( lua_State *L ) const
 {
-	Lua::NewEvent( L, Name() ); Rtt_ASSERT( lua_istable( L, -1 ) );
+	if ( IsPoolable() )
+	{
+		Lua::NewPooledEvent( L, Name() );
+	}
+	else
+	{
+		Lua::NewEvent( L, Name() );
+	}
+	Rtt_ASSERT( lua_istable( L, -1 ) );
 	return 1;
 }
 
+bool
+VirtualEvent::IsPoolable() const
+{
+	return false;
+}
+
 // ----------------------------------------------------------------------------
 
 ErrorEvent::ErrorEvent()
@@ -143,6 +161,12 @@ FrameEvent::Push( lua_State *L ) const
 	return 1;
 }
 
+bool
+FrameEvent::IsPoolable() const
+{
+	return true;
+}
+
 // ----------------------------------------------------------------------------
 
 const RenderEvent&
@@ -668,6 +692,12 @@ KeyEvent::Push( lua_State *L ) const
 	return 1;
 }
 
+bool
+KeyEvent::IsPoolable() const
+{
+	return true;
+}
+
 void
 KeyEvent::Dispatch( lua_State *L, Runtime& ) const
 {
@@ -774,6 +804,12 @@ AxisEvent::Push( lua_State *L ) const
 	return 1;
 }
 
+bool
+AxisEvent::IsPoolable() const
+{
+	return true;
+}
+
 // ----------------------------------------------------------------------------
 
 const char ColorSampleEvent::kName[] = "colorSample";
@@ -782,9 +818,18 @@ ColorSampleEvent::ColorSampleEvent( float x, float y, RGBA &color )
 : fX( x )
 , fY( y )
 , fColor( color )
+, fIsError( false )
 {
 }
 
+ColorSampleEvent::ColorSampleEvent( float x, float y )
+: fX( x )
+, fY( y )
+, fIsError( true )
+{
+	fColor.Clear();
+}
+
 const char*
 ColorSampleEvent::Name() const
 {
@@ -802,6 +847,13 @@ ColorSampleEvent::Push( lua_State *L ) const
 		lua_pushnumber( L, fY );
 		lua_setfield( L, -2, "y" );
 
+		if ( fIsError )
+		{
+			lua_pushboolean( L, 1 );
+			lua_setfield( L, -2, kIsErrorKey );
+			return 1;
+		}
+
 		lua_pushnumber( L, ( (float)fColor.r / 255.0f ) );
 		lua_setfield( L, -2, "r" );
 
@@ -820,6 +872,79 @@ ColorSampleEvent::Push( lua_State *L ) const
 
 // ----------------------------------------------------------------------------
 
+const char ScreenCaptureEvent::kName[] = "screenCapture";
+
+ScreenCaptureEvent::ScreenCaptureEvent( const DisplayObject *target )
+:	fTarget( target )
+{
+}
+
+const char*
+ScreenCaptureEvent::Name() const
+{
+	return Self::kName;
+}
+
+int
+ScreenCaptureEvent::Push( lua_State *L ) const
+{
+	if ( Rtt_VERIFY( Super::Push( L ) ) )
+	{
+		LuaProxy *proxy = ( fTarget ? fTarget->GetProxy() : NULL );
+		if ( proxy )
+		{
+			proxy->PushTable( L );
+			lua_setfield( L, -2, "target" );
+		}
+		else
+		{
+			lua_pushboolean( L, 1 );
+			lua_setfield( L, -2, kIsErrorKey );
+		}
+	}
+
+	return 1;
+}
+
+// ----------------------------------------------------------------------------
+
+const char TextureLoadEvent::kName[] = "textureLoad";
+
+TextureLoadEvent::TextureLoadEvent( const char *filename, TextureResource *texture )
+:	fFilename( filename ),
+	fTexture( texture )
+{
+}
+
+const char*
+TextureLoadEvent::Name() const
+{
+	return Self::kName;
+}
+
+int
+TextureLoadEvent::Push( lua_State *L ) const
+{
+	if ( Rtt_VERIFY( Super::Push( L ) ) )
+	{
+		lua_pushstring( L, fFilename );
+		lua_setfield( L, -2, "filename" );
+
+		lua_pushboolean( L, NULL == fTexture );
+		lua_setfield( L, -2, kIsErrorKey );
+
+		if ( fTexture )
+		{
+			fTexture->PushProxy( L );
+			lua_setfield( L, -2, "texture" );
+		}
+	}
+
+	return 1;
+}
+
+// ----------------------------------------------------------------------------
+
 HitEvent::HitEvent( Real xScreen, Real yScreen )
 :	fXContent( xScreen ),
 	fYContent( yScreen ),
@@ -865,6 +990,12 @@ HitEvent::Push( lua_State *L ) const
 	return 1;
 }
 
+bool
+HitEvent::IsPoolable() const
+{
+	return true;
+}
+
 void
 HitEvent::InvalidateTime()
 {
@@ -923,8 +1054,85 @@ TestMask( Rtt_Allocator *allocator, DisplayObject& child, const Matrix& srcToDst
 	return result;
 }
 
+// Only visible/hitTestable objects are tested, and in the multitouch case,
+// only objects that do not have a per object focus id set, since we dispatch
+// focused events outside of hit testing.
+static bool
+ShouldTest( const DisplayObject& child )
+{
+	return child.ShouldHitTest() && ! child.GetFocusId();
+}
+
+bool
+HitEvent::TestLeaf( DisplayObject& child, const Matrix& parentToDst, const Display& display ) const
+{
+	Real x = fXContent;
+	Real y = fYContent;
+
+//	Rtt_ASSERT( child.IsStageBoundsValid() || ! child.CanCull() );
+
+	bool didHit = false;
+
+	// Only test if object is actually on-screen
+	// Test bounding box before doing more expensive testing
+	if ( ! child.IsOffScreen() && child.StageBounds().HitTest( x, y ) )
+	{
+		Rtt_ASSERT( child.IsStageBoundsValid() );
+		child.Prepare( display );
+
+		// TODO: Should we only do SetForceDraw() if the object is hidden?
+		// Ensure Draw() is not a no-op for hidden objects
+		// as defined by DisplayObject::IsNotHidden()
+		bool oldValue = child.IsForceDraw();
+		child.SetForceDraw( true );
+
+		didHit = child.HitTest( x, y );
+
+		child.SetForceDraw( oldValue );
+
+		// Only do deeper testing if a mask exists and the "isHitTestMasked" property is true
+		if ( didHit && child.IsHitTestMasked() && child.GetMask() )
+		{
+			Matrix childToDst( parentToDst );
+			childToDst.Concat( child.GetMatrix() );
+			didHit = TestMask( display.GetRuntime().GetAllocator(), child, childToDst, x, y );
+		}
+	}
+
+	return didHit;
+}
+
+bool
+HitEvent::TestGroup( DisplayObject& child, const Matrix& parentToDst, const Display& display ) const
+{
+	Real x = fXContent;
+	Real y = fYContent;
+
+	// By default, we hit test children, but if the group has hit test masking on,
+	// then we hit test the group's clipped bounding box before we attempt to
+	// hit test the group's children.
+	bool hitTestChildren = child.HitTest( x, y );
+	if( hitTestChildren && child.IsHitTestMasked() )
+	{
+		// By default, stage bounds of composite objects are not built.
+		child.BuildStageBounds();
+		hitTestChildren = child.StageBounds().HitTest( x, y );
+
+		// Only do deeper testing if a mask exists and the "isHitTestMasked" property is true
+		if ( hitTestChildren && child.GetMask() )
+		{
+			Matrix childToDst( parentToDst );
+			childToDst.Concat( child.GetMatrix() );
+
+			hitTestChildren = TestMask( display.GetRuntime().GetAllocator(), child, childToDst, x, y );
+		}
+	}
+
+	return hitTestChildren;
+}
+
 void
-HitEvent::Test( HitTestObject& hitParent, const Matrix& srcToDstSpace ) const
+HitEvent::Test( HitTestObject& hitParent, const Matrix& srcToDstSpace, HitTestObjectArena& arena ) const
 {
 	Rtt_ASSERT( hitParent.Target().AsGroupObject() );
 
@@ -940,97 +1148,151 @@ HitEvent::Test( HitTestObject& hitParent, const Matrix& srcToDstSpace ) const
 	const StageObject *stage = object.GetStage(); Rtt_ASSERT( stage );
 
 	const Display& display = stage->GetDisplay();
-	Rtt_Allocator *allocator = display.GetRuntime().GetAllocator();
-
-	Real x = fXContent;
-	Real y = fYContent;
 
 	for ( S32 i = 0, iMax = object.NumChildren(); i < iMax; i++ )
 	{
 		DisplayObject& child = object.ChildAt( i );
 
-		// Only add visible/hitTestable objects
-		// and in the multitouch case, do not have per object focus id set
-		// since we dispatch focused events outside of hit testing.
-		if ( child.ShouldHitTest() && ! child.GetFocusId() )
+		if ( ShouldTest( child ) )
 		{
 			GroupObject* childAsGroup = child.AsGroupObject();
 			if ( ! childAsGroup )
 			{
-//				Rtt_ASSERT( child.IsStageBoundsValid() || ! child.CanCull() );
-
-				// Only test if object is actually on-screen
-				// Test bounding box before doing more expensive testing
-				if ( ! child.IsOffScreen() && child.StageBounds().HitTest( fXContent, fYContent ) )
+				if ( TestLeaf( child, xform, display ) )
 				{
-					Rtt_ASSERT( child.IsStageBoundsValid() );
-					child.Prepare( display );
-
-					// TODO: Should we only do SetForceDraw() if the object is hidden?
-					// Ensure Draw() is not a no-op for hidden objects
-					// as defined by DisplayObject::IsNotHidden()
-					bool oldValue = child.IsForceDraw();
-					child.SetForceDraw( true );
-
-					bool didHit = child.HitTest( x, y );
-
-					child.SetForceDraw( oldValue );
-
-					// Only do deeper testing if a mask exists and the "isHitTestMasked" property is true
-					if ( didHit && child.IsHitTestMasked() && child.GetMask() )
-					{
-						Matrix childToDst( xform );
-						childToDst.Concat( child.GetMatrix() );
-						didHit = TestMask( allocator, child, childToDst, x, y );
-					}
-
-					if ( didHit )
-					{
-						// Only if we hit, do we add child to the snapshot
-						HitTestObject* hitChild = Rtt_NEW( object.Allocator(), HitTestObject( child, & hitParent ) );
-						hitParent.Prepend( hitChild );
-					}
+					// Only if we hit, do we add child to the snapshot
+					HitTestObject* hitChild = arena.Append( child, & hitParent );
+					hitParent.Prepend( hitChild );
 				}
 			}
-			else
+			else if ( TestGroup( child, xform, display ) )
 			{
-				// By default, we hit test children, but if the group has hit test masking on,
-				// then we hit test the group's clipped bounding box before we attempt to
-				// hit test the group's children.
-				bool hitTestChildren = child.HitTest( x, y );
-				if( hitTestChildren && child.IsHitTestMasked() )
+				const U32 mark = arena.Mark();
+				HitTestObject* hitGroup = arena.Append( child, & hitParent );
+
+				// Recursively call on children
+				Test( * hitGroup, xform, arena );
+				if ( hitGroup->NumChildren() > 0 )
+				{
+					// Only groups that contain children that were hit are added to the snapshot
+					hitParent.Prepend( hitGroup );
+				}
+				else
 				{
-					// By default, stage bounds of composite objects are not built.
-					child.BuildStageBounds();
-					hitTestChildren = child.StageBounds().HitTest( x, y );
-
-					// Only do deeper testing if a mask exists and the "isHitTestMasked" property is true
-					if ( hitTestChildren && child.GetMask() )
-					{
-						Matrix childToDst( xform );
-						childToDst.Concat( child.GetMatrix() );
-
-						hitTestChildren = TestMask( allocator, child, childToDst, x, y );
-					}
+					// Nothing was appended on top of hitGroup
+					arena.Release( mark );
 				}
+			}
+		}
+	}
+}
+
+namespace { // anonymous
+
+// One level of the path from the stage to the current candidate
+struct HitTestFrame
+{
+	GroupObject *fGroup;
+	HitTestObject *fNode; // Created once a descendant is hit
+	Matrix fXform; // Transform applied to fGroup's children
+	bool fDidHit; // Whether fGroup's children should be tested
+};
+
+} // anonymous namespace
+
+void
+HitEvent::TestIndexed( HitTestObject& root, StageObject& stage, HitTestObjectArena& arena ) const
+{
+	Rtt_ASSERT( & root.Target() == & stage );
+
+	const Display& display = stage.GetDisplay();
+	const RenderList& list = stage.GetRenderList();
+	const std::vector< S32 >& candidates = stage.GetHitTestIndex().Query( fXContent, fYContent );
+
+	// Candidates are in draw order, i.e. a depth-first walk of the hierarchy,
+	// so the ancestors of consecutive candidates form a stack. Each group is
+	// tested at most once, and its node is created when its first descendant
+	// is hit, which reproduces the sibling order Test() builds.
+	std::vector< HitTestFrame > frames( 1 );
+	frames[0].fGroup = & stage;
+	frames[0].fNode = & root;
+	frames[0].fXform.Concat( stage.GetMatrix() );
+	frames[0].fDidHit = true;
+
+	for ( size_t i = 0, iMax = candidates.size(); i < iMax; i++ )
+	{
+		DisplayObject *child = const_cast< DisplayObject * >( list.LeafAt( candidates[i] ) );
+		Rtt_ASSERT( child );
+
+		// Cheap rejection before visiting any ancestors
+		if ( ! ShouldTest( * child )
+			 || child->IsOffScreen()
+			 || ! child->StageBounds().HitTest( fXContent, fYContent ) )
+		{
+			continue;
+		}
+
+		// Depth of child's parent below the stage
+		size_t depth = 0;
+		GroupObject *ancestor = child->GetParent();
+		for ( ; ancestor && ancestor != & stage; ancestor = ancestor->GetParent() )
+		{
+			++depth;
+		}
+
+		if ( ! Rtt_VERIFY( ancestor ) )
+		{
+			continue;
+		}
+
+		// Walk up until the path meets the frames retained from the previous candidate
+		size_t numFrames = frames.size();
+		frames.resize( depth + 1 );
+		size_t k = depth;
+		for ( GroupObject *g = child->GetParent();
+			  k > 0 && ! ( k < numFrames && frames[k].fGroup == g );
+			  g = g->GetParent(), --k )
+		{
+			frames[k].fGroup = g;
+			frames[k].fNode = NULL;
+			frames[k].fDidHit = false;
+		}
+
+		// Test the new groups top-down, stopping at the first miss
+		bool didHit = frames[k].fDidHit;
+		for ( ++k; didHit && k <= depth; ++k )
+		{
+			HitTestFrame& frame = frames[k];
+			const HitTestFrame& parent = frames[k - 1];
 
-				if ( hitTestChildren )
+			didHit = ShouldTest( * frame.fGroup ) && TestGroup( * frame.fGroup, parent.fXform, display );
+			frame.fDidHit = didHit;
+			frame.fXform = parent.fXform;
+			frame.fXform.Concat( frame.fGroup->GetMatrix() );
+		}
+
+		// Frames below a miss are stale; keep them out of the next comparison
+		if ( ! didHit )
+		{
+			frames.resize( k );
+			continue;
+		}
+
+		if ( TestLeaf( * child, frames[depth].fXform, display ) )
+		{
+			for ( k = 1; k <= depth; k++ )
+			{
+				HitTestFrame& frame = frames[k];
+				if ( ! frame.fNode )
 				{
-					HitTestObject* hitGroup = Rtt_NEW( object.Allocator(), HitTestObject( child, & hitParent ) );
-
-					// Recursively call on children
-					Test( * hitGroup, xform );
-					if ( hitGroup->NumChildren() > 0 )
-					{
-						// Only groups that contain children that were hit are added to the snapshot
-						hitParent.Prepend( hitGroup );
-					}
-					else
-					{
-						Rtt_DELETE( hitGroup );
-					}
+					HitTestObject *parentNode = frames[k - 1].fNode;
+					frame.fNode = arena.Append( * frame.fGroup, parentNode );
+					parentNode->Prepend( frame.fNode );
 				}
 			}
+
+			HitTestObject *parentNode = frames[depth].fNode;
+			parentNode->Prepend( arena.Append( * child, parentNode ) );
 		}
 	}
 }
@@ -1111,9 +1373,26 @@ HitEvent::Dispatch( lua_State *L, Runtime& runtime ) const
 	{
 		Matrix identity;
 		stage.UpdateTransform( identity );
-		HitTestObject root( stage, NULL );
-		Test( root, identity ); // Generates subtree snapshot
-		DispatchEvent( L, root ); // Dispatches to that subtree
+
+		// Listeners can dispatch nested hit events, which allocate above mark
+		HitTestObjectArena& arena = display.GetHitTestArena();
+		const U32 mark = arena.Mark();
+		{
+			HitTestObject root( stage, NULL );
+
+			// Generates subtree snapshot
+			if ( display.GetDefaults().IsHitTestIndexed() )
+			{
+				TestIndexed( root, stage, arena );
+			}
+			else
+			{
+				Test( root, identity, arena );
+			}
+
+			DispatchEvent( L, root ); // Dispatches to that subtree
+		}
+		arena.Release( mark );
 	}
 
 	// Cleanup: Move objects from the snapshot orphanage to the real orphanage
@@ -1963,6 +2242,12 @@ SpriteEvent::Push( lua_State *L ) const
 	return 1;
 }
 
+bool
+SpriteEvent::IsPoolable() const
+{
+	return true;
+}
+
 // ----------------------------------------------------------------------------
 
 const char NetworkRequestEvent::kName[] = "networkRequest";
@@ -47,6 +47,7 @@ namespace Rtt
 
 class Display;
 class HitTestObject;
+class HitTestObjectArena;
 class StageObject;
 class GroupObject;
 class DisplayObject;
@@ -56,6 +57,7 @@ class PlatformInputAxis;
 class PlatformInputDevice;
 class Runtime;
 class LuaResource;
+class TextureResource;
 class UserdataWrapper;
 struct RGBA;
 
@@ -91,6 +93,10 @@ class VirtualEvent : public MEvent
 	protected:
 		int PrepareDispatch( lua_State *L ) const;
 
+		// High-frequency events return true so that, when event pooling is
+		// enabled, Push() reuses one Lua table per event name
+		virtual bool IsPoolable() const;
+
 	public:
 		virtual void Dispatch( lua_State *L, Runtime& runtime ) const;
 };
@@ -133,6 +139,9 @@ class FrameEvent : public VirtualEvent
 	public:
 		virtual const char* Name() const;
 		virtual int Push( lua_State *L ) const;
+
+	protected:
+		virtual bool IsPoolable() const;
 };
 
 // ============================================================================
@@ -397,6 +406,9 @@ class KeyEvent : public VirtualEvent
 
 		virtual void Dispatch( lua_State *L, Runtime& runtime ) const;
 
+	protected:
+		virtual bool IsPoolable() const;
+
 	public:
 		bool GetResult() const { return fResult; }
 
@@ -451,6 +463,9 @@ class AxisEvent : public VirtualEvent
 		virtual const char* Name() const;
 		virtual int Push( lua_State *L ) const;
 
+	protected:
+		virtual bool IsPoolable() const;
+
 	protected:
 		PlatformInputDevice *fDevicePointer;
 		PlatformInputAxis *fAxisPointer;
@@ -470,6 +485,9 @@ class ColorSampleEvent : public VirtualEvent
 
 		ColorSampleEvent( float x, float y, RGBA &color );
 
+		// The point could not be sampled; dispatched with "isError" set
+		ColorSampleEvent( float x, float y );
+
 		virtual const char* Name() const;
 		virtual int Push( lua_State *L ) const;
 
@@ -477,6 +495,52 @@ class ColorSampleEvent : public VirtualEvent
 		float fX;
 		float fY;
 		RGBA fColor;
+		bool fIsError;
+};
+
+// ----------------------------------------------------------------------------
+
+// Dispatched to the listener of display.requestCaptureScreen() with the
+// captured image object as "target", or with "isError" set on failure
+class ScreenCaptureEvent : public VirtualEvent
+{
+	public:
+		typedef VirtualEvent Super;
+		typedef ScreenCaptureEvent Self;
+
+	public:
+		static const char kName[];
+
+		ScreenCaptureEvent( const DisplayObject *target );
+
+		virtual const char* Name() const;
+		virtual int Push( lua_State *L ) const;
+
+	protected:
+		const DisplayObject *fTarget;
+};
+
+// ----------------------------------------------------------------------------
+
+// Dispatched to the listener of an asynchronous graphics.newTexture() once
+// the image has been decoded and queued for upload
+class TextureLoadEvent : public VirtualEvent
+{
+	public:
+		typedef VirtualEvent Super;
+		typedef TextureLoadEvent Self;
+
+	public:
+		static const char kName[];
+
+		TextureLoadEvent( const char *filename, TextureResource *texture );
+
+		virtual const char* Name() const;
+		virtual int Push( lua_State *L ) const;
+
+	protected:
+		const char *fFilename;
+		TextureResource *fTexture;
 };
 
 // ============================================================================
@@ -497,6 +561,9 @@ class HitEvent : public VirtualEvent
 		virtual int Push( lua_State *L ) const;
 		virtual void Dispatch( lua_State *L, Runtime& runtime ) const;
 
+	protected:
+		virtual bool IsPoolable() const;
+
 	public:
 		bool DispatchFocused( lua_State *L, Runtime& runtime, StageObject& stage, DisplayObject *focus ) const;
 
@@ -520,7 +587,15 @@ class HitEvent : public VirtualEvent
 		const void* GetId() const { return fId; }
 
 	protected:
-		void Test( HitTestObject& parent, const Matrix& srcToDstSpace ) const;
+		void Test( HitTestObject& parent, const Matrix& srcToDstSpace, HitTestObjectArena& arena ) const;
+
+		// Same result as Test() on the stage, but only visits the candidates
+		// returned by the stage's spatial index
+		void TestIndexed( HitTestObject& root, StageObject& stage, HitTestObjectArena& arena ) const;
+
+		// 'parentToDst' is the transform of the child's parent
+		bool TestLeaf( DisplayObject& child, const Matrix& parentToDst, const Display& display ) const;
+		bool TestGroup( DisplayObject& child, const Matrix& parentToDst, const Display& display ) const;
 
 	protected:
 		static void ScreenToContent( const Display& display,  Real xScreen, Real yScreen, Real& outXContent, Real& outYContent );
@@ -936,6 +1011,9 @@ class SpriteEvent : public VirtualEvent
 	public:
 		virtual const char* Name() const;
 		virtual int Push( lua_State *L ) const;
+
+	protected:
+		virtual bool IsPoolable() const;
 				
 	private:
 		const SpriteObject& fTarget;
@@ -12,6 +12,8 @@
 #include "Rtt_HitTestObject.h"
 #include "Display/Rtt_DisplayObject.h"
 
+#include <new>
+
 // ----------------------------------------------------------------------------
 
 namespace Rtt
@@ -31,14 +33,6 @@ HitTestObject::HitTestObject( DisplayObject& target, HitTestObject* parent )
 
 HitTestObject::~HitTestObject()
 {
-	for ( HitTestObject* iCurrent = fChild, *iNext = NULL;
-		  iCurrent;
-		  iCurrent = iNext )
-	{
-		iNext = iCurrent->fSibling;
-		Rtt_DELETE( iCurrent );
-	}
-
 	fTarget.SetUsedByHitTest( false );
 }
 
@@ -56,6 +50,58 @@ HitTestObject::Prepend( HitTestObject* child )
 
 // ----------------------------------------------------------------------------
 
+HitTestObjectArena::HitTestObjectArena( Rtt_Allocator *allocator )
+:	fAllocator( allocator ),
+	fBlocks(),
+	fCount( 0 )
+{
+}
+
+HitTestObjectArena::~HitTestObjectArena()
+{
+	Release( 0 );
+
+	for ( size_t i = 0, iMax = fBlocks.size(); i < iMax; i++ )
+	{
+		Rtt_FREE( fBlocks[i] );
+	}
+}
+
+HitTestObject*
+HitTestObjectArena::At( U32 index ) const
+{
+	HitTestObject *block = (HitTestObject *)fBlocks[index / kBlockSize];
+	return block + ( index % kBlockSize );
+}
+
+HitTestObject*
+HitTestObjectArena::Append( DisplayObject& target, HitTestObject *parent )
+{
+	if ( fCount == (U32)fBlocks.size() * kBlockSize )
+	{
+		fBlocks.push_back( Rtt_MALLOC( fAllocator, kBlockSize * sizeof( HitTestObject ) ) );
+	}
+
+	HitTestObject *result = new( At( fCount ) ) HitTestObject( target, parent );
+	++fCount;
+
+	return result;
+}
+
+void
+HitTestObjectArena::Release( U32 mark )
+{
+	Rtt_ASSERT( mark <= fCount );
+
+	while ( fCount > mark )
+	{
+		--fCount;
+		At( fCount )->~HitTestObject();
+	}
+}
+
+// ----------------------------------------------------------------------------
+
 } // namespace Rtt
 
 // ----------------------------------------------------------------------------
@@ -10,9 +10,15 @@
 #ifndef _Rtt_HitTestObject_H__
 #define _Rtt_HitTestObject_H__
 
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Types.h"
+
+#include <vector>
+
 // ----------------------------------------------------------------------------
 
 struct lua_State;
+struct Rtt_Allocator;
 
 namespace Rtt
 {
@@ -23,6 +29,9 @@ class DisplayObject;
 
 // HitTestObject is a wrapper for DisplayObjects. Its sole function is to allow
 // the creation of a snapshot of the display hierarchy during hit testing.
+//
+// Children are not owned. They are allocated from a HitTestObjectArena, which
+// destroys them when the snapshot is released.
 
 class HitTestObject
 {
@@ -54,6 +63,40 @@ class HitTestObject
 		S32 fNumChildren;
 };
 
+// Stack-like storage for the HitTestObjects of a hit-test snapshot, so that
+// dispatching a touch does not hit the heap once the arena has warmed up.
+// Storage is kept in fixed-size blocks so objects never move; nested
+// dispatches simply allocate above the outer dispatch's mark.
+class HitTestObjectArena
+{
+	Rtt_CLASS_NO_COPIES( HitTestObjectArena )
+
+	public:
+		enum
+		{
+			kBlockSize = 256
+		};
+
+	public:
+		HitTestObjectArena( Rtt_Allocator *allocator );
+		~HitTestObjectArena();
+
+	public:
+		HitTestObject* Append( DisplayObject& target, HitTestObject *parent );
+
+		// Destroys, newest first, every object appended after 'mark'
+		U32 Mark() const { return fCount; }
+		void Release( U32 mark );
+
+	private:
+		HitTestObject* At( U32 index ) const;
+
+	private:
+		Rtt_Allocator *fAllocator;
+		std::vector< void * > fBlocks; // Raw storage, freed by the destructor
+		U32 fCount;
+};
+
 // ----------------------------------------------------------------------------
 
 } // namespace Rtt
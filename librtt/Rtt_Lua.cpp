@@ -76,6 +76,7 @@ static const char kNameKey[] = "name";
 // evaluates to a string literal.
 static const char kCoronaCriticalSectionKey[] = "_corona.criticalSection." __FILE__;
 static const char kCoronaThreadKey[] = "_corona.thread." __FILE__;
+static const char kEventPoolKey[] = "_corona.eventPool." __FILE__;
 
 // ----------------------------------------------------------------------------
 
@@ -250,6 +251,100 @@ Lua::NewEvent( lua_State *L, const char *eventName )
 	}
 }
 
+// The pool maps each event name to its table, and each table to the DoCall()
+// depth at which it was last handed out. A table is only reused once the call
+// stack has unwound back to that depth, i.e. every listener that could still
+// be reading it has returned. Nested dispatches of the same event get a fresh
+// table instead.
+void
+Lua::NewPooledEvent( lua_State *L, const char *eventName )
+{
+	Rtt_ASSERT( NULL != eventName );
+
+	lua_getfield( L, LUA_REGISTRYINDEX, kEventPoolKey );
+	if ( ! lua_istable( L, -1 ) )
+	{
+		lua_pop( L, 1 );
+		NewEvent( L, eventName );
+		return;
+	}
+
+	int pool = lua_gettop( L );
+	lua_Number depth = GetCallDepth( L );
+
+	lua_getfield( L, pool, eventName );
+	if ( lua_istable( L, -1 ) )
+	{
+		lua_pushvalue( L, -1 );
+		lua_rawget( L, pool );
+		bool isFree = ( lua_tonumber( L, -1 ) >= depth );
+		lua_pop( L, 1 );
+
+		if ( ! isFree )
+		{
+			lua_pop( L, 2 ); // pop table, pool
+			NewEvent( L, eventName );
+			return;
+		}
+
+		// Clear fields (and any metatable) left over from the previous dispatch
+		int t = lua_gettop( L );
+		lua_pushnil( L );
+		while ( lua_next( L, t ) )
+		{
+			lua_pop( L, 1 ); // pop value
+			lua_pushvalue( L, -1 );
+			lua_pushnil( L );
+			lua_rawset( L, t );
+		}
+		lua_pushnil( L );
+		lua_setmetatable( L, t );
+	}
+	else
+	{
+		lua_pop( L, 1 );
+		lua_newtable( L );
+		lua_pushvalue( L, -1 );
+		lua_setfield( L, pool, eventName );
+	}
+
+	lua_pushvalue( L, -1 );
+	lua_pushnumber( L, depth );
+	lua_rawset( L, pool );
+
+	lua_pushstring( L, eventName );
+	lua_setfield( L, -2, kNameKey );
+
+	lua_remove( L, pool );
+}
+
+void
+Lua::SetEventPooling( lua_State *L, bool enabled )
+{
+	if ( enabled )
+	{
+		if ( IsEventPooling( L ) )
+		{
+			return;
+		}
+		lua_newtable( L );
+	}
+	else
+	{
+		lua_pushnil( L );
+	}
+	lua_setfield( L, LUA_REGISTRYINDEX, kEventPoolKey );
+}
+
+bool
+Lua::IsEventPooling( lua_State *L )
+{
+	lua_getfield( L, LUA_REGISTRYINDEX, kEventPoolKey );
+	bool result = lua_istable( L, -1 );
+	lua_pop( L, 1 );
+	return result;
+}
+
 void
 Lua::DispatchEvent( lua_State *L, Ref listenerRef, int nresults )
 {
@@ -781,6 +876,44 @@ Lua::Warning( lua_State *L, const char *fmt, ... )
 	lua_pop(L, 1);
 }
 	
+// States made with luaL_newstate() (e.g. to read config.lua) have no context.
+// They never pool events, so their depth can stay 0.
+static LuaContext *
+GetCallDepthContext( lua_State *L )
+{
+	void *ud = NULL;
+	(void)lua_getallocf( L, & ud );
+	return ( ud ? LuaContext::GetContext( L ) : NULL );
+}
+
+// The depth lives in the LuaContext, so it is shared by the coroutines of a
+// state but not by unrelated states (e.g. across Simulator relaunches)
+U32
+Lua::GetCallDepth( lua_State *L )
+{
+	LuaContext *context = GetCallDepthContext( L );
+	return ( context ? context->GetCallDepth() : 0 );
+}
+
+Lua::CallDepthScope::CallDepthScope( lua_State *L )
+:	fContext( GetCallDepthContext( L ) )
+{
+	if ( fContext )
+	{
+		fContext->SetCallDepth( fContext->GetCallDepth() + 1 );
+	}
+}
+
+Lua::CallDepthScope::~CallDepthScope()
+{
+	if ( fContext )
+	{
+		U32 depth = fContext->GetCallDepth();
+		Rtt_ASSERT( depth > 0 );
+		fContext->SetCallDepth( depth - 1 );
+	}
+}
+
 int
 Lua::DoCall( lua_State* L, int narg, int nresults )
 {
@@ -798,7 +931,11 @@ Lua::DoCall( lua_State* L, int narg, int nresults )
 	signal(SIGINT, LuaAction);
 #endif
 
-    int status = lua_pcall(L, narg, nresults, errfunc);
+	int status;
+	{
+		CallDepthScope scope( L );
+		status = lua_pcall(L, narg, nresults, errfunc);
+	}
 	
 #if !defined(EMSCRIPTEN)
 	signal(SIGINT, SIG_DFL);
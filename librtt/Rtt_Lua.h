@@ -27,6 +27,7 @@ Rtt_EXPORT_END
 namespace Rtt
 {
 
+class LuaContext;
 class MCriticalSection;
 class String;
 
@@ -66,6 +67,12 @@ class Lua
 		static void DeleteRef( lua_State *L, Ref ref );
 		static bool EqualRef( lua_State *L, Ref ref, int index );
 		static void NewEvent( lua_State *L, const char *eventName );
+		// Like NewEvent(), but reuses one table per event name when pooling is
+		// enabled (see SetEventPooling). Pooled tables are cleared and refilled
+		// for each dispatch, so listeners must copy any field they want to keep.
+		static void NewPooledEvent( lua_State *L, const char *eventName );
+		static void SetEventPooling( lua_State *L, bool enabled );
+		static bool IsEventPooling( lua_State *L );
 		static void DispatchEvent( lua_State *L, Ref listenerRef, int nresults );
 		static void DispatchRuntimeEvent( lua_State *L, int nresults );
 
@@ -115,6 +122,20 @@ class Lua
 	
 	public:
 		static int DoCall( lua_State* L, int narg, int nresults );
+		static U32 GetCallDepth( lua_State *L );
+
+		// Tracks nesting of DoCall() per state so pooled event tables still in
+		// use by a listener further up the stack are not handed out again
+		class CallDepthScope
+		{
+			public:
+				CallDepthScope( lua_State *L );
+				~CallDepthScope();
+
+			private:
+				LuaContext *fContext;
+		};
+
 		static int DoBuffer( lua_State *L, lua_CFunction loader, lua_CFunction pushargs );
 		static int DoFile( lua_State *L, const char* file, int narg, bool clear, String *errorMesg = NULL );
 
@@ -31,11 +31,14 @@
 #if defined ( Rtt_USE_OPENSLES )
 #include "Rtt_LuaLibOpenSLES.h"
 #endif
+#include "Rtt_LuaEventDispatcher.h"
 #include "Rtt_LuaLibNative.h"
 #if defined( Rtt_SQLITE )
 #include "Rtt_LuaLibSQLite.h"
 #endif
 #include "Rtt_LuaLibSystem.h"
+#include "Rtt_LuaLibTimer.h"
+#include "Rtt_LuaLibTransition.h"
 #include "Rtt_LuaUserdataProxy.h"
 #include "Rtt_MPlatform.h"
 #include "Rtt_PlatformData.h"
@@ -690,7 +693,7 @@ LuaContext::InitializeLuaCore( lua_State* L )
 		{ "sqlite3", LuaLibSQLite::Open },
 #endif
 		{ "store", LuaLibStore::Open },
-		{ "easing", Lua::Open< luaload_easing> },
+		{ "easing", LuaLibTransition::OpenEasing },
 		{ "dkjson", Lua::Open< luaload_dkjson > },
 		{ "json", Lua::Open< luaload_json > },
 #ifdef Rtt_DEBUGGER
@@ -761,11 +764,16 @@ LuaContext::InitializeRttCore( lua_State* L, Runtime *runtime )
 	// Init Userdata Proxy
 	LuaUserdataProxy::Initialize( L );
 
+	// Init listener storage of EventDispatcher (see init.lua)
+	LuaEventDispatcher::Initialize( L );
+
 	// Init core classes
 	CoronaLibraryInitialize( L );
 
 	// Init built-in libs
 	LuaLibSystem::Initialize( L );
+	LuaLibTimer::Initialize( L );
+	LuaLibTransition::Initialize( L );
 	LuaLibDisplay::Initialize( L, runtime->GetDisplay() );
 #if defined ( Rtt_USE_ALMIXER )
 	LuaLibOpenAL::Initialize( L );
@@ -836,7 +844,11 @@ LuaContext::DoCall( lua_State* L, int narg, int nresults )
 #endif
 
 	// The actual call
-	int status = lua_pcall(L, narg, nresults, errfunc);
+	int status;
+	{
+		Lua::CallDepthScope scope( L );
+		status = lua_pcall(L, narg, nresults, errfunc);
+	}
 
 #if (defined( Rtt_DEBUG ) || defined( Rtt_DEBUGGER )) && !defined(EMSCRIPTEN)
 	signal(SIGINT, SIG_DFL);
@@ -1079,7 +1091,8 @@ LuaContext::IsBinaryLua( const char* filename )
 LuaContext::LuaContext( ::lua_State* L )
 :	fL( L ),
 	fHandle( LuaContext::GetAllocator( L ), * L ),
-	fModules( 0 )
+	fModules( 0 ),
+	fCallDepth( 0 )
 {
 }
 
@@ -15,6 +15,7 @@
 #include "Core/Rtt_ResourceHandle.h"
 
 #include "Rtt_LuaAux.h"
+#include "Rtt_LuaProxyKeyCache.h"
 
 namespace Rtt
 {
@@ -130,10 +131,19 @@ class LuaContext
 	public:
 		void UpdateStage( StageObject& stage ) const ;
 
+	public:
+		LuaProxyKeyCache& GetProxyKeyCache() { return fProxyKeyCache; }
+
+		// Nesting of Lua::DoCall() on this state, see Lua::CallDepthScope
+		U32 GetCallDepth() const { return fCallDepth; }
+		void SetCallDepth( U32 newValue ) { fCallDepth = newValue; }
+
 	private:
 		lua_State* fL;
 		ResourceHandleOwner< lua_State > fHandle;
 		U32 fModules; // Used by Simulator to determine what modules are in use
+		LuaProxyKeyCache fProxyKeyCache;
+		U32 fCallDepth;
 };
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,370 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Rtt_LuaEventDispatcher.h"
+
+#include "Rtt_Lua.h"
+#include "Rtt_LuaContext.h"
+
+#include <algorithm>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+static const char kMetatableName[] = __FILE__; // unique identifier for this userdata type
+
+static const char kListenersKey[] = "_eventListeners";
+
+void
+LuaEventDispatcher::Initialize( lua_State *L )
+{
+	Rtt_LUA_STACK_GUARD( L );
+
+	const luaL_Reg kVTable[] =
+	{
+		{ "__gc", GC },
+		{ NULL, NULL }
+	};
+
+	Lua::InitializeMetatable( L, kMetatableName, kVTable );
+}
+
+LuaEventDispatcher::LuaEventDispatcher()
+:	fEvents(),
+	fGeneration( 0 )
+{
+}
+
+int
+LuaEventDispatcher::GC( lua_State *L )
+{
+	Self *listeners = (Self *)Lua::CheckUserdata( L, 1, kMetatableName );
+	Rtt_DELETE( listeners );
+
+	return 0;
+}
+
+void
+LuaEventDispatcher::ResolveListener( lua_State *L )
+{
+	if ( lua_isnil( L, 3 ) )
+	{
+		lua_pushvalue( L, 2 );
+		lua_gettable( L, 1 ); // self[eventName]
+		if ( lua_toboolean( L, -1 ) )
+		{
+			lua_pushvalue( L, 1 );
+			lua_replace( L, 3 );
+		}
+		lua_pop( L, 1 );
+	}
+}
+
+LuaEventDispatcher *
+LuaEventDispatcher::GetListeners( lua_State *L, bool create )
+{
+	Self *result = NULL;
+
+	lua_getfield( L, 1, kListenersKey );
+	if ( lua_touserdata( L, -1 ) && lua_getmetatable( L, -1 ) )
+	{
+		luaL_getmetatable( L, kMetatableName );
+		if ( lua_rawequal( L, -1, -2 ) )
+		{
+			result = (Self *)Lua::ToUserdata( L, -3 );
+		}
+		lua_pop( L, 2 );
+	}
+
+	if ( ! result && create )
+	{
+		lua_pop( L, 1 );
+
+		result = Rtt_NEW( LuaContext::GetAllocator( L ), Self );
+		Lua::PushUserdata( L, result, kMetatableName );
+		lua_newtable( L );
+		lua_setfenv( L, -2 );
+
+		lua_pushvalue( L, -1 );
+		lua_setfield( L, 1, kListenersKey );
+	}
+
+	if ( result )
+	{
+		lua_getfenv( L, -1 );
+	}
+	else
+	{
+		lua_pop( L, 1 );
+	}
+
+	return result;
+}
+
+size_t
+LuaEventDispatcher::Next( const ListenerArray& array, size_t hint, U64 generation )
+{
+	// Unless listeners were removed, the previous one is where it was
+	if ( hint < array.size() && generation == array[hint].fGeneration )
+	{
+		return hint + 1;
+	}
+
+	struct Compare
+	{
+		bool operator()( U64 lhs, const Listener& rhs ) const { return lhs < rhs.fGeneration; }
+	};
+
+	// Generations increase along the array
+	return std::upper_bound( array.begin(), array.end(), generation, Compare() ) - array.begin();
+}
+
+LuaEventDispatcher::ListenerArray *
+LuaEventDispatcher::Find( const char *eventName )
+{
+	ListenerArray *result = NULL;
+
+	if ( eventName )
+	{
+		std::unordered_map< std::string, ListenerArray >::iterator iter = fEvents.find( eventName );
+		if ( iter != fEvents.end() && ! iter->second.empty() )
+		{
+			result = & iter->second;
+		}
+	}
+
+	return result;
+}
+
+S32
+LuaEventDispatcher::IndexOf( lua_State *L, const ListenerArray& array, int index )
+{
+	for ( size_t i = 0, iMax = array.size(); i < iMax; i++ )
+	{
+		lua_pushnumber( L, (lua_Number)array[i].fGeneration );
+		lua_rawget( L, -2 );
+		bool isEqual = lua_rawequal( L, -1, index );
+		lua_pop( L, 1 );
+
+		if ( isEqual )
+		{
+			return (S32)i;
+		}
+	}
+
+	return -1;
+}
+
+void
+LuaEventDispatcher::Dispatch( lua_State *L, const char *eventName, bool isTable, int eventIndex, int resultIndex )
+{
+	ListenerArray *array = Find( eventName );
+	if ( ! array )
+	{
+		return;
+	}
+
+	int envIndex = lua_gettop( L );
+
+	// Listeners added from now on wait for the next event
+	const U64 lastGeneration = fGeneration;
+
+	U64 generation = 0;
+	for ( size_t i = Next( *array, array->size(), generation );
+		  i < array->size() && (*array)[i].fGeneration <= lastGeneration;
+		  i = Next( *array, i, generation ) )
+	{
+		const Listener& listener = (*array)[i];
+		generation = listener.fGeneration;
+
+		if ( listener.fIsTable != isTable )
+		{
+			continue;
+		}
+
+		lua_pushnumber( L, (lua_Number)generation );
+		lua_rawget( L, envIndex );
+
+		if ( isTable )
+		{
+			// Fetch method stored as property of object
+			lua_getfield( L, -1, eventName );
+			if ( ! lua_isfunction( L, -1 ) )
+			{
+				lua_pop( L, 2 );
+				continue;
+			}
+
+			lua_insert( L, -2 ); // method( obj, event )
+			lua_pushvalue( L, eventIndex );
+			lua_call( L, 2, 1 );
+		}
+		else
+		{
+			lua_pushvalue( L, eventIndex );
+			lua_call( L, 1, 1 );
+		}
+
+		if ( lua_toboolean( L, -1 ) )
+		{
+			lua_replace( L, resultIndex );
+		}
+		else
+		{
+			lua_pop( L, 1 );
+		}
+	}
+}
+
+// object:addEventListener( eventName [, listener] )
+int
+LuaEventDispatcher::AddEventListener( lua_State *L )
+{
+	lua_settop( L, 3 );
+	const char *eventName = luaL_checkstring( L, 2 );
+	ResolveListener( L );
+
+	int type = lua_type( L, 3 );
+	if ( LUA_TFUNCTION != type && LUA_TTABLE != type )
+	{
+		luaL_error( L, "addEventListener: listener must be a function or a table, got %s", luaL_typename( L, 3 ) );
+	}
+
+	Self *listeners = GetListeners( L, true );
+
+	Listener listener = { ++listeners->fGeneration, LUA_TTABLE == type };
+	lua_pushnumber( L, (lua_Number)listener.fGeneration );
+	lua_pushvalue( L, 3 );
+	lua_rawset( L, -3 );
+
+	listeners->fEvents[eventName].push_back( listener );
+
+	lua_pushboolean( L, 1 );
+	return 1;
+}
+
+// object:removeEventListener( eventName [, listener] )
+int
+LuaEventDispatcher::RemoveEventListener( lua_State *L )
+{
+	lua_settop( L, 3 );
+	const char *eventName = lua_tostring( L, 2 );
+	ResolveListener( L );
+
+	bool wasRemoved = false;
+
+	Self *listeners = GetListeners( L, false );
+	ListenerArray *array = listeners ? listeners->Find( eventName ) : NULL;
+	if ( array )
+	{
+		S32 i = IndexOf( L, *array, 3 );
+		if ( i >= 0 )
+		{
+			lua_pushnumber( L, (lua_Number)(*array)[i].fGeneration );
+			lua_pushnil( L );
+			lua_rawset( L, -3 );
+
+			array->erase( array->begin() + i );
+			wasRemoved = true;
+
+			// Signal a derived dispatcher, e.g. Runtime, that a listener has been removed
+			lua_getfield( L, 1, "didRemoveListener" );
+			if ( lua_isfunction( L, -1 ) )
+			{
+				lua_pushvalue( L, 1 );
+				lua_pushvalue( L, 2 );
+				lua_call( L, 2, 0 );
+			}
+			else
+			{
+				lua_pop( L, 1 );
+			}
+		}
+	}
+
+	if ( wasRemoved )
+	{
+		lua_pushboolean( L, 1 );
+	}
+	else
+	{
+		lua_pushnil( L );
+	}
+	return 1;
+}
+
+// object:hasEventListener( eventName [, listener] )
+int
+LuaEventDispatcher::HasEventListener( lua_State *L )
+{
+	lua_settop( L, 3 );
+	const char *eventName = lua_tostring( L, 2 );
+	ResolveListener( L );
+
+	Self *listeners = GetListeners( L, false );
+	ListenerArray *array = listeners ? listeners->Find( eventName ) : NULL;
+
+	lua_pushboolean( L, array && IndexOf( L, *array, 3 ) >= 0 );
+	return 1;
+}
+
+// object:dispatchEvent( event )
+int
+LuaEventDispatcher::DispatchEvent( lua_State *L )
+{
+	lua_settop( L, 2 );
+	luaL_checktype( L, 2, LUA_TTABLE );
+
+	lua_pushboolean( L, 0 ); // result
+	const int resultIndex = lua_gettop( L );
+
+	lua_getfield( L, 2, "name" ); // Keeps the name alive during the dispatch
+	const char *eventName = lua_tostring( L, -1 );
+
+	Self *listeners = eventName ? GetListeners( L, false ) : NULL;
+	if ( listeners )
+	{
+		// Function listeners are called before table listeners
+		listeners->Dispatch( L, eventName, false, 2, resultIndex );
+		listeners->Dispatch( L, eventName, true, 2, resultIndex );
+	}
+
+	lua_pushvalue( L, resultIndex );
+	return 1;
+}
+
+// object:respondsToEvent( eventName )
+int
+LuaEventDispatcher::RespondsToEvent( lua_State *L )
+{
+	const char *eventName = lua_tostring( L, 2 );
+
+	Self *listeners = GetListeners( L, false );
+	if ( listeners && listeners->Find( eventName ) )
+	{
+		lua_pushboolean( L, 1 );
+	}
+	else
+	{
+		lua_pushnil( L );
+	}
+	return 1;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
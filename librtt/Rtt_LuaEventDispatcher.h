@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_LuaEventDispatcher_H__
+#define _Rtt_LuaEventDispatcher_H__
+
+#include "Core/Rtt_Types.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+struct lua_State;
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Listeners of a Lua event dispatcher, i.e. Runtime, a display object or an
+// object created by system.newEventDispatcher(). The methods of EventDispatcher
+// in init.lua are bound to the Lua functions below, which keep the listeners
+// in a userdata stored in the receiver's "_eventListeners" field.
+//
+// Listeners are appended to an array per event name, stamped with an
+// increasing generation. Removal erases the entry right away, even during a
+// dispatch: each dispatch resumes after the generation of the last listener
+// it called, and skips listeners added after it began. So nothing is copied
+// or allocated per event.
+//
+// The listener values live in the userdata's environment table, keyed by
+// generation, so that the garbage collector sees them.
+class LuaEventDispatcher
+{
+	public:
+		typedef LuaEventDispatcher Self;
+
+	public:
+		static void Initialize( lua_State *L );
+
+	public:
+		// EventDispatcher methods; the receiver is at index 1
+		static int AddEventListener( lua_State *L );
+		static int RemoveEventListener( lua_State *L );
+		static int HasEventListener( lua_State *L );
+		static int DispatchEvent( lua_State *L );
+		static int RespondsToEvent( lua_State *L );
+
+	protected:
+		LuaEventDispatcher();
+
+	private:
+		static int GC( lua_State *L );
+
+		// Replaces a missing listener (index 3) with the receiver if it has a
+		// method named after the event (index 2)
+		static void ResolveListener( lua_State *L );
+
+		// Returns the receiver's listeners. Unless 'create' is true, NULL is
+		// returned if it has none. On success, the userdata and its
+		// environment table are pushed; otherwise nothing is.
+		static Self *GetListeners( lua_State *L, bool create );
+
+	private:
+		struct Listener
+		{
+			U64 fGeneration; // Key in the environment table
+			bool fIsTable;
+		};
+
+		typedef std::vector< Listener > ListenerArray;
+
+		// Returns the index of the first listener in 'array' added after
+		// 'generation'. 'hint' is the index the listener with 'generation'
+		// had before any removal.
+		static size_t Next( const ListenerArray& array, size_t hint, U64 generation );
+
+		ListenerArray *Find( const char *eventName );
+
+		// Index in 'array' of the first listener that is raw equal to the
+		// value at 'index', or -1. The environment table must be on top.
+		static S32 IndexOf( lua_State *L, const ListenerArray& array, int index );
+
+		// Calls the listeners of one kind, in the order they were added.
+		// Truthy results replace the value at 'resultIndex'.
+		void Dispatch( lua_State *L, const char *eventName, bool isTable, int eventIndex, int resultIndex );
+
+	private:
+		// Arrays are emptied, but never erased, so they can't disappear
+		// from under a dispatch.
+		std::unordered_map< std::string, ListenerArray > fEvents;
+		U64 fGeneration;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_LuaEventDispatcher_H__
@@ -15,6 +15,7 @@
 #include "Display/Rtt_TextureFactory.h"
 #include "Rtt_LuaContext.h"
 #include "Display/Rtt_LuaLibDisplay.h"
+#include "Rtt_LuaEventDispatcher.h"
 #include "Rtt_LuaProxy.h"
 #include "Rtt_MPlatform.h"
 #include "Rtt_MPlatformDevice.h"
@@ -901,6 +902,19 @@ setAccelerometerInterval( lua_State *L )
 	return 0;
 }
 
+// system.setEventPooling( enabled )
+//
+// When enabled, enterFrame, key, axis, touch, mouse and sprite events reuse one
+// table per event name instead of allocating a new one per dispatch. The table
+// is only valid for the duration of the listener call: listeners that keep the
+// event (or hand it to a timer/transition) must copy the fields they need.
+static int
+setEventPooling( lua_State *L )
+{
+	Lua::SetEventPooling( L, !! lua_toboolean( L, 1 ) );
+	return 0;
+}
+
 static int
 setGyroscopeInterval( lua_State *L )
 {
@@ -1323,6 +1337,11 @@ LuaLibSystem::Initialize( lua_State *L )
 		{ "__proxyindex", LuaProxy::__proxyindex },
 		{ "__proxynewindex", LuaProxy::__proxynewindex },
 		{ "__proxyregister", LuaProxy::__proxyregister },
+		{ "__addEventListener", LuaEventDispatcher::AddEventListener }, // private
+		{ "__removeEventListener", LuaEventDispatcher::RemoveEventListener }, // private
+		{ "__hasEventListener", LuaEventDispatcher::HasEventListener }, // private
+		{ "__dispatchEvent", LuaEventDispatcher::DispatchEvent }, // private
+		{ "__respondsToEvent", LuaEventDispatcher::RespondsToEvent }, // private
 		{ "pathForFile", LuaLibSystem::PathForFile },
 		{ "pathForTable", LuaLibSystem::PathForTable }, // private
 		{ "beginListener", LuaLibSystem::BeginListener }, // private; use system.activate() publicly
@@ -1345,6 +1364,7 @@ LuaLibSystem::Initialize( lua_State *L )
 		{ "getInputDevices", getInputDevices },
 		{ "setAccelerometerInterval", setAccelerometerInterval },
 		{ "setGyroscopeInterval", setGyroscopeInterval },
+		{ "setEventPooling", setEventPooling },
 		{ "activate", LuaLibSystem::Activate }, // public use
 		{ "deactivate", LuaLibSystem::Deactivate }, // public use
 
@@ -0,0 +1,342 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Rtt_LuaLibTimer.h"
+
+#include "Rtt_LuaContext.h"
+#include "Rtt_Runtime.h"
+#include "Rtt_TimerWheel.h"
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Registry table mapping timer ids (1-based) to their handles. A handle is
+// the table returned by timer.performWithDelay(); it holds the listener.
+static const char kHandlesKey[] = __FILE__;
+
+static const char kListenerKey[] = "_listener";
+static const char kIdKey[] = "_id";
+
+// Longer delays (about 24.8 days) are clamped to this
+static const lua_Number kMaxDelay = 0x7FFFFFFF;
+
+static TimerWheel&
+GetTimerWheel( lua_State *L )
+{
+	return LuaContext::GetRuntime( L )->GetTimerWheel();
+}
+
+static U64
+GetTime( lua_State *L )
+{
+	return (U64)LuaContext::GetRuntime( L )->GetElapsedMS();
+}
+
+static void
+PushHandles( lua_State *L )
+{
+	lua_getfield( L, LUA_REGISTRYINDEX, kHandlesKey );
+}
+
+// Returns the id of the handle at 'index', or kInvalidId if it has expired
+// or was cancelled
+static S32
+ToId( lua_State *L, int index )
+{
+	S32 result = TimerWheel::kInvalidId;
+
+	lua_getfield( L, index, kIdKey );
+	if ( lua_isnumber( L, -1 ) )
+	{
+		S32 id = (S32)lua_tointeger( L, -1 );
+
+		PushHandles( L );
+		lua_rawgeti( L, -1, id + 1 );
+		if ( lua_rawequal( L, -1, index ) )
+		{
+			result = id;
+		}
+		lua_pop( L, 2 );
+	}
+	lua_pop( L, 1 );
+
+	return result;
+}
+
+static void
+RemoveTimer( lua_State *L, S32 id )
+{
+	GetTimerWheel( L ).Remove( id );
+
+	PushHandles( L );
+	lua_pushnil( L );
+	lua_rawseti( L, -2, id + 1 );
+	lua_pop( L, 1 );
+}
+
+typedef bool (*TimerAction)( lua_State *L, S32 id );
+
+static bool
+CancelTimer( lua_State *L, S32 id )
+{
+	RemoveTimer( L, id );
+	return true;
+}
+
+static bool
+PauseTimer( lua_State *L, S32 id )
+{
+	return GetTimerWheel( L ).Pause( id, GetTime( L ) );
+}
+
+static bool
+ResumeTimer( lua_State *L, S32 id )
+{
+	return GetTimerWheel( L ).Resume( id, GetTime( L ) );
+}
+
+// Applies 'action' to the timers with the given tag, or to all of them if
+// 'tag' is NULL
+static void
+ApplyToTimers( lua_State *L, const char *tag, TimerAction action )
+{
+	std::vector< S32 > ids;
+	GetTimerWheel( L ).GetTimers( tag, ids );
+
+	for ( size_t i = 0, iMax = ids.size(); i < iMax; i++ )
+	{
+		action( L, ids[i] );
+	}
+}
+
+// Applies 'action' to the handle or tag at index 1. For a handle, pushes the
+// time it has left; a cancelled one also pushes its remaining iterations.
+static int
+ApplyToArgument( lua_State *L, const char *name, TimerAction action )
+{
+	int result = 0;
+
+	if ( lua_istable( L, 1 ) )
+	{
+		S32 id = ToId( L, 1 );
+		if ( TimerWheel::kInvalidId != id )
+		{
+			const TimerWheel& wheel = GetTimerWheel( L );
+			U64 time = GetTime( L );
+
+			if ( CancelTimer == action )
+			{
+				lua_pushnumber( L, (lua_Number)wheel.GetTimeLeft( id, time ) );
+				lua_pushinteger( L, wheel.GetIterationsLeft( id ) );
+				action( L, id );
+				result = 2;
+			}
+			else
+			{
+				action( L, id );
+				lua_pushnumber( L, (lua_Number)wheel.GetTimeLeft( id, time ) );
+				result = 1;
+			}
+		}
+	}
+	else if ( lua_type( L, 1 ) == LUA_TSTRING )
+	{
+		ApplyToTimers( L, lua_tostring( L, 1 ), action );
+	}
+	else
+	{
+		luaL_error( L, "timer.%s(): expected a timer handle or tag, got %s", name, luaL_typename( L, 1 ) );
+	}
+
+	return result;
+}
+
+// timer.performWithDelay( delay, listener [, iterations] [, tag] )
+static int
+performWithDelay( lua_State *L )
+{
+	lua_Number delay = luaL_checknumber( L, 1 );
+	delay = delay < 0 ? 0 : ( delay > kMaxDelay ? kMaxDelay : delay );
+
+	if ( ! lua_isfunction( L, 2 ) && ! lua_istable( L, 2 ) )
+	{
+		luaL_argerror( L, 2, "function or table listener expected" );
+	}
+
+	int tagIndex = 4;
+	S32 iterations = 1;
+	if ( lua_type( L, 3 ) == LUA_TSTRING )
+	{
+		tagIndex = 3;
+	}
+	else if ( ! lua_isnoneornil( L, 3 ) )
+	{
+		iterations = (S32)luaL_checkinteger( L, 3 ); // 0 or -1 repeat forever
+		if ( iterations <= 0 )
+		{
+			iterations = 0;
+		}
+	}
+	const char *tag = lua_tostring( L, tagIndex );
+
+	S32 id = GetTimerWheel( L ).Add( GetTime( L ), (U32)delay, iterations, tag );
+
+	lua_createtable( L, 0, 2 );
+	{
+		lua_pushvalue( L, 2 );
+		lua_setfield( L, -2, kListenerKey );
+		lua_pushinteger( L, id );
+		lua_setfield( L, -2, kIdKey );
+	}
+
+	PushHandles( L );
+	lua_pushvalue( L, -2 );
+	lua_rawseti( L, -2, id + 1 );
+	lua_pop( L, 1 );
+
+	return 1;
+}
+
+// timer.cancel( handleOrTag )
+static int
+cancel( lua_State *L )
+{
+	return ApplyToArgument( L, "cancel", CancelTimer );
+}
+
+// timer.pause( handleOrTag )
+static int
+pause( lua_State *L )
+{
+	return ApplyToArgument( L, "pause", PauseTimer );
+}
+
+// timer.resume( handleOrTag )
+static int
+resume( lua_State *L )
+{
+	return ApplyToArgument( L, "resume", ResumeTimer );
+}
+
+static int
+cancelAll( lua_State *L )
+{
+	ApplyToTimers( L, NULL, CancelTimer );
+	return 0;
+}
+
+static int
+pauseAll( lua_State *L )
+{
+	ApplyToTimers( L, NULL, PauseTimer );
+	return 0;
+}
+
+static int
+resumeAll( lua_State *L )
+{
+	ApplyToTimers( L, NULL, ResumeTimer );
+	return 0;
+}
+
+static int
+dispatchEvents( lua_State *L )
+{
+	TimerWheel& wheel = GetTimerWheel( L );
+
+	PushHandles( L );
+	int handlesIndex = lua_gettop( L );
+
+	TimerWheel::Expiration expiration;
+	while ( wheel.PopExpiration( expiration ) )
+	{
+		lua_rawgeti( L, handlesIndex, expiration.fId + 1 ); // handle
+		if ( expiration.fIsLast )
+		{
+			lua_pushnil( L );
+			lua_rawseti( L, handlesIndex, expiration.fId + 1 );
+		}
+
+		lua_createtable( L, 0, 4 ); // event
+		{
+			lua_pushliteral( L, "timer" );
+			lua_setfield( L, -2, "name" );
+			lua_pushvalue( L, -2 );
+			lua_setfield( L, -2, "source" );
+			lua_pushinteger( L, expiration.fCount );
+			lua_setfield( L, -2, "count" );
+			lua_pushnumber( L, (lua_Number)wheel.GetTime() );
+			lua_setfield( L, -2, "time" );
+		}
+
+		lua_getfield( L, -2, kListenerKey );
+		if ( lua_isfunction( L, -1 ) )
+		{
+			lua_pushvalue( L, -2 );
+			lua_call( L, 1, 0 ); // listener( event )
+		}
+		else if ( lua_istable( L, -1 ) )
+		{
+			lua_getfield( L, -1, "timer" );
+			if ( lua_isfunction( L, -1 ) )
+			{
+				lua_insert( L, -2 );
+				lua_pushvalue( L, -3 );
+				lua_call( L, 2, 0 ); // listener:timer( event )
+			}
+		}
+		lua_settop( L, handlesIndex );
+	}
+
+	return 0;
+}
+
+void
+LuaLibTimer::Initialize( lua_State *L )
+{
+	const luaL_Reg kVTable[] =
+	{
+		{ "performWithDelay", performWithDelay },
+		{ "cancel", cancel },
+		{ "pause", pause },
+		{ "resume", resume },
+		{ "cancelAll", cancelAll },
+		{ "pauseAll", pauseAll },
+		{ "resumeAll", resumeAll },
+
+		{ NULL, NULL }
+	};
+
+	luaL_register( L, "timer", kVTable );
+	lua_pop( L, 1 ); // pop "timer" table
+
+	lua_newtable( L );
+	lua_setfield( L, LUA_REGISTRYINDEX, kHandlesKey );
+}
+
+void
+LuaLibTimer::DispatchEvents( lua_State *L )
+{
+	lua_pushcfunction( L, dispatchEvents );
+	Lua::DoCall( L, 0, 0 );
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,43 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_LuaLibTimer_H__
+#define _Rtt_LuaLibTimer_H__
+
+// ----------------------------------------------------------------------------
+
+#include "Rtt_Lua.h"
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// The "timer" library, on top of the Runtime's TimerWheel
+class LuaLibTimer
+{
+	public:
+		typedef LuaLibTimer Self;
+
+	public:
+		static void Initialize( lua_State *L );
+
+	public:
+		// Calls the listeners of all due timers, from a single protected call.
+		// If one raises an error, the rest fire on the next frame.
+		static void DispatchEvents( lua_State *L );
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_LuaLibTimer_H__
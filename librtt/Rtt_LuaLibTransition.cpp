@@ -0,0 +1,640 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Rtt_LuaLibTransition.h"
+
+#include "Core/Rtt_SharedPtr.h"
+#include "Core/Rtt_Time.h"
+#include "Display/Rtt_Display.h"
+#include "Display/Rtt_ShaderData.h"
+#include "Display/Rtt_ShaderResource.h"
+#include "Display/Rtt_ShapeObject.h"
+#include "Display/Rtt_TweenPlayer.h"
+#include "Renderer/Rtt_Uniform.h"
+#include "Rtt_LuaContext.h"
+#include "Rtt_LuaProxy.h"
+#include "Rtt_LuaProxyVTable.h"
+#include "Rtt_Runtime.h"
+
+#include <string.h>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Registry table mapping tween ids (1-based) to their handles. A handle is
+// the table returned by transition.to(); it holds the target and listener,
+// which keeps the target's proxy alive while the tween runs.
+static const char kHandlesKey[] = __FILE__;
+
+static const char kIdKey[] = "_id";
+static const char kTargetKey[] = "_target";
+static const char kListenerKey[] = "_onComplete";
+
+static const lua_Number kMaxTime = 0x7FFFFFFF;
+
+struct PropertyName
+{
+	const char *fName;
+	TweenPlayer::Property fProperty;
+};
+
+static const PropertyName kObjectProperties[] =
+{
+	{ "x", TweenPlayer::kPropertyX },
+	{ "y", TweenPlayer::kPropertyY },
+	{ "rotation", TweenPlayer::kPropertyRotation },
+	{ "xScale", TweenPlayer::kPropertyXScale },
+	{ "yScale", TweenPlayer::kPropertyYScale },
+	{ "alpha", TweenPlayer::kPropertyAlpha },
+};
+
+static const PropertyName kFillProperties[] =
+{
+	{ "r", TweenPlayer::kPropertyFillR },
+	{ "g", TweenPlayer::kPropertyFillG },
+	{ "b", TweenPlayer::kPropertyFillB },
+	{ "a", TweenPlayer::kPropertyFillA },
+};
+
+// Indexed by TweenPlayer::Curve. Except for the first and last, names are
+// prefixed by the mode, e.g. "inOutQuad".
+static const char *kCurveNames[] =
+{
+	"linear",
+	"Sine",
+	"Quad",
+	"Cubic",
+	"Quart",
+	"Quint",
+	"Expo",
+	"Circ",
+	"Back",
+	"Elastic",
+	"Bounce",
+	"continuousLoop",
+};
+
+// Indexed by TweenPlayer::EaseMode
+static const char *kModeNames[] =
+{
+	"in",
+	"out",
+	"inOut",
+	"outIn",
+};
+
+static TweenPlayer&
+GetTweenPlayer( lua_State *L )
+{
+	return LuaContext::GetRuntime( L )->GetDisplay().GetTweenPlayer();
+}
+
+static U64
+GetTime( lua_State *L )
+{
+	return Rtt_AbsoluteToMilliseconds( LuaContext::GetRuntime( L )->GetElapsedTime() );
+}
+
+static void
+PushHandles( lua_State *L )
+{
+	lua_getfield( L, LUA_REGISTRYINDEX, kHandlesKey );
+}
+
+// ----------------------------------------------------------------------------
+
+static bool
+HasPrefix( TweenPlayer::Curve curve )
+{
+	return TweenPlayer::kLinear != curve && TweenPlayer::kContinuousLoop != curve;
+}
+
+// easing.<name>( t, tMax, start, delta )
+static int
+ease( lua_State *L )
+{
+	lua_Number t = luaL_checknumber( L, 1 );
+	lua_Number tMax = luaL_checknumber( L, 2 );
+	lua_Number start = luaL_optnumber( L, 3, 0. );
+	lua_Number delta = luaL_optnumber( L, 4, 1. );
+
+	TweenPlayer::Easing easing;
+	easing.fCurve = (U8)lua_tointeger( L, lua_upvalueindex( 1 ) );
+	easing.fMode = (U8)lua_tointeger( L, lua_upvalueindex( 2 ) );
+
+	float progress = tMax > 0. ? (float)Min( Max( t / tMax, 0. ), 1. ) : 1.f;
+	lua_pushnumber( L, start + delta * TweenPlayer::Ease( easing, progress ) );
+
+	return 1;
+}
+
+static bool
+EasingForName( const char *name, TweenPlayer::Easing& result )
+{
+	for ( int i = 0; i < TweenPlayer::kNumCurves; i++ )
+	{
+		TweenPlayer::Curve curve = (TweenPlayer::Curve)i;
+		int numModes = HasPrefix( curve ) ? TweenPlayer::kNumEaseModes : 1;
+
+		for ( int j = 0; j < numModes; j++ )
+		{
+			const char *suffix = name;
+			if ( HasPrefix( curve ) )
+			{
+				size_t prefixLength = strlen( kModeNames[j] );
+				suffix = 0 == strncmp( name, kModeNames[j], prefixLength ) ? name + prefixLength : NULL;
+			}
+
+			if ( suffix && 0 == strcmp( suffix, kCurveNames[i] ) )
+			{
+				result.fCurve = (U8)curve;
+				result.fMode = (U8)j;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+// Accepts a function of the "easing" module or its name. Other functions
+// can't be evaluated natively.
+static TweenPlayer::Easing
+ToEasing( lua_State *L, int index )
+{
+	TweenPlayer::Easing result = { TweenPlayer::kLinear, TweenPlayer::kEaseIn };
+
+	if ( lua_tocfunction( L, index ) == ease )
+	{
+		lua_getupvalue( L, index, 1 );
+		lua_getupvalue( L, index, 2 );
+		result.fCurve = (U8)lua_tointeger( L, -2 );
+		result.fMode = (U8)lua_tointeger( L, -1 );
+		lua_pop( L, 2 );
+	}
+	else if ( lua_type( L, index ) != LUA_TSTRING
+			  || ! EasingForName( lua_tostring( L, index ), result ) )
+	{
+		luaL_error( L, "transition: 'transition' must be a function of the easing library" );
+	}
+
+	return result;
+}
+
+// ----------------------------------------------------------------------------
+
+static bool
+IsShapeObject( const LuaProxy& proxy )
+{
+	const LuaProxyVTable& expected = LuaShapeObjectProxyVTable::Constant();
+
+	for ( const LuaProxyVTable *child = & proxy.Delegate(), *parent = & child->Parent();
+		  ;
+		  child = parent, parent = & child->Parent() )
+	{
+		if ( child == & expected ) { return true; }
+		if ( child == parent ) { break; }
+	}
+
+	return false;
+}
+
+static U32
+ToNumberField( lua_State *L, int index, const char *key, lua_Number defaultValue )
+{
+	lua_getfield( L, index, key );
+	lua_Number result = luaL_optnumber( L, -1, defaultValue );
+	lua_pop( L, 1 );
+
+	return (U32)Min( Max( result, (lua_Number)0. ), kMaxTime );
+}
+
+static void
+ReadProperties( lua_State *L, int index, const PropertyName *names, size_t numNames, TweenPlayer::Params& params )
+{
+	for ( size_t i = 0; i < numNames; i++ )
+	{
+		lua_getfield( L, index, names[i].fName );
+		if ( lua_isnumber( L, -1 ) )
+		{
+			params.fMask |= 1 << names[i].fProperty;
+			params.fValues[names[i].fProperty] = (float)lua_tonumber( L, -1 );
+		}
+		lua_pop( L, 1 );
+	}
+}
+
+// Reads the params of the table at 'index', keyed by the effect's names. On
+// failure, pushes an error message and returns false. (Raising the error here
+// would skip the destructor of 'resource'.)
+static bool
+ReadEffectProperties( lua_State *L, int index, ShapeObject& object, TweenPlayer::Params& params )
+{
+	ShaderData *data = GetTweenPlayer( L ).GetEffectData( object );
+	if ( ! data )
+	{
+		lua_pushliteral( L, "transition: the object's fill has no effect params" );
+		return false;
+	}
+
+	SharedPtr< ShaderResource > resource( data->GetShaderResource() );
+	if ( resource.IsNull() )
+	{
+		lua_pushliteral( L, "transition: the object's fill has no effect params" );
+		return false;
+	}
+
+	for ( lua_pushnil( L ); lua_next( L, index ); lua_pop( L, 1 ) )
+	{
+		const char *key = lua_type( L, -2 ) == LUA_TSTRING ? lua_tostring( L, -2 ) : NULL;
+		int dataIndex = key ? resource->GetDataIndex( key ) : -1;
+		if ( dataIndex < 0 || ! lua_isnumber( L, -1 ) )
+		{
+			lua_pushfstring( L, "transition: '%s' is not a numeric param of the object's effect", key ? key : "?" );
+			lua_replace( L, -3 );
+			lua_pop( L, 1 );
+			return false;
+		}
+
+		if ( resource->UsesUniforms() )
+		{
+			Uniform *uniform = data->GetUniform( (ShaderData::DataIndex)dataIndex );
+			if ( ! uniform )
+			{
+				ShaderResource::UniformData uniformData = resource->GetUniformData( key );
+				uniform = data->InitializeUniform(
+					LuaContext::GetAllocator( L ), (ShaderData::DataIndex)dataIndex, uniformData.dataType );
+			}
+
+			if ( Uniform::kScalar != uniform->GetDataType() )
+			{
+				lua_pushfstring( L, "transition: effect param '%s' is not a scalar", key );
+				lua_replace( L, -3 );
+				lua_pop( L, 1 );
+				return false;
+			}
+		}
+
+		TweenPlayer::Property property = (TweenPlayer::Property)( TweenPlayer::kPropertyEffect0 + dataIndex );
+		params.fMask |= 1 << property;
+		params.fValues[property] = (float)lua_tonumber( L, -1 );
+	}
+
+	return true;
+}
+
+// Adds a tween of the object at index 1 with the params at index 2
+static int
+AddTween( lua_State *L, const char *name, bool isFrom )
+{
+	LuaProxy *proxy = LuaProxy::GetProxy( L, 1 );
+	DisplayObject *object = proxy ? (DisplayObject *)proxy->Object() : NULL;
+	if ( ! object )
+	{
+		luaL_error( L, "transition.%s(): expected a display object, got %s", name, luaL_typename( L, 1 ) );
+	}
+	luaL_checktype( L, 2, LUA_TTABLE );
+
+	TweenPlayer::Params params;
+	params.fMask = 0;
+	for ( int i = 0; i < TweenPlayer::kNumProperties; i++ )
+	{
+		params.fValues[i] = 0.f;
+	}
+	params.fDuration = ToNumberField( L, 2, "time", 500. );
+	params.fDelay = ToNumberField( L, 2, "delay", 0. );
+	params.fIsFrom = isFrom;
+
+	lua_getfield( L, 2, "iterations" );
+	params.fIterations = (S32)luaL_optinteger( L, -1, 1 ); // 0 or -1 repeat forever
+	lua_pop( L, 1 );
+
+	lua_getfield( L, 2, "delta" );
+	params.fIsDelta = lua_toboolean( L, -1 );
+	lua_pop( L, 1 );
+
+	lua_getfield( L, 2, "transition" );
+	if ( lua_isnil( L, -1 ) )
+	{
+		params.fEasing.fCurve = TweenPlayer::kLinear;
+		params.fEasing.fMode = TweenPlayer::kEaseIn;
+	}
+	else
+	{
+		params.fEasing = ToEasing( L, -1 );
+	}
+	lua_pop( L, 1 );
+
+	ReadProperties( L, 2, kObjectProperties, sizeof( kObjectProperties ) / sizeof( kObjectProperties[0] ), params );
+
+	lua_getfield( L, 2, "fill" );
+	lua_getfield( L, 2, "effect" );
+	if ( ! lua_isnil( L, -2 ) || ! lua_isnil( L, -1 ) )
+	{
+		if ( ! IsShapeObject( * proxy ) )
+		{
+			luaL_error( L, "transition.%s(): only shape objects have a fill", name );
+		}
+
+		if ( lua_istable( L, -2 ) )
+		{
+			ReadProperties( L, lua_gettop( L ) - 1, kFillProperties, sizeof( kFillProperties ) / sizeof( kFillProperties[0] ), params );
+		}
+		if ( lua_istable( L, -1 )
+			 && ! ReadEffectProperties( L, lua_gettop( L ), * static_cast< ShapeObject * >( object ), params ) )
+		{
+			lua_error( L );
+		}
+	}
+	lua_pop( L, 2 );
+
+	lua_getfield( L, 2, "tag" );
+	const char *tag = lua_tostring( L, -1 );
+
+	S32 id = GetTweenPlayer( L ).Add( GetTime( L ), proxy, params, tag );
+	lua_pop( L, 1 );
+
+	lua_createtable( L, 0, 3 );
+	{
+		lua_pushinteger( L, id );
+		lua_setfield( L, -2, kIdKey );
+		lua_pushvalue( L, 1 );
+		lua_setfield( L, -2, kTargetKey );
+		lua_getfield( L, 2, "onComplete" );
+		lua_setfield( L, -2, kListenerKey );
+	}
+
+	PushHandles( L );
+	lua_pushvalue( L, -2 );
+	lua_rawseti( L, -2, id + 1 );
+	lua_pop( L, 1 );
+
+	return 1;
+}
+
+// ----------------------------------------------------------------------------
+
+// Returns the id of the handle at 'index', or kInvalidId if the tween has
+// finished or was cancelled
+static S32
+ToId( lua_State *L, int index )
+{
+	S32 result = TweenPlayer::kInvalidId;
+
+	lua_pushstring( L, kIdKey );
+	lua_rawget( L, index );
+	if ( lua_isnumber( L, -1 ) )
+	{
+		S32 id = (S32)lua_tointeger( L, -1 );
+
+		PushHandles( L );
+		lua_rawgeti( L, -1, id + 1 );
+		if ( lua_rawequal( L, -1, index ) )
+		{
+			result = id;
+		}
+		lua_pop( L, 2 );
+	}
+	lua_pop( L, 1 );
+
+	return result;
+}
+
+typedef void (*TweenAction)( lua_State *L, S32 id );
+
+static void
+CancelTween( lua_State *L, S32 id )
+{
+	GetTweenPlayer( L ).Remove( id );
+
+	PushHandles( L );
+	lua_pushnil( L );
+	lua_rawseti( L, -2, id + 1 );
+	lua_pop( L, 1 );
+}
+
+static void
+PauseTween( lua_State *L, S32 id )
+{
+	GetTweenPlayer( L ).Pause( id, GetTime( L ) );
+}
+
+static void
+ResumeTween( lua_State *L, S32 id )
+{
+	GetTweenPlayer( L ).Resume( id, GetTime( L ) );
+}
+
+// Applies 'action' to the tween handle, tag or display object at index 1,
+// or to all tweens if there's no argument
+static int
+ApplyToArgument( lua_State *L, const char *name, TweenAction action )
+{
+	std::vector< S32 > ids;
+
+	if ( lua_isnoneornil( L, 1 ) )
+	{
+		GetTweenPlayer( L ).GetTweens( NULL, NULL, ids );
+	}
+	else if ( lua_type( L, 1 ) == LUA_TSTRING )
+	{
+		GetTweenPlayer( L ).GetTweens( NULL, lua_tostring( L, 1 ), ids );
+	}
+	else if ( lua_istable( L, 1 ) )
+	{
+		// Handles are plain tables. Anything else must be a display object,
+		// as LuaProxy::GetProxy() rejects other tables.
+		lua_pushstring( L, kIdKey );
+		lua_rawget( L, 1 );
+		bool isHandle = ! lua_isnil( L, -1 );
+		lua_pop( L, 1 );
+
+		if ( isHandle )
+		{
+			S32 id = ToId( L, 1 );
+			if ( TweenPlayer::kInvalidId != id )
+			{
+				ids.push_back( id );
+			}
+		}
+		else
+		{
+			LuaProxy *proxy = LuaProxy::GetProxy( L, 1 );
+			if ( proxy )
+			{
+				GetTweenPlayer( L ).GetTweens( proxy, NULL, ids );
+			}
+		}
+	}
+	else
+	{
+		luaL_error( L, "transition.%s(): expected a transition handle, tag or display object, got %s", name, luaL_typename( L, 1 ) );
+	}
+
+	for ( size_t i = 0, iMax = ids.size(); i < iMax; i++ )
+	{
+		action( L, ids[i] );
+	}
+
+	return 0;
+}
+
+// transition.to( target, params )
+static int
+to( lua_State *L )
+{
+	return AddTween( L, "to", false );
+}
+
+// transition.from( target, params )
+static int
+from( lua_State *L )
+{
+	return AddTween( L, "from", true );
+}
+
+// transition.cancel( [handleTagOrObject] )
+static int
+cancel( lua_State *L )
+{
+	return ApplyToArgument( L, "cancel", CancelTween );
+}
+
+// transition.pause( [handleTagOrObject] )
+static int
+pause( lua_State *L )
+{
+	return ApplyToArgument( L, "pause", PauseTween );
+}
+
+// transition.resume( [handleTagOrObject] )
+static int
+resume( lua_State *L )
+{
+	return ApplyToArgument( L, "resume", ResumeTween );
+}
+
+static int
+dispatchEvents( lua_State *L )
+{
+	TweenPlayer& player = GetTweenPlayer( L );
+
+	PushHandles( L );
+	int handlesIndex = lua_gettop( L );
+
+	TweenPlayer::Completion completion;
+	while ( player.PopCompletion( completion ) )
+	{
+		lua_rawgeti( L, handlesIndex, completion.fId + 1 ); // handle
+		lua_pushnil( L );
+		lua_rawseti( L, handlesIndex, completion.fId + 1 );
+
+		// Cancelled since it finished, or its target was destroyed
+		if ( ! completion.fIsFinished || ! lua_istable( L, -1 ) )
+		{
+			lua_settop( L, handlesIndex );
+			continue;
+		}
+
+		lua_getfield( L, -1, kListenerKey );
+		if ( lua_isfunction( L, -1 ) )
+		{
+			lua_getfield( L, -2, kTargetKey );
+			lua_call( L, 1, 0 ); // onComplete( target )
+		}
+		else if ( lua_istable( L, -1 ) )
+		{
+			lua_getfield( L, -1, "onComplete" );
+			if ( lua_isfunction( L, -1 ) )
+			{
+				lua_insert( L, -2 );
+				lua_getfield( L, -3, kTargetKey );
+				lua_call( L, 2, 0 ); // listener:onComplete( target )
+			}
+		}
+		lua_settop( L, handlesIndex );
+	}
+
+	return 0;
+}
+
+void
+LuaLibTransition::Initialize( lua_State *L )
+{
+	const luaL_Reg kVTable[] =
+	{
+		{ "to", to },
+		{ "from", from },
+		{ "cancel", cancel },
+		{ "pause", pause },
+		{ "resume", resume },
+
+		{ NULL, NULL }
+	};
+
+	luaL_register( L, "transition", kVTable );
+	lua_pop( L, 1 ); // pop "transition" table
+
+	lua_newtable( L );
+	lua_setfield( L, LUA_REGISTRYINDEX, kHandlesKey );
+}
+
+int
+LuaLibTransition::OpenEasing( lua_State *L )
+{
+	lua_newtable( L );
+
+	for ( int i = 0; i < TweenPlayer::kNumCurves; i++ )
+	{
+		TweenPlayer::Curve curve = (TweenPlayer::Curve)i;
+		int numModes = HasPrefix( curve ) ? TweenPlayer::kNumEaseModes : 1;
+
+		for ( int j = 0; j < numModes; j++ )
+		{
+			lua_pushinteger( L, curve );
+			lua_pushinteger( L, j );
+			lua_pushcclosure( L, ease, 2 );
+
+			if ( HasPrefix( curve ) )
+			{
+				lua_pushstring( L, kModeNames[j] );
+				lua_pushstring( L, kCurveNames[i] );
+				lua_concat( L, 2 );
+				lua_insert( L, -2 );
+				lua_rawset( L, -3 );
+			}
+			else
+			{
+				lua_setfield( L, -2, kCurveNames[i] );
+			}
+		}
+	}
+
+	return 1;
+}
+
+void
+LuaLibTransition::DispatchEvents( lua_State *L )
+{
+	lua_pushcfunction( L, dispatchEvents );
+	Lua::DoCall( L, 0, 0 );
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,46 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_LuaLibTransition_H__
+#define _Rtt_LuaLibTransition_H__
+
+// ----------------------------------------------------------------------------
+
+#include "Rtt_Lua.h"
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// The "transition" library, on top of the Display's TweenPlayer, and the
+// "easing" module, whose functions select the curve of a transition
+class LuaLibTransition
+{
+	public:
+		typedef LuaLibTransition Self;
+
+	public:
+		static void Initialize( lua_State *L );
+		static int OpenEasing( lua_State *L );
+
+	public:
+		// Calls the onComplete listeners of all finished transitions, from a
+		// single protected call. If one raises an error, the rest are called
+		// on the next frame.
+		static void DispatchEvents( lua_State *L );
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_LuaLibTransition_H__
@@ -12,6 +12,7 @@
 #include "Rtt_LuaProxy.h"
 #include "Rtt_LuaProxyVTable.h"
 #include "Rtt_LuaAux.h"
+#include "Rtt_LuaContext.h"
 #include "Rtt_MLuaProxyable.h"
 
 #include <string.h>
@@ -419,13 +420,26 @@ LuaProxy::__proxyindex( lua_State *L )
 
 		const LuaProxyVTable& delegate = proxy->Delegate();
 		const LuaProxyVTable* pDelegate = & delegate;
+		S32 keyIndex = LuaProxyVTable::kNoKeyIndex;
 
 		#ifdef Rtt_TRACE_LUAPROXYDELEGATE
 			const LuaProxyVTableTracer tracer( delegate, proxy );
 			pDelegate = & tracer;
+		#else
+			if ( key )
+			{
+				keyIndex = LuaContext::GetContext( L )->GetProxyKeyCache().IndexForKey( L, 2, delegate );
+			}
 		#endif
 
-		result = pDelegate->ValueForKey( L, * object, key ); // Search for key in C++ delegate
+		if ( keyIndex >= 0 )
+		{
+			result = delegate.ValueForKeyIndex( L, * object, keyIndex );
+		}
+		else
+		{
+			result = pDelegate->ValueForKey( L, * object, key ); // Search for key in C++ delegate
+		}
 
 		if ( ! result )
 		{
@@ -516,6 +530,20 @@ LuaProxy::__proxynewindex( lua_State *L )
 	}
 	else
 	{
+		#ifndef Rtt_TRACE_LUAPROXYDELEGATE
+			// Check the type first, as lua_tostring() below converts numbers in place
+			if ( LUA_TSTRING == lua_type( L, 2 ) )
+			{
+				const LuaProxyVTable& delegate = proxy->Delegate();
+				S32 keyIndex = LuaContext::GetContext( L )->GetProxyKeyCache().IndexForKey( L, 2, delegate );
+				if ( keyIndex >= 0 )
+				{
+					delegate.SetValueForKeyIndex( L, * object, keyIndex, 3 );
+					return 0;
+				}
+			}
+		#endif
+
 		const char* key = lua_tostring( L, 2 );
 
 		Rtt_LUA_ASSERT( L, key, "__proxynewindex was passed a NULL key" );
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Rtt_LuaProxyKeyCache.h"
+
+#include "Rtt_Lua.h"
+#include "Rtt_LuaProxyVTable.h"
+
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+LuaProxyKeyCache::LuaProxyKeyCache()
+:	fKeysRef( LUA_NOREF ),
+	fNumKeys( 0 )
+{
+	memset( fEntries, 0, sizeof( fEntries ) );
+}
+
+S32
+LuaProxyKeyCache::IndexForKey( lua_State *L, int keyIndex, const LuaProxyVTable& delegate )
+{
+	Rtt_ASSERT( keyIndex > 0 );
+	Rtt_ASSERT( LUA_TSTRING == lua_type( L, keyIndex ) );
+
+	const char *key = lua_tostring( L, keyIndex );
+
+	size_t hash = ( (size_t)key >> 3 ) ^ ( (size_t)& delegate >> 4 );
+	Entry& entry = fEntries[hash & ( kNumEntries - 1 )];
+
+	if ( entry.fKey == key && entry.fDelegate == & delegate )
+	{
+		return entry.fIndex;
+	}
+
+	S32 result = delegate.IndexForKey( L, key );
+
+	// Entries are overwritten on collision. Their keys stay retained.
+	if ( Retain( L, keyIndex ) )
+	{
+		entry.fKey = key;
+		entry.fDelegate = & delegate;
+		entry.fIndex = result;
+	}
+
+	return result;
+}
+
+// Returns true if the key at 'keyIndex' is (now) in the table of retained keys
+bool
+LuaProxyKeyCache::Retain( lua_State *L, int keyIndex )
+{
+	if ( LUA_NOREF == fKeysRef )
+	{
+		lua_newtable( L );
+		fKeysRef = luaL_ref( L, LUA_REGISTRYINDEX );
+	}
+
+	lua_rawgeti( L, LUA_REGISTRYINDEX, fKeysRef );
+
+	lua_pushvalue( L, keyIndex );
+	lua_rawget( L, -2 );
+	bool result = ! lua_isnil( L, -1 );
+	lua_pop( L, 1 );
+
+	if ( ! result && fNumKeys < kMaxKeys )
+	{
+		lua_pushvalue( L, keyIndex );
+		lua_pushboolean( L, 1 );
+		lua_rawset( L, -3 ); // keys[key] = true
+		++fNumKeys;
+
+		result = true;
+	}
+
+	lua_pop( L, 1 );
+
+	return result;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
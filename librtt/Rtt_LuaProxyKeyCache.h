@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_LuaProxyKeyCache_H__
+#define _Rtt_LuaProxyKeyCache_H__
+
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Types.h"
+
+// ----------------------------------------------------------------------------
+
+struct lua_State;
+
+namespace Rtt
+{
+
+class LuaProxyVTable;
+
+// ----------------------------------------------------------------------------
+
+// Maps the property keys of LuaProxy accesses to the key indices of their
+// delegates (see LuaProxyVTable::IndexForKey). Lua strings are interned, so
+// the address of a key's characters identifies it, and a cached key costs a
+// pointer compare instead of hashing it at every level of the delegate chain.
+//
+// Cached keys are kept alive by a table in the registry, so their address
+// cannot be reused by another string. Once kMaxKeys keys are kept, new keys
+// are resolved by their delegate on every access.
+//
+// There is one cache per Lua state (see LuaContext::GetProxyKeyCache).
+class LuaProxyKeyCache
+{
+	Rtt_CLASS_NO_COPIES( LuaProxyKeyCache )
+
+	public:
+		typedef LuaProxyKeyCache Self;
+
+	public:
+		LuaProxyKeyCache();
+
+	public:
+		// Returns the key index of the string at 'keyIndex' in 'delegate', or
+		// LuaProxyVTable::kNoKeyIndex. The value at 'keyIndex' must be a string
+		// and 'keyIndex' must be an absolute stack index.
+		S32 IndexForKey( lua_State *L, int keyIndex, const LuaProxyVTable& delegate );
+
+	private:
+		bool Retain( lua_State *L, int keyIndex );
+
+	private:
+		enum
+		{
+			kNumEntries = 64, // Power of 2
+			kMaxKeys = 256,
+		};
+
+		struct Entry
+		{
+			const char *fKey;
+			const LuaProxyVTable *fDelegate;
+			S32 fIndex;
+		};
+
+		Entry fEntries[kNumEntries];
+		int fKeysRef; // Registry ref of the table of retained keys
+		S32 fNumKeys;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_LuaProxyKeyCache_H__
@@ -60,6 +60,26 @@ LuaProxyVTable::Parent() const
 	return * this;
 }
 
+S32
+LuaProxyVTable::IndexForKey( lua_State *, const char [] ) const
+{
+	return kNoKeyIndex;
+}
+
+int
+LuaProxyVTable::ValueForKeyIndex( lua_State *, const MLuaProxyable&, S32 ) const
+{
+	Rtt_ASSERT_NOT_REACHED();
+	return 0;
+}
+
+bool
+LuaProxyVTable::SetValueForKeyIndex( lua_State *, MLuaProxyable&, S32, int ) const
+{
+	Rtt_ASSERT_NOT_REACHED();
+	return false;
+}
+
 // ----------------------------------------------------------------------------
 
 #if defined( Rtt_DEBUG ) || defined( Rtt_AUTHORING_SIMULATOR )
@@ -770,6 +790,43 @@ LuaDisplayObjectProxyVTable::ValueForKey( lua_State *L, const MLuaProxyable& obj
 	return result;
 }
 
+static U8
+AlphaForValue( lua_State *L, int valueIndex )
+{
+	/* too verbose:
+	Rtt_WARN_SIM(
+		lua_tonumber( L, valueIndex ) >= 0. && lua_tonumber( L, valueIndex ) <= 1.0,
+		( "WARNING: Attempt to set object.alpha to %g which is outside valid range. It will be clamped to the range [0,1]\n", lua_tonumber( L, valueIndex ) ) );
+	 */
+
+	// Explicitly declare T b/c of crappy gcc compiler used by Symbian
+	lua_Integer alpha = (lua_Integer)(lua_tonumber( L, valueIndex ) * 255.0f);
+	lua_Integer value = Min( (lua_Integer)255, alpha );
+	return Max( (lua_Integer)0, value );
+}
+
+// Records where the property was set, for the "_lastChange" property
+// (this is a noop on non-debug builds because lua_where returns an empty string)
+void
+LuaDisplayObjectProxyVTable::RecordLastChange( lua_State *L, DisplayObject& o )
+{
+	luaL_where(L, 1);
+	const char *where = lua_tostring( L, -1 );
+
+	if (where[0] != 0)
+	{
+		if (o.fWhereChanged != NULL)
+		{
+			free((void *) o.fWhereChanged);
+		}
+
+		// If this fails, the pointer will be NULL and that's handled gracefully
+		o.fWhereChanged = strdup(where);
+	}
+
+	lua_pop(L, 1);
+}
+
 bool
 LuaDisplayObjectProxyVTable::SetValueForKey( lua_State *L, MLuaProxyable& object, const char key[], int valueIndex ) const
 {
@@ -819,18 +876,7 @@ LuaDisplayObjectProxyVTable::SetValueForKey( lua_State *L, MLuaProxyable& object
 		break;
 	case 2:
 		{
-            /* too verbose:
-			Rtt_WARN_SIM(
-				lua_tonumber( L, valueIndex ) >= 0. && lua_tonumber( L, valueIndex ) <= 1.0,
-				( "WARNING: Attempt to set object.alpha to %g which is outside valid range. It will be clamped to the range [0,1]\n", lua_tonumber( L, valueIndex ) ) );
-             */
-
-			// Explicitly declare T b/c of crappy gcc compiler used by Symbian
-			lua_Integer alpha = (lua_Integer)(lua_tonumber( L, valueIndex ) * 255.0f);
-			lua_Integer value = Min( (lua_Integer)255, alpha );
-			U8 newValue = Max( (lua_Integer)0, value );
-
-			o.SetAlpha( newValue );
+			o.SetAlpha( AlphaForValue( L, valueIndex ) );
 		}
 		break;
 	case 3:
@@ -946,27 +992,113 @@ LuaDisplayObjectProxyVTable::SetValueForKey( lua_State *L, MLuaProxyable& object
 	}
 
     // We changed a property so record where we are so that "_lastChange" will be available later to say where it happened
-    // (this is a noop on non-debug builds because lua_where returns an empty string)
     if (result)
     {
-        luaL_where(L, 1);
-        const char *where = lua_tostring( L, -1 );
+        RecordLastChange( L, o );
+    }
 
-        if (where[0] != 0)
-        {
-            if (o.fWhereChanged != NULL)
-            {
-                free((void *) o.fWhereChanged);
-            }
+    return result;
+}
 
-            // If this fails, the pointer will be NULL and that's handled gracefully
-            o.fWhereChanged = strdup(where);
-        }
+// Indices of the keys in LuaDisplayObjectProxyVTable::IndexForKey(). The
+// geometric ones match GeometricProperty.
+enum
+{
+	kKeyIndexX = 0,
+	kKeyIndexY,
+	kKeyIndexXScale,
+	kKeyIndexYScale,
+	kKeyIndexRotation,
+	kKeyIndexWidth,
+	kKeyIndexHeight,
+	kKeyIndexAlpha,
+	kKeyIndexIsVisible,
+};
+
+S32
+LuaDisplayObjectProxyVTable::IndexForKey( lua_State *L, const char key[] ) const
+{
+	// Only the most frequently accessed properties. None of them is handled
+	// by a derived vtable.
+	static const char * keys[] =
+	{
+		"x",					// 0
+		"y",					// 1
+		"xScale",				// 2
+		"yScale",				// 3
+		"rotation",				// 4
+		"width",				// 5
+		"height",				// 6
+		"alpha",				// 7
+		"isVisible",			// 8
+	};
+    const int numKeys = sizeof( keys ) / sizeof( const char * );
+	static StringHash sHash( *LuaContext::GetAllocator( L ), keys, numKeys, 9, 22, 6, __FILE__, __LINE__ );
+	StringHash *hash = &sHash;
 
-        lua_pop(L, 1);
-    }
+	Rtt_STATIC_ASSERT( kKeyIndexX == (S32)kOriginX );
+	Rtt_STATIC_ASSERT( kKeyIndexHeight == (S32)kHeight );
 
-    return result;
+	return hash->Lookup( key );
+}
+
+int
+LuaDisplayObjectProxyVTable::ValueForKeyIndex( lua_State *L, const MLuaProxyable& object, S32 index ) const
+{
+	const DisplayObject& o = static_cast< const DisplayObject& >( object );
+
+	switch ( index )
+	{
+	case kKeyIndexAlpha:
+		{
+			lua_Number alpha = (float)o.Alpha() / 255.0;
+			lua_pushnumber( L, alpha );
+		}
+		break;
+	case kKeyIndexIsVisible:
+		{
+			lua_pushboolean( L, o.IsVisible() );
+		}
+		break;
+	default:
+		{
+			Rtt_ASSERT( index >= kKeyIndexX && index <= kKeyIndexHeight );
+			lua_pushnumber( L, Rtt_RealToFloat( o.GetGeometricProperty( (GeometricProperty)index ) ) );
+		}
+		break;
+	}
+
+	return 1;
+}
+
+bool
+LuaDisplayObjectProxyVTable::SetValueForKeyIndex( lua_State *L, MLuaProxyable& object, S32 index, int valueIndex ) const
+{
+	DisplayObject& o = static_cast< DisplayObject& >( object );
+
+	switch ( index )
+	{
+	case kKeyIndexAlpha:
+		{
+			o.SetAlpha( AlphaForValue( L, valueIndex ) );
+		}
+		break;
+	case kKeyIndexIsVisible:
+		{
+			o.SetVisible( lua_toboolean( L, valueIndex ) != 0 );
+		}
+		break;
+	default:
+		{
+			Rtt_ASSERT( index >= kKeyIndexX && index <= kKeyIndexHeight );
+			o.SetGeometricProperty( (GeometricProperty)index, luaL_toreal( L, valueIndex ) );
+		}
+		break;
+	}
+
+	RecordLastChange( L, o );
+
+	return true;
 }
 
 // ----------------------------------------------------------------------------
@@ -49,6 +49,8 @@ class LuaProxyVTable
 	public:
 		typedef LuaProxyVTable Self;
 
+		static const S32 kNoKeyIndex = -1;
+
 	public:
 		#if defined( Rtt_DEBUG ) || defined( Rtt_AUTHORING_SIMULATOR )
 		// Proxy's delegate or an ancestor must match expected
@@ -67,6 +69,14 @@ class LuaProxyVTable
 //		virtual int Length( lua_State *L ) const;
 		virtual const LuaProxyVTable& Parent() const;
 
+		// Keys that resolve to the same property for every object of this
+		// vtable can be mapped to an index once (see LuaProxyKeyCache) and
+		// then accessed through the *ForKeyIndex() methods. A vtable must not
+		// index keys that a derived vtable handles itself.
+		virtual S32 IndexForKey( lua_State *L, const char key[] ) const;
+		virtual int ValueForKeyIndex( lua_State *L, const MLuaProxyable& object, S32 index ) const;
+		virtual bool SetValueForKeyIndex( lua_State *L, MLuaProxyable& object, S32 index, int valueIndex ) const;
+
     bool DumpObjectProperties( lua_State *L, const MLuaProxyable& object, const char **keys, const int numKeys, String& result ) const;
 };
 
@@ -86,12 +96,20 @@ class LuaDisplayObjectProxyVTable : public LuaProxyVTable
 		static int scale( lua_State *L );
 		static int rotate( lua_State *L );
 
+	public:
+		// Also used by display.setProperties()
+		static void RecordLastChange( lua_State *L, DisplayObject& o );
+
 	protected:
 		LuaDisplayObjectProxyVTable() {}
 
 	public:
 		virtual int ValueForKey( lua_State *L, const MLuaProxyable& object, const char key[] ) const;
 		virtual bool SetValueForKey( lua_State *L, MLuaProxyable& object, const char key[], int valueIndex ) const;
+
+		virtual S32 IndexForKey( lua_State *L, const char key[] ) const;
+		virtual int ValueForKeyIndex( lua_State *L, const MLuaProxyable& object, S32 index ) const;
+		virtual bool SetValueForKeyIndex( lua_State *L, MLuaProxyable& object, S32 index, int valueIndex ) const;
 		
 		// Removes child at index from parent and pushes onto the stack. Pushes nil
 		// if index is invalid. If isOrphan is false, converts object into plain Lua table,
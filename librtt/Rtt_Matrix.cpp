@@ -14,6 +14,16 @@
 
 #include "Renderer/Rtt_Geometry_Renderer.h"
 
+#if ! defined( Rtt_REAL_FIXED )
+	#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+		#define Rtt_MATRIX_SSE2
+		#include <emmintrin.h>
+	#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+		#define Rtt_MATRIX_NEON
+		#include <arm_neon.h>
+	#endif
+#endif
+
 // ----------------------------------------------------------------------------
 
 namespace Rtt
@@ -233,6 +243,95 @@ Matrix::Apply( Geometry& geometry ) const
 	}
 }
 
+// Position and texture writes are fused into a single pass over 'dst' so each
+// (44-byte) interleaved vertex is only touched once. Positions are transformed
+// two at a time; Vertex2 arrays are tightly packed, so a pair fills one vector.
+void
+Matrix::Apply( Geometry& geometry, const Vertex2 src[], const Vertex2 *texSrc, U32 numVertices ) const
+{
+	Rtt_ASSERT( numVertices <= geometry.GetVerticesAllocated() );
+
+	Geometry::Vertex *Rtt_RESTRICT dst = geometry.GetVertexData();
+
+	Real row0[3];
+	Real row1[3];
+	if ( IsIdentity() )
+	{
+		Private::MatrixInitIdentityValues( row0, row1 );
+	}
+	else
+	{
+		row0[0] = fRow0[0]; row0[1] = fRow0[1]; row0[2] = fRow0[2];
+		row1[0] = fRow1[0]; row1[1] = fRow1[1]; row1[2] = fRow1[2];
+	}
+
+	U32 i = 0;
+
+#if defined( Rtt_MATRIX_SSE2 ) || defined( Rtt_MATRIX_NEON )
+	// For v = [ x0 y0 x1 y1 ] and its pairwise swap s = [ y0 x0 y1 x1 ]:
+	// v * [ a d a d ] + s * [ b c b c ] + [ tx ty tx ty ]
+	const float kDiagonal[4] = { row0[0], row1[1], row0[0], row1[1] };
+	const float kCross[4] = { row0[1], row1[0], row0[1], row1[0] };
+	const float kTranslation[4] = { row0[2], row1[2], row0[2], row1[2] };
+
+	#if defined( Rtt_MATRIX_SSE2 )
+		const __m128 diagonal = _mm_loadu_ps( kDiagonal );
+		const __m128 cross = _mm_loadu_ps( kCross );
+		const __m128 translation = _mm_loadu_ps( kTranslation );
+	#else
+		const float32x4_t diagonal = vld1q_f32( kDiagonal );
+		const float32x4_t cross = vld1q_f32( kCross );
+		const float32x4_t translation = vld1q_f32( kTranslation );
+	#endif
+
+	for ( ; i + 2 <= numVertices; i += 2 )
+	{
+	#if defined( Rtt_MATRIX_SSE2 )
+		__m128 v = _mm_loadu_ps( & src[i].x );
+		__m128 s = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+		__m128 r = _mm_add_ps( _mm_add_ps( _mm_mul_ps( v, diagonal ), _mm_mul_ps( s, cross ) ), translation );
+		_mm_storel_pi( (__m64 *)& dst[i].x, r );
+		_mm_storeh_pi( (__m64 *)& dst[i + 1].x, r );
+	#else
+		float32x4_t v = vld1q_f32( & src[i].x );
+		float32x4_t s = vrev64q_f32( v );
+		float32x4_t r = vmlaq_f32( vmlaq_f32( translation, v, diagonal ), s, cross );
+		vst1_f32( & dst[i].x, vget_low_f32( r ) );
+		vst1_f32( & dst[i + 1].x, vget_high_f32( r ) );
+	#endif
+
+		dst[i].z = Rtt_REAL_0;
+		dst[i + 1].z = Rtt_REAL_0;
+
+		if ( texSrc )
+		{
+			dst[i].u = texSrc[i].x;
+			dst[i].v = texSrc[i].y;
+			dst[i].q = Rtt_REAL_1;
+			dst[i + 1].u = texSrc[i + 1].x;
+			dst[i + 1].v = texSrc[i + 1].y;
+			dst[i + 1].q = Rtt_REAL_1;
+		}
+	}
+#endif
+
+	// Scalar fallback and tail
+	for ( ; i < numVertices; i++ )
+	{
+		Geometry::Vertex& d = dst[i];
+		d.x = Private::MatrixRowDotVertex2( row0, src[i] );
+		d.y = Private::MatrixRowDotVertex2( row1, src[i] );
+		d.z = Rtt_REAL_0;
+
+		if ( texSrc )
+		{
+			d.u = texSrc[i].x;
+			d.v = texSrc[i].y;
+			d.q = Rtt_REAL_1;
+		}
+	}
+}
+
 void
 Matrix::ApplyTranslation( Vertex2& v ) const
 {
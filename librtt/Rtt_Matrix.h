@@ -43,6 +43,12 @@ class Matrix
 		void Apply( Vertex2& v ) const;
 		void Apply( Vertex2 vertices[], S32 numVertices ) const;
 		void Apply( Geometry& geometry ) const;
+
+		// Writes transformed 'src' positions (z = 0) into the first 'numVertices'
+		// vertices of 'geometry'. When 'texSrc' is non-NULL, u/v are copied from
+		// it (q = 1) in the same pass.
+		void Apply( Geometry& geometry, const Vertex2 src[], const Vertex2 *texSrc, U32 numVertices ) const;
+
 		void ApplyTranslation( Vertex2& v ) const;
 		void ApplyScale( Real& value ) const;
 
@@ -37,6 +37,17 @@ PlatformSurface::~PlatformSurface()
 {
 }
 
+void
+PlatformSurface::ReleaseCurrent() const
+{
+}
+
+bool
+PlatformSurface::SupportsRenderThread() const
+{
+	return false;
+}
+
 // ----------------------------------------------------------------------------
 
 // TODO: Replace platform ifdef's with a feature ifdef: Rtt_OFFSCREEN_SURFACE in Rtt_Config.h
@@ -29,6 +29,14 @@ class PlatformSurface
 		virtual void SetCurrent() const = 0;
 		virtual void Flush() const = 0;
 
+		// Detaches the context from the calling thread, so that another one
+		// can make it current. Does nothing by default.
+		virtual void ReleaseCurrent() const;
+
+		// True if the context can be made current on a thread other than the
+		// one that created it (see RenderThread). False by default.
+		virtual bool SupportsRenderThread() const;
+
 	public:
 		// Size in pixels of underlying surface
 		virtual S32 Width() const = 0;
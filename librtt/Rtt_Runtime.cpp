@@ -30,6 +30,8 @@
 #include "Rtt_PlatformExitCallback.h"
 #include "Rtt_PlatformTimer.h"
 #include "Rtt_Scheduler.h"
+#include "Rtt_LuaLibTimer.h"
+#include "Rtt_TimerWheel.h"
 #include "Rtt_LuaFrameworks.h"
 #include "Rtt_HTTPClient.h"
 
@@ -153,6 +155,7 @@ Runtime::Runtime( const MPlatform& platform, MCallback *viewCallback )
 	fVMContext( LuaContext::New( Allocator(), platform, this ) ), 
 	fTimer( platform.CreateTimerWithCallback( viewCallback ? * viewCallback : * this ) ),
 	fScheduler( Rtt_NEW( & fAllocator, Scheduler( * this ) ) ),
+	fTimerWheel( Rtt_NEW( & fAllocator, TimerWheel ) ),
 	fArchive( NULL ),
 #ifdef Rtt_USE_ALMIXER
 	fOpenALPlayer(NULL),
@@ -223,6 +226,7 @@ Runtime::~Runtime()
 	fDisplay->Teardown();
 
 	LuaContext::Delete( fVMContext );
+	Rtt_DELETE( fTimerWheel );
 
 	// Marking the Lua context as NULL invalidates the resource cache.
 	// We do this before we delete the display list to prevent resources in the
@@ -1395,6 +1399,13 @@ Runtime::operator()()
 			FinalizeWorkingThreadWithEvent(this, fVMContext->L());
 		}
 #endif
+		// Timers fire before enterFrame, all from one Lua call
+		fTimerWheel->Advance( (U64)GetElapsedMS() );
+		if ( fTimerWheel->HasExpirations() )
+		{
+			LuaLibTimer::DispatchEvents( fVMContext->L() );
+		}
+
 		fDisplay->Update();
 
 		++fFrame;
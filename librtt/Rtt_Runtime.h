@@ -45,6 +45,7 @@ class PlatformExitCallback;
 class PlatformSurface;
 class PlatformTimer;
 class Scheduler;
+class TimerWheel;
 
 // ----------------------------------------------------------------------------
 
@@ -133,6 +134,7 @@ class Runtime : public MCallback,
 		Rtt_INLINE Display& GetDisplay() { return * fDisplay; }
 		Rtt_INLINE const Display& GetDisplay() const { return * fDisplay; }
 		Rtt_INLINE Scheduler& GetScheduler() const { return * fScheduler; }
+		Rtt_INLINE TimerWheel& GetTimerWheel() const { return * fTimerWheel; }
 		Rtt_INLINE const MPlatform& Platform() const { return fPlatform; }
 
 		Rtt_INLINE bool IsVMContextValid() const { return NULL != fVMContext; }
@@ -279,6 +281,7 @@ class Runtime : public MCallback,
 		LuaContext* fVMContext;
 		PlatformTimer* fTimer;
 		Scheduler* fScheduler;
+		TimerWheel* fTimerWheel;
 		Archive* fArchive;
 	
 #ifdef Rtt_USE_ALMIXER
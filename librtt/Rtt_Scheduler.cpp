@@ -12,6 +12,15 @@
 #include "Rtt_Scheduler.h"
 #include "Rtt_Runtime.h"
 
+#include "Core/Rtt_Time.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 
 namespace Rtt
@@ -27,15 +36,259 @@ template class Rtt::Array<Rtt::Task *>;
 	
 // ----------------------------------------------------------------------------
 
+// Fixed set of worker threads running the background phase of AsyncTasks.
+// 
+// Each worker owns a queue. Submissions are dealt round-robin; a worker pops
+// from the front of its own queue and, when that runs dry, steals from the
+// back of the others'. Finished tasks are pushed onto a lock-free MPSC stack
+// which the main thread detaches in one exchange and reverses into FIFO order.
+class TaskPool
+{
+	Rtt_CLASS_NO_COPIES( TaskPool )
+
+	public:
+		TaskPool( Rtt_Allocator* allocator );
+		~TaskPool();
+
+	public:
+		// Worker count, clamped so we don't starve the main/GL threads
+		static U32 DefaultWorkerCount();
+
+	public:
+		// Producer side: main thread only
+		void Submit( AsyncTask* task );
+
+		// Consumer side: main thread only. Returns NULL if nothing is ready.
+		AsyncTask* NextCompletion();
+
+	protected:
+		void WorkerMain( U32 index );
+		AsyncTask* Pop( U32 index );
+		AsyncTask* Steal( U32 thief );
+		void Complete( AsyncTask* task );
+
+	private:
+		struct Worker
+		{
+			std::mutex fMutex;
+			std::deque< AsyncTask* > fQueue;
+			std::thread fThread;
+		};
+
+	private:
+		Rtt_Allocator* fAllocator;
+		std::vector< Worker* > fWorkers;
+		std::mutex fSleepMutex;
+		std::condition_variable fWakeUp;
+		std::atomic< U32 > fNumQueued;
+		std::atomic< bool > fExiting;
+		std::atomic< AsyncTask* > fCompleted; // Written by workers
+		AsyncTask* fReadyHead; // Main thread only
+		U32 fNextWorker;
+};
+
+U32
+TaskPool::DefaultWorkerCount()
+{
+	U32 result = std::thread::hardware_concurrency();
+	result = ( result > 1 ? result - 1 : 1 );
+	return Min( result, (U32)4 );
+}
+
+TaskPool::TaskPool( Rtt_Allocator* allocator )
+:	fAllocator( allocator ),
+	fWorkers(),
+	fNumQueued( 0 ),
+	fExiting( false ),
+	fCompleted( NULL ),
+	fReadyHead( NULL ),
+	fNextWorker( 0 )
+{
+	const U32 numWorkers = DefaultWorkerCount();
+
+	// All queues must exist before any worker starts stealing
+	for ( U32 i = 0; i < numWorkers; i++ )
+	{
+		fWorkers.push_back( new Worker );
+	}
+
+	for ( U32 i = 0; i < numWorkers; i++ )
+	{
+		fWorkers[i]->fThread = std::thread( &TaskPool::WorkerMain, this, i );
+	}
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard< std::mutex > lock( fSleepMutex );
+		fExiting = true;
+	}
+	fWakeUp.notify_all();
+
+	for ( size_t i = 0, iMax = fWorkers.size(); i < iMax; i++ )
+	{
+		fWorkers[i]->fThread.join();
+	}
+
+	// Anything not yet run is dropped. Completion phases can't run here:
+	// the runtime (and its Lua state) is being torn down.
+	for ( size_t i = 0, iMax = fWorkers.size(); i < iMax; i++ )
+	{
+		Worker* worker = fWorkers[i];
+		for ( size_t j = 0, jMax = worker->fQueue.size(); j < jMax; j++ )
+		{
+			Rtt_DELETE( worker->fQueue[j] );
+		}
+		delete worker;
+	}
+
+	for ( AsyncTask* task = NextCompletion(); task; task = NextCompletion() )
+	{
+		Rtt_DELETE( task );
+	}
+}
+
+void
+TaskPool::Submit( AsyncTask* task )
+{
+	Rtt_ASSERT( task && ! task->getKeepAlive() );
+
+	Worker* worker = fWorkers[fNextWorker];
+	fNextWorker = ( fNextWorker + 1 ) % fWorkers.size();
+
+	{
+		// Count the task before publishing it: a worker may pop it as soon
+		// as it is queued, and its decrement must not wrap the counter.
+		// Taking the lock orders this with a worker's predicate check,
+		// so the wake-up can't be lost between the check and the wait.
+		std::lock_guard< std::mutex > lock( fSleepMutex );
+		++fNumQueued;
+	}
+
+	{
+		std::lock_guard< std::mutex > lock( worker->fMutex );
+		worker->fQueue.push_back( task );
+	}
+	fWakeUp.notify_one();
+}
+
+AsyncTask*
+TaskPool::NextCompletion()
+{
+	if ( ! fReadyHead )
+	{
+		// Detach everything finished so far; the stack is in LIFO order
+		AsyncTask* stack = fCompleted.exchange( NULL, std::memory_order_acquire );
+		while ( stack )
+		{
+			AsyncTask* next = stack->fNext;
+			stack->fNext = fReadyHead;
+			fReadyHead = stack;
+			stack = next;
+		}
+	}
+
+	AsyncTask* result = fReadyHead;
+	if ( result )
+	{
+		fReadyHead = result->fNext;
+		result->fNext = NULL;
+	}
+
+	return result;
+}
+
+void
+TaskPool::WorkerMain( U32 index )
+{
+	while ( ! fExiting )
+	{
+		AsyncTask* task = Pop( index );
+		if ( ! task )
+		{
+			task = Steal( index );
+		}
+
+		if ( task )
+		{
+			--fNumQueued;
+			task->RunInBackground();
+			Complete( task );
+		}
+		else
+		{
+			std::unique_lock< std::mutex > lock( fSleepMutex );
+			while ( 0 == fNumQueued && ! fExiting )
+			{
+				fWakeUp.wait( lock );
+			}
+		}
+	}
+}
+
+AsyncTask*
+TaskPool::Pop( U32 index )
+{
+	Worker* worker = fWorkers[index];
+
+	std::lock_guard< std::mutex > lock( worker->fMutex );
+	AsyncTask* result = NULL;
+	if ( ! worker->fQueue.empty() )
+	{
+		result = worker->fQueue.front();
+		worker->fQueue.pop_front();
+	}
+	return result;
+}
+
+AsyncTask*
+TaskPool::Steal( U32 thief )
+{
+	const size_t numWorkers = fWorkers.size();
+	for ( size_t i = 1; i < numWorkers; i++ )
+	{
+		Worker* victim = fWorkers[( thief + i ) % numWorkers];
+
+		std::lock_guard< std::mutex > lock( victim->fMutex );
+		if ( ! victim->fQueue.empty() )
+		{
+			AsyncTask* result = victim->fQueue.back();
+			victim->fQueue.pop_back();
+			return result;
+		}
+	}
+	return NULL;
+}
+
+void
+TaskPool::Complete( AsyncTask* task )
+{
+	AsyncTask* head = fCompleted.load( std::memory_order_relaxed );
+	do
+	{
+		task->fNext = head;
+	}
+	while ( ! fCompleted.compare_exchange_weak( head, task, std::memory_order_release, std::memory_order_relaxed ) );
+}
+
+// ----------------------------------------------------------------------------
+
+// Enough to absorb a burst of completions without eating into the frame
+static const U32 kDefaultCompletionBudget = 2000; // microseconds
+
 Scheduler::Scheduler( Runtime& owner )
 :	fOwner( owner ),
 	fProcessing( false ),
-	fTasks( owner.GetAllocator() )
+	fTasks( owner.GetAllocator() ),
+	fPool( NULL ),
+	fCompletionBudget( kDefaultCompletionBudget )
 {
 }
 
 Scheduler::~Scheduler()
 {
+	Rtt_DELETE( fPool );
 }
 
 #if 0
@@ -55,32 +308,74 @@ Scheduler::Append( Task* e )
 	fTasks.Append( e );
 }
 
+void
+Scheduler::AppendAsync( AsyncTask* e )
+{
+	if ( ! fPool )
+	{
+		fPool = Rtt_NEW( fOwner.GetAllocator(), TaskPool( fOwner.GetAllocator() ) );
+	}
+
+	fPool->Submit( e );
+}
+
 void
 Scheduler::Run()
 {
 	fProcessing = true;
 	
-	int i = 0;
-	while (i < fTasks.Length())
+	// Keep-alive tasks are compacted towards the front as we go, rather than
+	// removing each finished task individually (which shifts the whole array).
+	// Tasks appended while running are picked up by this same pass.
+	S32 numKept = 0;
+	for ( S32 i = 0; i < fTasks.Length(); i++ )
 	{
 		Task * t = fTasks[i];
 		if (t->getKeepAlive())
 		{
 			(*t)(*this);
-			i++;
+			fTasks[numKept++] = t;
 		}
 		else
 		{
 			// "pop event"
-			fTasks.Remove(i, 1, false);
 			(*t)(*this);
 			Rtt_DELETE(t);
 		}
 	}
+	if ( numKept < fTasks.Length() )
+	{
+		fTasks.Remove( numKept, fTasks.Length() - numKept, false );
+	}
+
+	if ( fPool )
+	{
+		RunCompletions();
+	}
 
 	fProcessing = false;
 }
 
+void
+Scheduler::RunCompletions()
+{
+	const Rtt_AbsoluteTime start = Rtt_GetAbsoluteTime();
+
+	// Always make progress, even if a single completion blows the budget
+	for ( AsyncTask* t = fPool->NextCompletion(); t; )
+	{
+		(*t)(*this);
+		Rtt_DELETE(t);
+
+		if ( Rtt_AbsoluteToMicroseconds( Rtt_GetAbsoluteTime() - start ) >= fCompletionBudget )
+		{
+			break;
+		}
+
+		t = fPool->NextCompletion();
+	}
+}
+
 // ----------------------------------------------------------------------------
 
 } // namespace Rtt
@@ -19,6 +19,7 @@ namespace Rtt
 
 class Runtime;
 class Scheduler;
+class TaskPool;
 
 // ----------------------------------------------------------------------------
 
@@ -39,6 +40,24 @@ class Task
 		bool fKeepAlive;
 };
 
+// A task whose work is split in two phases. RunInBackground() executes on
+// one of the Scheduler's worker threads; once it returns, the task is handed
+// back to the Scheduler and operator() runs on the main thread as usual.
+class AsyncTask : public Task
+{
+	public:
+		AsyncTask() : Task( false ), fNext( NULL ) {}
+
+	public:
+		// Called on a worker thread. Must not touch Lua, display objects or GL.
+		virtual void RunInBackground() = 0;
+
+	private:
+		friend class TaskPool;
+
+		AsyncTask* fNext; // Intrusive link used by the completion queue
+};
+
 class Scheduler
 {
 	public:
@@ -52,9 +71,22 @@ class Scheduler
 //		void Prepend( Task* e );
 		void Append( Task* e );
 
+		// Queues the background phase of 'e' on a worker thread. The Scheduler
+		// owns 'e' and deletes it after its completion phase has run.
+		void AppendAsync( AsyncTask* e );
+
 	public:
 		void Run();
 
+	public:
+		// Upper bound on the time Run() spends on completion phases per call.
+		// Completions that don't fit are deferred to the next call.
+		void SetCompletionBudget( U32 microseconds ) { fCompletionBudget = microseconds; }
+		U32 GetCompletionBudget() const { return fCompletionBudget; }
+
+	protected:
+		void RunCompletions();
+
 	public:
 		Owner& GetOwner() { return fOwner; }
 
@@ -62,6 +94,8 @@ class Scheduler
 		Owner& fOwner;
 		
 		PtrArray< Task > fTasks;
+		TaskPool* fPool; // Created on first AppendAsync()
+		U32 fCompletionBudget;
 		bool fProcessing;
 };
 
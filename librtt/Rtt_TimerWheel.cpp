@@ -0,0 +1,442 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Rtt_TimerWheel.h"
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+TimerWheel::TimerWheel()
+:	fTimers(),
+	fFree( kInvalidId ),
+	fTags(),
+	fDue(),
+	fNextDue( 0 ),
+	fTick( 0 ),
+	fTime( 0 ),
+	fNumScheduled( 0 )
+{
+	for ( S32 i = 0; i < kNumSlots; i++ )
+	{
+		fSlots[i] = kInvalidId;
+	}
+}
+
+S32
+TimerWheel::Add( U64 time, U32 delay, S32 iterations, const char *tag )
+{
+	S32 id = fFree;
+	if ( kInvalidId != id )
+	{
+		fFree = fTimers[id].fNext;
+	}
+	else
+	{
+		id = (S32)fTimers.size();
+		fTimers.push_back( Timer() );
+	}
+
+	Timer& timer = fTimers[id];
+	timer.fExpiration = time + delay;
+	timer.fDelay = delay;
+	timer.fIterations = iterations > 0 ? iterations : 0;
+	timer.fCount = 0;
+	timer.fSlot = kInvalidId;
+	timer.fTag.assign( tag ? tag : "" );
+
+	Schedule( id );
+	LinkTag( id );
+
+	return id;
+}
+
+void
+TimerWheel::Remove( S32 id )
+{
+	if ( ! IsValid( id ) )
+	{
+		return;
+	}
+
+	Timer& timer = fTimers[id];
+
+	// Due timers are skipped by PopExpiration()
+	if ( kScheduled == timer.fState )
+	{
+		Unschedule( id );
+	}
+	UnlinkTag( id );
+
+	timer.fTag.clear();
+	timer.fState = kFree;
+	timer.fNext = fFree;
+	fFree = id;
+}
+
+bool
+TimerWheel::Pause( S32 id, U64 time )
+{
+	bool result = false;
+
+	if ( IsValid( id ) )
+	{
+		Timer& timer = fTimers[id];
+		if ( kScheduled == timer.fState || kDue == timer.fState )
+		{
+			timer.fExpiration = GetTimeLeft( id, time );
+
+			if ( kScheduled == timer.fState )
+			{
+				Unschedule( id );
+			}
+			timer.fState = kPaused;
+			result = true;
+		}
+	}
+
+	return result;
+}
+
+bool
+TimerWheel::Resume( S32 id, U64 time )
+{
+	bool result = false;
+
+	if ( IsValid( id ) && kPaused == fTimers[id].fState )
+	{
+		fTimers[id].fExpiration += time;
+		Schedule( id );
+		result = true;
+	}
+
+	return result;
+}
+
+U64
+TimerWheel::GetTimeLeft( S32 id, U64 time ) const
+{
+	U64 result = 0;
+
+	if ( IsValid( id ) )
+	{
+		const Timer& timer = fTimers[id];
+		if ( kPaused == timer.fState )
+		{
+			result = timer.fExpiration;
+		}
+		else if ( kScheduled == timer.fState && timer.fExpiration > time )
+		{
+			result = timer.fExpiration - time;
+		}
+	}
+
+	return result;
+}
+
+S32
+TimerWheel::GetIterationsLeft( S32 id ) const
+{
+	S32 result = 0;
+
+	if ( IsValid( id ) )
+	{
+		const Timer& timer = fTimers[id];
+		result = timer.fIterations > 0 ? timer.fIterations - timer.fCount : -1;
+	}
+
+	return result;
+}
+
+bool
+TimerWheel::IsValid( S32 id ) const
+{
+	return id >= 0 && id < (S32)fTimers.size() && kFree != fTimers[id].fState;
+}
+
+void
+TimerWheel::GetTimers( const char *tag, std::vector< S32 >& result ) const
+{
+	if ( tag )
+	{
+		std::unordered_map< std::string, S32 >::const_iterator iter = fTags.find( tag );
+		if ( iter != fTags.end() )
+		{
+			S32 id = iter->second;
+			do
+			{
+				result.push_back( id );
+				id = fTimers[id].fTagNext;
+			}
+			while ( id != iter->second );
+		}
+	}
+	else
+	{
+		for ( S32 i = 0, iMax = (S32)fTimers.size(); i < iMax; i++ )
+		{
+			if ( kFree != fTimers[i].fState )
+			{
+				result.push_back( i );
+			}
+		}
+	}
+}
+
+void
+TimerWheel::Advance( U64 time )
+{
+	fTime = time;
+
+	if ( fNextDue >= fDue.size() )
+	{
+		fDue.clear();
+		fNextDue = 0;
+	}
+
+	while ( fTick <= time )
+	{
+		// Nothing left to move: skip ahead
+		if ( 0 == fNumScheduled )
+		{
+			fTick = time + 1;
+			break;
+		}
+
+		S32 index = (S32)( fTick & ( kLevel0Size - 1 ) );
+
+		// Once a level wraps around, move the timers of the next slot of
+		// the level above down
+		if ( 0 == index )
+		{
+			for ( S32 level = 1; level < kNumLevels; level++ )
+			{
+				S32 shift = kLevel0Bits + ( level - 1 ) * kLevelBits;
+				S32 i = (S32)( ( fTick >> shift ) & ( kLevelSize - 1 ) );
+				Cascade( kLevel0Size + ( level - 1 ) * kLevelSize + i );
+				if ( 0 != i )
+				{
+					break;
+				}
+			}
+		}
+
+		S32& head = fSlots[index];
+		while ( kInvalidId != head )
+		{
+			S32 id = head;
+			Unschedule( id );
+			fTimers[id].fState = kDue;
+			fDue.push_back( id );
+		}
+
+		++fTick;
+	}
+}
+
+bool
+TimerWheel::PopExpiration( Expiration& result )
+{
+	while ( fNextDue < fDue.size() )
+	{
+		S32 id = fDue[fNextDue++];
+
+		// Skip timers that were removed or paused since, and duplicates of
+		// reused ones
+		Timer& timer = fTimers[id];
+		if ( kDue != timer.fState )
+		{
+			continue;
+		}
+
+		result.fId = id;
+		result.fCount = ++timer.fCount;
+		result.fIsLast = ( timer.fIterations > 0 && timer.fCount >= timer.fIterations );
+
+		if ( result.fIsLast )
+		{
+			Remove( id );
+		}
+		else
+		{
+			// Keep the cadence; a timer that fell behind fires next frame
+			timer.fExpiration += timer.fDelay;
+			Schedule( id );
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void
+TimerWheel::Schedule( S32 id )
+{
+	Timer& timer = fTimers[id];
+
+	S32 slot = (S32)( fTick & ( kLevel0Size - 1 ) ); // Overdue: next tick
+	if ( timer.fExpiration >= fTick )
+	{
+		U64 delta = timer.fExpiration - fTick;
+		if ( delta < kLevel0Size )
+		{
+			slot = (S32)( timer.fExpiration & ( kLevel0Size - 1 ) );
+		}
+		else
+		{
+			S32 level = 1;
+			S32 shift = kLevel0Bits;
+			while ( level < kNumLevels - 1 && delta >= ( (U64)1 << ( shift + kLevelBits ) ) )
+			{
+				++level;
+				shift += kLevelBits;
+			}
+
+			// Delays fit in 32 bits, so the top level covers them all
+			slot = kLevel0Size + ( level - 1 ) * kLevelSize
+				+ (S32)( ( timer.fExpiration >> shift ) & ( kLevelSize - 1 ) );
+		}
+	}
+
+	timer.fSlot = slot;
+	timer.fState = kScheduled;
+	Link( fSlots[slot], id );
+	++fNumScheduled;
+}
+
+void
+TimerWheel::Unschedule( S32 id )
+{
+	Timer& timer = fTimers[id];
+	Rtt_ASSERT( kScheduled == timer.fState );
+
+	Unlink( fSlots[timer.fSlot], id );
+	timer.fSlot = kInvalidId;
+	--fNumScheduled;
+}
+
+void
+TimerWheel::Cascade( S32 slot )
+{
+	S32& head = fSlots[slot];
+	while ( kInvalidId != head )
+	{
+		S32 id = head;
+		Unschedule( id );
+		Schedule( id );
+	}
+}
+
+void
+TimerWheel::Link( S32& head, S32 id )
+{
+	Timer& timer = fTimers[id];
+
+	// Append, so that timers due on the same tick fire in order
+	if ( kInvalidId == head )
+	{
+		head = id;
+		timer.fPrev = id;
+		timer.fNext = id;
+	}
+	else
+	{
+		S32 tail = fTimers[head].fPrev;
+		timer.fPrev = tail;
+		timer.fNext = head;
+		fTimers[tail].fNext = id;
+		fTimers[head].fPrev = id;
+	}
+}
+
+void
+TimerWheel::Unlink( S32& head, S32 id )
+{
+	Timer& timer = fTimers[id];
+
+	if ( timer.fNext == id )
+	{
+		head = kInvalidId;
+	}
+	else
+	{
+		fTimers[timer.fPrev].fNext = timer.fNext;
+		fTimers[timer.fNext].fPrev = timer.fPrev;
+		if ( head == id )
+		{
+			head = timer.fNext;
+		}
+	}
+}
+
+void
+TimerWheel::LinkTag( S32 id )
+{
+	Timer& timer = fTimers[id];
+	if ( timer.fTag.empty() )
+	{
+		return;
+	}
+
+	std::pair< std::unordered_map< std::string, S32 >::iterator, bool > entry =
+		fTags.insert( std::make_pair( timer.fTag, id ) );
+	if ( entry.second )
+	{
+		timer.fTagPrev = id;
+		timer.fTagNext = id;
+	}
+	else
+	{
+		S32 head = entry.first->second;
+		S32 tail = fTimers[head].fTagPrev;
+		timer.fTagPrev = tail;
+		timer.fTagNext = head;
+		fTimers[tail].fTagNext = id;
+		fTimers[head].fTagPrev = id;
+	}
+}
+
+void
+TimerWheel::UnlinkTag( S32 id )
+{
+	Timer& timer = fTimers[id];
+	if ( timer.fTag.empty() )
+	{
+		return;
+	}
+
+	std::unordered_map< std::string, S32 >::iterator iter = fTags.find( timer.fTag );
+	Rtt_ASSERT( iter != fTags.end() );
+
+	if ( timer.fTagNext == id )
+	{
+		fTags.erase( iter );
+	}
+	else
+	{
+		fTimers[timer.fTagPrev].fTagNext = timer.fTagNext;
+		fTimers[timer.fTagNext].fTagPrev = timer.fTagPrev;
+		if ( iter->second == id )
+		{
+			iter->second = timer.fTagNext;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
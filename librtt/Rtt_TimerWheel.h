@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_TimerWheel_H__
+#define _Rtt_TimerWheel_H__
+
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Types.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Schedules the timers of the Lua "timer" library (see LuaLibTimer). Runtime
+// advances it once per frame, before enterFrame, so timers fire in sync with
+// frames: each is due on the first frame at or after its expiration, and
+// fires at most once per frame.
+//
+// Timers hang off a hierarchical wheel with 1 ms ticks: 256 slots for the
+// next 256 ms, then 4 levels of 64 slots, each covering 64 times the range of
+// the level below. A timer is moved down a level whenever the level below
+// wraps around, so adding, removing and firing a timer are all O(1), no
+// matter how many are pending.
+//
+// Timers are referred to by their index, which is reused once they are
+// removed.
+class TimerWheel
+{
+	Rtt_CLASS_NO_COPIES( TimerWheel )
+
+	public:
+		typedef TimerWheel Self;
+
+		static const S32 kInvalidId = -1;
+
+		struct Expiration
+		{
+			S32 fId;
+			S32 fCount; // Number of times it fired, including this one
+			bool fIsLast; // If so, the timer was removed
+		};
+
+	public:
+		TimerWheel();
+
+	public:
+		// Adds a timer that fires every 'delay' ms, starting 'delay' ms after
+		// 'time', for the given number of iterations (forever if <= 0).
+		// 'tag' may be NULL.
+		S32 Add( U64 time, U32 delay, S32 iterations, const char *tag );
+		void Remove( S32 id );
+
+		// Both return false if the timer was not running, resp. paused
+		bool Pause( S32 id, U64 time );
+		bool Resume( S32 id, U64 time );
+
+		// Time until the timer fires. Paused timers keep what they had left.
+		U64 GetTimeLeft( S32 id, U64 time ) const;
+
+		// Or -1 if it repeats forever
+		S32 GetIterationsLeft( S32 id ) const;
+
+		bool IsValid( S32 id ) const;
+
+		// Appends the timers with the given tag, or all timers if 'tag' is
+		// NULL, to 'result'.
+		void GetTimers( const char *tag, std::vector< S32 >& result ) const;
+
+	public:
+		// Moves timers that are due at 'time' to a queue
+		void Advance( U64 time );
+
+		// Pops the next due timer off the queue and reschedules it, unless
+		// that was its last iteration. Returns false once the queue is empty.
+		bool PopExpiration( Expiration& result );
+
+		bool HasExpirations() const { return fNextDue < fDue.size(); }
+
+		// Time of the last call to Advance()
+		U64 GetTime() const { return fTime; }
+
+	private:
+		enum
+		{
+			kLevel0Bits = 8,
+			kLevelBits = 6,
+			kNumLevels = 5,
+
+			kLevel0Size = 1 << kLevel0Bits,
+			kLevelSize = 1 << kLevelBits,
+			kNumSlots = kLevel0Size + ( kNumLevels - 1 ) * kLevelSize,
+		};
+
+		enum State
+		{
+			kFree = 0,
+			kScheduled,
+			kDue,
+			kPaused,
+		};
+
+		struct Timer
+		{
+			U64 fExpiration; // When paused, the time that was left
+			U32 fDelay;
+			S32 fIterations;
+			S32 fCount;
+			S32 fPrev; // Circular list of the slot or tag
+			S32 fNext; // Also links free timers
+			S32 fSlot;
+			S32 fTagPrev;
+			S32 fTagNext;
+			std::string fTag;
+			U8 fState;
+		};
+
+		void Schedule( S32 id );
+		void Unschedule( S32 id );
+		void Cascade( S32 slot );
+
+		void Link( S32& head, S32 id );
+		void Unlink( S32& head, S32 id );
+		void LinkTag( S32 id );
+		void UnlinkTag( S32 id );
+
+	private:
+		std::vector< Timer > fTimers;
+		S32 fFree;
+		S32 fSlots[kNumSlots]; // Head of each slot's list
+		std::unordered_map< std::string, S32 > fTags; // Head of each tag's list
+		std::vector< S32 > fDue;
+		size_t fNextDue;
+		U64 fTick; // Next tick to process
+		U64 fTime;
+		S32 fNumScheduled;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_TimerWheel_H__
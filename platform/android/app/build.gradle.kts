@@ -217,6 +217,8 @@ android {
     }
     aaptOptions {
         additionalParameters("--extra-packages", extraPackages.filter { it.isNotBlank() }.joinToString(":"))
+        // Compressed textures are read in place from the APK
+        noCompress("ktx", "ktx2")
     }
     if (isExpansionFileRequired) {
         assetPacks.add(":preloadedAssets")
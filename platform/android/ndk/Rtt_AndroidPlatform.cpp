@@ -11,6 +11,7 @@
 #include "Core/Rtt_Build.h"
 #include "Core/Rtt_String.h"
 #include "Corona/CoronaLua.h"
+#include "Display/Rtt_KTXBitmap.h"
 #include "Display/Rtt_PlatformBitmap.h"
 #include "Rtt_RenderingStream.h"
 #include "Rtt_LuaContext.h"
@@ -27,6 +28,7 @@
 #include "Rtt_AndroidTimer.h"
 
 #include "AndroidGLView.h"
+#include "AndroidZipFileEntry.h"
 #include "NativeToJavaBridge.h"
 #include "CoronaLua.h"
 #include "jniUtils.h"
@@ -186,6 +188,19 @@ PlatformBitmap* AndroidPlatform::CreateBitmap( const char* path, bool convertToG
 		{
 			result = Rtt_NEW( & GetAllocator(), AndroidMaskAssetBitmap( GetAllocator(), path, fNativeToJavaBridge ) );
 		}
+		else if ( KTXBitmap::IsKTXFile( path ) )
+		{
+			// Read in place from the APK, which requires the asset to be stored uncompressed
+			AndroidZipFileEntry zipFileEntry( & GetAllocator() );
+			if ( fNativeToJavaBridge->GetAssetFileLocation( path, zipFileEntry ) && ! zipFileEntry.IsCompressed() )
+			{
+				result = KTXBitmap::Create(
+					& GetAllocator(),
+					zipFileEntry.GetPackageFilePath(),
+					zipFileEntry.GetByteOffsetInPackage(),
+					zipFileEntry.GetByteCountInPackage() );
+			}
+		}
 		else
 		{
 			result = Rtt_NEW( & GetAllocator(), AndroidAssetBitmap( GetAllocator(), path, fNativeToJavaBridge ) );
@@ -405,7 +405,6 @@ EXTERNAL_FILES_OLD  := \
 
 PLATFORM_FILES := \
 	$(CORONA_ROOT)/platform/android/ndk/generated/init.cpp \
-	$(CORONA_ROOT)/platform/android/ndk/generated/easing.cpp \
 	$(CORONA_ROOT)/platform/android/ndk/generated/json.cpp \
 	$(CORONA_ROOT)/platform/android/ndk/generated/dkjson.cpp \
 	$(CORONA_ROOT)/platform/android/ndk/generated/shell.cpp \
@@ -506,6 +505,14 @@ LIBRTT_FILES := \
 	$(CORONA_ROOT)/librtt/Display/Rtt_CPUResourcePool.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_Display.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_DisplayDefaults.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_FrameProfiler.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_RenderList.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_SpatialIndex.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_TweenPlayer.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_RenderThread.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_KTXBitmap.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_TextureAtlas.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_FrameReadback.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_DisplayObject.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_GradientPaint.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_GradientPaintAdapter.cpp \
@@ -596,6 +603,11 @@ LIBRTT_FILES := \
 	$(CORONA_ROOT)/librtt/Rtt_LuaResourceOwner.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaTableIterator.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaUserdataProxy.cpp \
+	$(CORONA_ROOT)/librtt/Rtt_LuaProxyKeyCache.cpp \
+	$(CORONA_ROOT)/librtt/Rtt_LuaLibTransition.cpp \
+	$(CORONA_ROOT)/librtt/Rtt_TimerWheel.cpp \
+	$(CORONA_ROOT)/librtt/Rtt_LuaLibTimer.cpp \
+	$(CORONA_ROOT)/librtt/Rtt_LuaEventDispatcher.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_Matrix.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_PlatformAudioSessionManager.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_PlatformData.cpp \
@@ -719,6 +731,9 @@ LIBRTT_FILES := \
 	$(TACHYON_DIR)/Rtt_GL.cpp \
 	$(TACHYON_DIR)/Rtt_GLCommandBuffer.cpp \
 	$(TACHYON_DIR)/Rtt_GLFrameBufferObject.cpp \
+	$(TACHYON_DIR)/Rtt_GLProgramCache.cpp \
+	$(TACHYON_DIR)/Rtt_GLStreamBuffer.cpp \
+	$(TACHYON_DIR)/Rtt_GLReadback.cpp \
 	$(TACHYON_DIR)/Rtt_GLGeometry.cpp \
 	$(TACHYON_DIR)/Rtt_GLProgram.cpp \
 	$(TACHYON_DIR)/Rtt_GLRenderer.cpp \
@@ -12,6 +12,8 @@
 
 #include "Display/Rtt_PlatformBitmap.h"
 
+#include <mutex>
+
 // ----------------------------------------------------------------------------
 
 struct CGImage;
@@ -82,6 +84,8 @@ class AppleFileBitmap : public AppleBitmap
 
 	public:
 		virtual const void* GetBits( Rtt_Allocator* context ) const;
+		virtual void FreeBits() const;
+		virtual bool CanDecodeInBackground() const { return true; } // CoreGraphics decode is thread-safe
 		virtual U32 Width() const;
 		virtual U32 Height() const;
 		virtual PlatformBitmap::Format GetFormat() const;
@@ -95,6 +99,11 @@ class AppleFileBitmap : public AppleBitmap
 		float fScale;
 		U8 fProperties;
 		U8 fIsMask;
+
+		// Held while fData is decoded or freed. The async texture loader
+		// decodes on a worker thread while the main thread may ask for the
+		// bits of the same bitmap (e.g. to hit test it).
+		mutable std::mutex fBitsMutex;
 };
 
 #if defined( Rtt_IPHONE_ENV ) || defined( Rtt_TVOS_ENV )
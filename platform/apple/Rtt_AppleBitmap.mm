@@ -331,6 +331,8 @@ if ( provider )
 const void*
 AppleFileBitmap::GetBits( Rtt_Allocator* context ) const
 {
+	std::lock_guard< std::mutex > lock( fBitsMutex );
+
 	if ( ! fData )
 	{
 		// We don't support these colorspaces because we cannot create
@@ -353,6 +355,14 @@ AppleFileBitmap::GetBits( Rtt_Allocator* context ) const
 	return fData;
 }
 
+void
+AppleFileBitmap::FreeBits() const
+{
+	std::lock_guard< std::mutex > lock( fBitsMutex );
+
+	Super::FreeBits();
+}
+
 #ifdef Rtt_DEBUG
 void
 AppleFileBitmap::PrintChannel( const U8 *bytes, int channel, U32 bytesPerPixel ) const
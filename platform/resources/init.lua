@@ -14,15 +14,6 @@
 -- luacheck: globals network
 -- luacheck: globals Runtime
 
-local function getOrCreateTable( receiver, index )
-	local t = receiver[index]
-	if nil == t then
-		t = {}
-		receiver[index] = t
-	end
-	return t
-end
-
 local Object = {}
 function Object:new( o )
 	o = o or {}
@@ -45,115 +36,35 @@ end
 
 local EventDispatcher = Object:newClass()
 
-EventDispatcher._indexForType = { ["table"]="_tableListeners", ["function"]="_functionListeners" }
-
-function EventDispatcher:getOrCreateTable( eventName, listenerType )
-	local index = EventDispatcher._indexForType[ listenerType ]
-	local t = nil
-	if index then
-		t = getOrCreateTable( self, index )
-		t = getOrCreateTable( t, eventName )
-	end
-	if nil == t then
-        error("addEventListener: listener cannot be nil: "..tostring(index))
-    end
-	return t
-end
-
--- Every instance of EventDispatcher has two tables of listeners stored in then
--- _tableListeners and _functionListeners properties. Each of these tables is
--- itself a table that stores arrays keyed by the eventName. For example, a
--- table listener for the event "touch" is stored as an element of the array
--- self._tableListeners["touch"]. We have convenience methods to access the
--- either then _tableListeners or _functionListeners properties.
---
--- Here's an example of an EventDispatcher instance "o" and the contents of its
--- _tableListeners and _functionListeners private properties:
---
---		o._tableListeners =
---		{
---			"touch" = { obj1, obj2, obj3, ... },
---			"enterFrame" = { obj4, obj5, obj6, ... },
---		}
+-- Listeners are stored and dispatched natively (see Rtt_LuaEventDispatcher.cpp),
+-- in a userdata kept in the dispatcher's "_eventListeners" property. For each
+-- event name, function listeners are called before table listeners, in the
+-- order they were added. A table listener receives the event through the
+-- method named after it, e.g. obj:touch( event ).
 --
---		o._functionListeners =
---		{
---			"touch" = { func1, func2, func3, ... },
---			"enterFrame" = { func4, func5, func6, ... },
---		}
---
-function EventDispatcher:addEventListener( eventName, listener )
-    -- assume 'self' if listener not specified
-    if not listener and self[eventName] then listener = self; end
-
-	-- get table for either function or table listeners
-	local t = self:getOrCreateTable( eventName, type( listener ) )
-	if t then
-		table.insert( t, listener )
-	end
-	return (t ~= nil)
-end
-
+-- Listeners may be added or removed during a dispatch. Removed listeners are
+-- not called anymore; added ones are only called for subsequent events.
+EventDispatcher.addEventListener = system.__addEventListener
+EventDispatcher.removeEventListener = system.__removeEventListener
+EventDispatcher.hasEventListener = system.__hasEventListener
+EventDispatcher.dispatchEvent = system.__dispatchEvent
+EventDispatcher.respondsToEvent = system.__respondsToEvent
+
+-- prevent public access to private functions
+system.__addEventListener = nil
+system.__removeEventListener = nil
+system.__hasEventListener = nil
+system.__dispatchEvent = nil
+system.__respondsToEvent = nil
+
+-- Called after a listener is removed, so that derived objects can stop
+-- producing events nobody listens to.
 -- luacheck: push
 -- luacheck: ignore 212 -- Unused argument.
 function EventDispatcher:didRemoveListener( eventName )
 end
 -- luacheck: pop
 
-function EventDispatcher:removeEventListener( eventName, listener )
-    -- assume 'self' if listener not specified
-    if not listener and self[eventName] then listener = self; end
-
-	-- Find the given event listener in this dispatcher's collection.
-	local wasRemoved = false
-	local k = EventDispatcher._indexForType[ type(listener) ]
-	local listenerTable = self[ k ] -- table either for function or table listeners
-	if listenerTable then
-		local listenerArray = listenerTable[ eventName ]
-		if listenerArray then
-			for index = 1, #listenerArray do
-				if rawequal( listener, listenerArray[index] ) then
-					-- Remove the listener from the event's array of listeners.
-					table.remove( listenerArray, index )
-					wasRemoved = true
-
-					-- If the event's array of listeners is empty, then remove array from dispatcher's collection.
-					if #listenerArray == 0 then
-						listenerTable[ eventName ] = nil
-					end
-
-					-- Signal an EventDispatcher derived object that a listener has been removed.
-					self:didRemoveListener( eventName )
-					break
-				end
-			end
-		end
-	end
-
-	-- Returns true if the listener was found and removed.
-	return wasRemoved or nil
-end
-
-function EventDispatcher:hasEventListener( eventName, listener )
-    -- assume 'self' if listener not specified
-    if not listener and self[eventName] then listener = self; end
-
-	-- Find the given event listener in this dispatcher's collection.
-	local k = EventDispatcher._indexForType[ type(listener) ]
-	local listenerTable = self[ k ] -- table either for function or table listeners
-	if listenerTable then
-		local listenerArray = listenerTable[eventName]
-		if listenerArray then
-			for index = 1, #listenerArray do
-				if rawequal( listener, listenerArray[index] ) then
-					return true
-				end
-			end
-		end
-	end
-	return false
-end
-
 function cloneArray( array )
 	local clone = {}
 	for k,v in ipairs( array ) do
@@ -162,59 +73,6 @@ function cloneArray( array )
 	return clone
 end
 
-function EventDispatcher:dispatchEvent( event )
-	local result = false;
-	local eventName = event.name
-
-	-- array of functions is self._functionListeners[eventName]
-	local functionDict = self._functionListeners
-	local functionArray = ( functionDict and functionDict[eventName] ) or nil
-	if ( functionArray ~= nil ) and ( #functionArray > 0 ) then
-		local functionArrayClone = cloneArray( functionArray )
-		for index = 1, #functionArrayClone do
-			local func = functionArrayClone[ index ]
-			if self:hasEventListener( eventName, func ) then
-				-- Dispatch event to function listener.
-				local handled = func( event )
-				result = handled or result
-			end
-		end
-	end
-
-	-- array of table listeners is self._tableListeners[eventName]
-	local tableDict = self._tableListeners
-	local tableArray = ( tableDict and tableDict[eventName] ) or nil
-	if ( tableArray ~= nil ) and ( #tableArray > 0 ) then
-		local tableArrayClone = cloneArray( tableArray )
-		for index = 1, #tableArrayClone do
-			local obj = tableArrayClone[ index ]
-			if self:hasEventListener( eventName, obj ) then
-				-- Fetch method stored as property of object.
-				local method = obj[eventName]
-				if ( type(method) == "function" ) then
-					-- Dispatch event to table listener.
-					local handled = method( obj, event )
-					result = handled or result
-				end
-			end
-		end
-	end
-
-	return result
-end
-
-function EventDispatcher:respondsToEvent( eventName )
-	local t = self._functionListeners
-	local result = t and t[eventName]
-
-	if not result then
-		t = self._tableListeners
-		result = t and t[eventName]
-	end
-
-	return result;
-end
-
 -- Set up a public function allowing developers to create their own private event dispatchers.
 -- Mostly intended for plugin developers. Avoids event name collision with Runtime's event dispatcher.
 system.newEventDispatcher = function()
@@ -0,0 +1,66 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Times a cold start against a large archive: run make_modules.sh first, then
+-- build for a device, where every module is compiled into resource.car (the
+-- Simulator loads them from files instead). Prints the time to main.lua, the
+-- time to require every module once, and the time to look up names that are
+-- not in the archive, which is the worst case for a linear scan.
+
+local kNumModules = 5000
+local kNumMisses = 1000
+
+-- Includes opening the archive and running init.lua
+local launchTime = system.getTimer()
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function rate( name, count, f )
+	local start = system.getTimer()
+	f()
+	local elapsed = system.getTimer() - start
+	print( string.format( "%s: %.1f ms (%.2f us each)", name, elapsed, 1000 * elapsed / count ) )
+end
+
+print( string.format( "launch to main.lua: %.1f ms", launchTime ) )
+
+local found = pcall( require, "modules.m1" )
+check( "modules present (run make_modules.sh)", found )
+
+if found then
+	package.loaded["modules.m1"] = nil
+
+	rate( "require " .. kNumModules .. " modules", kNumModules, function()
+		for i = 1, kNumModules do
+			local m = require( "modules.m" .. i )
+			if m.index ~= i then
+				check( "modules.m" .. i, false )
+			end
+		end
+	end )
+
+	rate( "require " .. kNumMisses .. " missing modules", kNumMisses, function()
+		for i = 1, kNumMisses do
+			if pcall( require, "modules.missing" .. i ) then
+				check( "modules.missing" .. i, false )
+			end
+		end
+	end )
+end
+
+local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+print( result )
+display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
@@ -0,0 +1,18 @@
+#!/bin/sh
+#
+# Writes the modules that main.lua requires into modules/. Run it once before
+# building the project.
+#
+# Usage: make_modules.sh [count]
+
+COUNT=${1:-5000}
+
+cd "$(dirname "$0")" || exit 1
+rm -rf modules
+mkdir modules
+
+i=1
+while [ $i -le $COUNT ]; do
+	printf 'return { index = %d }\n' $i > "modules/m$i.lua"
+	i=$((i + 1))
+done
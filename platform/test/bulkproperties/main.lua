@@ -0,0 +1,139 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Benchmark for display.setProperties() and display.getProperties() against
+-- per-property access: writes and reads x, y and rotation of 20k rects,
+-- through arrays and float buffers. Prints the mean time per pass of each,
+-- checks that the bulk calls leave the same values as per-property access,
+-- and that bulk writes are faster.
+
+local kNumObjects = 20000
+local kNumPasses = 50
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function near( a, b )
+	return math.abs( a - b ) < 0.01
+end
+
+local group = display.newGroup()
+local objects = {}
+for i = 1, kNumObjects do
+	objects[i] = display.newRect( group, 0, 0, 4, 4 )
+end
+
+-- The same values as arrays and as float buffers
+local xs, ys, rotations = {}, {}, {}
+local xBuffer = display.newFloatBuffer( kNumObjects )
+local yBuffer = display.newFloatBuffer( kNumObjects )
+local rotationBuffer = display.newFloatBuffer( kNumObjects )
+for i = 1, kNumObjects do
+	xs[i] = math.random( display.contentWidth )
+	ys[i] = math.random( display.contentHeight )
+	rotations[i] = math.random( 360 )
+	xBuffer[i], yBuffer[i], rotationBuffer[i] = xs[i], ys[i], rotations[i]
+end
+
+-- Returns the mean time of 'f' in ms
+local function time( f )
+	local start = system.getTimer()
+	for n = 1, kNumPasses do
+		f()
+	end
+	return ( system.getTimer() - start ) / kNumPasses
+end
+
+local function reset()
+	for i = 1, kNumObjects do
+		local o = objects[i]
+		o.x, o.y, o.rotation = 0, 0, 0
+	end
+end
+
+local function matches( label )
+	for i = 1, kNumObjects do
+		local o = objects[i]
+		if not ( near( o.x, xs[i] ) and near( o.y, ys[i] ) and near( o.rotation, rotations[i] ) ) then
+			check( label .. ": object " .. i, false )
+			return
+		end
+	end
+end
+
+-- Writes
+local setEach = time( function()
+	for i = 1, kNumObjects do
+		local o = objects[i]
+		o.x = xs[i]
+		o.y = ys[i]
+		o.rotation = rotations[i]
+	end
+end )
+
+reset()
+local setArrays = time( function()
+	display.setProperties( objects, { x = xs, y = ys, rotation = rotations } )
+end )
+matches( "setProperties (arrays)" )
+
+reset()
+local setBuffers = time( function()
+	display.setProperties( objects, { x = xBuffer, y = yBuffer, rotation = rotationBuffer } )
+end )
+matches( "setProperties (buffers)" )
+
+-- Reads
+local outX, outY, outRotation = {}, {}, {}
+local getEach = time( function()
+	for i = 1, kNumObjects do
+		local o = objects[i]
+		outX[i] = o.x
+		outY[i] = o.y
+		outRotation[i] = o.rotation
+	end
+end )
+
+local getArrays = time( function()
+	display.getProperties( objects, { x = outX, y = outY, rotation = outRotation } )
+end )
+
+local outXBuffer = display.newFloatBuffer( kNumObjects )
+local outYBuffer = display.newFloatBuffer( kNumObjects )
+local outRotationBuffer = display.newFloatBuffer( kNumObjects )
+local getBuffers = time( function()
+	display.getProperties( objects, { x = outXBuffer, y = outYBuffer, rotation = outRotationBuffer } )
+end )
+
+for i = 1, kNumObjects do
+	if not ( near( outX[i], xs[i] ) and near( outXBuffer[i], xs[i] )
+		and near( outY[i], ys[i] ) and near( outYBuffer[i], ys[i] )
+		and near( outRotation[i], rotations[i] ) and near( outRotationBuffer[i], rotations[i] ) ) then
+		check( "getProperties: object " .. i, false )
+		break
+	end
+end
+
+print( string.format( "%d objects, x/y/rotation, ms per pass:", kNumObjects ) )
+print( string.format( "set: per property %.3f, arrays %.3f (%.1fx), buffers %.3f (%.1fx)",
+	setEach, setArrays, setEach / setArrays, setBuffers, setEach / setBuffers ) )
+print( string.format( "get: per property %.3f, arrays %.3f (%.1fx), buffers %.3f (%.1fx)",
+	getEach, getArrays, getEach / getArrays, getBuffers, getEach / getBuffers ) )
+
+check( "setProperties is faster", setArrays < setEach and setBuffers < setEach )
+
+local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+print( result )
+display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
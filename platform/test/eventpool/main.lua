@@ -0,0 +1,90 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- GC-pressure benchmark for system.setEventPooling(). Runs the same number of
+-- frames with fresh and with pooled event tables while the collector is
+-- stopped, and prints the Lua heap growth per frame for each. The listeners
+-- only read the event, so any difference comes from the event tables.
+
+local kNumListeners = 100
+local kNumFrames = 300
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	system.setEventPooling( false )
+	collectgarbage( "restart" )
+
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+local frameTimes = {}
+
+local listeners = {}
+for i = 1, kNumListeners do
+	listeners[i] = function( event )
+		frameTimes[i] = event.time
+	end
+end
+
+-- Returns the heap growth in KB per frame via onComplete( kbPerFrame )
+local function measure( pooled, onComplete )
+	system.setEventPooling( pooled )
+
+	for i = 1, kNumListeners do
+		Runtime:addEventListener( "enterFrame", listeners[i] )
+	end
+
+	local frames = 0
+	local startCount
+
+	local function onFrame()
+		if not startCount then
+			collectgarbage( "collect" )
+			collectgarbage( "stop" )
+			startCount = collectgarbage( "count" )
+			return
+		end
+
+		frames = frames + 1
+		if frames >= kNumFrames then
+			local growth = collectgarbage( "count" ) - startCount
+			collectgarbage( "restart" )
+
+			Runtime:removeEventListener( "enterFrame", onFrame )
+			for i = 1, kNumListeners do
+				Runtime:removeEventListener( "enterFrame", listeners[i] )
+			end
+
+			onComplete( growth / frames )
+		end
+	end
+
+	Runtime:addEventListener( "enterFrame", onFrame )
+end
+
+measure( false, function( fresh )
+	print( string.format( "fresh events:  %.3f KB per frame", fresh ) )
+
+	measure( true, function( pooled )
+		print( string.format( "pooled events: %.3f KB per frame", pooled ) )
+
+		check( "pooled events allocate less", pooled < fresh )
+		finish()
+	end )
+end )
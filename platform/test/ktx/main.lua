@@ -0,0 +1,158 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Loads generated KTX files: a valid one, and malformed ones that must be
+-- rejected (display.newImage() returns nil) without crashing or allocating
+-- for the sizes they claim. Also checks that textureMemoryUsed counts the
+-- compressed size of textures uploaded compressed.
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function u32( v )
+	local b = {}
+	for i = 1, 4 do
+		b[i] = v % 256
+		v = math.floor( v / 256 )
+	end
+	return string.char( unpack( b ) )
+end
+
+local function u64( lo, hi )
+	return u32( lo ) .. u32( hi or 0 )
+end
+
+local kKTX1Identifier = string.char( 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A )
+local kKTX2Identifier = string.char( 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A )
+
+local kETC1 = 0x8D64 -- GL_ETC1_RGB8_OES
+local kETC1Block = string.rep( "\0", 8 ) -- 4x4 pixels
+
+local function ktx1( p )
+	return kKTX1Identifier
+		.. u32( 0x04030201 )
+		.. u32( 0 ) -- glType
+		.. u32( 1 ) -- glTypeSize
+		.. u32( 0 ) -- glFormat
+		.. u32( p.format or kETC1 )
+		.. u32( 0x1907 ) -- glBaseInternalFormat (GL_RGB)
+		.. u32( p.width or 4 )
+		.. u32( p.height or 4 )
+		.. u32( 0 ) -- pixelDepth
+		.. u32( 0 ) -- numberOfArrayElements
+		.. u32( 1 ) -- numberOfFaces
+		.. u32( 1 ) -- numberOfMipmapLevels
+		.. u32( 0 ) -- bytesOfKeyValueData
+		.. u32( p.imageSize or #kETC1Block )
+		.. ( p.data or kETC1Block )
+end
+
+local function ktx2( p )
+	local kLevelIndexOffset = 80
+	local dataOffset = kLevelIndexOffset + 24
+	local data = p.data or kETC1Block
+	return kKTX2Identifier
+		.. u32( 147 ) -- VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+		.. u32( 1 ) -- typeSize
+		.. u32( p.width or 4 )
+		.. u32( p.height or 4 )
+		.. u32( 0 ) -- pixelDepth
+		.. u32( 0 ) -- layerCount
+		.. u32( 1 ) -- faceCount
+		.. u32( 1 ) -- levelCount
+		.. u32( 0 ) -- supercompressionScheme
+		.. u32( 0 ) .. u32( 0 ) -- dfdByteOffset, dfdByteLength
+		.. u32( 0 ) .. u32( 0 ) -- kvdByteOffset, kvdByteLength
+		.. u64( 0 ) .. u64( 0 ) -- sgdByteOffset, sgdByteLength
+		.. ( p.levelOffset or u64( dataOffset ) )
+		.. u64( #data ) -- byteLength
+		.. u64( #data ) -- uncompressedByteLength
+		.. data
+end
+
+local function load( filename, contents )
+	local path = system.pathForFile( filename, system.TemporaryDirectory )
+	local file = assert( io.open( path, "wb" ) )
+	file:write( contents )
+	file:close()
+
+	local image = display.newImage( filename, system.TemporaryDirectory )
+	os.remove( path )
+	return image
+end
+
+local image = load( "valid.ktx", ktx1( {} ) )
+check( "valid KTX is loaded", image and image.width == 4 and image.height == 4 )
+display.remove( image )
+
+image = load( "valid.ktx2", ktx2( {} ) )
+check( "valid KTX2 is loaded", image and image.width == 4 and image.height == 4 )
+display.remove( image )
+
+local rejected =
+{
+	[ "bad_identifier.ktx" ] = "KTX 1.1" .. ktx1( {} ):sub( 8 ),
+	[ "unknown_format.ktx" ] = ktx1( { format = 0x1908 } ),
+	[ "zero_width.ktx" ] = ktx1( { width = 0 } ),
+	[ "truncated_level.ktx" ] = ktx1( { data = kETC1Block:sub( 1, 4 ) } ),
+	[ "short_level.ktx" ] = ktx1( { width = 64, height = 64 } ),
+
+	-- Sizes whose byte counts wrap around in 32 bits
+	[ "huge.ktx" ] = ktx1( { width = 65536, height = 65536 } ),
+	[ "wide.ktx" ] = ktx1( { width = 0xFFFFFFFF, height = 4 } ),
+	[ "huge.ktx2" ] = ktx2( { width = 0x80000000, height = 0x80000000 } ),
+
+	-- Level offset + length wraps around in 64 bits
+	[ "level_offset.ktx2" ] = ktx2( { levelOffset = u64( 0xFFFFFFFC, 0xFFFFFFFF ) } ),
+}
+
+for filename, contents in pairs( rejected ) do
+	image = load( filename, contents )
+	check( filename .. " is rejected", nil == image )
+	display.remove( image )
+end
+
+-- Memory accounting: ETC1/ETC2 RGB is 4 bits per pixel. When the GPU lacks
+-- the format, the image is decoded and must be counted at its decoded size.
+local kSize = 256
+local kCompressedBytes = kSize * kSize / 2
+local kRGBABytes = kSize * kSize * 4
+local kLevel = string.rep( kETC1Block, kCompressedBytes / #kETC1Block )
+
+local compressed =
+{
+	[ "memory.ktx" ] = ktx1( { width = kSize, height = kSize, imageSize = kCompressedBytes, data = kLevel } ),
+	[ "memory.ktx2" ] = ktx2( { width = kSize, height = kSize, data = kLevel } ),
+}
+
+for filename, contents in pairs( compressed ) do
+	local before = system.getInfo( "textureMemoryUsed" )
+	image = load( filename, contents )
+	local used = system.getInfo( "textureMemoryUsed" ) - before
+
+	check( filename .. " is loaded", image and image.width == kSize and image.height == kSize )
+	if used < kRGBABytes then
+		print( string.format( "%s: %d bytes, RGBA would be %d", filename, used, kRGBABytes ) )
+		check( filename .. " counts its compressed size", used == kCompressedBytes )
+	else
+		print( string.format( "%s: %d bytes, decoded (format not supported by the GPU)", filename, used ) )
+		check( filename .. " counts its decoded size", used > 0 and used <= kRGBABytes )
+	end
+	display.remove( image )
+end
+
+local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+print( result )
+display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
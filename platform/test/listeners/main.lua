@@ -0,0 +1,122 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Dispatch benchmark for native listener storage: registers 500 enterFrame
+-- listeners (functions, then tables) on Runtime and prints the dispatch cost
+-- per frame, measured over real frames and over repeated
+-- Runtime:dispatchEvent() calls. Checks that every listener runs once per
+-- dispatch.
+
+local kNumListeners = 500
+local kNumFrames = 120
+local kNumDispatches = 1000
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+local calls = 0
+
+local function newListeners( kind )
+	local listeners = {}
+	for i = 1, kNumListeners do
+		if "table" == kind then
+			listeners[i] = { enterFrame = function() calls = calls + 1 end }
+		else
+			listeners[i] = function() calls = calls + 1 end
+		end
+	end
+	return listeners
+end
+
+local function addListeners( listeners )
+	local start = system.getTimer()
+	for i = 1, #listeners do
+		Runtime:addEventListener( "enterFrame", listeners[i] )
+	end
+	return system.getTimer() - start
+end
+
+local function removeListeners( listeners )
+	local start = system.getTimer()
+	for i = 1, #listeners do
+		Runtime:removeEventListener( "enterFrame", listeners[i] )
+	end
+	return system.getTimer() - start
+end
+
+local function run( kinds, index )
+	local kind = kinds[index]
+	if not kind then
+		finish()
+		return
+	end
+
+	local listeners = newListeners( kind )
+	local addTime = addListeners( listeners )
+
+	-- Synthetic dispatches: listener cost only
+	calls = 0
+	local event = { name = "enterFrame" }
+	local start = system.getTimer()
+	for i = 1, kNumDispatches do
+		Runtime:dispatchEvent( event )
+	end
+	local dispatchTime = system.getTimer() - start
+	check( kind .. ": every listener per dispatch", kNumDispatches * kNumListeners == calls )
+
+	-- Real frames: the last listener added runs last, so the time from the
+	-- first to the last listener is the dispatch cost of the frame
+	calls = 0
+	local frames = 0
+	local frameStart
+	local frameTime = 0
+
+	local function first()
+		frameStart = system.getTimer()
+	end
+
+	local function last()
+		frames = frames + 1
+		frameTime = frameTime + ( system.getTimer() - frameStart )
+
+		if frames >= kNumFrames then
+			Runtime:removeEventListener( "enterFrame", first )
+			Runtime:removeEventListener( "enterFrame", last )
+			local removeTime = removeListeners( listeners )
+
+			check( kind .. ": every listener per frame", kNumFrames * kNumListeners == calls )
+
+			print( string.format( "%d %s listeners: frame %.1f us, dispatchEvent %.1f us, add %.3f ms, remove %.3f ms",
+				kNumListeners, kind, 1000 * frameTime / frames, 1000 * dispatchTime / kNumDispatches, addTime, removeTime ) )
+
+			-- Outside of this dispatch, so the next listeners start on a new frame
+			timer.performWithDelay( 1, function() run( kinds, index + 1 ) end )
+		end
+	end
+
+	-- Keeps 'first' ahead of the others without re-registering them
+	removeListeners( listeners )
+	Runtime:addEventListener( "enterFrame", first )
+	addListeners( listeners )
+	Runtime:addEventListener( "enterFrame", last )
+end
+
+run( { "function", "table" }, 1 )
@@ -0,0 +1,118 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Checks that display object properties read and write the same values
+-- whether or not their keys are in the proxy key cache, including after
+-- the cache stops retaining new keys. Then times obj.x = obj.x + 1 and a
+-- property outside the cache, and prints both rates.
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function near( a, b )
+	return math.abs( a - b ) < 0.01
+end
+
+local function checkObject( name, object )
+	object.x, object.y = 10, 20
+	check( name .. ": x, y", 10 == object.x and 20 == object.y )
+
+	object.xScale, object.yScale = 2, 3
+	check( name .. ": xScale, yScale", 2 == object.xScale and 3 == object.yScale )
+	object.xScale, object.yScale = 1, 1
+
+	object.rotation = 45
+	check( name .. ": rotation", 45 == object.rotation )
+	object.rotation = 0
+
+	object.alpha = 0.5
+	check( name .. ": alpha", near( 0.5, object.alpha ) )
+	object.alpha = 2
+	check( name .. ": alpha clamped", 1 == object.alpha )
+
+	object.isVisible = false
+	check( name .. ": isVisible", false == object.isVisible )
+	object.isVisible = true
+
+	check( name .. ": width, height", "number" == type( object.width ) and "number" == type( object.height ) )
+
+	-- Keys outside the cache
+	object.anchorX = 0.25
+	check( name .. ": anchorX", near( 0.25, object.anchorX ) )
+	check( name .. ": contentBounds", "table" == type( object.contentBounds ) )
+
+	-- Custom fields live in the proxy's table
+	object.score = 42
+	check( name .. ": custom field", 42 == object.score )
+	object.x = object.x + 1
+	check( name .. ": custom field kept", 42 == object.score and 11 == object.x )
+end
+
+local rect = display.newRect( 0, 0, 40, 20 )
+check( "rect: width, height", 40 == rect.width and 20 == rect.height )
+rect.width = 60
+check( "rect: width set", 60 == rect.width )
+
+checkObject( "rect", rect )
+checkObject( "group", display.newGroup() )
+checkObject( "circle", display.newCircle( 0, 0, 10 ) )
+checkObject( "text", display.newText( "key cache", 0, 0, native.systemFont, 12 ) )
+
+-- Shared keys, different objects and delegates
+local a, b = display.newRect( 0, 0, 10, 10 ), display.newGroup()
+a.x, b.x = 1, 2
+check( "per object", 1 == a.x and 2 == b.x )
+
+-- More keys than the cache retains; later keys are resolved uncached
+local object = display.newRect( 0, 0, 10, 10 )
+for i = 1, 1000 do
+	local key = "key" .. i
+	object[key] = i
+	check( "many keys: " .. key, i == object[key] )
+end
+checkObject( "after many keys", object )
+
+-- Keys built at runtime are the same interned strings
+object[ "r" .. "otation" ] = 30
+check( "built key", 30 == object.rotation )
+
+local kIterations = 1000000
+
+local function rate( name, f )
+	local start = system.getTimer()
+	f()
+	local elapsed = math.max( system.getTimer() - start, 1 )
+	print( string.format( "%s: %d ops/ms", name, kIterations / elapsed ) )
+end
+
+local bench = display.newRect( 0, 0, 10, 10 )
+bench.x = 0
+rate( "obj.x = obj.x + 1", function()
+	for i = 1, kIterations do
+		bench.x = bench.x + 1
+	end
+end )
+check( "benchmark: x", kIterations == bench.x )
+
+bench.anchorX = 0
+rate( "obj.anchorX = obj.anchorX (uncached)", function()
+	for i = 1, kIterations do
+		bench.anchorX = bench.anchorX
+	end
+end )
+
+local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+print( result )
+display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
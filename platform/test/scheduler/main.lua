@@ -0,0 +1,110 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Stress test for the Scheduler's worker pool: queues 10000 asynchronous
+-- texture loads in a single frame, each of which runs as a background task
+-- with a main-thread completion. Checks that every load completes, and prints
+-- the total time along with the longest frame and the number of frames that
+-- took more than twice the frame interval while the tasks drained.
+
+local kNumTasks = 10000
+local kFrameInterval = 1000 / display.fps
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+-- Distinct copies of one small image, so that no load is answered by the cache
+local source = display.newRect( 0, 0, 8, 8 )
+source:setFillColor( 1, 0.5, 0 )
+display.save( source, { filename = "source.png", baseDir = system.TemporaryDirectory, captureOffscreenArea = true } )
+source:removeSelf()
+
+local file = io.open( system.pathForFile( "source.png", system.TemporaryDirectory ), "rb" )
+check( "source image saved", file )
+if not file then
+	finish()
+	return
+end
+local bytes = file:read( "*a" )
+file:close()
+
+for i = 1, kNumTasks do
+	local copy = io.open( system.pathForFile( "copy" .. i .. ".png", system.TemporaryDirectory ), "wb" )
+	copy:write( bytes )
+	copy:close()
+end
+
+local textures = {}
+local numLoaded = 0
+local numFrames = 0
+local numSlowFrames = 0
+local worstFrame = 0
+local start, lastFrame
+
+local function onFrame()
+	local now = system.getTimer()
+	local elapsed = now - lastFrame
+	lastFrame = now
+
+	numFrames = numFrames + 1
+	worstFrame = math.max( worstFrame, elapsed )
+	if elapsed > 2 * kFrameInterval then
+		numSlowFrames = numSlowFrames + 1
+	end
+end
+
+local function onLoad( event )
+	check( event.filename .. ": loaded", not event.isError and event.texture )
+	numLoaded = numLoaded + 1
+
+	if kNumTasks == numLoaded then
+		Runtime:removeEventListener( "enterFrame", onFrame )
+
+		print( string.format( "%d tasks: %.0f ms over %d frames", kNumTasks, system.getTimer() - start, numFrames ) )
+		print( string.format( "longest frame: %.1f ms, frames over %.1f ms: %d", worstFrame, 2 * kFrameInterval, numSlowFrames ) )
+
+		for i = 1, kNumTasks do
+			if textures[i] then
+				textures[i]:releaseSelf()
+			end
+		end
+		for i = 1, kNumTasks do
+			os.remove( system.pathForFile( "copy" .. i .. ".png", system.TemporaryDirectory ) )
+		end
+
+		finish()
+	end
+end
+
+start = system.getTimer()
+lastFrame = start
+Runtime:addEventListener( "enterFrame", onFrame )
+
+for i = 1, kNumTasks do
+	textures[i] = graphics.newTexture( {
+		type = "image",
+		filename = "copy" .. i .. ".png",
+		baseDir = system.TemporaryDirectory,
+		async = true,
+		listener = onLoad,
+	} )
+end
+print( string.format( "queued %d tasks in %.0f ms", kNumTasks, system.getTimer() - start ) )
@@ -0,0 +1,147 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Measures the first-use latency of effects with a cold and a warm program
+-- cache. Launch it twice: the first launch empties the cache in
+-- CachesDirectory/shaders and measures compiling every effect. The second
+-- launch measures loading the same programs from the cache, prints both and
+-- checks that the warm cache is faster.
+--
+-- For each effect, the time is resourceCreateTime plus renderTimeCPU, summed
+-- over the frames after the effect is first drawn. Programs are compiled or
+-- loaded in one or the other, depending on whether they are precompiled.
+
+local lfs = require( "lfs" )
+
+local kEffects =
+{
+	"filter.blur", "filter.sepia", "filter.grayscale", "filter.pixelate", "filter.vignette",
+	"filter.swirl", "filter.emboss", "filter.hue", "filter.crystallize", "filter.water",
+}
+local kFramesPerEffect = 3 -- Statistics trail by a frame, more with a render thread
+local kResultsFile = "shadercache.txt"
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish( result )
+	display.stopProfiling()
+
+	result = result or ( ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures ) )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+local function removeFiles( path )
+	if not path or "directory" ~= lfs.attributes( path, "mode" ) then
+		return
+	end
+
+	for name in lfs.dir( path ) do
+		if "." ~= name and ".." ~= name then
+			local child = path .. "/" .. name
+			if "directory" == lfs.attributes( child, "mode" ) then
+				removeFiles( child )
+			else
+				os.remove( child )
+			end
+		end
+	end
+end
+
+local resultsPath = system.pathForFile( kResultsFile, system.DocumentsDirectory )
+
+local function readColdTime()
+	local file = io.open( resultsPath, "r" )
+	if not file then
+		return nil
+	end
+
+	local value = tonumber( file:read( "*l" ) )
+	file:close()
+	return value
+end
+
+-- Draws each effect in turn and calls onComplete( totalMs, worstMs )
+local function measure( onComplete )
+	local index = 0
+	local frames = 0
+	local elapsed = 0
+	local total = 0
+	local worst = 0
+
+	local function onFrame()
+		local statistics = display.getFrameStatistics()
+		if index > 0 and statistics then
+			elapsed = elapsed + statistics.resourceCreateTime + statistics.renderTimeCPU
+		end
+
+		frames = frames - 1
+		if frames > 0 then
+			return
+		end
+
+		if index > 0 then
+			print( string.format( "%-20s %8.3f ms", kEffects[index], elapsed ) )
+			total = total + elapsed
+			worst = math.max( worst, elapsed )
+		end
+
+		index = index + 1
+		if index > #kEffects then
+			Runtime:removeEventListener( "enterFrame", onFrame )
+			onComplete( total, worst )
+			return
+		end
+
+		local rect = display.newRect( display.contentCenterX, display.contentCenterY, 100, 100 )
+		rect.fill.effect = kEffects[index]
+
+		frames = kFramesPerEffect
+		elapsed = 0
+	end
+
+	Runtime:addEventListener( "enterFrame", onFrame )
+end
+
+local coldTime = readColdTime()
+
+display.startProfiling()
+
+if not coldTime then
+	-- Files only: the renderer keeps its driver directory open
+	removeFiles( system.pathForFile( "shaders", system.CachesDirectory ) )
+
+	print( "Cold cache:" )
+	measure( function( total, worst )
+		print( string.format( "cold: %.3f ms total, %.3f ms worst", total, worst ) )
+
+		local file = io.open( resultsPath, "w" )
+		file:write( total, "\n" )
+		file:close()
+
+		finish( "Relaunch for the warm cache" )
+	end )
+else
+	os.remove( resultsPath )
+
+	print( "Warm cache:" )
+	measure( function( total, worst )
+		print( string.format( "warm: %.3f ms total, %.3f ms worst (cold: %.3f ms)", total, worst, coldTime ) )
+
+		check( "warm cache is faster", total < coldTime )
+		finish()
+	end )
+end
@@ -0,0 +1,105 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Benchmark scene for skipping clean subtrees: a growing number of static
+-- rects, in groups of 100, next to a few rects that move every frame. Prints
+-- the mean preparationTime (transform, prepare and draw of the stage) from
+-- display.getFrameStatistics() for each count. With clean groups skipped, it
+-- should grow far slower than the number of static objects.
+
+local kCounts = { 0, 5000, 10000, 20000 }
+local kNumMoving = 10
+local kGroupSize = 100
+local kNumFrames = 120
+local kWarmupFrames = 10 -- Skipped, as they include creating the scene
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	display.stopProfiling()
+
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+local scene
+local moving = {}
+
+local function newScene( count )
+	if scene then
+		scene:removeSelf()
+	end
+	scene = display.newGroup()
+
+	local group
+	for i = 1, count do
+		if 1 == i % kGroupSize then
+			group = display.newGroup()
+			scene:insert( group )
+		end
+		display.newRect( group, math.random( display.contentWidth ), math.random( display.contentHeight ), 4, 4 )
+	end
+
+	local movingGroup = display.newGroup()
+	scene:insert( movingGroup )
+	for i = 1, kNumMoving do
+		moving[i] = display.newRect( movingGroup, 0, i * 20, 10, 10 )
+		moving[i]:setFillColor( 1, 0, 0 )
+	end
+end
+
+local function run( index )
+	local count = kCounts[index]
+	if not count then
+		finish()
+		return
+	end
+
+	newScene( count )
+
+	local warmup = kWarmupFrames
+	local frames = 0
+	local prepTime = 0
+
+	local function onFrame( event )
+		for i = 1, kNumMoving do
+			moving[i].x = ( event.time / 10 + i * 30 ) % display.contentWidth
+		end
+
+		local statistics = display.getFrameStatistics()
+		if warmup > 0 then
+			warmup = warmup - 1
+		elseif statistics then
+			frames = frames + 1
+			prepTime = prepTime + statistics.preparationTime
+		end
+
+		if frames >= kNumFrames then
+			Runtime:removeEventListener( "enterFrame", onFrame )
+
+			check( count .. " static: measured", prepTime > 0 )
+			print( string.format( "%6d static objects: preparationTime %.3f ms", count, prepTime / frames ) )
+
+			run( index + 1 )
+		end
+	end
+
+	Runtime:addEventListener( "enterFrame", onFrame )
+end
+
+display.startProfiling()
+run( 1 )
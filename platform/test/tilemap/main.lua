@@ -0,0 +1,145 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Texture-fetch benchmark for trilinear filtering: a 64x64 (4096 tile) map,
+-- zoomed out to fit the screen and panned every frame, is drawn once from a
+-- tile sheet loaded with the "linear" and once with the "trilinear" minTextureFilter.
+-- Prints the mean renderTimeGPU and renderTimeCPU per frame for each. GPU
+-- times are 0 where the driver has no timer queries.
+
+local kSheetTiles = 8 -- Tiles per side of the sheet
+local kTileSize = 32
+local kMapTiles = 64 -- Tiles per side of the map
+local kNumFrames = 120
+local kWarmupFrames = 10
+local kFilters = { "linear", "trilinear" }
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	display.stopProfiling()
+	display.setDefault( "minTextureFilter", "linear" )
+
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+-- Tile sheet with fine detail in each tile, which linear filtering aliases
+local kSheetSize = kSheetTiles * kTileSize
+local sheetGroup = display.newGroup()
+for i = 0, kSheetTiles * kSheetTiles - 1 do
+	local x = ( i % kSheetTiles ) * kTileSize
+	local y = math.floor( i / kSheetTiles ) * kTileSize
+	local r, g, b = math.random(), math.random(), math.random()
+	for j = 0, 3 do
+		local stripe = display.newRect( sheetGroup, x + j * 8 + 2, y + kTileSize / 2, 4, kTileSize )
+		stripe:setFillColor( r, g, b )
+	end
+end
+display.save( sheetGroup, { filename = "tiles.png", baseDir = system.TemporaryDirectory, captureOffscreenArea = true } )
+sheetGroup:removeSelf()
+
+-- One copy per filter, so each is loaded as its own texture
+local file = io.open( system.pathForFile( "tiles.png", system.TemporaryDirectory ), "rb" )
+check( "tile sheet saved", file )
+if not file then
+	finish()
+	return
+end
+local bytes = file:read( "*a" )
+file:close()
+
+for _, filter in ipairs( kFilters ) do
+	local copy = io.open( system.pathForFile( "tiles_" .. filter .. ".png", system.TemporaryDirectory ), "wb" )
+	copy:write( bytes )
+	copy:close()
+end
+
+local map
+
+local function newMap( filter )
+	if map then
+		map:removeSelf()
+	end
+
+	display.setDefault( "minTextureFilter", filter )
+
+	-- The saved sheet is scaled by the content scale; the sheet options undo that
+	local sheet = graphics.newImageSheet( "tiles_" .. filter .. ".png", system.TemporaryDirectory,
+	{
+		width = kTileSize,
+		height = kTileSize,
+		numFrames = kSheetTiles * kSheetTiles,
+		sheetContentWidth = kSheetSize,
+		sheetContentHeight = kSheetSize,
+	} )
+
+	map = display.newGroup()
+	for y = 0, kMapTiles - 1 do
+		for x = 0, kMapTiles - 1 do
+			local tile = display.newImageRect( map, sheet, math.random( kSheetTiles * kSheetTiles ), kTileSize, kTileSize )
+			tile.x = ( x + 0.5 ) * kTileSize
+			tile.y = ( y + 0.5 ) * kTileSize
+		end
+	end
+
+	local scale = math.min( display.contentWidth, display.contentHeight ) / ( kMapTiles * kTileSize )
+	map.xScale, map.yScale = scale, scale
+end
+
+local function run( index )
+	local filter = kFilters[index]
+	if not filter then
+		finish()
+		return
+	end
+
+	newMap( filter )
+
+	local warmup = kWarmupFrames
+	local frames = 0
+	local gpuTime = 0
+	local cpuTime = 0
+
+	local function onFrame( event )
+		-- Sub-pixel pan, so every frame is redrawn
+		map.x = 4 * math.sin( event.time / 500 )
+
+		local statistics = display.getFrameStatistics()
+		if warmup > 0 then
+			warmup = warmup - 1
+		elseif statistics then
+			frames = frames + 1
+			gpuTime = gpuTime + statistics.renderTimeGPU
+			cpuTime = cpuTime + statistics.renderTimeCPU
+		end
+
+		if frames >= kNumFrames then
+			Runtime:removeEventListener( "enterFrame", onFrame )
+
+			check( filter .. ": measured", cpuTime > 0 )
+			print( string.format( "%-9s GPU %.3f ms, CPU %.3f ms", filter, gpuTime / frames, cpuTime / frames ) )
+
+			run( index + 1 )
+		end
+	end
+
+	Runtime:addEventListener( "enterFrame", onFrame )
+end
+
+display.startProfiling()
+run( 1 )
@@ -0,0 +1,105 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Checks the semantics of the timer library: counts and iterations, table
+-- listeners, cancel/pause/resume by handle and by tag, and delay clamping.
+-- Prints PASS (and shows it on screen) after about a second.
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local counts = {}
+local function counter( name )
+	counts[name] = 0
+	return function( event )
+		counts[name] = counts[name] + 1
+		check( name .. ": event name", "timer" == event.name )
+		check( name .. ": event count", counts[name] == event.count )
+	end
+end
+
+-- One-shot timers fire once, and pass their handle as the source
+local oneShot
+oneShot = timer.performWithDelay( 10, function( event )
+	counts.oneShot = ( counts.oneShot or 0 ) + 1
+	check( "oneShot: source", oneShot == event.source )
+end )
+
+-- Iterations, with the tag in place of the iteration count
+timer.performWithDelay( 10, counter( "threeTimes" ), 3 )
+timer.performWithDelay( 10, counter( "tagOnly" ), "tagOnly" )
+
+-- Timers that repeat forever, until cancelled
+local forever = timer.performWithDelay( 10, counter( "forever" ), 0 )
+
+-- Table listeners receive the event through their "timer" method
+local object = { count = 0 }
+function object:timer( event )
+	self.count = event.count
+end
+timer.performWithDelay( 10, object, 2 )
+
+-- Cancelling returns the time and iterations left, and the listener never fires
+local cancelled = timer.performWithDelay( 500, counter( "cancelled" ), 4 )
+local timeLeft, iterationsLeft = timer.cancel( cancelled )
+check( "cancel: time left", timeLeft and timeLeft > 0 and timeLeft <= 500 )
+check( "cancel: iterations left", 4 == iterationsLeft )
+check( "cancel: twice", nil == timer.cancel( cancelled ) )
+
+-- Tags apply to every timer with the tag, and only to those
+timer.performWithDelay( 50, counter( "tagged1" ), "group" )
+timer.performWithDelay( 50, counter( "tagged2" ), 1, "group" )
+timer.performWithDelay( 50, counter( "untagged" ) )
+timer.cancel( "group" )
+
+-- Paused timers keep the time they had left
+local paused = timer.performWithDelay( 100, counter( "paused" ) )
+local pausedTimeLeft = timer.pause( paused )
+check( "pause: time left", pausedTimeLeft and pausedTimeLeft > 0 and pausedTimeLeft <= 100 )
+
+-- Negative delays fire on the next frame; overlong ones are clamped
+timer.performWithDelay( -100, counter( "negative" ) )
+local overlong = timer.performWithDelay( 1e12, counter( "overlong" ) )
+local overlongTimeLeft = timer.cancel( overlong )
+check( "overlong: clamped", overlongTimeLeft and overlongTimeLeft <= 0x7FFFFFFF )
+
+check( "bad listener", not pcall( timer.performWithDelay, 10, 42 ) )
+check( "bad argument", not pcall( timer.cancel, 42 ) )
+
+timer.performWithDelay( 300, function()
+	check( "paused: not fired while paused", 0 == counts.paused )
+	timer.resume( paused )
+end )
+
+timer.performWithDelay( 1000, function()
+	check( "oneShot: fired once", 1 == counts.oneShot )
+	check( "oneShot: expired", nil == timer.cancel( oneShot ) )
+	check( "threeTimes", 3 == counts.threeTimes )
+	check( "tagOnly", 1 == counts.tagOnly )
+	check( "forever: still firing", counts.forever > 3 )
+	check( "table listener", 2 == object.count )
+	check( "cancelled", 0 == counts.cancelled )
+	check( "tagged", 0 == counts.tagged1 and 0 == counts.tagged2 )
+	check( "untagged", 1 == counts.untagged )
+	check( "paused: fired after resume", 1 == counts.paused )
+	check( "negative", 1 == counts.negative )
+	check( "overlong", 0 == counts.overlong )
+
+	timer.cancel( forever )
+
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end )
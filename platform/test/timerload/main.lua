@@ -0,0 +1,120 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Load test for the timer wheel with 100k timers. Prints:
+--   * the cost of adding and of cancelling 100k timers
+--   * the mean frame interval with 100k pending timers, spread over the
+--     wheel's levels, next to the interval with none
+--   * the cost per timer of firing 100k timers due on the same frame
+-- Checks that cancelled timers never fire and that due ones all fire once.
+
+local kNumTimers = 100000
+local kNumFrames = 120
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+-- Calls onComplete( meanIntervalMs ) after kNumFrames frames
+local function measureFrames( onComplete )
+	local frames = 0
+	local total = 0
+	local last
+
+	local function onFrame()
+		local now = system.getTimer()
+		if last then
+			frames = frames + 1
+			total = total + ( now - last )
+		end
+		last = now
+
+		if frames >= kNumFrames then
+			Runtime:removeEventListener( "enterFrame", onFrame )
+			onComplete( total / frames )
+		end
+	end
+
+	Runtime:addEventListener( "enterFrame", onFrame )
+end
+
+local function measureFiring()
+	local fired = 0
+	local first
+
+	local function onTimer()
+		if 0 == fired then
+			first = system.getTimer()
+		end
+		fired = fired + 1
+
+		if kNumTimers == fired then
+			local elapsed = system.getTimer() - first
+			print( string.format( "fire: %.3f ms for %d timers due together (%.3f us each)", elapsed, kNumTimers, 1000 * elapsed / kNumTimers ) )
+
+			-- Give any duplicate firing a few frames to show up
+			timer.performWithDelay( 100, function()
+				check( "due timers fire once", kNumTimers == fired )
+				finish()
+			end )
+		end
+	end
+
+	for i = 1, kNumTimers do
+		timer.performWithDelay( 50, onTimer )
+	end
+end
+
+local baseline
+
+local function measurePending()
+	local cancelledFired = 0
+	local function onCancelled()
+		cancelledFired = cancelledFired + 1
+	end
+
+	-- Delays from 1 s to about 4.7 hours, so they land on different levels
+	local handles = {}
+	local start = system.getTimer()
+	for i = 1, kNumTimers do
+		handles[i] = timer.performWithDelay( 1000 + math.floor( 2 ^ ( 24 * i / kNumTimers ) ), onCancelled )
+	end
+	local addTime = system.getTimer() - start
+	print( string.format( "add: %.3f ms for %d timers", addTime, kNumTimers ) )
+
+	measureFrames( function( interval )
+		print( string.format( "frame interval: %.3f ms with %d pending timers, %.3f ms with none", interval, kNumTimers, baseline ) )
+
+		start = system.getTimer()
+		for i = 1, kNumTimers do
+			timer.cancel( handles[i] )
+		end
+		local cancelTime = system.getTimer() - start
+		print( string.format( "cancel: %.3f ms for %d timers", cancelTime, kNumTimers ) )
+
+		check( "pending timers not fired", 0 == cancelledFired )
+		measureFiring()
+	end )
+end
+
+measureFrames( function( interval )
+	baseline = interval
+	measurePending()
+end )
@@ -0,0 +1,127 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Checks the semantics of the transition library: end values, from/delta,
+-- delays, iterations, onComplete listeners, cancel/pause/resume by handle,
+-- tag and object, and the easing functions it accepts.
+-- Prints PASS (and shows it on screen) after about a second.
+
+local easing = require( "easing" )
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function near( a, b )
+	return math.abs( a - b ) < 0.001
+end
+
+local completions = {}
+local function completed( name )
+	completions[name] = 0
+	return function( target )
+		completions[name] = completions[name] + 1
+		check( name .. ": target", "table" == type( target ) )
+	end
+end
+
+-- Easing functions are evaluated natively, and can be called directly
+check( "easing.linear", near( 0.25, easing.linear( 1, 4, 0, 1 ) ) )
+check( "easing.outQuad", near( 0.75, easing.outQuad( 1, 2, 0, 1 ) ) )
+check( "easing.inOutQuad", near( 10, easing.inOutQuad( 1, 1, 0, 10 ) ) )
+
+-- Plain end values, with the target passed to onComplete
+local plain = display.newRect( 0, 0, 10, 10 )
+transition.to( plain, { time = 100, x = 100, y = 50, alpha = 0.5, transition = easing.outQuad, onComplete = completed( "plain" ) } )
+
+-- From the given values to the current ones
+local from = display.newRect( 100, 0, 10, 10 )
+transition.from( from, { time = 100, x = 0, onComplete = completed( "from" ) } )
+
+-- Start values are read once the delay has elapsed
+local delayed = display.newRect( 0, 0, 10, 10 )
+transition.to( delayed, { delay = 100, time = 50, x = 10, delta = true } )
+delayed.x = 50
+
+-- Iterations complete once, after the last one
+local repeated = display.newRect( 0, 0, 10, 10 )
+transition.to( repeated, { time = 50, iterations = 3, rotation = 90, onComplete = completed( "repeated" ) } )
+
+-- Table listeners receive the event through their "onComplete" method
+local listener = { count = 0 }
+function listener:onComplete( target )
+	self.count = self.count + 1
+end
+transition.to( display.newRect( 0, 0, 10, 10 ), { time = 50, xScale = 2, onComplete = listener } )
+
+-- Cancelled transitions stop where they are, and don't complete
+local cancelled = display.newRect( 0, 0, 10, 10 )
+local handle = transition.to( cancelled, { time = 100, x = 100, onComplete = completed( "cancelled" ) } )
+transition.cancel( handle )
+transition.cancel( handle )
+
+local tagged = display.newRect( 0, 0, 10, 10 )
+transition.to( tagged, { time = 100, x = 100, tag = "group", onComplete = completed( "tagged" ) } )
+transition.to( tagged, { time = 100, y = 100, tag = "group" } )
+transition.cancel( "group" )
+
+-- Paused transitions resume where they were
+local paused = display.newRect( 0, 0, 10, 10 )
+transition.to( paused, { time = 100, x = 100, onComplete = completed( "paused" ) } )
+transition.pause( paused )
+
+-- Fills and effects only apply to shapes, and effects need params
+local filled = display.newRect( 0, 0, 10, 10 )
+check( "fill", pcall( transition.to, filled, { time = 50, fill = { r = 0, g = 0.5 } } ) )
+check( "fill: not a shape", not pcall( transition.to, display.newGroup(), { fill = { r = 0 } } ) )
+check( "effect: none set", not pcall( transition.to, filled, { effect = { intensity = 1 } } ) )
+
+-- Lua easing functions can't be evaluated natively
+check( "custom easing", not pcall( transition.to, filled, { transition = function( t, tMax, start, delta ) return start end } ) )
+check( "easing by name", pcall( transition.to, filled, { time = 50, alpha = 0.5, transition = "inOutSine" } ) )
+check( "unknown easing name", not pcall( transition.to, filled, { transition = "inOutNothing" } ) )
+
+check( "bad target", not pcall( transition.to, {}, { x = 1 } ) )
+check( "bad argument", not pcall( transition.cancel, 42 ) )
+
+timer.performWithDelay( 50, function()
+	check( "from: in progress", from.x < 100 )
+	check( "delayed: not started", 50 == delayed.x )
+end )
+
+timer.performWithDelay( 300, function()
+	check( "paused: not moved while paused", 0 == paused.x )
+	transition.resume( paused )
+end )
+
+timer.performWithDelay( 1000, function()
+	check( "plain: end values", 100 == plain.x and 50 == plain.y and near( 0.5, plain.alpha ) )
+	check( "plain: completed once", 1 == completions.plain )
+	check( "from: end value", 100 == from.x )
+	check( "from: completed once", 1 == completions.from )
+	check( "delayed: start read after the delay", 60 == delayed.x )
+	check( "repeated: completed once", 1 == completions.repeated )
+	check( "repeated: end value", 90 == repeated.rotation )
+	check( "table listener", 1 == listener.count )
+	check( "cancelled: not moved", 0 == cancelled.x )
+	check( "cancelled: not completed", 0 == completions.cancelled )
+	check( "tagged: not moved", 0 == tagged.x and 0 == tagged.y )
+	check( "tagged: not completed", 0 == completions.tagged )
+	check( "paused: end value", 100 == paused.x )
+	check( "paused: completed after resume", 1 == completions.paused )
+
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end )
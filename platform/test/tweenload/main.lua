@@ -0,0 +1,106 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Load test for the transition library: 10k concurrent tweens, each driving
+-- x, y, rotation and alpha of its own rect. The per-frame cost is the
+-- "TweenPlayer::Run" zone of the frame profiler, read back from
+-- display.writeProfile(). Prints its mean and worst over 120 frames and
+-- checks that the mean stays under 1 ms.
+
+local easing = require( "easing" )
+
+local kNumTweens = 10000
+local kNumFrames = 120
+local kBudget = 1 -- ms per frame
+local kProfileFile = "tweenload.json"
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+-- Returns the durations (in ms) of every zone named 'zoneName' in the trace
+local function readZones( path, zoneName )
+	local result = {}
+
+	local file = io.open( path, "r" )
+	if not file then
+		return result
+	end
+
+	local pattern = '"name":"' .. zoneName:gsub( "%p", "%%%0" ) .. '".-"dur":(%d+)'
+	for line in file:lines() do
+		local duration = line:match( pattern )
+		if duration then
+			result[#result + 1] = tonumber( duration ) / 1000
+		end
+	end
+	file:close()
+
+	return result
+end
+
+local group = display.newGroup()
+for i = 1, kNumTweens do
+	local rect = display.newRect( group, math.random( display.contentWidth ), math.random( display.contentHeight ), 4, 4 )
+	transition.to( rect,
+	{
+		time = 10000, -- Outlasts the measured frames
+		x = math.random( display.contentWidth ),
+		y = math.random( display.contentHeight ),
+		rotation = 360,
+		alpha = 0.25,
+		transition = easing.inOutQuad,
+	} )
+end
+
+display.startProfiling()
+
+local frames = 0
+local function onFrame()
+	frames = frames + 1
+	if frames < kNumFrames then
+		return
+	end
+
+	Runtime:removeEventListener( "enterFrame", onFrame )
+
+	check( "profile written", display.writeProfile( kProfileFile, system.TemporaryDirectory ) )
+	display.stopProfiling()
+	transition.cancel()
+
+	local durations = readZones( system.pathForFile( kProfileFile, system.TemporaryDirectory ), "TweenPlayer::Run" )
+	check( "frames measured", #durations > 0 )
+
+	if #durations > 0 then
+		local total, worst = 0, 0
+		for _, duration in ipairs( durations ) do
+			total = total + duration
+			worst = math.max( worst, duration )
+		end
+		local mean = total / #durations
+
+		print( string.format( "%d tweens: %.3f ms per frame, worst %.3f ms (%d frames)", kNumTweens, mean, worst, #durations ) )
+		check( "under " .. kBudget .. " ms per frame", mean < kBudget )
+	end
+
+	finish()
+end
+
+Runtime:addEventListener( "enterFrame", onFrame )
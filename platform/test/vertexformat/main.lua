@@ -0,0 +1,137 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Bandwidth benchmark for the compact vertex format. Draws the same moving
+-- rects with two effects that only differ in whether the kernel reads the
+-- vertex user data: the first is batched in the compact format, the second
+-- in the full one. Prints the batched vertex bytes per frame, the upload
+-- time (resourceUpdateTime) and the CPU and GPU render times for each.
+
+local kNumRects = 20000
+local kNumFrames = 120
+local kWarmupFrames = 10
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	display.stopProfiling()
+
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+-- Same fragment cost; only "full" references the vertex user data
+graphics.defineEffect{
+	category = "filter",
+	group = "vertexformat",
+	name = "compact",
+	fragment = [[
+P_COLOR vec4 FragmentKernel( P_UV vec2 texCoord )
+{
+	return texture2D( CoronaSampler0, texCoord ) * v_ColorScale;
+}
+]],
+}
+
+graphics.defineEffect{
+	category = "filter",
+	group = "vertexformat",
+	name = "full",
+	vertexData = {
+		{ name = "unused", default = 0, index = 0 },
+	},
+	fragment = [[
+P_COLOR vec4 FragmentKernel( P_UV vec2 texCoord )
+{
+	return texture2D( CoronaSampler0, texCoord ) * v_ColorScale + CoronaVertexUserData.x;
+}
+]],
+}
+
+local kEffects = { "filter.vertexformat.compact", "filter.vertexformat.full" }
+
+local group
+local rects = {}
+
+local function newScene( effect )
+	if group then
+		group:removeSelf()
+	end
+	group = display.newGroup()
+
+	for i = 1, kNumRects do
+		local rect = display.newRect( group, math.random( display.contentWidth ), math.random( display.contentHeight ), 4, 4 )
+		rect.fill.effect = effect
+		rects[i] = rect
+	end
+end
+
+local results = {}
+
+local function run( index )
+	local effect = kEffects[index]
+	if not effect then
+		local compact, full = results[1], results[2]
+		check( "compact batches fewer bytes", compact.vertexBytes < full.vertexBytes )
+		print( string.format( "compact/full vertex bytes: %.2f", compact.vertexBytes / full.vertexBytes ) )
+		finish()
+		return
+	end
+
+	newScene( effect )
+
+	local warmup = kWarmupFrames
+	local frames = 0
+	local totals = { vertexBytes = 0, resourceUpdateTime = 0, renderTimeCPU = 0, renderTimeGPU = 0 }
+
+	local function onFrame( event )
+		local dx = ( 0 == event.frame % 2 ) and 1 or -1
+		for i = 1, kNumRects do
+			local rect = rects[i]
+			rect.x = rect.x + dx
+		end
+
+		local statistics = display.getFrameStatistics()
+		if warmup > 0 then
+			warmup = warmup - 1
+		elseif statistics then
+			frames = frames + 1
+			for k in pairs( totals ) do
+				totals[k] = totals[k] + statistics[k]
+			end
+		end
+
+		if frames >= kNumFrames then
+			Runtime:removeEventListener( "enterFrame", onFrame )
+
+			for k, v in pairs( totals ) do
+				totals[k] = v / frames
+			end
+			results[index] = totals
+
+			print( string.format( "%s: %d KB per frame, upload %.3f ms, CPU %.3f ms, GPU %.3f ms",
+				effect, totals.vertexBytes / 1024, totals.resourceUpdateTime, totals.renderTimeCPU, totals.renderTimeGPU ) )
+
+			run( index + 1 )
+		end
+	end
+
+	Runtime:addEventListener( "enterFrame", onFrame )
+end
+
+display.startProfiling()
+run( 1 )
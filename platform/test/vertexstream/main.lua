@@ -0,0 +1,100 @@
+------------------------------------------------------------------------------
+--
+-- This file is part of the Corona game engine.
+-- For overview and more information on licensing please refer to README.md 
+-- Home page: https://github.com/coronalabs/corona
+-- Contact: support@coronalabs.com
+--
+------------------------------------------------------------------------------
+
+-- Measures the CPU time the renderer spends dispatching batched draws, which
+-- stream their vertices through the VBO ring. Moves a growing number of
+-- rects every frame, so all of their vertices are streamed again, and prints
+-- the mean renderTimeCPU and preparationTime from display.getFrameStatistics()
+-- for each count. Compare the numbers against a build without the ring.
+
+local kCounts = { 1000, 5000, 10000, 20000 }
+local kNumFrames = 120
+local kWarmupFrames = 10 -- Skipped, as they include creating the scene
+local kSize = 4
+
+local failures = 0
+
+local function check( name, condition )
+	if not condition then
+		failures = failures + 1
+		print( "FAIL: " .. name )
+	end
+end
+
+local function finish()
+	display.stopProfiling()
+
+	local result = ( 0 == failures ) and "PASS" or ( "FAILED: " .. failures )
+	print( result )
+	display.newText( result, display.contentCenterX, display.contentCenterY, native.systemFont, 24 )
+end
+
+local group
+local step = 0
+
+local function newScene( count )
+	if group then
+		group:removeSelf()
+	end
+	group = display.newGroup()
+
+	for i = 1, count do
+		local rect = display.newRect( group, math.random( display.contentWidth ), math.random( display.contentHeight ), kSize, kSize )
+		rect:setFillColor( math.random(), math.random(), math.random() )
+	end
+end
+
+local function run( index )
+	local count = kCounts[index]
+	if not count then
+		finish()
+		return
+	end
+
+	newScene( count )
+
+	local warmup = kWarmupFrames
+	local frames = 0
+	local renderTime, prepTime, drawCalls = 0, 0, 0
+
+	local function onFrame()
+		-- Every vertex changes, so nothing can be reused from the last frame
+		step = step + 1
+		local dx = ( 0 == step % 2 ) and 1 or -1
+		for i = 1, group.numChildren do
+			local rect = group[i]
+			rect.x = rect.x + dx
+		end
+
+		local statistics = display.getFrameStatistics()
+		if warmup > 0 then
+			warmup = warmup - 1
+		elseif statistics then
+			frames = frames + 1
+			renderTime = renderTime + statistics.renderTimeCPU
+			prepTime = prepTime + statistics.preparationTime
+			drawCalls = drawCalls + statistics.drawCallCount
+		end
+
+		if frames >= kNumFrames then
+			Runtime:removeEventListener( "enterFrame", onFrame )
+
+			check( count .. " rects: drawn", drawCalls > 0 )
+			print( string.format( "%6d rects: renderTimeCPU %.3f ms, preparationTime %.3f ms, %.1f draws per frame",
+				count, renderTime / frames, prepTime / frames, drawCalls / frames ) )
+
+			run( index + 1 )
+		end
+	end
+
+	Runtime:addEventListener( "enterFrame", onFrame )
+end
+
+display.startProfiling()
+run( 1 )
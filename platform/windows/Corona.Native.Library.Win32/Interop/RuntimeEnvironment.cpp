@@ -18,6 +18,7 @@
 #include "Core\Rtt_String.h"
 #include "CryptoPP\md5.h"
 #include "Display\Rtt_Display.h"
+#include "Display\Rtt_RenderThread.h"
 #include "Display\Rtt_Scene.h"
 #include "Display\Rtt_StageObject.h"
 #include "Interop\Storage\SQLiteStoredPreferences.h"
@@ -1124,6 +1125,12 @@ OperationResult RuntimeEnvironment::RunUsing(const RuntimeEnvironment::CreationS
 	auto result = fRuntimePointer->LoadApplication(updatedLaunchOptions);
 	if (Rtt::Runtime::kSuccess == result)
 	{
+		// If frames are rendered on a separate thread, then the runtime selects the rendering context when it needs it.
+		if (fRenderSurfacePointer && fRuntimePointer->GetDisplay().GetRenderThread())
+		{
+			fRenderSurfacePointer->SetSelectsContextOnPaint(false);
+		}
+
 		// Load was successful. Start running the Corona application.
 		fRuntimePointer->BeginRunLoop();
 		OnRuntimeTimerElapsed();
@@ -1736,16 +1743,31 @@ void RuntimeEnvironment::OnIpcWindowReceivedMessage(UI::UIComponent &sender, UI:
 void RuntimeEnvironment::OnRenderFrame(UI::RenderSurfaceControl &sender, HandledEventArgs &arguments)
 {
 	// Do not continue if the runtime is not currently running.
-	if (!fRuntimePointer || (fRuntimePointer->IsProperty(Rtt::Runtime::kIsApplicationLoaded) == false))
+	if (!fRuntimePointer)
 	{
 		return;
 	}
+	bool isRunning = fRuntimePointer->IsProperty(Rtt::Runtime::kIsApplicationLoaded);
 	switch (fRuntimeState)
 	{
 		case RuntimeState::kNotStarted:
 		case RuntimeState::kTerminating:
 		case RuntimeState::kTerminated:
-			return;
+			isRunning = false;
+			break;
+	}
+	if (!isRunning)
+	{
+		// The render thread may own the rendering context, so clear the surface while holding it ourselves.
+		// Otherwise, let the surface draw its own black screen.
+		auto renderThreadPointer = fRuntimePointer->GetDisplay().GetRenderThread();
+		if (renderThreadPointer)
+		{
+			Rtt::RenderThread::Lock lock(renderThreadPointer);
+			sender.DrawBlackScreen();
+			arguments.SetHandled();
+		}
+		return;
 	}
 
 	// Have the runtime render a frame.
@@ -1763,6 +1785,7 @@ void RuntimeEnvironment::OnDestroyingSurface(UI::UIComponent &sender, const Even
 		// We can't reliably select the OpenGL context of a window/control that is being destroyed.
 		// So, let Corona's OpenGL functions no-op and let the surface destroy the context itself.
 		::wglMakeCurrent(nullptr, nullptr);
+		fRuntimePointer->GetDisplay().SetSurfaceDestroyed();
 
 		// Delete the Corona runtime.
 		// Note: This will dispatch a Lua "applicationEvent" and terminate the runtime before deletion.
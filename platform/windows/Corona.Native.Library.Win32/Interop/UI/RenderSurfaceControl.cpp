@@ -27,7 +27,8 @@ RenderSurfaceControl::RenderSurfaceControl(HWND windowHandle)
 	fRenderFrameEventHandlerPointer(nullptr),
 	fMainDeviceContextHandle(nullptr),
 	fPaintDeviceContextHandle(nullptr),
-	fRenderingContextHandle(nullptr)
+	fRenderingContextHandle(nullptr),
+	fSelectsContextOnPaint(true)
 {
 	// Add event handlers.
 	GetReceivedMessageEventHandlers().Add(&fReceivedMessageEventHandler);
@@ -71,7 +72,9 @@ void RenderSurfaceControl::SelectRenderingContext()
 	if (fRenderingContextHandle)
 	{
 		// Favor the Win32 BeginPaint() function's device context over our main device context, if available.
-		if (fPaintDeviceContextHandle)
+		// Note: It is only valid on the control's thread, during a paint message.
+		bool isOnControlThread = (::GetWindowThreadProcessId(GetWindowHandle(), nullptr) == ::GetCurrentThreadId());
+		if (isOnControlThread && fPaintDeviceContextHandle)
 		{
 			wasSelected = ::wglMakeCurrent(fPaintDeviceContextHandle, fRenderingContextHandle);
 		}
@@ -113,6 +116,26 @@ void RenderSurfaceControl::SelectRenderingContext()
 	}
 }
 
+void RenderSurfaceControl::ReleaseRenderingContext()
+{
+	if (fRenderingContextHandle && (::wglGetCurrentContext() == fRenderingContextHandle))
+	{
+		::wglMakeCurrent(nullptr, nullptr);
+	}
+}
+
+void RenderSurfaceControl::SetSelectsContextOnPaint(bool value)
+{
+	fSelectsContextOnPaint = value;
+}
+
+void RenderSurfaceControl::DrawBlackScreen()
+{
+	::glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	::glClear(GL_COLOR_BUFFER_BIT);
+	SwapBuffers();
+}
+
 void RenderSurfaceControl::SwapBuffers()
 {
 	if (fPaintDeviceContextHandle)
@@ -477,8 +500,11 @@ void RenderSurfaceControl::OnPaint()
 	// Render to the control.
 	if (fMainDeviceContextHandle && fRenderingContextHandle)
 	{
-		// Select this control's OpenGL context.
-		SelectRenderingContext();
+		// Select this control's OpenGL context, unless the handler does so itself.
+		if (fSelectsContextOnPaint || !fRenderFrameEventHandlerPointer)
+		{
+			SelectRenderingContext();
+		}
 
 		// If the owner of this surface has provided a RenderFrameHandler, then use it to draw the next frame.
 		// Otherwise, draw a black screen until a handler has been given to this surface.
@@ -495,9 +521,18 @@ void RenderSurfaceControl::OnPaint()
 		}
 		if (false == didDraw)
 		{
-			::glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-			::glClear(GL_COLOR_BUFFER_BIT);
-			SwapBuffers();
+			// A handler that selects the context itself clears the surface while it owns the context.
+			// If it didn't, then no other thread is using the context, but don't leave it selected.
+			bool isSelectedHere = (!fSelectsContextOnPaint && fRenderFrameEventHandlerPointer);
+			if (isSelectedHere)
+			{
+				SelectRenderingContext();
+			}
+			DrawBlackScreen();
+			if (isSelectedHere)
+			{
+				ReleaseRenderingContext();
+			}
 		}
 	}
 	else
@@ -147,6 +147,26 @@ class RenderSurfaceControl : public Control
 		/// </summary>
 		void SelectRenderingContext();
 
+		/// <summary>Detaches this surface's rendering context from the calling thread, if current.</summary>
+		/// <remarks>The context can then be selected by another thread.</remarks>
+		void ReleaseRenderingContext();
+
+		/// <summary>
+		///  <para>Sets whether the rendering context is selected before the "RenderFrame" handler is invoked.</para>
+		///  <para>
+		///   Set false if the handler selects the context itself, such as when frames are rendered on another thread.
+		///   The handler is then expected to draw (or clear) the surface itself whenever another thread can own the
+		///   context, since the black screen drawn when it doesn't handle the event is not synchronized with that thread.
+		///  </para>
+		///  <para>Set true by default.</para>
+		/// </summary>
+		/// <param name="value">Set false to leave context selection to the "RenderFrame" handler.</param>
+		void SetSelectsContextOnPaint(bool value);
+
+		/// <summary>Clears the surface to black and swaps buffers.</summary>
+		/// <remarks>The rendering context must be selected by the calling thread.</remarks>
+		void DrawBlackScreen();
+
 		/// <summary>
 		///  Swaps the rendering surface's back buffer with the front buffer, the last rendered content appear onscreen.
 		/// </summary>
@@ -251,6 +271,9 @@ class RenderSurfaceControl : public Control
 		/// <summary>Handle to OpenGL's rendering context.</summary>
 		HGLRC fRenderingContextHandle;
 
+		/// <summary>Set false if the "RenderFrame" handler selects the rendering context itself.</summary>
+		bool fSelectsContextOnPaint;
+
 		/// <summary>Stores the major/minor version number of the OpenGL driver that is rendering to this surface.</summary>
 		RenderSurfaceControl::Version fRendererVersion;
 
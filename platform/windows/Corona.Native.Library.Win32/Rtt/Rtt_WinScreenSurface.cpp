@@ -41,6 +41,21 @@ void WinScreenSurface::SetCurrent() const
 	}
 }
 
+void WinScreenSurface::ReleaseCurrent() const
+{
+	auto surfaceControlPointer = fEnvironment.GetRenderSurface();
+	if (surfaceControlPointer)
+	{
+		surfaceControlPointer->ReleaseRenderingContext();
+	}
+}
+
+bool WinScreenSurface::SupportsRenderThread() const
+{
+	// WGL contexts can be selected by any thread, one thread at a time.
+	return true;
+}
+
 void WinScreenSurface::Flush() const
 {
 	auto surfaceControlPointer = fEnvironment.GetRenderSurface();
@@ -38,6 +38,8 @@ class WinScreenSurface : public PlatformSurface
 		virtual ~WinScreenSurface();
 
 		virtual void SetCurrent() const;
+		virtual void ReleaseCurrent() const;
+		virtual bool SupportsRenderThread() const;
 		virtual void Flush() const;
 		virtual S32 Width() const;
 		virtual S32 Height() const;
@@ -28,10 +28,16 @@ static void
 Usage( const char* arg0 )
 {
 	fprintf(stderr, "Usage:\n");
-	fprintf(stderr, "  %s {-a|--add} dest.car srcfile0 [srcfile1 ...]\n", arg0);
-	fprintf(stderr, "  %s {-f|--filelist} filelist dest.car\n", arg0);
+	fprintf(stderr, "  %s [-z|--compress platform] [-1|--version1] {-a|--add} dest.car srcfile0 [srcfile1 ...]\n", arg0);
+	fprintf(stderr, "  %s [-z|--compress platform] [-1|--version1] {-f|--filelist} filelist dest.car\n", arg0);
 	fprintf(stderr, "  %s {-x|--extract} src.car destdir\n", arg0);
 	fprintf(stderr, "  %s {-l|--list} src.car\n", arg0);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  -z, --compress  deflate each file that is large enough and compresses well.\n");
+	fprintf(stderr, "                  Only the runtimes of some platforms can read compressed\n");
+	fprintf(stderr, "                  archives (android), so the target platform must be given\n");
+	fprintf(stderr, "  -1, --version1  write a version 1 archive, readable by runtimes that predate\n");
+	fprintf(stderr, "                  the hashed index (cannot be combined with -z)\n");
 }
 
 // ----------------------------------------------------------------------------
@@ -40,10 +46,50 @@ Rtt_EXPORT int
 Rtt_CarMain( int argc, const char *argv[] )
 {
 	int result = 0;
+	const char *arg0 = argv[0];
 
-	if ( argc < 3 )
+	// Compression and the archive version are modifiers to --add and --filelist
+	bool compress = false;
+	bool isLegacyFormat = false;
+	for ( ; argc > 1; --argc, ++argv )
 	{
-		Usage( argv[0] );
+		if ( 0 == strcmp(argv[1], "-z") || 0 == strcmp(argv[1], "--compress") )
+		{
+			if ( argc < 3 )
+			{
+				Usage( arg0 );
+				return -1;
+			}
+
+			const char *platform = argv[2];
+			if ( ! Archive::CanDecompress( platform ) )
+			{
+				fprintf(stderr, "%s: %s runtimes cannot read compressed archives\n", arg0, platform);
+				return -1;
+			}
+
+			compress = true;
+			--argc;
+			++argv;
+		}
+		else if ( 0 == strcmp(argv[1], "-1") || 0 == strcmp(argv[1], "--version1") )
+		{
+			isLegacyFormat = true;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	if ( compress && isLegacyFormat )
+	{
+		fprintf(stderr, "%s: -z cannot be combined with -1\n", arg0);
+		result = -1;
+	}
+	else if ( argc < 3 )
+	{
+		Usage( arg0 );
 		result = -1;
 	}
 	else
@@ -52,7 +98,7 @@ Rtt_CarMain( int argc, const char *argv[] )
 		{
 			if ( argc < 4 )
 			{
-				Usage( argv[0] );
+				Usage( arg0 );
 				result = -1;
 			}
 			else
@@ -64,7 +110,7 @@ Rtt_CarMain( int argc, const char *argv[] )
 		{
 			if (argc < 3)
 			{
-				Usage(argv[0]);
+				Usage(arg0);
 				result = -1;
 			}
 			else
@@ -76,7 +122,7 @@ Rtt_CarMain( int argc, const char *argv[] )
 		{
 			if ( argc != 4 )
 			{
-				Usage( argv[0] );
+				Usage( arg0 );
 				result = -1;
 			}
 			else
@@ -92,7 +138,7 @@ Rtt_CarMain( int argc, const char *argv[] )
 				{
 					if ((inFile = fopen(argv[2], "r")) == NULL)
 					{
-						fprintf(stderr, "%s: cannot open '%s' for reading\n", argv[0], argv[2]);
+						fprintf(stderr, "%s: cannot open '%s' for reading\n", arg0, argv[2]);
 						
 						return -1;
 					}
@@ -107,7 +153,7 @@ Rtt_CarMain( int argc, const char *argv[] )
 				
 				if (srcPaths == NULL)
 				{
-					fprintf(stderr, "%s: out of memory allocating %d filenames\n", argv[0], numAlloced);
+					fprintf(stderr, "%s: out of memory allocating %d filenames\n", arg0, numAlloced);
 					
 					return -1;
 				}
@@ -131,14 +177,14 @@ Rtt_CarMain( int argc, const char *argv[] )
 					
 					if (srcPaths == NULL)
 					{
-						fprintf(stderr, "%s: out of memory allocating %d filenames\n", argv[0], numAlloced);
+						fprintf(stderr, "%s: out of memory allocating %d filenames\n", arg0, numAlloced);
 						
 						return -1;
 					}
 					
 					if ((srcPaths[numSrcPaths++] = strdup(buf)) == NULL)
 					{
-						fprintf(stderr, "%s: out of memory after processing %d filenames\n", argv[0], numSrcPaths);
+						fprintf(stderr, "%s: out of memory after processing %d filenames\n", arg0, numSrcPaths);
 						
 						return -1;
 					}
@@ -150,7 +196,7 @@ Rtt_CarMain( int argc, const char *argv[] )
 				
 				fclose( inFile );
 				
-				Archive::Serialize( argv[3], numSrcPaths, srcPaths );
+				Archive::Serialize( argv[3], numSrcPaths, srcPaths, compress, isLegacyFormat );
 				
 				// Free the memory we allocated
 				for (int i = 0; i < numSrcPaths; i++)
@@ -171,7 +217,7 @@ Rtt_CarMain( int argc, const char *argv[] )
 					printf( "argv[%d] = %s\n", i, argv[i] );
 				}
 			#endif
-			Archive::Serialize( argv[argOffset+1], numSrcPaths, srcPaths );
+			Archive::Serialize( argv[argOffset+1], numSrcPaths, srcPaths, compress, isLegacyFormat );
 		}
 	}
 
@@ -0,0 +1,64 @@
+#!/bin/sh
+#
+# Size and latency of compressed archives against raw ones: packs the same
+# generated modules with and without -z, then prints the archive sizes and
+# the time to extract every entry, which for compressed archives includes
+# inflating it.
+#
+# Usage: bench_car.sh [path/to/car] [number of modules]
+
+CAR=${1:-./car}
+COUNT=${2:-5000}
+RUNS=5
+TMP=$(mktemp -d "${TMPDIR:-/tmp}/carXXXXXX")
+trap 'rm -rf "$TMP"' EXIT
+
+# Modules of a few hundred bytes to a few KB, like compiled app code
+mkdir -p "$TMP/src"
+awk -v count="$COUNT" -v dir="$TMP/src" 'BEGIN {
+	for ( i = 1; i <= count; i++ ) {
+		file = dir "/module" i ".lu"
+		print "local M = {}" > file
+		for ( j = 0; j < 5 + i % 40; j++ ) {
+			print "function M.f" j "( a, b ) return a * " i + j " + b, \"" i "-" j "\" end" > file
+		}
+		print "return M" > file
+		close( file )
+	}
+}'
+
+# Milliseconds since the epoch. BSD date has no %N, so fall back to perl.
+now()
+{
+	t=$(date +%s%N)
+	case "$t" in
+		*N) perl -MTime::HiRes=time -e 'printf "%d\n", time() * 1000' ;;
+		*) echo $((t / 1000000)) ;;
+	esac
+}
+
+bench()
+{
+	name=$1
+	shift
+
+	"$CAR" "$@" -a "$TMP/$name.car" "$TMP"/src/*.lu || exit 1
+
+	total=0
+	run=0
+	while [ $run -lt $RUNS ]; do
+		rm -rf "$TMP/out"
+		mkdir "$TMP/out"
+		start=$(now)
+		"$CAR" -x "$TMP/$name.car" "$TMP/out" > /dev/null
+		total=$((total + $(now) - start))
+		run=$((run + 1))
+	done
+
+	printf '%-12s %10d bytes  %6d ms to extract (mean of %d)\n' \
+		"$name" $(wc -c < "$TMP/$name.car") $((total / RUNS)) $RUNS
+}
+
+echo "$COUNT modules, $(cat "$TMP"/src/*.lu | wc -c | tr -d ' ') bytes"
+bench raw
+bench compressed -z android
@@ -0,0 +1,76 @@
+#!/bin/sh
+#
+# Round-trip checks for the car tool: archives written in every format are
+# listed and extracted back to identical files, and the output is the same
+# for the same input.
+#
+# Usage: test_car.sh [path/to/car]
+
+CAR=${1:-./car}
+TMP=$(mktemp -d "${TMPDIR:-/tmp}/carXXXXXX")
+trap 'rm -rf "$TMP"' EXIT
+
+failures=0
+
+fail()
+{
+	echo "FAIL: $1"
+	failures=$((failures + 1))
+}
+
+# Sources: small and large, compressible and not, and two files with the same name
+mkdir -p "$TMP/src" "$TMP/other"
+i=0
+while [ $i -lt 50 ]; do
+	printf 'return { value = %d }\n' $i > "$TMP/src/module$i.lu"
+	i=$((i + 1))
+done
+awk 'BEGIN { for ( i = 0; i < 4000; i++ ) print "local x = " i }' > "$TMP/src/large.lu"
+head -c 4096 /dev/urandom > "$TMP/src/random.lu"
+printf 'return "first"\n' > "$TMP/src/dup.lu"
+printf 'return "second"\n' > "$TMP/other/dup.lu"
+
+roundtrip()
+{
+	name=$1
+	shift
+
+	rm -f "$TMP/$name.car"
+	"$CAR" "$@" -a "$TMP/$name.car" "$TMP"/src/*.lu || { fail "$name: write"; return; }
+
+	count=$("$CAR" -l "$TMP/$name.car" | grep -c '\.lu')
+	[ "$count" -eq 53 ] || fail "$name: listed $count of 53 entries"
+
+	rm -rf "$TMP/out"
+	mkdir "$TMP/out"
+	"$CAR" -x "$TMP/$name.car" "$TMP/out" > /dev/null
+	diff -r "$TMP/src" "$TMP/out" > /dev/null || fail "$name: extracted files differ"
+}
+
+roundtrip v2
+roundtrip compressed -z android
+roundtrip v1 -1
+
+[ "$(head -c 4 "$TMP/v2.car" | tail -c 1 | od -An -tu1 | tr -d ' ')" = "2" ] || fail "v2: wrong version byte"
+[ "$(head -c 4 "$TMP/v1.car" | tail -c 1 | od -An -tu1 | tr -d ' ')" = "1" ] || fail "v1: wrong version byte"
+[ $(wc -c < "$TMP/compressed.car") -lt $(wc -c < "$TMP/v2.car") ] || fail "compressed: archive did not shrink"
+
+# Same input gives the same archive, including entries with the same name
+"$CAR" -a "$TMP/a.car" "$TMP/src/dup.lu" "$TMP/other/dup.lu" "$TMP"/src/module*.lu
+"$CAR" -a "$TMP/b.car" "$TMP/src/dup.lu" "$TMP/other/dup.lu" "$TMP"/src/module*.lu
+cmp -s "$TMP/a.car" "$TMP/b.car" || fail "archives of the same input differ"
+
+if "$CAR" -z android -1 -a "$TMP/bad.car" "$TMP/src/large.lu" 2> /dev/null; then
+	fail "-z -1 was accepted"
+fi
+
+# Only platforms whose runtime links zlib can be compressed for
+if "$CAR" -z ios -a "$TMP/bad.car" "$TMP/src/large.lu" 2> /dev/null; then
+	fail "-z ios was accepted"
+fi
+
+if [ $failures -eq 0 ]; then
+	echo "PASS"
+fi
+
+exit $failures
@@ -0,0 +1,146 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+// Compares the batched Matrix::Apply( Geometry&, src, texSrc, n ) used by
+// ClosedPath::UpdateGeometry against the per-vertex scalar loop it replaced.
+//
+// Usage: transformbench [numVertices] [numIterations]
+
+#include "Core/Rtt_Build.h"
+
+#include "Core/Rtt_Time.h"
+#include "Renderer/Rtt_Geometry_Renderer.h"
+#include "Renderer/Rtt_Renderer.h"
+#include "Rtt_Matrix.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// ----------------------------------------------------------------------------
+
+using namespace Rtt;
+
+// The geometry here is never attached to a Renderer, so CPUResource never
+// calls into it. These stand in for the renderer sources, which aren't linked.
+void Renderer::QueueUpdate( CPUResource* resource ) {}
+void Renderer::QueueDestroy( GPUResource* resource ) {}
+
+// The loop ClosedPath::UpdateGeometry used before the batched transform
+static void
+ApplyScalar( const Matrix& m, Geometry& geometry, const Vertex2 src[], const Vertex2 *texSrc, U32 numVertices )
+{
+	Geometry::Vertex *dst = geometry.GetVertexData();
+
+	for ( U32 i = 0; i < numVertices; i++ )
+	{
+		Geometry::Vertex& d = dst[i];
+
+		Vertex2 v = src[i];
+		m.Apply( v );
+
+		d.x = v.x;
+		d.y = v.y;
+		d.z = 0.f;
+
+		if ( texSrc )
+		{
+			d.u = texSrc[i].x;
+			d.v = texSrc[i].y;
+			d.q = 1.f;
+		}
+	}
+}
+
+static double
+MicrosecondsSince( Rtt_AbsoluteTime start )
+{
+	return (double)Rtt_AbsoluteToMicroseconds( Rtt_GetAbsoluteTime() - start );
+}
+
+static int
+Run( Rtt_Allocator *allocator, U32 numVertices, U32 numIterations )
+{
+	Vertex2 *src = (Vertex2 *)malloc( numVertices * sizeof( Vertex2 ) );
+	Vertex2 *texSrc = (Vertex2 *)malloc( numVertices * sizeof( Vertex2 ) );
+	for ( U32 i = 0; i < numVertices; i++ )
+	{
+		src[i].x = (Real)( i % 640 );
+		src[i].y = (Real)( i / 640 );
+		texSrc[i].x = (Real)( i & 1 );
+		texSrc[i].y = (Real)( ( i >> 1 ) & 1 );
+	}
+
+	Geometry scalarGeometry( allocator, Geometry::kTriangleStrip, numVertices, 0, false );
+	Geometry batchGeometry( allocator, Geometry::kTriangleStrip, numVertices, 0, false );
+
+	Matrix m;
+	m.Rotate( 30.f );
+	m.Scale( 1.5f, 0.75f );
+	m.Translate( 100.f, 50.f );
+
+	double scalarTime = 0.;
+	double batchTime = 0.;
+
+	// Alternate the two so both see the same cache and clock conditions
+	for ( U32 n = 0; n < numIterations; n++ )
+	{
+		Rtt_AbsoluteTime start = Rtt_GetAbsoluteTime();
+		ApplyScalar( m, scalarGeometry, src, texSrc, numVertices );
+		scalarTime += MicrosecondsSince( start );
+
+		start = Rtt_GetAbsoluteTime();
+		m.Apply( batchGeometry, src, texSrc, numVertices );
+		batchTime += MicrosecondsSince( start );
+	}
+
+	// Both paths must produce the same vertices
+	int mismatches = 0;
+	const Geometry::Vertex *a = scalarGeometry.GetVertexData();
+	const Geometry::Vertex *b = batchGeometry.GetVertexData();
+	for ( U32 i = 0; i < numVertices; i++ )
+	{
+		if ( fabsf( a[i].x - b[i].x ) > 1e-3f || fabsf( a[i].y - b[i].y ) > 1e-3f
+			|| a[i].z != b[i].z || a[i].u != b[i].u || a[i].v != b[i].v || a[i].q != b[i].q )
+		{
+			++mismatches;
+		}
+	}
+
+	printf( "%u vertices, %u iterations\n", numVertices, numIterations );
+	printf( "scalar: %8.2f us per call\n", scalarTime / numIterations );
+	printf( "batch:  %8.2f us per call (%.2fx)\n", batchTime / numIterations, scalarTime / batchTime );
+
+	free( texSrc );
+	free( src );
+
+	if ( mismatches > 0 )
+	{
+		printf( "FAILED: %d vertices differ\n", mismatches );
+		return 1;
+	}
+
+	printf( "PASS\n" );
+	return 0;
+}
+
+int
+main( int argc, const char *argv[] )
+{
+	U32 numVertices = argc > 1 ? (U32)atoi( argv[1] ) : 40000; // 10k rects
+	U32 numIterations = argc > 2 ? (U32)atoi( argv[2] ) : 1000;
+
+	Rtt_Allocator *allocator = Rtt_AllocatorCreate();
+	int result = Run( allocator, numVertices, numIterations );
+	Rtt_AllocatorDestroy( allocator );
+
+	return result;
+}
+
+// ----------------------------------------------------------------------------